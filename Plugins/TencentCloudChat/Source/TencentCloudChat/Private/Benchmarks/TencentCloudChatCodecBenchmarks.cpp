@@ -0,0 +1,187 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatBenchmark.h"
+
+#if TENCENTCLOUDCHAT_WITH_BENCHMARKS
+
+#include "TencentCloudChatCodec.h"
+#include "TencentCloudChatString.h"
+#include "Dom/JsonObject.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+// 一条典型的礼物连击消息：TencentCloudChatCodec 与手写 JSON（FJsonObject）的编解码对比
+namespace
+{
+	namespace CodecBenchField
+	{
+		enum : uint32
+		{
+			GiftId = 1,
+			Count,
+			SenderLevel,
+			Combo,
+			Message,
+			PositionX,
+			PositionY,
+			ComboTimestamps,
+		};
+	}
+
+	const TencentCloudChatCodecSchema CodecBenchSchema = TencentCloudChatCodecSchema(1, 1)
+		.Field(CodecBenchField::GiftId, TEXT("GiftId"), ETencentCloudChatCodecType::UInt)
+		.Field(CodecBenchField::Count, TEXT("Count"), ETencentCloudChatCodecType::UInt)
+		.Field(CodecBenchField::SenderLevel, TEXT("SenderLevel"), ETencentCloudChatCodecType::UInt)
+		.Field(CodecBenchField::Combo, TEXT("Combo"), ETencentCloudChatCodecType::Bool)
+		.Field(CodecBenchField::Message, TEXT("Message"), ETencentCloudChatCodecType::String)
+		.Field(CodecBenchField::PositionX, TEXT("PositionX"), ETencentCloudChatCodecType::Float)
+		.Field(CodecBenchField::PositionY, TEXT("PositionY"), ETencentCloudChatCodecType::Float)
+		.Field(CodecBenchField::ComboTimestamps, TEXT("ComboTimestamps"), ETencentCloudChatCodecType::IntArray);
+
+	struct CodecBenchGift
+	{
+		uint64 GiftId = 10086;
+		uint64 Count = 99;
+		uint64 SenderLevel = 42;
+		bool bCombo = true;
+		FString Message = TEXT("送你一架火箭 🚀 GG!");
+		float PositionX = 512.25f;
+		float PositionY = 384.5f;
+		TArray<int64> ComboTimestamps = { 1700000000000, 1700000000120, 1700000000245, 1700000000361,
+										  1700000000480, 1700000000602, 1700000000719, 1700000000840 };
+	};
+	const CodecBenchGift CodecBenchSample;
+
+	void CodecBenchEncodeBinary(TencentCloudChatCodecWriter &Writer, const CodecBenchGift &Gift)
+	{
+		Writer.Reset();
+		Writer.WriteUInt(CodecBenchField::GiftId, Gift.GiftId);
+		Writer.WriteUInt(CodecBenchField::Count, Gift.Count);
+		Writer.WriteUInt(CodecBenchField::SenderLevel, Gift.SenderLevel);
+		Writer.WriteBool(CodecBenchField::Combo, Gift.bCombo);
+		Writer.WriteString(CodecBenchField::Message, FStringView(Gift.Message));
+		Writer.WriteFloat(CodecBenchField::PositionX, Gift.PositionX);
+		Writer.WriteFloat(CodecBenchField::PositionY, Gift.PositionY);
+		Writer.WriteIntArray(CodecBenchField::ComboTimestamps, Gift.ComboTimestamps);
+	}
+
+	bool CodecBenchDecodeBinary(TConstArrayView<uint8> Data, CodecBenchGift &Gift)
+	{
+		TencentCloudChatCodecReader Reader;
+		if (!Reader.Parse(Data, &CodecBenchSchema))
+		{
+			return false;
+		}
+		Reader.ReadUInt(CodecBenchField::GiftId, Gift.GiftId);
+		Reader.ReadUInt(CodecBenchField::Count, Gift.Count);
+		Reader.ReadUInt(CodecBenchField::SenderLevel, Gift.SenderLevel);
+		Reader.ReadBool(CodecBenchField::Combo, Gift.bCombo);
+		Reader.ReadString(CodecBenchField::Message, Gift.Message);
+		Reader.ReadFloat(CodecBenchField::PositionX, Gift.PositionX);
+		Reader.ReadFloat(CodecBenchField::PositionY, Gift.PositionY);
+		TencentCloudChatCodecIntArrayView Timestamps;
+		if (Reader.ReadIntArray(CodecBenchField::ComboTimestamps, Timestamps))
+		{
+			Gift.ComboTimestamps.Reset();
+			Timestamps.ToArray(Gift.ComboTimestamps);
+		}
+		return true;
+	}
+
+	// 业务侧常见的写法：FJsonObject -> FString -> UTF-8
+	TArray<uint8> CodecBenchEncodeJson(const CodecBenchGift &Gift)
+	{
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetNumberField(TEXT("giftId"), double(Gift.GiftId));
+		Object->SetNumberField(TEXT("count"), double(Gift.Count));
+		Object->SetNumberField(TEXT("senderLevel"), double(Gift.SenderLevel));
+		Object->SetBoolField(TEXT("combo"), Gift.bCombo);
+		Object->SetStringField(TEXT("message"), Gift.Message);
+		Object->SetNumberField(TEXT("positionX"), Gift.PositionX);
+		Object->SetNumberField(TEXT("positionY"), Gift.PositionY);
+		TArray<TSharedPtr<FJsonValue>> Timestamps;
+		for (int64 Timestamp : Gift.ComboTimestamps)
+		{
+			Timestamps.Add(MakeShared<FJsonValueNumber>(double(Timestamp)));
+		}
+		Object->SetArrayField(TEXT("comboTimestamps"), Timestamps);
+
+		FString Json;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+		FJsonSerializer::Serialize(Object, Writer);
+
+		FTCHARToUTF8 Utf8(*Json);
+		return TArray<uint8>(reinterpret_cast<const uint8 *>(Utf8.Get()), Utf8.Length());
+	}
+
+	bool CodecBenchDecodeJson(TConstArrayView<uint8> Data, CodecBenchGift &Gift)
+	{
+		FString Json;
+		TencentCloudChatString::ToFString(FUtf8StringView(reinterpret_cast<const UTF8CHAR *>(Data.GetData()), Data.Num()), Json);
+
+		TSharedPtr<FJsonObject> Object;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<TCHAR>::Create(Json), Object) || !Object.IsValid())
+		{
+			return false;
+		}
+		Gift.GiftId = uint64(Object->GetNumberField(TEXT("giftId")));
+		Gift.Count = uint64(Object->GetNumberField(TEXT("count")));
+		Gift.SenderLevel = uint64(Object->GetNumberField(TEXT("senderLevel")));
+		Gift.bCombo = Object->GetBoolField(TEXT("combo"));
+		Gift.Message = Object->GetStringField(TEXT("message"));
+		Gift.PositionX = float(Object->GetNumberField(TEXT("positionX")));
+		Gift.PositionY = float(Object->GetNumberField(TEXT("positionY")));
+		Gift.ComboTimestamps.Reset();
+		for (const TSharedPtr<FJsonValue> &Value : Object->GetArrayField(TEXT("comboTimestamps")))
+		{
+			Gift.ComboTimestamps.Add(int64(Value->AsNumber()));
+		}
+		return true;
+	}
+
+	TencentCloudChatBenchmark::Registrar CodecEncodeBinary(TEXT("Codec.Encode.Gift.Binary"), [](int64 Iterations)
+	{
+		TencentCloudChatCodecWriter Writer(CodecBenchSchema);
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			CodecBenchEncodeBinary(Writer, CodecBenchSample);
+			TencentCloudChatBenchmark::Sink(Writer.GetData().Num());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar CodecEncodeJson(TEXT("Codec.Encode.Gift.Json"), [](int64 Iterations)
+	{
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			TencentCloudChatBenchmark::Sink(CodecBenchEncodeJson(CodecBenchSample).Num());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar CodecDecodeBinary(TEXT("Codec.Decode.Gift.Binary"), [](int64 Iterations)
+	{
+		TencentCloudChatCodecWriter Writer(CodecBenchSchema);
+		CodecBenchEncodeBinary(Writer, CodecBenchSample);
+		const TArray<uint8> Encoded(Writer.GetData());
+		CodecBenchGift Gift;
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			CodecBenchDecodeBinary(Encoded, Gift);
+			TencentCloudChatBenchmark::Sink(int64(Gift.Count));
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar CodecDecodeJson(TEXT("Codec.Decode.Gift.Json"), [](int64 Iterations)
+	{
+		const TArray<uint8> Encoded = CodecBenchEncodeJson(CodecBenchSample);
+		CodecBenchGift Gift;
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			CodecBenchDecodeJson(Encoded, Gift);
+			TencentCloudChatBenchmark::Sink(int64(Gift.Count));
+		}
+	});
+}
+
+#endif // TENCENTCLOUDCHAT_WITH_BENCHMARKS
@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatBenchmark.h"
+
+#if TENCENTCLOUDCHAT_WITH_BENCHMARKS
+
+#include "TencentCloudChatConversationStore.h"
+
+#include "Algo/Sort.h"
+#include "Math/RandomStream.h"
+
+// 会话列表的增量更新：1 次操作为一个随机会话收到新消息（orderKey 变为最大），即 OnConversationChanged 的常见情形
+//
+// Store 用例直接写入全局的 TencentCloudChatConversationStore（包含 OnChanged 广播），预热时批量插入 bench_ 开头的会话，
+// 结束后删除；已加载的真实会话会一起参与排序。SortedArray 用例是引入 Store 之前的做法：TArray 中线性查找、
+// 修改后整体重新排序。
+namespace
+{
+	constexpr int32 ConversationBenchSeed = 0x7E5C;
+
+	V2TIMConversation MakeBenchConversation(int32 index, uint64 orderKey)
+	{
+		V2TIMConversation Conversation;
+		Conversation.conversationID = TCHAR_TO_UTF8(*FString::Printf(TEXT("bench_c2c_%06d"), index));
+		Conversation.userID = TCHAR_TO_UTF8(*FString::Printf(TEXT("bench_%06d"), index));
+		Conversation.type = V2TIM_C2C;
+		Conversation.isPinned = index % 100 == 0;
+		Conversation.orderKey = orderKey;
+		return Conversation;
+	}
+
+	// 已经写入 Store 的 bench_ 会话数和最近使用的 orderKey
+	int32 StoreBenchPopulated = 0;
+	uint64 StoreBenchOrderKey = 0;
+
+	void PopulateStoreBench(int32 size)
+	{
+		if (StoreBenchPopulated >= size)
+		{
+			return;
+		}
+		V2TIMConversationVector Conversations;
+		for (int32 Index = StoreBenchPopulated; Index < size; ++Index)
+		{
+			Conversations.PushBack(MakeBenchConversation(Index, ++StoreBenchOrderKey));
+		}
+		TencentCloudChatConversationStore::Upsert(Conversations);
+		StoreBenchPopulated = size;
+	}
+
+	void ClearStoreBench()
+	{
+		for (int32 Index = 0; Index < StoreBenchPopulated; ++Index)
+		{
+			TencentCloudChatConversationStore::Remove(MakeBenchConversation(Index, 0).conversationID);
+		}
+		StoreBenchPopulated = 0;
+		StoreBenchOrderKey = 0;
+	}
+
+	void RunStoreBench(int32 size, int64 iterations)
+	{
+		PopulateStoreBench(size);
+		FRandomStream Random(ConversationBenchSeed);
+		for (int64 Iteration = 0; Iteration < iterations; ++Iteration)
+		{
+			V2TIMConversationVector Changed;
+			Changed.PushBack(MakeBenchConversation(Random.RandHelper(size), ++StoreBenchOrderKey));
+			TencentCloudChatConversationStore::Upsert(Changed);
+		}
+		TencentCloudChatBenchmark::Sink(TencentCloudChatConversationStore::GetIndex(MakeBenchConversation(0, 0).conversationID));
+	}
+
+	/**
+	 * 与 TencentCloudChatConversationStore 相同的排序规则
+	 */
+	bool SortedArrayBenchLess(const V2TIMConversation &a, const V2TIMConversation &b)
+	{
+		if (a.isPinned != b.isPinned)
+		{
+			return a.isPinned;
+		}
+		if (a.orderKey != b.orderKey)
+		{
+			return a.orderKey > b.orderKey;
+		}
+		return strcmp(a.conversationID.CString(), b.conversationID.CString()) < 0;
+	}
+
+	TArray<V2TIMConversation> SortedArrayBenchConversations;
+	uint64 SortedArrayBenchOrderKey = 0;
+
+	void ClearSortedArrayBench()
+	{
+		SortedArrayBenchConversations.Empty();
+		SortedArrayBenchOrderKey = 0;
+	}
+
+	void RunSortedArrayBench(int32 size, int64 iterations)
+	{
+		TArray<V2TIMConversation> &Conversations = SortedArrayBenchConversations;
+		if (Conversations.Num() != size)
+		{
+			ClearSortedArrayBench();
+			Conversations.Reserve(size);
+			for (int32 Index = 0; Index < size; ++Index)
+			{
+				Conversations.Add(MakeBenchConversation(Index, ++SortedArrayBenchOrderKey));
+			}
+			Algo::Sort(Conversations, SortedArrayBenchLess);
+		}
+
+		FRandomStream Random(ConversationBenchSeed);
+		for (int64 Iteration = 0; Iteration < iterations; ++Iteration)
+		{
+			const V2TIMConversation Changed = MakeBenchConversation(Random.RandHelper(size), ++SortedArrayBenchOrderKey);
+			V2TIMConversation *Existing = Conversations.FindByPredicate([&Changed](const V2TIMConversation &Conversation)
+			{
+				return Conversation.conversationID == Changed.conversationID;
+			});
+			*Existing = Changed;
+			Algo::Sort(Conversations, SortedArrayBenchLess);
+		}
+		TencentCloudChatBenchmark::Sink(Conversations[0].orderKey);
+	}
+
+	TencentCloudChatBenchmark::Registrar Store1K(TEXT("Conversation.Store.Update.1k"), [](int64 Iterations) { RunStoreBench(1000, Iterations); }, &ClearStoreBench);
+	TencentCloudChatBenchmark::Registrar Store10K(TEXT("Conversation.Store.Update.10k"), [](int64 Iterations) { RunStoreBench(10000, Iterations); }, &ClearStoreBench);
+	TencentCloudChatBenchmark::Registrar Store100K(TEXT("Conversation.Store.Update.100k"), [](int64 Iterations) { RunStoreBench(100000, Iterations); }, &ClearStoreBench);
+
+	TencentCloudChatBenchmark::Registrar SortedArray1K(TEXT("Conversation.SortedArray.Update.1k"), [](int64 Iterations) { RunSortedArrayBench(1000, Iterations); }, &ClearSortedArrayBench);
+	TencentCloudChatBenchmark::Registrar SortedArray10K(TEXT("Conversation.SortedArray.Update.10k"), [](int64 Iterations) { RunSortedArrayBench(10000, Iterations); }, &ClearSortedArrayBench);
+	TencentCloudChatBenchmark::Registrar SortedArray100K(TEXT("Conversation.SortedArray.Update.100k"), [](int64 Iterations) { RunSortedArrayBench(100000, Iterations); }, &ClearSortedArrayBench);
+}
+
+#endif // TENCENTCLOUDCHAT_WITH_BENCHMARKS
@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatBenchmark.h"
+
+#if TENCENTCLOUDCHAT_WITH_BENCHMARKS
+
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatDispatcher.h"
+
+// 回调的包装开销：业务回调直接调用，与经过 TencentCloudChatDispatcher::Marshal（统计、延迟记录、游戏线程分发）的对比
+//
+// 在当前线程上模拟 SDK 触发回调。打开 TencentCloudChat.Dispatch.GameThread 时每次操作包含一次入队和一次 Drain，
+// 需要在游戏线程运行。
+namespace
+{
+	void DrainDispatcherBench()
+	{
+		if (TencentCloudChatDispatcher::IsGameThreadDispatchEnabled() && IsInGameThread())
+		{
+			TencentCloudChatDispatcher::Drain(0.0);
+		}
+	}
+
+	TencentCloudChatBenchmark::Registrar CallbackDirect(TEXT("Dispatcher.Callback.Direct"), [](int64 Iterations)
+	{
+		int64 Calls = 0;
+		for (int64 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			V2TIMCallback *Callback = TencentCloudChatCallback::Create([&Calls]() { ++Calls; });
+			Callback->OnSuccess();
+		}
+		TencentCloudChatBenchmark::Sink(Calls);
+	});
+
+	TencentCloudChatBenchmark::Registrar CallbackMarshal(TEXT("Dispatcher.Callback.Marshal"), [](int64 Iterations)
+	{
+		int64 Calls = 0;
+		for (int64 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			V2TIMCallback *Callback = TencentCloudChatDispatcher::Marshal(TencentCloudChatCallback::Create([&Calls]() { ++Calls; }));
+			Callback->OnSuccess();
+			DrainDispatcherBench();
+		}
+		TencentCloudChatBenchmark::Sink(Calls);
+	});
+
+	TencentCloudChatBenchmark::Registrar SendCallbackDirect(TEXT("Dispatcher.SendCallback.Direct"), [](int64 Iterations)
+	{
+		const V2TIMMessage Message;
+		int64 Calls = 0;
+		for (int64 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			V2TIMSendCallback *Callback = TencentCloudChatSendCallback::Create([&Calls](const V2TIMMessage &) { ++Calls; });
+			Callback->OnSuccess(Message);
+		}
+		TencentCloudChatBenchmark::Sink(Calls);
+	});
+
+	/**
+	 * 发送回调的 OnSuccess 带一个 V2TIMMessage，游戏线程分发时需要拷贝消息
+	 */
+	TencentCloudChatBenchmark::Registrar SendCallbackMarshal(TEXT("Dispatcher.SendCallback.Marshal"), [](int64 Iterations)
+	{
+		const V2TIMMessage Message;
+		int64 Calls = 0;
+		for (int64 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			V2TIMSendCallback *Callback = TencentCloudChatDispatcher::Marshal(TencentCloudChatSendCallback::Create([&Calls](const V2TIMMessage &) { ++Calls; }));
+			Callback->OnSuccess(Message);
+			DrainDispatcherBench();
+		}
+		TencentCloudChatBenchmark::Sink(Calls);
+	});
+
+	/**
+	 * 批量入队后一次 Drain，对应消息突发时的分发
+	 */
+	TencentCloudChatBenchmark::Registrar EnqueueDrain(TEXT("Dispatcher.Enqueue.Drain.Batch"), [](int64 Iterations)
+	{
+		if (!IsInGameThread())
+		{
+			TencentCloudChatBenchmark::Skip(TEXT("must run on the game thread"));
+			return;
+		}
+		int64 Calls = 0;
+		for (int64 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			TencentCloudChatDispatcher::Enqueue([&Calls]() { ++Calls; });
+		}
+		TencentCloudChatDispatcher::Drain(0.0);
+		TencentCloudChatBenchmark::Sink(Calls);
+	});
+}
+
+#endif // TENCENTCLOUDCHAT_WITH_BENCHMARKS
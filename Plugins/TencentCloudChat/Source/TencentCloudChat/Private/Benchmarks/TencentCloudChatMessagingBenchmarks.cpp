@@ -0,0 +1,196 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatBenchmark.h"
+
+#if TENCENTCLOUDCHAT_WITH_BENCHMARKS
+
+#include "TencentCloudChat.h"
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatDispatcher.h"
+#include "TencentCloudChatLoopback.h"
+#include "TencentCloudChatPrivate.h"
+
+#include "V2TIMListener.h"
+#include "V2TIMMessageManager.h"
+
+// 经过 TencentCloudChat 的消息吞吐：在进程内回环后端（TencentCloudChatLoopback）上发送、等待回调和回显
+//
+// 运行期间 TencentCloudChat 临时改用一个回环客户端，结束后恢复原来的后端；用例在调用 TencentCloudChat.Bench 的线程上
+// 同步运行，期间不会有其他游戏线程代码调用 TencentCloudChat。回环网络的延迟取 TencentCloudChat.Loopback.LatencyMs，
+// 默认为 0，此时测到的是插件和回环后端自身的开销。
+namespace
+{
+	constexpr double MessagingBenchTimeoutSeconds = 30.0;
+
+	const char *const MessagingBenchClientID = "bench_client";
+	const char *const MessagingBenchEchoID = "bench_echo";
+	// 不登录的账号，发给它的消息只有发送回调
+	const char *const MessagingBenchSinkID = "bench_sink";
+
+	/**
+	 * 把收到的文本消息原样发回给发送方
+	 */
+	class MessagingBenchEchoListener : public V2TIMAdvancedMsgListener
+	{
+	public:
+		V2TIMManager *Manager = nullptr;
+
+		void OnRecvNewMessage(const V2TIMMessage &message) override
+		{
+			if (message.elemList.Size() == 1 && message.elemList[0]->elemType == V2TIM_ELEM_TYPE_TEXT)
+			{
+				Manager->SendC2CTextMessage(static_cast<const V2TIMTextElem *>(message.elemList[0])->text, message.sender, nullptr);
+			}
+		}
+	};
+
+	/**
+	 * 经过 TencentCloudChat 注册，统计回到插件的消息数
+	 */
+	class MessagingBenchCountingListener : public V2TIMAdvancedMsgListener
+	{
+	public:
+		TAtomic<int64> Received{0};
+
+		void OnRecvNewMessage(const V2TIMMessage &message) override
+		{
+			++Received;
+		}
+	};
+
+	struct MessagingBenchWorld
+	{
+		V2TIMManager *Client = nullptr;
+		V2TIMManager *Echo = nullptr;
+		MessagingBenchEchoListener EchoListener;
+		MessagingBenchCountingListener ClientListener;
+		TAtomic<int64> Acked{0};
+	};
+
+	/**
+	 * 第一次使用时创建并登录两个回环客户端，之后一直保留
+	 */
+	MessagingBenchWorld &GetMessagingBenchWorld()
+	{
+		static MessagingBenchWorld *World = []()
+		{
+			MessagingBenchWorld *NewWorld = new MessagingBenchWorld();
+			NewWorld->Client = TencentCloudChatLoopback::CreateManager();
+			NewWorld->Echo = TencentCloudChatLoopback::CreateManager();
+			NewWorld->EchoListener.Manager = NewWorld->Echo;
+			for (V2TIMManager *Manager : {NewWorld->Client, NewWorld->Echo})
+			{
+				Manager->InitSDK(0, V2TIMSDKConfig());
+			}
+			NewWorld->Client->Login(V2TIMString(MessagingBenchClientID), V2TIMString(), nullptr);
+			NewWorld->Echo->Login(V2TIMString(MessagingBenchEchoID), V2TIMString(), nullptr);
+			NewWorld->Echo->GetMessageManager()->AddAdvancedMsgListener(&NewWorld->EchoListener);
+			TencentCloudChatLoopback::Flush(MessagingBenchTimeoutSeconds);
+			return NewWorld;
+		}();
+		return *World;
+	}
+
+	/**
+	 * 在作用域内让 TencentCloudChat 使用 manager
+	 */
+	class MessagingBenchBackendScope
+	{
+	public:
+		explicit MessagingBenchBackendScope(V2TIMManager *manager)
+			: Previous(TencentCloudChatBackend::IsOverridden() ? TencentCloudChatBackend::Get() : nullptr)
+		{
+			TencentCloudChatBackend::Set(manager);
+		}
+
+		~MessagingBenchBackendScope()
+		{
+			TencentCloudChatBackend::Set(Previous);
+		}
+
+	private:
+		V2TIMManager *Previous;
+	};
+
+	/**
+	 * 等待 counter 达到 target；打开游戏线程分发时回调在游戏线程执行，等待期间需要执行分发队列
+	 */
+	bool WaitForMessagingBench(const TAtomic<int64> &counter, int64 target)
+	{
+		const bool bDrain = TencentCloudChatDispatcher::IsGameThreadDispatchEnabled() && IsInGameThread();
+		const double Deadline = FPlatformTime::Seconds() + MessagingBenchTimeoutSeconds;
+		while (counter.Load() < target)
+		{
+			if (bDrain)
+			{
+				TencentCloudChatDispatcher::Drain(0.0);
+			}
+			else
+			{
+				FPlatformProcess::YieldThread();
+			}
+			if (FPlatformTime::Seconds() > Deadline)
+			{
+				TencentCloudChatBenchmark::Skip(FString::Printf(TEXT("timed out after %lld of %lld"), counter.Load(), target));
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * 发送 iterations 条文本消息，每条消息一个从对象池分配的发送回调
+	 */
+	void SendMessagingBenchMessages(MessagingBenchWorld &world, int64 iterations, const V2TIMString &receiver)
+	{
+		const V2TIMString Text("gg wp, rematch?");
+		const V2TIMOfflinePushInfo OfflinePushInfo;
+		for (int64 Iteration = 0; Iteration < iterations; ++Iteration)
+		{
+			V2TIMMessage Message = TencentCloudChat::CreateTextMessage(Text);
+			TencentCloudChat::SendMessage(Message, receiver, V2TIMString(), V2TIM_PRIORITY_NORMAL, false, OfflinePushInfo,
+				TencentCloudChatSendCallback::Create(
+					[&world](const V2TIMMessage &)
+					{
+						++world.Acked;
+					},
+					[&world](int, const V2TIMString &)
+					{
+						++world.Acked;
+					}));
+		}
+	}
+
+	/**
+	 * CreateTextMessage + SendMessage，等待全部发送回调；接收方不在线
+	 */
+	TencentCloudChatBenchmark::Registrar MessagingSendAck(TEXT("Messaging.Loopback.C2C.SendAck"), [](int64 Iterations)
+	{
+		MessagingBenchWorld &World = GetMessagingBenchWorld();
+		MessagingBenchBackendScope Backend(World.Client);
+		World.Acked = 0;
+		SendMessagingBenchMessages(World, Iterations, V2TIMString(MessagingBenchSinkID));
+		WaitForMessagingBench(World.Acked, Iterations);
+	});
+
+	/**
+	 * SendMessage 发出，对端回显后经过插件的监听器在 OnRecvNewMessage 收到；1 次操作为 1 个来回
+	 */
+	TencentCloudChatBenchmark::Registrar MessagingRoundTrip(TEXT("Messaging.Loopback.C2C.RoundTrip"), [](int64 Iterations)
+	{
+		MessagingBenchWorld &World = GetMessagingBenchWorld();
+		MessagingBenchBackendScope Backend(World.Client);
+		TencentCloudChat::AddAdvancedMsgListener(&World.ClientListener);
+		World.Acked = 0;
+		World.ClientListener.Received = 0;
+		SendMessagingBenchMessages(World, Iterations, V2TIMString(MessagingBenchEchoID));
+		if (WaitForMessagingBench(World.ClientListener.Received, Iterations))
+		{
+			WaitForMessagingBench(World.Acked, Iterations);
+		}
+		TencentCloudChat::RemoveAdvancedMsgListener(&World.ClientListener);
+	});
+}
+
+#endif // TENCENTCLOUDCHAT_WITH_BENCHMARKS
@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatBenchmark.h"
+
+#if TENCENTCLOUDCHAT_WITH_BENCHMARKS
+
+#include "TencentCloudChat.h"
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatSearch.h"
+#include "HAL/Event.h"
+#include "Math/RandomStream.h"
+#include "Misc/StringBuilder.h"
+
+// 本地全文索引（TencentCloudChatTextIndex）在 10 万条中英文混合消息上的边输入边搜索，与 SDK 的 SearchLocalMessages 对比
+namespace
+{
+	constexpr int32 SearchBenchMessages = 100000;
+	constexpr int32 SearchBenchConversations = 200;
+
+	const TCHAR *const SearchBenchWords[] = {
+		TEXT("gg"), TEXT("wp"), TEXT("lobby"), TEXT("ready"), TEXT("push"), TEXT("mid"), TEXT("boss"), TEXT("raid"),
+		TEXT("loot"), TEXT("heal"), TEXT("tank"), TEXT("afk"), TEXT("queue"), TEXT("rank"), TEXT("match"), TEXT("team"),
+		TEXT("再来一局"), TEXT("准备好了"), TEXT("等我一下"), TEXT("打野"), TEXT("上路"), TEXT("开团"), TEXT("撤退"), TEXT("装备"),
+		TEXT("副本"), TEXT("队长"), TEXT("晚上见"), TEXT("谢谢"), TEXT("好的"), TEXT("收到"), TEXT("厉害"), TEXT("加油"),
+	};
+
+	FString MakeSearchBenchText(FRandomStream &Random)
+	{
+		TStringBuilder<128> Text;
+		const int32 Words = Random.RandRange(3, 10);
+		for (int32 Index = 0; Index < Words; ++Index)
+		{
+			if (Index > 0)
+			{
+				Text << TEXT(' ');
+			}
+			Text << SearchBenchWords[Random.RandHelper(UE_ARRAY_COUNT(SearchBenchWords))];
+		}
+		return FString(Text.ToView());
+	}
+
+	V2TIMString MakeSearchBenchID(const ANSICHAR *prefix, int32 number)
+	{
+		TAnsiStringBuilder<32> ID;
+		ID << prefix << number;
+		return V2TIMString(ID.GetData(), ID.Len());
+	}
+
+	/**
+	 * 固定种子生成的索引，第一次使用时建立
+	 */
+	TencentCloudChatTextIndex &GetSearchBenchIndex()
+	{
+		static TencentCloudChatTextIndex *Index = []()
+		{
+			TencentCloudChatTextIndex *NewIndex = new TencentCloudChatTextIndex();
+			FRandomStream Random(20240601);
+			for (int32 Number = 0; Number < SearchBenchMessages; ++Number)
+			{
+				NewIndex->Add(MakeSearchBenchID("msg_", Number), MakeSearchBenchID("group_", Number % SearchBenchConversations),
+							  1700000000 + Number, MakeSearchBenchText(Random));
+			}
+			return NewIndex;
+		}();
+		return *Index;
+	}
+
+	void RunSearchBenchQuery(int64 Iterations, const TCHAR *Query, const V2TIMString &ConversationID = V2TIMString())
+	{
+		TencentCloudChatTextIndex &Index = GetSearchBenchIndex();
+		TArray<TencentCloudChatSearchHit> Hits;
+		for (int64 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			TencentCloudChatBenchmark::Sink(Index.Search(Query, Hits, 20, ConversationID));
+		}
+	}
+
+	TencentCloudChatBenchmark::Registrar SearchInsert(TEXT("Search.Index.Insert"), [](int64 Iterations)
+	{
+		TencentCloudChatTextIndex Index;
+		FRandomStream Random(7);
+		TArray<FString> Texts;
+		Texts.Reserve(1024);
+		for (int32 Number = 0; Number < 1024; ++Number)
+		{
+			Texts.Add(MakeSearchBenchText(Random));
+		}
+		const V2TIMString ConversationID("group_bench");
+		for (int64 Number = 0; Number < Iterations; ++Number)
+		{
+			Index.Add(MakeSearchBenchID("msg_", int32(Number)), ConversationID, Number, Texts[Number % Texts.Num()]);
+		}
+		TencentCloudChatBenchmark::Sink(Index.Num());
+	});
+
+	// 边输入边搜索：依次输入 "l"、"lo"、"lob"、"lobb"，单个字母的关键字会被忽略
+	TencentCloudChatBenchmark::Registrar SearchLatinTyping(TEXT("Search.Index.Latin.TypeAhead.100k"), [](int64 Iterations)
+	{
+		RunSearchBenchQuery(Iterations, TEXT("l"));
+		RunSearchBenchQuery(Iterations, TEXT("lo"));
+		RunSearchBenchQuery(Iterations, TEXT("lob"));
+		RunSearchBenchQuery(Iterations, TEXT("lobb"));
+	});
+
+	TencentCloudChatBenchmark::Registrar SearchCJKTyping(TEXT("Search.Index.CJK.TypeAhead.100k"), [](int64 Iterations)
+	{
+		RunSearchBenchQuery(Iterations, TEXT("再"));
+		RunSearchBenchQuery(Iterations, TEXT("再来"));
+		RunSearchBenchQuery(Iterations, TEXT("再来一"));
+		RunSearchBenchQuery(Iterations, TEXT("再来一局"));
+	});
+
+	TencentCloudChatBenchmark::Registrar SearchTwoTerms(TEXT("Search.Index.TwoTerms.100k"), [](int64 Iterations)
+	{
+		RunSearchBenchQuery(Iterations, TEXT("boss 开团"));
+	});
+
+	TencentCloudChatBenchmark::Registrar SearchConversation(TEXT("Search.Index.OneConversation.100k"), [](int64 Iterations)
+	{
+		RunSearchBenchQuery(Iterations, TEXT("再来一局"), V2TIMString("group_42"));
+	});
+
+	/**
+	 * SDK 的 SearchLocalMessages：搜索当前登录账号本地数据库中的全部会话，每次等待回调返回
+	 *
+	 * 需要已经登录，数据库中的消息与上面的索引不同，只用于比较单次搜索的往返耗时。直接调用 SDK 接口，
+	 * 回调在 SDK 线程执行，不经过游戏线程分发，可以在游戏线程上等待。
+	 */
+	TencentCloudChatBenchmark::Registrar SearchSDK(TEXT("Search.SDK.SearchLocalMessages"), [](int64 Iterations)
+	{
+		if (TencentCloudChat::GetLoginStatus() != V2TIM_STATUS_LOGINED)
+		{
+			TencentCloudChatBenchmark::Skip(TEXT("not logged in"));
+			return;
+		}
+
+		V2TIMMessageSearchParam Param;
+		Param.keywordList.PushBack(V2TIMString(TCHAR_TO_UTF8(TEXT("再来一局"))));
+		Param.keywordListMatchType = V2TIM_KEYWORD_LIST_MATCH_TYPE_AND;
+		Param.pageIndex = 0;
+		Param.pageSize = 20;
+
+		FEvent *Done = FPlatformProcess::GetSynchEventFromPool();
+		for (int64 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			TencentCloudChatBackend::Get()->GetMessageManager()->SearchLocalMessages(Param, TencentCloudChatValueCallback<V2TIMMessageSearchResult>::Create(
+				[Done](const V2TIMMessageSearchResult &result)
+				{
+					TencentCloudChatBenchmark::Sink(result.totalCount);
+					Done->Trigger();
+				},
+				[Done](int error_code, const V2TIMString &error_message)
+				{
+					Done->Trigger();
+				}));
+			if (!Done->Wait(FTimespan::FromSeconds(5.0)))
+			{
+				// 回调之后仍可能触发，事件不能归还
+				TencentCloudChatBenchmark::Skip(TEXT("no callback within 5 s"));
+				return;
+			}
+		}
+		FPlatformProcess::ReturnSynchEventToPool(Done);
+	});
+}
+
+#endif // TENCENTCLOUDCHAT_WITH_BENCHMARKS
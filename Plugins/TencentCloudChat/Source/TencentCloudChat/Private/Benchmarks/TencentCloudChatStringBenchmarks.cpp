@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatBenchmark.h"
+
+#if TENCENTCLOUDCHAT_WITH_BENCHMARKS
+
+#include "TencentCloudChatString.h"
+
+// FString <-> V2TIMString：业务常用写法（TCHAR_TO_UTF8 / UTF8_TO_TCHAR）与 TencentCloudChatString 的对比
+namespace
+{
+	// 典型的 userID
+	const FString ShortText = TEXT("player_0123456789");
+
+	// 一条较长的聊天文本，包含中文，转换后超过 TCHAR_TO_UTF8 的内联缓冲区
+	FString MakeLongText()
+	{
+		FString Text;
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			Text += TEXT("gg wp, 再来一局？ see you in the next lobby! ");
+		}
+		return Text;
+	}
+	const FString LongText = MakeLongText();
+
+	TencentCloudChatBenchmark::Registrar ToV2TIMShortBaseline(TEXT("String.ToV2TIM.Short.TCHAR_TO_UTF8"), [](int64 Iterations)
+	{
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			V2TIMString Str(TCHAR_TO_UTF8(*ShortText));
+			TencentCloudChatBenchmark::Sink(Str.Size());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar ToV2TIMShortBridge(TEXT("String.ToV2TIM.Short.Bridge"), [](int64 Iterations)
+	{
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			V2TIMString Str = TencentCloudChatString::ToV2TIM(ShortText);
+			TencentCloudChatBenchmark::Sink(Str.Size());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar ToV2TIMLongBaseline(TEXT("String.ToV2TIM.Long.TCHAR_TO_UTF8"), [](int64 Iterations)
+	{
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			V2TIMString Str(TCHAR_TO_UTF8(*LongText));
+			TencentCloudChatBenchmark::Sink(Str.Size());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar ToV2TIMLongBridge(TEXT("String.ToV2TIM.Long.Bridge"), [](int64 Iterations)
+	{
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			V2TIMString Str = TencentCloudChatString::ToV2TIM(LongText);
+			TencentCloudChatBenchmark::Sink(Str.Size());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar ToFStringLongBaseline(TEXT("String.ToFString.Long.UTF8_TO_TCHAR"), [](int64 Iterations)
+	{
+		const V2TIMString Source = TencentCloudChatString::ToV2TIM(LongText);
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			FString Str(UTF8_TO_TCHAR(Source.CString()));
+			TencentCloudChatBenchmark::Sink(Str.Len());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar ToFStringLongBridge(TEXT("String.ToFString.Long.Bridge"), [](int64 Iterations)
+	{
+		const V2TIMString Source = TencentCloudChatString::ToV2TIM(LongText);
+		FString Str;
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			TencentCloudChatString::ToFString(Source, Str);
+			TencentCloudChatBenchmark::Sink(Str.Len());
+		}
+	});
+}
+
+#endif // TENCENTCLOUDCHAT_WITH_BENCHMARKS
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatBenchmark.h"
+
+#if TENCENTCLOUDCHAT_WITH_BENCHMARKS
+
+#include "TencentCloudChatVector.h"
+
+// 100 个 userID 的列表（GetUsersInfo 单次建议上限）：逐个 PushBack、TencentCloudChatVector 批量转换与 TArray 原生操作的对比
+namespace
+{
+	constexpr int32 ListSize = 100;
+
+	TArray<FString> MakeUserIDs()
+	{
+		TArray<FString> UserIDs;
+		UserIDs.Reserve(ListSize);
+		for (int32 Index = 0; Index < ListSize; ++Index)
+		{
+			UserIDs.Add(FString::Printf(TEXT("player_%010d"), Index));
+		}
+		return UserIDs;
+	}
+	const TArray<FString> UserIDs = MakeUserIDs();
+
+	TencentCloudChatBenchmark::Registrar ToV2TIMBaseline(TEXT("Vector.ToV2TIM.100.PushBack_TCHAR_TO_UTF8"), [](int64 Iterations)
+	{
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			V2TIMStringVector Vector;
+			for (const FString &UserID : UserIDs)
+			{
+				Vector.PushBack(TCHAR_TO_UTF8(*UserID));
+			}
+			TencentCloudChatBenchmark::Sink(Vector.Size());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar ToV2TIMBulk(TEXT("Vector.ToV2TIM.100.Bulk"), [](int64 Iterations)
+	{
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			V2TIMStringVector Vector = TencentCloudChatVector::ToV2TIM(UserIDs);
+			TencentCloudChatBenchmark::Sink(Vector.Size());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar ToV2TIMNative(TEXT("Vector.ToV2TIM.100.NativeTArrayCopy"), [](int64 Iterations)
+	{
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			TArray<FString> Copy = UserIDs;
+			TencentCloudChatBenchmark::Sink(Copy.Num());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar ToTArrayBaseline(TEXT("Vector.ToTArray.100.Add_UTF8_TO_TCHAR"), [](int64 Iterations)
+	{
+		const V2TIMStringVector Source = TencentCloudChatVector::ToV2TIM(UserIDs);
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			TArray<FString> Out;
+			for (size_t Element = 0; Element < Source.Size(); ++Element)
+			{
+				Out.Add(UTF8_TO_TCHAR(Source[Element].CString()));
+			}
+			TencentCloudChatBenchmark::Sink(Out.Num());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar ToTArrayBulk(TEXT("Vector.ToTArray.100.BulkReuse"), [](int64 Iterations)
+	{
+		const V2TIMStringVector Source = TencentCloudChatVector::ToV2TIM(UserIDs);
+		TArray<FString> Out;
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			TencentCloudChatVector::ToTArray(Source, Out);
+			TencentCloudChatBenchmark::Sink(Out.Num());
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar IterateRangeFor(TEXT("Vector.Iterate.100.RangeFor"), [](int64 Iterations)
+	{
+		const V2TIMStringVector Source = TencentCloudChatVector::ToV2TIM(UserIDs);
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			int64 Total = 0;
+			for (const V2TIMString &UserID : Source)
+			{
+				Total += UserID.Size();
+			}
+			TencentCloudChatBenchmark::Sink(Total);
+		}
+	});
+
+	TencentCloudChatBenchmark::Registrar IterateNative(TEXT("Vector.Iterate.100.NativeTArray"), [](int64 Iterations)
+	{
+		for (int64 Index = 0; Index < Iterations; ++Index)
+		{
+			int64 Total = 0;
+			for (const FString &UserID : UserIDs)
+			{
+				Total += UserID.Len();
+			}
+			TencentCloudChatBenchmark::Sink(Total);
+		}
+	});
+}
+
+#endif // TENCENTCLOUDCHAT_WITH_BENCHMARKS
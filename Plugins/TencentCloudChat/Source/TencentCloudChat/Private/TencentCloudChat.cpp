@@ -5,31 +5,31 @@
 #include "Modules/ModuleManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "CoreMinimal.h"
-#include "HAL/Runnable.h"
+#include "Async/Async.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatBatcher.h"
+#include "TencentCloudChatConversationStore.h"
+#include "TencentCloudChatDispatcher.h"
+#include "TencentCloudChatEventRecording.h"
+#include "TencentCloudChatHistoryCache.h"
+#include "TencentCloudChatListenerProxies.h"
+#include "TencentCloudChatLoadTest.h"
+#include "TencentCloudChatLoopback.h"
+#include "TencentCloudChatProfileCache.h"
+#include "TencentCloudChatRouter.h"
+#include "TencentCloudChatScheduler.h"
+#include "TencentCloudChatSearch.h"
+#include "TencentCloudChatStats.h"
+#include "TencentCloudChatTrace.h"
+#include "TencentCloudChatUnreadCounter.h"
+#include "TencentCloudChatUserStatus.h"
+#include "TencentCloudChatVector.h"
 // #include "TencentCloudChatLibrary/ExampleLibrary.h"
-class InitSDKRunner : public FRunnable
-{
-public:
-    virtual uint32 Run() override
-    {
-        // 在子线程中执行的函数
-		ReturnValue = V2TIMManager::GetInstance()->InitSDK(sdkAppID, config);
-        return 0;
-    }
-	void SetParam(uint32_t _sdkAppID,  V2TIMSDKConfig _config)
-    {
-        sdkAppID = _sdkAppID;
-		config = _config;
-    }
-	bool GetReturnValue() const
-    {
-        return ReturnValue;
-    }
-private:
-    bool ReturnValue = false;
-	uint32_t sdkAppID = 0;
-	V2TIMSDKConfig config = V2TIMSDKConfig();
-};
+
+DEFINE_LOG_CATEGORY(LogTencentCloudChat);
+
+DEFINE_STAT(STAT_TencentCloudChat_InitSDKTimeMs);
 
 #define LOCTEXT_NAMESPACE "TencentCloudChat"
 
@@ -68,6 +68,14 @@ void TencentCloudChat::StartupModule()
 		// // FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("ThirdPartyLibraryError", *LibraryPath));
 		// FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("ThirdPartyLibraryError", "Failed to load example third party library"));
 	}
+
+	TencentCloudChatLoopback::Startup();
+	TencentCloudChatStats::Startup();
+	TencentCloudChatDispatcher::Startup();
+	TencentCloudChatBatcher::Startup();
+	TencentCloudChatScheduler::Startup();
+	TencentCloudChatUnreadCounter::Startup();
+	TencentCloudChatUserStatus::Startup();
 }
 
 
@@ -76,6 +84,23 @@ void TencentCloudChat::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 
+	TencentCloudChatEventReplay::Shutdown();
+	TencentCloudChatEventRecorder::Shutdown();
+	TencentCloudChatLoadTest::Shutdown();
+	TencentCloudChatUserStatus::Shutdown();
+	TencentCloudChatUnreadCounter::Shutdown();
+	TencentCloudChatConversationStore::Shutdown();
+	TencentCloudChatProfileCache::Shutdown();
+	TencentCloudChatHistoryCache::Shutdown();
+	TencentCloudChatSearch::Shutdown();
+	TencentCloudChatRouter::Shutdown();
+	TencentCloudChatScheduler::Shutdown();
+	TencentCloudChatBatcher::Shutdown();
+	TencentCloudChatDispatcher::Shutdown();
+	TencentCloudChatTrace::Shutdown();
+	TencentCloudChatStats::Shutdown();
+	TencentCloudChatLoopback::Shutdown();
+
 	// Free the dll handle
 	FPlatformProcess::FreeDllHandle(ImSDKHandle);
 	ImSDKHandle = nullptr;
@@ -85,14 +110,17 @@ void TencentCloudChat::ShutdownModule()
  */
 void TencentCloudChat::AddSDKListener(V2TIMSDKListener *listener)
 {
-	V2TIMManager::GetInstance()->AddSDKListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(AddSDKListener);
+	TencentCloudChatBackend::Get()->AddSDKListener(TencentCloudChatSDKListenerProxies::Acquire(listener));
 }
 /**
  * 1.3 移除 SDK 监听
  */
 void TencentCloudChat::RemoveSDKListener(V2TIMSDKListener *listener)
 {
-	V2TIMManager::GetInstance()->RemoveSDKListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(RemoveSDKListener);
+	TencentCloudChatBackend::Get()->RemoveSDKListener(TencentCloudChatSDKListenerProxies::Find(listener));
+	TencentCloudChatSDKListenerProxies::Release(listener);
 }
 /**
  * 1.4 初始化 SDK
@@ -103,26 +131,56 @@ void TencentCloudChat::RemoveSDKListener(V2TIMSDKListener *listener)
  */
 bool TencentCloudChat::InitSDK(uint32_t sdkAppID, const V2TIMSDKConfig &config)
 {
+	TENCENTCLOUDCHAT_SCOPE_API(InitSDK);
+	// 同步版本：等待后台线程初始化完成，会阻塞调用线程，游戏线程上请使用 InitSDKAsync
+	return InitSDKAsync(sdkAppID, config).Get();
+}
+/**
+ * 1.4 异步初始化 SDK
+ *
+ * @param sdkAppID 应用 ID，必填项，可以在[控制台](https://console.cloud.tencent.com/im)中获取
+ * @param config   配置信息
+ * @return 初始化结果，true：成功；false：失败
+ */
+TFuture<bool> TencentCloudChat::InitSDKAsync(uint32_t sdkAppID, const V2TIMSDKConfig &config)
+{
+	TENCENTCLOUDCHAT_SCOPE_API(InitSDKAsync);
 
 	uint32_t param = 9;
-	V2TIMManager::GetInstance()->CallExperimentalAPI("setUIPlatform", &param, nullptr);
-
-	InitSDKRunner* InitSDKRunnable = new InitSDKRunner();
-
-	InitSDKRunnable->SetParam(sdkAppID,config);
-    // 创建子线程并启动
-    FRunnableThread* InitSDKThread = FRunnableThread::Create(InitSDKRunnable, TEXT("InitSDKThread"));
+	TencentCloudChatBackend::Get()->CallExperimentalAPI("setUIPlatform", &param, nullptr);
 
-    // 等待子线程结束
-    InitSDKThread->WaitForCompletion();
+	// 在子线程中执行初始化，调用线程立即返回
+	return Async(EAsyncExecution::Thread, [sdkAppID, config]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const bool ret = TencentCloudChatBackend::Get()->InitSDK(sdkAppID, config);
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
 
-	bool ret = InitSDKRunnable->GetReturnValue();
-    // // 释放资源
-    delete InitSDKThread;
+		SET_FLOAT_STAT(STAT_TencentCloudChat_InitSDKTimeMs, ElapsedMs);
+		UE_LOG(LogTencentCloudChat, Log, TEXT("InitSDK %s in %.2f ms"), ret ? TEXT("succeeded") : TEXT("failed"), ElapsedMs);
 
-    delete InitSDKRunnable;
+		if (ret)
+		{
+			TencentCloudChatStats::OnSDKInitialized();
+			TencentCloudChatTrace::OnSDKInitialized();
+		}
 
-	return ret;
+		return ret;
+	});
+}
+/**
+ * 1.4 异步初始化 SDK，完成后在游戏线程回调 onComplete
+ */
+void TencentCloudChat::InitSDKAsync(uint32_t sdkAppID, const V2TIMSDKConfig &config,
+									FTencentCloudChatInitSDKDelegate onComplete)
+{
+	InitSDKAsync(sdkAppID, config).Next([onComplete = MoveTemp(onComplete)](bool ret)
+	{
+		AsyncTask(ENamedThreads::GameThread, [onComplete, ret]()
+		{
+			onComplete.ExecuteIfBound(ret);
+		});
+	});
 }
 /**
  * 1.5 反初始化 SDK
@@ -130,7 +188,10 @@ bool TencentCloudChat::InitSDK(uint32_t sdkAppID, const V2TIMSDKConfig &config)
  */
 void TencentCloudChat::UnInitSDK()
 {
-	V2TIMManager::GetInstance()->UnInitSDK();
+	TENCENTCLOUDCHAT_SCOPE_API(UnInitSDK);
+	TencentCloudChatStats::OnSDKUninitialized();
+	TencentCloudChatTrace::OnSDKUninitialized();
+	TencentCloudChatBackend::Get()->UnInitSDK();
 }
 /**
  * 1.6 获取 SDK 版本
@@ -138,7 +199,8 @@ void TencentCloudChat::UnInitSDK()
  */
 V2TIMString TencentCloudChat::GetVersion()
 {
-	return V2TIMManager::GetInstance()->GetVersion();
+	TENCENTCLOUDCHAT_SCOPE_API(GetVersion);
+	return TencentCloudChatBackend::Get()->GetVersion();
 }
 /**
  *  1.7 获取服务器当前时间
@@ -153,7 +215,8 @@ V2TIMString TencentCloudChat::GetVersion()
  */
 int64_t TencentCloudChat::GetServerTime()
 {
-	return V2TIMManager::GetInstance()->GetServerTime();
+	TENCENTCLOUDCHAT_SCOPE_API(GetServerTime);
+	return TencentCloudChatBackend::Get()->GetServerTime();
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -162,6 +225,26 @@ int64_t TencentCloudChat::GetServerTime()
 //
 /////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	/**
+	 * 切换账号时丢弃各模块中上一个账号的数据；TencentCloudChatBackendScope 中模拟用户的登录登出不影响这些数据
+	 */
+	void ResetAccountState()
+	{
+		if (TencentCloudChatBackend::HasThreadOverride())
+		{
+			return;
+		}
+		TencentCloudChatHistoryCache::InvalidateAll();
+		TencentCloudChatConversationStore::Reset();
+		TencentCloudChatUnreadCounter::Reset();
+		TencentCloudChatProfileCache::Reset();
+		TencentCloudChatUserStatus::Reset();
+		TencentCloudChatSearch::Reset();
+	}
+}
+
 /**
  * 2.1 登录
  *
@@ -177,7 +260,9 @@ int64_t TencentCloudChat::GetServerTime()
 void TencentCloudChat::Login(const V2TIMString &userID, const V2TIMString &userSig,
 							 V2TIMCallback *callback)
 {
-	V2TIMManager::GetInstance()->Login(userID, userSig, callback);
+	TENCENTCLOUDCHAT_SCOPE_API(Login);
+	ResetAccountState();
+	TencentCloudChatBackend::Get()->Login(userID, userSig, TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -188,7 +273,9 @@ void TencentCloudChat::Login(const V2TIMString &userID, const V2TIMString &userS
  */
 void TencentCloudChat::Logout(V2TIMCallback *callback)
 {
-	V2TIMManager::GetInstance()->Logout(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(Logout);
+	ResetAccountState();
+	TencentCloudChatBackend::Get()->Logout(TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -196,7 +283,8 @@ void TencentCloudChat::Logout(V2TIMCallback *callback)
  */
 V2TIMString TencentCloudChat::GetLoginUser()
 {
-	return V2TIMManager::GetInstance()->GetLoginUser();
+	TENCENTCLOUDCHAT_SCOPE_API(GetLoginUser);
+	return TencentCloudChatBackend::Get()->GetLoginUser();
 }
 
 /**
@@ -208,7 +296,8 @@ V2TIMString TencentCloudChat::GetLoginUser()
  */
 V2TIMLoginStatus TencentCloudChat::GetLoginStatus()
 {
-	return V2TIMManager::GetInstance()->GetLoginStatus();
+	TENCENTCLOUDCHAT_SCOPE_API(GetLoginStatus);
+	return TencentCloudChatBackend::Get()->GetLoginStatus();
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -225,7 +314,8 @@ V2TIMLoginStatus TencentCloudChat::GetLoginStatus()
  */
 void TencentCloudChat::AddSimpleMsgListener(V2TIMSimpleMsgListener *listener)
 {
-	V2TIMManager::GetInstance()->AddSimpleMsgListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(AddSimpleMsgListener);
+	TencentCloudChatBackend::Get()->AddSimpleMsgListener(TencentCloudChatSimpleMsgListenerProxies::Acquire(listener));
 }
 
 /**
@@ -233,7 +323,9 @@ void TencentCloudChat::AddSimpleMsgListener(V2TIMSimpleMsgListener *listener)
  */
 void TencentCloudChat::RemoveSimpleMsgListener(V2TIMSimpleMsgListener *listener)
 {
-	V2TIMManager::GetInstance()->RemoveSimpleMsgListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(RemoveSimpleMsgListener);
+	TencentCloudChatBackend::Get()->RemoveSimpleMsgListener(TencentCloudChatSimpleMsgListenerProxies::Find(listener));
+	TencentCloudChatSimpleMsgListenerProxies::Release(listener);
 }
 
 /**
@@ -246,7 +338,12 @@ void TencentCloudChat::RemoveSimpleMsgListener(V2TIMSimpleMsgListener *listener)
 V2TIMString TencentCloudChat::SendC2CTextMessage(const V2TIMString &text, const V2TIMString &userID,
 												 V2TIMSendCallback *callback)
 {
-	return V2TIMManager::GetInstance()->SendC2CTextMessage(text, userID, callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SendC2CTextMessage);
+	TencentCloudChatTraceSendId TraceID;
+	const V2TIMString MsgID = TencentCloudChatBackend::Get()->SendC2CTextMessage(text, userID, TencentCloudChatTrace::TraceSend(TraceID, TencentCloudChatHistoryCache::TrackSend(TencentCloudChatDispatcher::Marshal(callback))));
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::SendIssued, MsgID);
+	TraceID.Set(MsgID);
+	return MsgID;
 }
 
 /**
@@ -263,7 +360,13 @@ V2TIMString TencentCloudChat::SendC2CCustomMessage(const V2TIMBuffer &customData
 												   const V2TIMString &userID,
 												   V2TIMSendCallback *callback)
 {
-	return V2TIMManager::GetInstance()->SendC2CCustomMessage(customData, userID, callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SendC2CCustomMessage);
+	TencentCloudChatStats::RecordPayloadSent(int64(customData.Size()));
+	TencentCloudChatTraceSendId TraceID;
+	const V2TIMString MsgID = TencentCloudChatBackend::Get()->SendC2CCustomMessage(customData, userID, TencentCloudChatTrace::TraceSend(TraceID, TencentCloudChatHistoryCache::TrackSend(TencentCloudChatDispatcher::Marshal(callback))));
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::SendIssued, MsgID);
+	TraceID.Set(MsgID);
+	return MsgID;
 }
 
 /**
@@ -281,7 +384,12 @@ V2TIMString TencentCloudChat::SendGroupTextMessage(const V2TIMString &text, cons
 												   V2TIMMessagePriority priority,
 												   V2TIMSendCallback *callback)
 {
-	return V2TIMManager::GetInstance()->SendGroupTextMessage(text, groupID, priority, callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SendGroupTextMessage);
+	TencentCloudChatTraceSendId TraceID;
+	const V2TIMString MsgID = TencentCloudChatBackend::Get()->SendGroupTextMessage(text, groupID, priority, TencentCloudChatTrace::TraceSend(TraceID, TencentCloudChatHistoryCache::TrackSend(TencentCloudChatDispatcher::Marshal(callback))));
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::SendIssued, MsgID);
+	TraceID.Set(MsgID);
+	return MsgID;
 }
 
 /**
@@ -302,7 +410,13 @@ V2TIMString TencentCloudChat::SendGroupCustomMessage(const V2TIMBuffer &customDa
 													 V2TIMMessagePriority priority,
 													 V2TIMSendCallback *callback)
 {
-	return V2TIMManager::GetInstance()->SendGroupCustomMessage(customData, groupID, priority, callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SendGroupCustomMessage);
+	TencentCloudChatStats::RecordPayloadSent(int64(customData.Size()));
+	TencentCloudChatTraceSendId TraceID;
+	const V2TIMString MsgID = TencentCloudChatBackend::Get()->SendGroupCustomMessage(customData, groupID, priority, TencentCloudChatTrace::TraceSend(TraceID, TencentCloudChatHistoryCache::TrackSend(TencentCloudChatDispatcher::Marshal(callback))));
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::SendIssued, MsgID);
+	TraceID.Set(MsgID);
+	return MsgID;
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -316,14 +430,17 @@ V2TIMString TencentCloudChat::SendGroupCustomMessage(const V2TIMBuffer &customDa
  */
 void TencentCloudChat::AddGroupListener(V2TIMGroupListener *listener)
 {
-	V2TIMManager::GetInstance()->AddGroupListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(AddGroupListener);
+	TencentCloudChatBackend::Get()->AddGroupListener(TencentCloudChatGroupListenerProxies::Acquire(listener));
 }
 
 /**
  * 4.2 设置群组监听器
  */
 void TencentCloudChat::RemoveGroupListener(V2TIMGroupListener *listener){
-	V2TIMManager::GetInstance()->RemoveGroupListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(RemoveGroupListener);
+	TencentCloudChatBackend::Get()->RemoveGroupListener(TencentCloudChatGroupListenerProxies::Find(listener));
+	TencentCloudChatGroupListenerProxies::Release(listener);
 }
 
 /**
@@ -349,7 +466,8 @@ void TencentCloudChat::RemoveGroupListener(V2TIMGroupListener *listener){
 void TencentCloudChat::CreateGroup(const V2TIMString &groupType, const V2TIMString &groupID,
 								   const V2TIMString &groupName,
 								   V2TIMValueCallback<V2TIMString> *callback){
-									V2TIMManager::GetInstance()->CreateGroup(groupType,groupID,groupName,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateGroup);
+									TencentCloudChatBackend::Get()->CreateGroup(groupType,groupID,groupName,TencentCloudChatDispatcher::Marshal(callback));
 								   }
 
 /**
@@ -365,7 +483,8 @@ void TencentCloudChat::CreateGroup(const V2TIMString &groupType, const V2TIMStri
  */
 void TencentCloudChat::JoinGroup(const V2TIMString &groupID, const V2TIMString &message,
 								 V2TIMCallback *callback){
-									V2TIMManager::GetInstance()->JoinGroup(groupID,message,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(JoinGroup);
+									TencentCloudChatBackend::Get()->JoinGroup(groupID,message,TencentCloudChatDispatcher::Marshal(callback));
 								 }
 
 /**
@@ -374,7 +493,8 @@ void TencentCloudChat::JoinGroup(const V2TIMString &groupID, const V2TIMString &
  * @note 在公开群（Public）、会议（Meeting）和直播群（AVChatRoom）中，群主是不可以退群的，群主只能调用 DismissGroup 解散群组。
  */
 void TencentCloudChat::QuitGroup(const V2TIMString &groupID, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->QuitGroup(groupID,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(QuitGroup);
+	TencentCloudChatBackend::Get()->QuitGroup(groupID,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -384,7 +504,8 @@ void TencentCloudChat::QuitGroup(const V2TIMString &groupID, V2TIMCallback *call
  *  - 其他群：群主可以解散群组。
  */
 void TencentCloudChat::DismissGroup(const V2TIMString &groupID, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->DismissGroup(groupID,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DismissGroup);
+	TencentCloudChatBackend::Get()->DismissGroup(groupID,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -402,14 +523,16 @@ void TencentCloudChat::DismissGroup(const V2TIMString &groupID, V2TIMCallback *c
  */
 void TencentCloudChat::GetUsersInfo(const V2TIMStringVector &userIDList,
 									V2TIMValueCallback<V2TIMUserFullInfoVector> *callback){
-										V2TIMManager::GetInstance()->GetUsersInfo(userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetUsersInfo);
+										TencentCloudChatBackend::Get()->GetUsersInfo(userIDList,TencentCloudChatDispatcher::Marshal(callback));
 									}
 
 /**
  * 5.2 修改个人资料
  */
 void TencentCloudChat::SetSelfInfo(const V2TIMUserFullInfo &info, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->SetSelfInfo(info,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetSelfInfo);
+	TencentCloudChatBackend::Get()->SetSelfInfo(info,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -424,7 +547,8 @@ void TencentCloudChat::SetSelfInfo(const V2TIMUserFullInfo &info, V2TIMCallback
  */
 void TencentCloudChat::GetUserStatus(const V2TIMStringVector &userIDList,
 									 V2TIMValueCallback<V2TIMUserStatusVector> *callback){
-										V2TIMManager::GetInstance()->GetUserStatus(userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetUserStatus);
+										TencentCloudChatBackend::Get()->GetUserStatus(userIDList,TencentCloudChatDispatcher::Marshal(callback));
 									 }
 
 /**
@@ -435,7 +559,8 @@ void TencentCloudChat::GetUserStatus(const V2TIMStringVector &userIDList,
  *  @note 请注意，该接口只支持设置自己的自定义状态，即 V2TIMUserStatus.customStatus
  */
 void TencentCloudChat::SetSelfStatus(const V2TIMUserStatus &status, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->SetSelfStatus(status,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetSelfStatus);
+	TencentCloudChatBackend::Get()->SetSelfStatus(status,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -451,7 +576,8 @@ void TencentCloudChat::SetSelfStatus(const V2TIMUserStatus &status, V2TIMCallbac
  *   - 该功能为 IM 旗舰版功能，[购买旗舰版套餐包](https://buy.cloud.tencent.com/avc?from=17491)后可使用，详见[价格说明](https://cloud.tencent.com/document/product/269/11673?from=17472#.E5.9F.BA.E7.A1.80.E6.9C.8D.E5.8A.A1.E8.AF.A6.E6.83.85)。
  */
 void TencentCloudChat::SubscribeUserStatus(const V2TIMStringVector &userIDList, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->SubscribeUserStatus(userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SubscribeUserStatus);
+	TencentCloudChatBackend::Get()->SubscribeUserStatus(userIDList,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -462,7 +588,8 @@ void TencentCloudChat::SubscribeUserStatus(const V2TIMStringVector &userIDList,
  *   - 该功能为 IM 旗舰版功能，[购买旗舰版套餐包](https://buy.cloud.tencent.com/avc?from=17491)后可使用，详见[价格说明](https://cloud.tencent.com/document/product/269/11673?from=17472#.E5.9F.BA.E7.A1.80.E6.9C.8D.E5.8A.A1.E8.AF.A6.E6.83.85)。
  */
 void TencentCloudChat::UnsubscribeUserStatus(const V2TIMStringVector &userIDList, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->UnsubscribeUserStatus(userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(UnsubscribeUserStatus);
+	TencentCloudChatBackend::Get()->UnsubscribeUserStatus(userIDList,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -481,14 +608,17 @@ void TencentCloudChat::UnsubscribeUserStatus(const V2TIMStringVector &userIDList
  * 1.1 添加高级消息的事件监听器
  */
 void TencentCloudChat::AddAdvancedMsgListener(V2TIMAdvancedMsgListener *listener){
-	V2TIMManager::GetInstance()->GetMessageManager()->AddAdvancedMsgListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(AddAdvancedMsgListener);
+	TencentCloudChatBackend::Get()->GetMessageManager()->AddAdvancedMsgListener(TencentCloudChatAdvancedMsgListenerProxies::Acquire(listener));
 }
 
 /**
  * 1.2 移除高级消息监听器
  */
 void TencentCloudChat::RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *listener){
-	V2TIMManager::GetInstance()->GetMessageManager()->RemoveAdvancedMsgListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(RemoveAdvancedMsgListener);
+	TencentCloudChatBackend::Get()->GetMessageManager()->RemoveAdvancedMsgListener(TencentCloudChatAdvancedMsgListenerProxies::Find(listener));
+	TencentCloudChatAdvancedMsgListenerProxies::Release(listener);
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -501,7 +631,10 @@ void TencentCloudChat::RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *liste
  * 2.1 创建文本消息
  */
 V2TIMMessage TencentCloudChat::CreateTextMessage(const V2TIMString &text){
-	return V2TIMManager::GetInstance()->GetMessageManager()->CreateTextMessage(text);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateTextMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateTextMessage(text);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 }
 
 /**
@@ -520,14 +653,20 @@ V2TIMMessage TencentCloudChat::CreateTextMessage(const V2TIMString &text){
  */
 V2TIMMessage TencentCloudChat::CreateTextAtMessage(const V2TIMString &text,
 												   const V2TIMStringVector &atUserList){
-													return V2TIMManager::GetInstance()->GetMessageManager()->CreateTextAtMessage(text,atUserList);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateTextAtMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateTextAtMessage(text,atUserList);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 												   }
 
 /**
  * 2.3 创建自定义消息
  */
 V2TIMMessage TencentCloudChat::CreateCustomMessage(const V2TIMBuffer &data){
-	return V2TIMManager::GetInstance()->GetMessageManager()->CreateCustomMessage(data);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateCustomMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateCustomMessage(data);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 }
 
 /**
@@ -539,14 +678,20 @@ V2TIMMessage TencentCloudChat::CreateCustomMessage(const V2TIMBuffer &data){
 V2TIMMessage TencentCloudChat::CreateCustomMessage(const V2TIMBuffer &data,
 												   const V2TIMString &description,
 												   const V2TIMString &extension){
-													return V2TIMManager::GetInstance()->GetMessageManager()->CreateCustomMessage(data,description,extension);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateCustomMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateCustomMessage(data,description,extension);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 												   }
 
 /**
  * 2.5 创建图片消息（图片最大支持 28 MB）
  */
 V2TIMMessage TencentCloudChat::CreateImageMessage(const V2TIMString &imagePath){
-	return V2TIMManager::GetInstance()->GetMessageManager()->CreateImageMessage(imagePath);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateImageMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateImageMessage(imagePath);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 }
 
 /**
@@ -555,7 +700,10 @@ V2TIMMessage TencentCloudChat::CreateImageMessage(const V2TIMString &imagePath){
  * @param duration  语音时长，单位 s
  */
 V2TIMMessage TencentCloudChat::CreateSoundMessage(const V2TIMString &soundPath, uint32_t duration){
-	return V2TIMManager::GetInstance()->GetMessageManager()->CreateSoundMessage(soundPath,duration);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateSoundMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateSoundMessage(soundPath,duration);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 }
 
 /**
@@ -568,7 +716,10 @@ V2TIMMessage TencentCloudChat::CreateSoundMessage(const V2TIMString &soundPath,
 V2TIMMessage TencentCloudChat::CreateVideoMessage(const V2TIMString &videoFilePath,
 												  const V2TIMString &type, uint32_t duration,
 												  const V2TIMString &snapshotPath){
-													return V2TIMManager::GetInstance()->GetMessageManager()->CreateVideoMessage(videoFilePath,type,duration,snapshotPath);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateVideoMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateVideoMessage(videoFilePath,type,duration,snapshotPath);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 												  }
 
 /**
@@ -576,7 +727,10 @@ V2TIMMessage TencentCloudChat::CreateVideoMessage(const V2TIMString &videoFilePa
  */
 V2TIMMessage TencentCloudChat::CreateFileMessage(const V2TIMString &filePath,
 												 const V2TIMString &fileName){
-													return V2TIMManager::GetInstance()->GetMessageManager()->CreateFileMessage(filePath,fileName);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateFileMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateFileMessage(filePath,fileName);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 												 }
 
 /**
@@ -584,7 +738,10 @@ V2TIMMessage TencentCloudChat::CreateFileMessage(const V2TIMString &filePath,
  */
 V2TIMMessage TencentCloudChat::CreateLocationMessage(const V2TIMString &desc, double longitude,
 													 double latitude){
-														return V2TIMManager::GetInstance()->GetMessageManager()->CreateLocationMessage(desc,longitude,latitude);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateLocationMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateLocationMessage(desc,longitude,latitude);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 													 }
 
 /**
@@ -597,7 +754,10 @@ V2TIMMessage TencentCloudChat::CreateLocationMessage(const V2TIMString &desc, do
  * @param data  自定义数据
  */
 V2TIMMessage TencentCloudChat::CreateFaceMessage(uint32_t index, const V2TIMBuffer &data){
-	return V2TIMManager::GetInstance()->GetMessageManager()->CreateFaceMessage(index,data);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateFaceMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateFaceMessage(index,data);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 }
 
 /**
@@ -631,7 +791,10 @@ V2TIMMessage TencentCloudChat::CreateMergerMessage(const V2TIMMessageVector &mes
 												   const V2TIMString &title,
 												   const V2TIMStringVector &abstractList,
 												   const V2TIMString &compatibleText){
-													return V2TIMManager::GetInstance()->GetMessageManager()->CreateMergerMessage(messageList,title,abstractList,compatibleText);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateMergerMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateMergerMessage(messageList,title,abstractList,compatibleText);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 												   }
 
 /**
@@ -645,7 +808,10 @@ V2TIMMessage TencentCloudChat::CreateMergerMessage(const V2TIMMessageVector &mes
  * @return 转发消息对象，elem 内容和原消息完全一致。
  */
 V2TIMMessage TencentCloudChat::CreateForwardMessage(const V2TIMMessage &message){
-	return V2TIMManager::GetInstance()->GetMessageManager()->CreateForwardMessage(message);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateForwardMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateForwardMessage(message);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 }
 
 /**
@@ -664,7 +830,10 @@ V2TIMMessage TencentCloudChat::CreateForwardMessage(const V2TIMMessage &message)
  * - 定向群消息默认不计入群会话的未读计数。
  */
 V2TIMMessage TencentCloudChat::CreateTargetedGroupMessage(const V2TIMMessage &message, const V2TIMStringVector &receiverList){
-	return V2TIMManager::GetInstance()->GetMessageManager()->CreateTargetedGroupMessage(message,receiverList);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateTargetedGroupMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateTargetedGroupMessage(message,receiverList);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 }
 
 /**
@@ -683,7 +852,10 @@ V2TIMMessage TencentCloudChat::CreateTargetedGroupMessage(const V2TIMMessage &me
  *  - 直播群（AVChatRoom）不支持发送 @ 消息。
  */
 V2TIMMessage TencentCloudChat::CreateAtSignedGroupMessage(const V2TIMMessage &message, const V2TIMStringVector &atUserList){
-	return V2TIMManager::GetInstance()->GetMessageManager()->CreateAtSignedGroupMessage(message,atUserList);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateAtSignedGroupMessage);
+	V2TIMMessage Message = TencentCloudChatBackend::Get()->GetMessageManager()->CreateAtSignedGroupMessage(message,atUserList);
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Created, Message.msgID);
+	return Message;
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -719,8 +891,22 @@ V2TIMString TencentCloudChat::SendMessage(V2TIMMessage &message, const V2TIMStri
 										  bool onlineUserOnly,
 										  const V2TIMOfflinePushInfo &offlinePushInfo,
 										  V2TIMSendCallback *callback){
-											return V2TIMManager::GetInstance()->GetMessageManager()->SendMessage(message,receiver,groupID,priority,onlineUserOnly,offlinePushInfo,callback);
-										  }
+	TENCENTCLOUDCHAT_SCOPE_API(SendMessage);
+#if TENCENTCLOUDCHAT_WITH_STATS
+	for (size_t Index = 0; Index < message.elemList.Size(); ++Index)
+	{
+		const V2TIMElem *Elem = message.elemList[Index];
+		if (Elem && Elem->elemType == V2TIM_ELEM_TYPE_CUSTOM)
+		{
+			TencentCloudChatStats::RecordPayloadSent(int64(static_cast<const V2TIMCustomElem *>(Elem)->data.Size()));
+		}
+	}
+#endif
+	const V2TIMString MsgID = TencentCloudChatBackend::Get()->GetMessageManager()->SendMessage(message,receiver,groupID,priority,onlineUserOnly,offlinePushInfo,
+		TencentCloudChatTrace::TraceSend(message.msgID, TencentCloudChatHistoryCache::TrackSend(TencentCloudChatDispatcher::Marshal(callback))));
+	TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::SendIssued, MsgID);
+	return MsgID;
+}
 
 /////////////////////////////////////////////////////////////////////////////////
 //
@@ -745,7 +931,8 @@ V2TIMString TencentCloudChat::SendMessage(V2TIMMessage &message, const V2TIMStri
  */
 void TencentCloudChat::SetC2CReceiveMessageOpt(const V2TIMStringVector &userIDList,
 											   V2TIMReceiveMessageOpt opt, V2TIMCallback *callback){
-V2TIMManager::GetInstance()->GetMessageManager()->SetC2CReceiveMessageOpt(userIDList,opt,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetC2CReceiveMessageOpt);
+TencentCloudChatBackend::Get()->GetMessageManager()->SetC2CReceiveMessageOpt(userIDList,opt,TencentCloudChatDispatcher::Marshal(callback));
 											   }
 
 /**
@@ -755,7 +942,8 @@ V2TIMManager::GetInstance()->GetMessageManager()->SetC2CReceiveMessageOpt(userID
 void TencentCloudChat::GetC2CReceiveMessageOpt(
 	const V2TIMStringVector &userIDList,
 	V2TIMValueCallback<V2TIMReceiveMessageOptInfoVector> *callback){
-		V2TIMManager::GetInstance()->GetMessageManager()->GetC2CReceiveMessageOpt(userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetC2CReceiveMessageOpt);
+		TencentCloudChatBackend::Get()->GetMessageManager()->GetC2CReceiveMessageOpt(userIDList,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -766,9 +954,10 @@ void TencentCloudChat::GetC2CReceiveMessageOpt(
  *                 V2TIMMessage.V2TIM_NOT_RECEIVE_MESSAGE：不会接收到群消息
  *                 V2TIMMessage.V2TIM_RECEIVE_NOT_NOTIFY_MESSAGE：在线正常接收消息，离线不会有推送通知
  */
-void SetGroupReceiveMessageOpt(const V2TIMString &groupID, V2TIMReceiveMessageOpt opt,
+void TencentCloudChat::SetGroupReceiveMessageOpt(const V2TIMString &groupID, V2TIMReceiveMessageOpt opt,
 							   V2TIMCallback *callback){
-								V2TIMManager::GetInstance()->GetMessageManager()->SetGroupReceiveMessageOpt(groupID,opt,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetGroupReceiveMessageOpt);
+								TencentCloudChatBackend::Get()->GetMessageManager()->SetGroupReceiveMessageOpt(groupID,opt,TencentCloudChatDispatcher::Marshal(callback));
 							   }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -789,7 +978,8 @@ void SetGroupReceiveMessageOpt(const V2TIMString &groupID, V2TIMReceiveMessageOp
  */
 void TencentCloudChat::GetHistoryMessageList(const V2TIMMessageListGetOption &option,
 											 V2TIMValueCallback<V2TIMMessageVector> *callback){
-												V2TIMManager::GetInstance()->GetMessageManager()->GetHistoryMessageList(option,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetHistoryMessageList);
+												TencentCloudChatBackend::Get()->GetMessageManager()->GetHistoryMessageList(option,TencentCloudChatDispatcher::Marshal(callback));
 											 }
 
 /**
@@ -802,7 +992,8 @@ void TencentCloudChat::GetHistoryMessageList(const V2TIMMessageListGetOption &op
  *  - 如果发送方撤回消息，已经收到消息的一方会收到 V2TIMAdvancedMsgListener::OnRecvMessageRevoked 回调。
  */
 void TencentCloudChat::RevokeMessage(const V2TIMMessage &message, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->RevokeMessage(message,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(RevokeMessage);
+	TencentCloudChatBackend::Get()->GetMessageManager()->RevokeMessage(message,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -814,7 +1005,8 @@ void TencentCloudChat::RevokeMessage(const V2TIMMessage &message, V2TIMCallback
  *  - 消息无论修改成功或则失败，callback 都会返回最新的消息对象。
  */
 void TencentCloudChat::ModifyMessage(const V2TIMMessage &message, V2TIMCompleteCallback<V2TIMMessage> *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->ModifyMessage(message,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(ModifyMessage);
+	TencentCloudChatBackend::Get()->GetMessageManager()->ModifyMessage(message,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -824,7 +1016,8 @@ void TencentCloudChat::ModifyMessage(const V2TIMMessage &message, V2TIMCompleteC
  *  - 从 5.8 版本开始，当 userID 为 nil 时，标记所有单聊会话为已读状态。
  */
 void TencentCloudChat::MarkC2CMessageAsRead(const V2TIMString &userID, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->MarkC2CMessageAsRead(userID,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(MarkC2CMessageAsRead);
+	TencentCloudChatBackend::Get()->GetMessageManager()->MarkC2CMessageAsRead(userID,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -834,14 +1027,16 @@ void TencentCloudChat::MarkC2CMessageAsRead(const V2TIMString &userID, V2TIMCall
  *  - 从 5.8 版本开始，当 groupID 为 nil 时，标记所有群组会话为已读状态。
  */
 void TencentCloudChat::MarkGroupMessageAsRead(const V2TIMString &groupID, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->MarkGroupMessageAsRead(groupID,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(MarkGroupMessageAsRead);
+	TencentCloudChatBackend::Get()->GetMessageManager()->MarkGroupMessageAsRead(groupID,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
  * 5.6 标记所有会话为已读 （5.8 及其以上版本支持）
  */
 void TencentCloudChat::MarkAllMessageAsRead(V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->MarkAllMessageAsRead(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(MarkAllMessageAsRead);
+	TencentCloudChatBackend::Get()->GetMessageManager()->MarkAllMessageAsRead(TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -855,7 +1050,8 @@ void TencentCloudChat::MarkAllMessageAsRead(V2TIMCallback *callback){
  * 如果该账号在其他设备上拉取过这些消息，那么调用该接口删除后，这些消息仍然会保存在那些设备上，即删除消息不支持多端同步。
  */
 void TencentCloudChat::DeleteMessages(const V2TIMMessageVector &messages, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->DeleteMessages(messages,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteMessages);
+	TencentCloudChatBackend::Get()->GetMessageManager()->DeleteMessages(messages,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -867,7 +1063,8 @@ void TencentCloudChat::DeleteMessages(const V2TIMMessageVector &messages, V2TIMC
  *
  */
 void TencentCloudChat::ClearC2CHistoryMessage(const V2TIMString &userID, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->ClearC2CHistoryMessage(userID,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(ClearC2CHistoryMessage);
+	TencentCloudChatBackend::Get()->GetMessageManager()->ClearC2CHistoryMessage(userID,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -878,7 +1075,8 @@ void TencentCloudChat::ClearC2CHistoryMessage(const V2TIMString &userID, V2TIMCa
  * - 会话内的消息在本地删除的同时，在服务器也会同步删除。
  */
 void TencentCloudChat::ClearGroupHistoryMessage(const V2TIMString &groupID, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->ClearGroupHistoryMessage(groupID,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(ClearGroupHistoryMessage);
+	TencentCloudChatBackend::Get()->GetMessageManager()->ClearGroupHistoryMessage(groupID,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -895,7 +1093,8 @@ void TencentCloudChat::ClearGroupHistoryMessage(const V2TIMString &groupID, V2TI
 V2TIMString TencentCloudChat::InsertGroupMessageToLocalStorage(
 	V2TIMMessage &message, const V2TIMString &groupID, const V2TIMString &sender,
 	V2TIMValueCallback<V2TIMMessage> *callback){
-		return V2TIMManager::GetInstance()->GetMessageManager()->InsertGroupMessageToLocalStorage(message,groupID,sender,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(InsertGroupMessageToLocalStorage);
+		return TencentCloudChatBackend::Get()->GetMessageManager()->InsertGroupMessageToLocalStorage(message,groupID,sender,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -911,16 +1110,18 @@ V2TIMString TencentCloudChat::InsertGroupMessageToLocalStorage(
 V2TIMString TencentCloudChat::InsertC2CMessageToLocalStorage(
 	V2TIMMessage &message, const V2TIMString &userID, const V2TIMString &sender,
 	V2TIMValueCallback<V2TIMMessage> *callback){
-		return V2TIMManager::GetInstance()->GetMessageManager()->InsertC2CMessageToLocalStorage(message,userID,sender,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(InsertC2CMessageToLocalStorage);
+		return TencentCloudChatBackend::Get()->GetMessageManager()->InsertC2CMessageToLocalStorage(message,userID,sender,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
  * 5.12 根据 messageID 查询指定会话中的本地消息
  * @param messageIDList 消息 ID 列表
  */
-void FindMessages(const V2TIMStringVector &messageIDList,
+void TencentCloudChat::FindMessages(const V2TIMStringVector &messageIDList,
 				  V2TIMValueCallback<V2TIMMessageVector> *callback){
-					V2TIMManager::GetInstance()->GetMessageManager()->FindMessages(messageIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(FindMessages);
+					TencentCloudChatBackend::Get()->GetMessageManager()->FindMessages(messageIDList,TencentCloudChatDispatcher::Marshal(callback));
 				  }
 
 /**
@@ -930,7 +1131,8 @@ void FindMessages(const V2TIMStringVector &messageIDList,
  */
 void TencentCloudChat::SearchLocalMessages(const V2TIMMessageSearchParam &searchParam,
 										   V2TIMValueCallback<V2TIMMessageSearchResult> *callback){
-											V2TIMManager::GetInstance()->GetMessageManager()->SearchLocalMessages(searchParam,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SearchLocalMessages);
+											TencentCloudChatBackend::Get()->GetMessageManager()->SearchLocalMessages(searchParam,TencentCloudChatDispatcher::Marshal(callback));
 										   }
 
 /**
@@ -943,7 +1145,8 @@ void TencentCloudChat::SearchLocalMessages(const V2TIMMessageSearchParam &search
  * - 该接口调用成功后，会话未读数不会变化，消息发送者会收到 onRecvMessageReadReceipts 回调，回调里面会携带消息的最新已读信息。
  */
 void TencentCloudChat::SendMessageReadReceipts(const V2TIMMessageVector &messageList, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->SendMessageReadReceipts(messageList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SendMessageReadReceipts);
+	TencentCloudChatBackend::Get()->GetMessageManager()->SendMessageReadReceipts(messageList,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -956,7 +1159,8 @@ void TencentCloudChat::SendMessageReadReceipts(const V2TIMMessageVector &message
  * - messageList 里的消息必须在同一个会话中。
  */
 void TencentCloudChat::GetMessageReadReceipts(const V2TIMMessageVector &messageList, V2TIMValueCallback<V2TIMMessageReceiptVector> *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->GetMessageReadReceipts(messageList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetMessageReadReceipts);
+	TencentCloudChatBackend::Get()->GetMessageManager()->GetMessageReadReceipts(messageList,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -971,7 +1175,8 @@ void TencentCloudChat::GetMessageReadReceipts(const V2TIMMessageVector &messageL
  * - 使用该功能之前，请您先到控制台打开对应的开关，详情参考文档 [群消息已读回执](https://cloud.tencent.com/document/product/269/75343#.E8.AE.BE.E7.BD.AE.E6.94.AF.E6.8C.81.E5.B7.B2.E8.AF.BB.E5.9B.9E.E6.89.A7.E7.9A.84.E7.BE.A4.E7.B1.BB.E5.9E.8B) 。
  */
 void TencentCloudChat::GetGroupMessageReadMemberList(const V2TIMMessage &message, V2TIMGroupMessageReadMembersFilter filter, uint64_t nextSeq, uint32_t count, V2TIMValueCallback<V2TIMGroupMessageReadMemberList> *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->GetGroupMessageReadMemberList(message,filter,nextSeq,count,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetGroupMessageReadMemberList);
+	TencentCloudChatBackend::Get()->GetMessageManager()->GetGroupMessageReadMemberList(message,filter,nextSeq,count,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -985,14 +1190,16 @@ void TencentCloudChat::GetGroupMessageReadMemberList(const V2TIMMessage &message
  * - 我们强烈建议不同的用户设置不同的扩展 key，这样大部分场景都不会冲突，比如投票、接龙、问卷调查，都可以把自己的 userID 作为扩展 key。
  */
 void TencentCloudChat::SetMessageExtensions(const V2TIMMessage &message, const V2TIMMessageExtensionVector &extensions, V2TIMValueCallback<V2TIMMessageExtensionResultVector> *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->SetMessageExtensions(message,extensions,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetMessageExtensions);
+	TencentCloudChatBackend::Get()->GetMessageManager()->SetMessageExtensions(message,extensions,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
  * 5.18 获取消息扩展（6.7 及其以上版本支持，需要您购买旗舰版套餐）
  */
-void GetMessageExtensions(const V2TIMMessage &message, V2TIMValueCallback<V2TIMMessageExtensionVector> *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->GetMessageExtensions(message,callback);
+void TencentCloudChat::GetMessageExtensions(const V2TIMMessage &message, V2TIMValueCallback<V2TIMMessageExtensionVector> *callback){
+	TENCENTCLOUDCHAT_SCOPE_API(GetMessageExtensions);
+	TencentCloudChatBackend::Get()->GetMessageManager()->GetMessageExtensions(message,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -1003,7 +1210,8 @@ void GetMessageExtensions(const V2TIMMessage &message, V2TIMValueCallback<V2TIMM
  * - 当多个用户同时设置或删除同一个扩展 key 时，只有第一个用户可以执行成功，其它用户会收到 23001 错误码和最新的扩展信息，在收到错误码和扩展信息后，请按需重新发起删除操作。
  */
 void TencentCloudChat::DeleteMessageExtensions(const V2TIMMessage &message, const V2TIMStringVector &keys, V2TIMValueCallback<V2TIMMessageExtensionResultVector> *callback){
-	V2TIMManager::GetInstance()->GetMessageManager()->DeleteMessageExtensions(message,keys,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteMessageExtensions);
+	TencentCloudChatBackend::Get()->GetMessageManager()->DeleteMessageExtensions(message,keys,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -1017,7 +1225,8 @@ void TencentCloudChat::DeleteMessageExtensions(const V2TIMMessage &message, cons
 void TencentCloudChat::TranslateText(const V2TIMStringVector &sourceTextList,
 									 const V2TIMString &sourceLanguage, const V2TIMString &targetLanguage,
 									 V2TIMValueCallback<V2TIMStringToV2TIMStringMap> *callback){
-										V2TIMManager::GetInstance()->GetMessageManager()->TranslateText(sourceTextList,sourceLanguage,targetLanguage,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(TranslateText);
+										TencentCloudChatBackend::Get()->GetMessageManager()->TranslateText(sourceTextList,sourceLanguage,targetLanguage,TencentCloudChatDispatcher::Marshal(callback));
 									 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1039,7 +1248,8 @@ void TencentCloudChat::TranslateText(const V2TIMStringVector &sourceTextList,
 void TencentCloudChat::CreateGroup(const V2TIMGroupInfo &info,
 								   const V2TIMCreateGroupMemberInfoVector &memberList,
 								   V2TIMValueCallback<V2TIMString> *callback){
-									V2TIMManager::GetInstance()->GetGroupManager()->CreateGroup(info,memberList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateGroup);
+									TencentCloudChatBackend::Get()->GetGroupManager()->CreateGroup(info,memberList,TencentCloudChatDispatcher::Marshal(callback));
 								   }
 
 /**
@@ -1051,7 +1261,8 @@ void TencentCloudChat::CreateGroup(const V2TIMGroupInfo &info,
  * ERR_SDK_COMM_API_CALL_FREQUENCY_LIMIT （7008）错误
  */
 void TencentCloudChat::GetJoinedGroupList(V2TIMValueCallback<V2TIMGroupInfoVector> *callback){
-	V2TIMManager::GetInstance()->GetGroupManager()->GetJoinedGroupList(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetJoinedGroupList);
+	TencentCloudChatBackend::Get()->GetGroupManager()->GetJoinedGroupList(TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1065,7 +1276,8 @@ void TencentCloudChat::GetJoinedGroupList(V2TIMValueCallback<V2TIMGroupInfoVecto
  */
 void TencentCloudChat::GetGroupsInfo(const V2TIMStringVector &groupIDList,
 									 V2TIMValueCallback<V2TIMGroupInfoResultVector> *callback){
-										V2TIMManager::GetInstance()->GetGroupManager()->GetGroupsInfo(groupIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetGroupsInfo);
+										TencentCloudChatBackend::Get()->GetGroupManager()->GetGroupsInfo(groupIDList,TencentCloudChatDispatcher::Marshal(callback));
 									 }
 
 /**
@@ -1076,14 +1288,16 @@ void TencentCloudChat::GetGroupsInfo(const V2TIMStringVector &groupIDList,
  */
 void TencentCloudChat::SearchGroups(const V2TIMGroupSearchParam &searchParam,
 									V2TIMValueCallback<V2TIMGroupInfoVector> *callback){
-										V2TIMManager::GetInstance()->GetGroupManager()->SearchGroups(searchParam,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SearchGroups);
+										TencentCloudChatBackend::Get()->GetGroupManager()->SearchGroups(searchParam,TencentCloudChatDispatcher::Marshal(callback));
 									}
 
 /**
  * 2.3 修改群资料
  */
 void TencentCloudChat::SetGroupInfo(const V2TIMGroupInfo &info, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetGroupManager()->SetGroupInfo(info,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetGroupInfo);
+	TencentCloudChatBackend::Get()->GetGroupManager()->SetGroupInfo(info,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -1105,7 +1319,8 @@ void TencentCloudChat::SetGroupInfo(const V2TIMGroupInfo &info, V2TIMCallback *c
 void TencentCloudChat::InitGroupAttributes(const V2TIMString &groupID,
 										   const V2TIMGroupAttributeMap &attributes,
 										   V2TIMCallback *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->InitGroupAttributes(groupID,attributes,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(InitGroupAttributes);
+											TencentCloudChatBackend::Get()->GetGroupManager()->InitGroupAttributes(groupID,attributes,TencentCloudChatDispatcher::Marshal(callback));
 										   }
 
 /**
@@ -1118,7 +1333,8 @@ void TencentCloudChat::InitGroupAttributes(const V2TIMString &groupID,
 void TencentCloudChat::SetGroupAttributes(const V2TIMString &groupID,
 										  const V2TIMGroupAttributeMap &attributes,
 										  V2TIMCallback *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->SetGroupAttributes(groupID,attributes,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetGroupAttributes);
+											TencentCloudChatBackend::Get()->GetGroupManager()->SetGroupAttributes(groupID,attributes,TencentCloudChatDispatcher::Marshal(callback));
 										  }
 
 /**
@@ -1130,7 +1346,8 @@ void TencentCloudChat::SetGroupAttributes(const V2TIMString &groupID,
  */
 void TencentCloudChat::DeleteGroupAttributes(const V2TIMString &groupID, const V2TIMStringVector &keys,
 											 V2TIMCallback *callback){
-												V2TIMManager::GetInstance()->GetGroupManager()->DeleteGroupAttributes(groupID,keys,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteGroupAttributes);
+												TencentCloudChatBackend::Get()->GetGroupManager()->DeleteGroupAttributes(groupID,keys,TencentCloudChatDispatcher::Marshal(callback));
 											 }
 
 /**
@@ -1142,7 +1359,8 @@ void TencentCloudChat::DeleteGroupAttributes(const V2TIMString &groupID, const V
  */
 void TencentCloudChat::GetGroupAttributes(const V2TIMString &groupID, const V2TIMStringVector &keys,
 										  V2TIMValueCallback<V2TIMGroupAttributeMap> *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->GetGroupAttributes(groupID,keys,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetGroupAttributes);
+											TencentCloudChatBackend::Get()->GetGroupManager()->GetGroupAttributes(groupID,keys,TencentCloudChatDispatcher::Marshal(callback));
 										  }
 
 /**
@@ -1154,7 +1372,8 @@ void TencentCloudChat::GetGroupAttributes(const V2TIMString &groupID, const V2TI
  */
 void TencentCloudChat::GetGroupOnlineMemberCount(const V2TIMString &groupID,
 												 V2TIMValueCallback<uint32_t> *callback){
-													V2TIMManager::GetInstance()->GetGroupManager()->GetGroupOnlineMemberCount(groupID,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetGroupOnlineMemberCount);
+													TencentCloudChatBackend::Get()->GetGroupManager()->GetGroupOnlineMemberCount(groupID,TencentCloudChatDispatcher::Marshal(callback));
 												 }
 
 /**
@@ -1167,7 +1386,8 @@ void TencentCloudChat::GetGroupOnlineMemberCount(const V2TIMString &groupID,
  */
 void TencentCloudChat::SetGroupCounters(const V2TIMString &groupID, const V2TIMStringToInt64Map &counters,
 										V2TIMValueCallback<V2TIMStringToInt64Map> *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->SetGroupCounters(groupID,counters,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetGroupCounters);
+											TencentCloudChatBackend::Get()->GetGroupManager()->SetGroupCounters(groupID,counters,TencentCloudChatDispatcher::Marshal(callback));
 										}
 
 /**
@@ -1179,7 +1399,8 @@ void TencentCloudChat::SetGroupCounters(const V2TIMString &groupID, const V2TIMS
  */
 void TencentCloudChat::GetGroupCounters(const V2TIMString &groupID, const V2TIMStringVector &keys,
 										V2TIMValueCallback<V2TIMStringToInt64Map> *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->GetGroupCounters(groupID,keys,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetGroupCounters);
+											TencentCloudChatBackend::Get()->GetGroupManager()->GetGroupCounters(groupID,keys,TencentCloudChatDispatcher::Marshal(callback));
 										}
 
 /**
@@ -1197,7 +1418,8 @@ void TencentCloudChat::GetGroupCounters(const V2TIMString &groupID, const V2TIMS
 void TencentCloudChat::IncreaseGroupCounter(const V2TIMString &groupID,
 											const V2TIMString &key, int64_t value,
 											V2TIMValueCallback<V2TIMStringToInt64Map> *callback){
-												V2TIMManager::GetInstance()->GetGroupManager()->IncreaseGroupCounter(groupID,key,value,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(IncreaseGroupCounter);
+												TencentCloudChatBackend::Get()->GetGroupManager()->IncreaseGroupCounter(groupID,key,value,TencentCloudChatDispatcher::Marshal(callback));
 											}
 
 /**
@@ -1215,7 +1437,8 @@ void TencentCloudChat::IncreaseGroupCounter(const V2TIMString &groupID,
 void TencentCloudChat::DecreaseGroupCounter(const V2TIMString &groupID,
 											const V2TIMString &key, int64_t value,
 											V2TIMValueCallback<V2TIMStringToInt64Map> *callback){
-												V2TIMManager::GetInstance()->GetGroupManager()->DecreaseGroupCounter(groupID,key,value,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DecreaseGroupCounter);
+												TencentCloudChatBackend::Get()->GetGroupManager()->DecreaseGroupCounter(groupID,key,value,TencentCloudChatDispatcher::Marshal(callback));
 											}
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1246,7 +1469,8 @@ void TencentCloudChat::DecreaseGroupCounter(const V2TIMString &groupID,
 void TencentCloudChat::GetGroupMemberList(const V2TIMString &groupID, uint32_t filter,
 										  uint64_t nextSeq,
 										  V2TIMValueCallback<V2TIMGroupMemberInfoResult> *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->GetGroupMemberList(groupID,filter,nextSeq,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetGroupMemberList);
+											TencentCloudChatBackend::Get()->GetGroupManager()->GetGroupMemberList(groupID,filter,nextSeq,TencentCloudChatDispatcher::Marshal(callback));
 										  }
 
 /**
@@ -1255,7 +1479,8 @@ void TencentCloudChat::GetGroupMemberList(const V2TIMString &groupID, uint32_t f
 void TencentCloudChat::GetGroupMembersInfo(
 	const V2TIMString &groupID, V2TIMStringVector memberList,
 	V2TIMValueCallback<V2TIMGroupMemberFullInfoVector> *callback){
-		V2TIMManager::GetInstance()->GetGroupManager()->GetGroupMembersInfo(groupID,memberList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetGroupMembersInfo);
+		TencentCloudChatBackend::Get()->GetGroupManager()->GetGroupMembersInfo(groupID,memberList,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1267,7 +1492,8 @@ void TencentCloudChat::GetGroupMembersInfo(
 void TencentCloudChat::SearchGroupMembers(
 	const V2TIMGroupMemberSearchParam &param,
 	V2TIMValueCallback<V2TIMGroupSearchGroupMembersMap> *callback){
-		V2TIMManager::GetInstance()->GetGroupManager()->SearchGroupMembers(param,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SearchGroupMembers);
+		TencentCloudChatBackend::Get()->GetGroupManager()->SearchGroupMembers(param,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1276,7 +1502,8 @@ void TencentCloudChat::SearchGroupMembers(
 void TencentCloudChat::SetGroupMemberInfo(const V2TIMString &groupID,
 										  const V2TIMGroupMemberFullInfo &info,
 										  V2TIMCallback *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->SetGroupMemberInfo(groupID,info,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetGroupMemberInfo);
+											TencentCloudChatBackend::Get()->GetGroupManager()->SetGroupMemberInfo(groupID,info,TencentCloudChatDispatcher::Marshal(callback));
 										  }
 
 /**
@@ -1287,7 +1514,8 @@ void TencentCloudChat::SetGroupMemberInfo(const V2TIMString &groupID,
 void TencentCloudChat::MuteGroupMember(const V2TIMString &groupID, const V2TIMString &userID,
 									   uint32_t seconds,
 									   V2TIMCallback *callback){
-										V2TIMManager::GetInstance()->GetGroupManager()->MuteGroupMember(groupID,userID,seconds,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(MuteGroupMember);
+										TencentCloudChatBackend::Get()->GetGroupManager()->MuteGroupMember(groupID,userID,seconds,TencentCloudChatDispatcher::Marshal(callback));
 									   }
 
 /**
@@ -1299,10 +1527,11 @@ void TencentCloudChat::MuteGroupMember(const V2TIMString &groupID, const V2TIMSt
  * 管理员身份才可以邀请其他人进群。
  * - 直播群（AVChatRoom）：不支持此功能。
  */
-void InviteUserToGroup(
+void TencentCloudChat::InviteUserToGroup(
 	const V2TIMString &groupID, const V2TIMStringVector &userList,
 	V2TIMValueCallback<V2TIMGroupMemberOperationResultVector> *callback){
-		V2TIMManager::GetInstance()->GetGroupManager()->InviteUserToGroup(groupID,userList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(InviteUserToGroup);
+		TencentCloudChatBackend::Get()->GetGroupManager()->InviteUserToGroup(groupID,userList,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1316,7 +1545,8 @@ void InviteUserToGroup(
 void TencentCloudChat::KickGroupMember(
 	const V2TIMString &groupID, const V2TIMStringVector &memberList, const V2TIMString &reason,
 	V2TIMValueCallback<V2TIMGroupMemberOperationResultVector> *callback){
-		V2TIMManager::GetInstance()->GetGroupManager()->KickGroupMember(groupID,memberList,reason,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(KickGroupMember);
+		TencentCloudChatBackend::Get()->GetGroupManager()->KickGroupMember(groupID,memberList,reason,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1334,7 +1564,8 @@ void TencentCloudChat::KickGroupMember(
  */
 void TencentCloudChat::SetGroupMemberRole(const V2TIMString &groupID, const V2TIMString &userID,
 										  uint32_t role, V2TIMCallback *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->SetGroupMemberRole(groupID,userID,role,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetGroupMemberRole);
+											TencentCloudChatBackend::Get()->GetGroupManager()->SetGroupMemberRole(groupID,userID,role,TencentCloudChatDispatcher::Marshal(callback));
 										  }
 
 /**
@@ -1352,7 +1583,8 @@ void TencentCloudChat::SetGroupMemberRole(const V2TIMString &groupID, const V2TI
 void TencentCloudChat::MarkGroupMemberList(const V2TIMString &groupID,
 										   const V2TIMStringVector &memberList, uint32_t markType,
 										   bool enableMark, V2TIMCallback *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->MarkGroupMemberList(groupID,memberList,markType,enableMark,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(MarkGroupMemberList);
+											TencentCloudChatBackend::Get()->GetGroupManager()->MarkGroupMemberList(groupID,memberList,markType,enableMark,TencentCloudChatDispatcher::Marshal(callback));
 										   }
 
 /**
@@ -1364,7 +1596,8 @@ void TencentCloudChat::MarkGroupMemberList(const V2TIMString &groupID,
  */
 void TencentCloudChat::TransferGroupOwner(const V2TIMString &groupID, const V2TIMString &userID,
 										  V2TIMCallback *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->TransferGroupOwner(groupID,userID,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(TransferGroupOwner);
+											TencentCloudChatBackend::Get()->GetGroupManager()->TransferGroupOwner(groupID,userID,TencentCloudChatDispatcher::Marshal(callback));
 										  }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1377,7 +1610,8 @@ void TencentCloudChat::TransferGroupOwner(const V2TIMString &groupID, const V2TI
  */
 void TencentCloudChat::GetGroupApplicationList(
 	V2TIMValueCallback<V2TIMGroupApplicationResult> *callback){
-		V2TIMManager::GetInstance()->GetGroupManager()->GetGroupApplicationList(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetGroupApplicationList);
+		TencentCloudChatBackend::Get()->GetGroupManager()->GetGroupApplicationList(TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1385,7 +1619,8 @@ void TencentCloudChat::GetGroupApplicationList(
  */
 void TencentCloudChat::AcceptGroupApplication(const V2TIMGroupApplication &application,
 											  const V2TIMString &reason, V2TIMCallback *callback){
-												V2TIMManager::GetInstance()->GetGroupManager()->AcceptGroupApplication(application,reason,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(AcceptGroupApplication);
+												TencentCloudChatBackend::Get()->GetGroupManager()->AcceptGroupApplication(application,reason,TencentCloudChatDispatcher::Marshal(callback));
 											  }
 
 /**
@@ -1393,14 +1628,16 @@ void TencentCloudChat::AcceptGroupApplication(const V2TIMGroupApplication &appli
  */
 void TencentCloudChat::RefuseGroupApplication(const V2TIMGroupApplication &application,
 											  const V2TIMString &reason, V2TIMCallback *callback){
-												V2TIMManager::GetInstance()->GetGroupManager()->RefuseGroupApplication(application,reason,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(RefuseGroupApplication);
+												TencentCloudChatBackend::Get()->GetGroupManager()->RefuseGroupApplication(application,reason,TencentCloudChatDispatcher::Marshal(callback));
 											  }
 
 /**
  * 4.4 标记申请列表为已读
  */
 void TencentCloudChat::SetGroupApplicationRead(V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetGroupManager()->SetGroupApplicationRead(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetGroupApplicationRead);
+	TencentCloudChatBackend::Get()->GetGroupManager()->SetGroupApplicationRead(TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1413,7 +1650,8 @@ void TencentCloudChat::SetGroupApplicationRead(V2TIMCallback *callback){
  * 5.1 获取当前用户已经加入的支持话题的社群列表
  */
 void TencentCloudChat::GetJoinedCommunityList(V2TIMValueCallback<V2TIMGroupInfoVector> *callback){
-	V2TIMManager::GetInstance()->GetGroupManager()->GetJoinedCommunityList(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetJoinedCommunityList);
+	TencentCloudChatBackend::Get()->GetGroupManager()->GetJoinedCommunityList(TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -1421,7 +1659,8 @@ void TencentCloudChat::GetJoinedCommunityList(V2TIMValueCallback<V2TIMGroupInfoV
  */
 void TencentCloudChat::CreateTopicInCommunity(const V2TIMString &groupID, const V2TIMTopicInfo &topicInfo,
 											  V2TIMValueCallback<V2TIMString> *callback){
-												V2TIMManager::GetInstance()->GetGroupManager()->CreateTopicInCommunity(groupID,topicInfo,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateTopicInCommunity);
+												TencentCloudChatBackend::Get()->GetGroupManager()->CreateTopicInCommunity(groupID,topicInfo,TencentCloudChatDispatcher::Marshal(callback));
 											  }
 
 /**
@@ -1430,14 +1669,16 @@ void TencentCloudChat::CreateTopicInCommunity(const V2TIMString &groupID, const
 void TencentCloudChat::DeleteTopicFromCommunity(const V2TIMString &groupID,
 												const V2TIMStringVector &topicIDList,
 												V2TIMValueCallback<V2TIMTopicOperationResultVector> *callback){
-													V2TIMManager::GetInstance()->GetGroupManager()->DeleteTopicFromCommunity(groupID,topicIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteTopicFromCommunity);
+													TencentCloudChatBackend::Get()->GetGroupManager()->DeleteTopicFromCommunity(groupID,topicIDList,TencentCloudChatDispatcher::Marshal(callback));
 												}
 
 /**
  * 5.4 修改话题信息
  */
 void TencentCloudChat::SetTopicInfo(const V2TIMTopicInfo &topicInfo, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetGroupManager()->SetTopicInfo(topicInfo,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetTopicInfo);
+	TencentCloudChatBackend::Get()->GetGroupManager()->SetTopicInfo(topicInfo,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -1446,21 +1687,25 @@ void TencentCloudChat::SetTopicInfo(const V2TIMTopicInfo &topicInfo, V2TIMCallba
  */
 void TencentCloudChat::GetTopicInfoList(const V2TIMString &groupID, const V2TIMStringVector &topicIDList,
 										V2TIMValueCallback<V2TIMTopicInfoResultVector> *callback){
-											V2TIMManager::GetInstance()->GetGroupManager()->GetTopicInfoList(groupID,topicIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetTopicInfoList);
+											TencentCloudChatBackend::Get()->GetGroupManager()->GetTopicInfoList(groupID,topicIDList,TencentCloudChatDispatcher::Marshal(callback));
 										}
 
 /**
  * 1.1 添加会话监听器
  */
 void TencentCloudChat::AddConversationListener(V2TIMConversationListener *listener){
-	V2TIMManager::GetInstance()->GetConversationManager()->AddConversationListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(AddConversationListener);
+	TencentCloudChatBackend::Get()->GetConversationManager()->AddConversationListener(TencentCloudChatConversationListenerProxies::Acquire(listener));
 }
 
 /**
  * 1.2 移除会话监听器
  */
 void TencentCloudChat::RemoveConversationListener(V2TIMConversationListener *listener){
-	V2TIMManager::GetInstance()->GetConversationManager()->RemoveConversationListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(RemoveConversationListener);
+	TencentCloudChatBackend::Get()->GetConversationManager()->RemoveConversationListener(TencentCloudChatConversationListenerProxies::Find(listener));
+	TencentCloudChatConversationListenerProxies::Release(listener);
 }
 
 /**
@@ -1488,7 +1733,8 @@ void TencentCloudChat::RemoveConversationListener(V2TIMConversationListener *lis
  */
 void TencentCloudChat::GetConversationList(uint64_t nextSeq, uint32_t count,
 										   V2TIMValueCallback<V2TIMConversationResult> *callback){
-											V2TIMManager::GetInstance()->GetConversationManager()->GetConversationList(nextSeq,count,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetConversationList);
+											TencentCloudChatBackend::Get()->GetConversationManager()->GetConversationList(nextSeq,count,TencentCloudChatDispatcher::Marshal(callback));
 										   }
 
 /**
@@ -1499,7 +1745,8 @@ void TencentCloudChat::GetConversationList(uint64_t nextSeq, uint32_t count,
  */
 void TencentCloudChat::GetConversation(const V2TIMString &conversationID,
 									   V2TIMValueCallback<V2TIMConversation> *callback){
-										V2TIMManager::GetInstance()->GetConversationManager()->GetConversation(conversationID,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetConversation);
+										TencentCloudChatBackend::Get()->GetConversationManager()->GetConversation(conversationID,TencentCloudChatDispatcher::Marshal(callback));
 									   }
 
 /**
@@ -1510,7 +1757,8 @@ void TencentCloudChat::GetConversation(const V2TIMString &conversationID,
  */
 void TencentCloudChat::GetConversationList(const V2TIMStringVector &conversationIDList,
 										   V2TIMValueCallback<V2TIMConversationVector> *callback){
-											V2TIMManager::GetInstance()->GetConversationManager()->GetConversationList(conversationIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetConversationList);
+											TencentCloudChatBackend::Get()->GetConversationManager()->GetConversationList(conversationIDList,TencentCloudChatDispatcher::Marshal(callback));
 										   }
 
 /**
@@ -1524,7 +1772,8 @@ void TencentCloudChat::GetConversationList(const V2TIMStringVector &conversation
 void TencentCloudChat::GetConversationListByFilter(const V2TIMConversationListFilter &filter,
 												   uint64_t nextSeq, uint32_t count,
 												   V2TIMValueCallback<V2TIMConversationResult> *callback){
-													V2TIMManager::GetInstance()->GetConversationManager()->GetConversationListByFilter(filter,nextSeq,count,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetConversationListByFilter);
+													TencentCloudChatBackend::Get()->GetConversationManager()->GetConversationListByFilter(filter,nextSeq,count,TencentCloudChatDispatcher::Marshal(callback));
 												   }
 
 /**
@@ -1538,7 +1787,8 @@ void TencentCloudChat::GetConversationListByFilter(const V2TIMConversationListFi
  * - 会话内的消息在本地删除的同时，在服务器也会同步删除。
  */
 void TencentCloudChat::DeleteConversation(const V2TIMString &conversationID, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetConversationManager()->DeleteConversation(conversationID,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteConversation);
+	TencentCloudChatBackend::Get()->GetConversationManager()->DeleteConversation(conversationID,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -1553,7 +1803,8 @@ void TencentCloudChat::DeleteConversation(const V2TIMString &conversationID, V2T
  */
 void TencentCloudChat::SetConversationDraft(const V2TIMString &conversationID,
 											const V2TIMString &draftText, V2TIMCallback *callback){
-												V2TIMManager::GetInstance()->GetConversationManager()->SetConversationDraft(conversationID,draftText,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetConversationDraft);
+												TencentCloudChatBackend::Get()->GetConversationManager()->SetConversationDraft(conversationID,draftText,TencentCloudChatDispatcher::Marshal(callback));
 											}
 
 /**
@@ -1563,7 +1814,8 @@ void TencentCloudChat::SetConversationDraft(const V2TIMString &conversationID,
  */
 void TencentCloudChat::SetConversationCustomData(const V2TIMStringVector &conversationIDList, const V2TIMBuffer &customData,
 												 V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback){
-													V2TIMManager::GetInstance()->GetConversationManager()->SetConversationCustomData(conversationIDList,customData,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetConversationCustomData);
+													TencentCloudChatBackend::Get()->GetConversationManager()->SetConversationCustomData(conversationIDList,customData,TencentCloudChatDispatcher::Marshal(callback));
 												 }
 
 /**
@@ -1576,7 +1828,8 @@ void TencentCloudChat::SetConversationCustomData(const V2TIMStringVector &conver
  */
 void TencentCloudChat::PinConversation(const V2TIMString &conversationID, bool isPinned,
 									   V2TIMCallback *callback){
-										V2TIMManager::GetInstance()->GetConversationManager()->PinConversation(conversationID,isPinned,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(PinConversation);
+										TencentCloudChatBackend::Get()->GetConversationManager()->PinConversation(conversationID,isPinned,TencentCloudChatDispatcher::Marshal(callback));
 									   }
 
 /**
@@ -1595,7 +1848,8 @@ void TencentCloudChat::PinConversation(const V2TIMString &conversationID, bool i
  */
 void TencentCloudChat::MarkConversation(const V2TIMStringVector &conversationIDList, uint64_t markType, bool enableMark,
 										V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback){
-											V2TIMManager::GetInstance()->GetConversationManager()->MarkConversation(conversationIDList,markType,enableMark,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(MarkConversation);
+											TencentCloudChatBackend::Get()->GetConversationManager()->MarkConversation(conversationIDList,markType,enableMark,TencentCloudChatDispatcher::Marshal(callback));
 										}
 
 /**
@@ -1606,7 +1860,8 @@ void TencentCloudChat::MarkConversation(const V2TIMStringVector &conversationIDL
  *  V2TIM_NOT_RECEIVE_MESSAGE 或 V2TIM_RECEIVE_NOT_NOTIFY_MESSAGE 的会话。
  */
 void TencentCloudChat::GetTotalUnreadMessageCount(V2TIMValueCallback<uint64_t> *callback){
-	V2TIMManager::GetInstance()->GetConversationManager()->GetTotalUnreadMessageCount(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetTotalUnreadMessageCount);
+	TencentCloudChatBackend::Get()->GetConversationManager()->GetTotalUnreadMessageCount(TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -1620,7 +1875,8 @@ void TencentCloudChat::GetTotalUnreadMessageCount(V2TIMValueCallback<uint64_t> *
  */
 void TencentCloudChat::GetUnreadMessageCountByFilter(const V2TIMConversationListFilter &filter,
 													 V2TIMValueCallback<uint64_t> *callback){
-														V2TIMManager::GetInstance()->GetConversationManager()->GetUnreadMessageCountByFilter(filter,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetUnreadMessageCountByFilter);
+														TencentCloudChatBackend::Get()->GetConversationManager()->GetUnreadMessageCountByFilter(filter,TencentCloudChatDispatcher::Marshal(callback));
 													 }
 
 /**
@@ -1632,7 +1888,8 @@ void TencentCloudChat::GetUnreadMessageCountByFilter(const V2TIMConversationList
  *  - 当您调用这个接口以后，该 filter 下的未读数发生变化时，SDK 会给您抛 OnUnreadMessageCountChangedByFilter 回调。
  */
 void TencentCloudChat::SubscribeUnreadMessageCountByFilter(const V2TIMConversationListFilter &filter){
-	V2TIMManager::GetInstance()->GetConversationManager()->SubscribeUnreadMessageCountByFilter(filter);
+	TENCENTCLOUDCHAT_SCOPE_API(SubscribeUnreadMessageCountByFilter);
+	TencentCloudChatBackend::Get()->GetConversationManager()->SubscribeUnreadMessageCountByFilter(filter);
 }
 
 /**
@@ -1642,7 +1899,8 @@ void TencentCloudChat::SubscribeUnreadMessageCountByFilter(const V2TIMConversati
  *
  */
 void TencentCloudChat::UnsubscribeUnreadMessageCountByFilter(const V2TIMConversationListFilter &filter){
-	V2TIMManager::GetInstance()->GetConversationManager()->UnsubscribeUnreadMessageCountByFilter(filter);
+	TENCENTCLOUDCHAT_SCOPE_API(UnsubscribeUnreadMessageCountByFilter);
+	TencentCloudChatBackend::Get()->GetConversationManager()->UnsubscribeUnreadMessageCountByFilter(filter);
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1661,21 +1919,24 @@ void TencentCloudChat::UnsubscribeUnreadMessageCountByFilter(const V2TIMConversa
  */
 void TencentCloudChat::CreateConversationGroup(const V2TIMString &groupName, const V2TIMStringVector &conversationIDList,
 											   V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback){
-												V2TIMManager::GetInstance()->GetConversationManager()->CreateConversationGroup(groupName,conversationIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateConversationGroup);
+												TencentCloudChatBackend::Get()->GetConversationManager()->CreateConversationGroup(groupName,conversationIDList,TencentCloudChatDispatcher::Marshal(callback));
 											   }
 
 /**
  * 2.2 获取会话分组列表
  */
 void TencentCloudChat::GetConversationGroupList(V2TIMValueCallback<V2TIMStringVector> *callback){
-	V2TIMManager::GetInstance()->GetConversationManager()->GetConversationGroupList(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetConversationGroupList);
+	TencentCloudChatBackend::Get()->GetConversationManager()->GetConversationGroupList(TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
  * 2.3 删除会话分组
  */
 void TencentCloudChat::DeleteConversationGroup(const V2TIMString &groupName, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetConversationManager()->DeleteConversationGroup(groupName,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteConversationGroup);
+	TencentCloudChatBackend::Get()->GetConversationManager()->DeleteConversationGroup(groupName,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -1684,7 +1945,8 @@ void TencentCloudChat::DeleteConversationGroup(const V2TIMString &groupName, V2T
  */
 void TencentCloudChat::RenameConversationGroup(const V2TIMString &oldName, const V2TIMString &newName,
 											   V2TIMCallback *callback){
-												V2TIMManager::GetInstance()->GetConversationManager()->RenameConversationGroup(oldName,newName,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(RenameConversationGroup);
+												TencentCloudChatBackend::Get()->GetConversationManager()->RenameConversationGroup(oldName,newName,TencentCloudChatDispatcher::Marshal(callback));
 											   }
 
 /**
@@ -1692,7 +1954,8 @@ void TencentCloudChat::RenameConversationGroup(const V2TIMString &oldName, const
  */
 void TencentCloudChat::AddConversationsToGroup(const V2TIMString &groupName, const V2TIMStringVector &conversationIDList,
 											   V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback){
-												V2TIMManager::GetInstance()->GetConversationManager()->AddConversationsToGroup(groupName,conversationIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(AddConversationsToGroup);
+												TencentCloudChatBackend::Get()->GetConversationManager()->AddConversationsToGroup(groupName,conversationIDList,TencentCloudChatDispatcher::Marshal(callback));
 											   }
 
 /**
@@ -1700,7 +1963,8 @@ void TencentCloudChat::AddConversationsToGroup(const V2TIMString &groupName, con
  */
 void TencentCloudChat::DeleteConversationsFromGroup(const V2TIMString &groupName, const V2TIMStringVector &conversationIDList,
 													V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback){
-														V2TIMManager::GetInstance()->GetConversationManager()->DeleteConversationsFromGroup(groupName,conversationIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteConversationsFromGroup);
+														TencentCloudChatBackend::Get()->GetConversationManager()->DeleteConversationsFromGroup(groupName,conversationIDList,TencentCloudChatDispatcher::Marshal(callback));
 													}
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1713,14 +1977,17 @@ void TencentCloudChat::DeleteConversationsFromGroup(const V2TIMString &groupName
  * 1.1 添加关系链监听器
  */
 void TencentCloudChat::AddFriendListener(V2TIMFriendshipListener *listener){
-	V2TIMManager::GetInstance()->GetFriendshipManager()->AddFriendListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(AddFriendListener);
+	TencentCloudChatBackend::Get()->GetFriendshipManager()->AddFriendListener(TencentCloudChatFriendshipListenerProxies::Acquire(listener));
 }
 
 /**
  * 1.2 移除关系链监听器
  */
 void TencentCloudChat::RemoveFriendListener(V2TIMFriendshipListener *listener){
-	V2TIMManager::GetInstance()->GetFriendshipManager()->RemoveFriendListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(RemoveFriendListener);
+	TencentCloudChatBackend::Get()->GetFriendshipManager()->RemoveFriendListener(TencentCloudChatFriendshipListenerProxies::Find(listener));
+	TencentCloudChatFriendshipListenerProxies::Release(listener);
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1733,7 +2000,8 @@ void TencentCloudChat::RemoveFriendListener(V2TIMFriendshipListener *listener){
  * 2.1 获取好友列表
  */
 void TencentCloudChat::GetFriendList(V2TIMValueCallback<V2TIMFriendInfoVector> *callback){
-	V2TIMManager::GetInstance()->GetFriendshipManager()->GetFriendList(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetFriendList);
+	TencentCloudChatBackend::Get()->GetFriendshipManager()->GetFriendList(TencentCloudChatDispatcher::Marshal(callback));
 
 }
 
@@ -1746,7 +2014,8 @@ void TencentCloudChat::GetFriendList(V2TIMValueCallback<V2TIMFriendInfoVector> *
  */
 void TencentCloudChat::GetFriendsInfo(const V2TIMStringVector &userIDList,
 									  V2TIMValueCallback<V2TIMFriendInfoResultVector> *callback){
-	V2TIMManager::GetInstance()->GetFriendshipManager()->GetFriendsInfo(userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetFriendsInfo);
+	TencentCloudChatBackend::Get()->GetFriendshipManager()->GetFriendsInfo(userIDList,TencentCloudChatDispatcher::Marshal(callback));
 
 									  }
 
@@ -1754,7 +2023,8 @@ void TencentCloudChat::GetFriendsInfo(const V2TIMStringVector &userIDList,
  * 2.3 设置指定好友资料
  */
 void TencentCloudChat::SetFriendInfo(const V2TIMFriendInfo &info, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetFriendshipManager()->SetFriendInfo(info,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetFriendInfo);
+	TencentCloudChatBackend::Get()->GetFriendshipManager()->SetFriendInfo(info,TencentCloudChatDispatcher::Marshal(callback));
 
 }
 
@@ -1766,7 +2036,8 @@ void TencentCloudChat::SetFriendInfo(const V2TIMFriendInfo &info, V2TIMCallback
  */
 void TencentCloudChat::SearchFriends(const V2TIMFriendSearchParam &searchParam,
 									 V2TIMValueCallback<V2TIMFriendInfoResultVector> *callback){
-										V2TIMManager::GetInstance()->GetFriendshipManager()->SearchFriends(searchParam,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SearchFriends);
+										TencentCloudChatBackend::Get()->GetFriendshipManager()->SearchFriends(searchParam,TencentCloudChatDispatcher::Marshal(callback));
 									 }
 
 /**
@@ -1774,7 +2045,8 @@ void TencentCloudChat::SearchFriends(const V2TIMFriendSearchParam &searchParam,
  */
 void TencentCloudChat::AddFriend(const V2TIMFriendAddApplication &application,
 								 V2TIMValueCallback<V2TIMFriendOperationResult> *callback){
-									V2TIMManager::GetInstance()->GetFriendshipManager()->AddFriend(application,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(AddFriend);
+									TencentCloudChatBackend::Get()->GetFriendshipManager()->AddFriend(application,TencentCloudChatDispatcher::Marshal(callback));
 								 }
 
 /**
@@ -1790,7 +2062,8 @@ void TencentCloudChat::AddFriend(const V2TIMFriendAddApplication &application,
 void TencentCloudChat::DeleteFromFriendList(
 	const V2TIMStringVector &userIDList, V2TIMFriendType deleteType,
 	V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback){
-		V2TIMManager::GetInstance()->GetFriendshipManager()->DeleteFromFriendList(userIDList,deleteType,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteFromFriendList);
+		TencentCloudChatBackend::Get()->GetFriendshipManager()->DeleteFromFriendList(userIDList,deleteType,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1810,7 +2083,8 @@ void TencentCloudChat::DeleteFromFriendList(
  */
 void TencentCloudChat::CheckFriend(const V2TIMStringVector &userIDList, V2TIMFriendType checkType,
 								   V2TIMValueCallback<V2TIMFriendCheckResultVector> *callback){
-									V2TIMManager::GetInstance()->GetFriendshipManager()->CheckFriend(userIDList,checkType,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(CheckFriend);
+									TencentCloudChatBackend::Get()->GetFriendshipManager()->CheckFriend(userIDList,checkType,TencentCloudChatDispatcher::Marshal(callback));
 								   }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1828,7 +2102,8 @@ void TencentCloudChat::CheckFriend(const V2TIMStringVector &userIDList, V2TIMFri
  */
 void TencentCloudChat::GetFriendApplicationList(
 	V2TIMValueCallback<V2TIMFriendApplicationResult> *callback){
-		V2TIMManager::GetInstance()->GetFriendshipManager()->GetFriendApplicationList(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetFriendApplicationList);
+		TencentCloudChatBackend::Get()->GetFriendshipManager()->GetFriendApplicationList(TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1840,7 +2115,8 @@ void TencentCloudChat::GetFriendApplicationList(
 void TencentCloudChat::AcceptFriendApplication(
 	const V2TIMFriendApplication &application, V2TIMFriendAcceptType acceptType,
 	V2TIMValueCallback<V2TIMFriendOperationResult> *callback){
-		V2TIMManager::GetInstance()->GetFriendshipManager()->AcceptFriendApplication(application,acceptType,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(AcceptFriendApplication);
+		TencentCloudChatBackend::Get()->GetFriendshipManager()->AcceptFriendApplication(application,acceptType,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1851,7 +2127,8 @@ void TencentCloudChat::AcceptFriendApplication(
 void TencentCloudChat::RefuseFriendApplication(
 	const V2TIMFriendApplication &application,
 	V2TIMValueCallback<V2TIMFriendOperationResult> *callback){
-		V2TIMManager::GetInstance()->GetFriendshipManager()->RefuseFriendApplication(application,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(RefuseFriendApplication);
+		TencentCloudChatBackend::Get()->GetFriendshipManager()->RefuseFriendApplication(application,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1861,14 +2138,16 @@ void TencentCloudChat::RefuseFriendApplication(
  */
 void TencentCloudChat::DeleteFriendApplication(const V2TIMFriendApplication &application,
 											   V2TIMCallback *callback){
-												V2TIMManager::GetInstance()->GetFriendshipManager()->DeleteFriendApplication(application,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteFriendApplication);
+												TencentCloudChatBackend::Get()->GetFriendshipManager()->DeleteFriendApplication(application,TencentCloudChatDispatcher::Marshal(callback));
 											   }
 
 /**
  * 3.5 设置好友申请已读
  */
 void TencentCloudChat::SetFriendApplicationRead(V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetFriendshipManager()->SetFriendApplicationRead(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetFriendApplicationRead);
+	TencentCloudChatBackend::Get()->GetFriendshipManager()->SetFriendApplicationRead(TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1882,7 +2161,8 @@ void TencentCloudChat::SetFriendApplicationRead(V2TIMCallback *callback){
  */
 void TencentCloudChat::AddToBlackList(const V2TIMStringVector &userIDList,
 									  V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback){
-										V2TIMManager::GetInstance()->GetFriendshipManager()->AddToBlackList(userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(AddToBlackList);
+										TencentCloudChatBackend::Get()->GetFriendshipManager()->AddToBlackList(userIDList,TencentCloudChatDispatcher::Marshal(callback));
 									  }
 
 /**
@@ -1891,14 +2171,16 @@ void TencentCloudChat::AddToBlackList(const V2TIMStringVector &userIDList,
 void TencentCloudChat::DeleteFromBlackList(
 	const V2TIMStringVector &userIDList,
 	V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback){
-		V2TIMManager::GetInstance()->GetFriendshipManager()->DeleteFromBlackList(userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteFromBlackList);
+		TencentCloudChatBackend::Get()->GetFriendshipManager()->DeleteFromBlackList(userIDList,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
  * 4.3 获取黑名单列表
  */
 void TencentCloudChat::GetBlackList(V2TIMValueCallback<V2TIMFriendInfoVector> *callback){
-	V2TIMManager::GetInstance()->GetFriendshipManager()->GetBlackList(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetBlackList);
+	TencentCloudChatBackend::Get()->GetFriendshipManager()->GetBlackList(TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -1916,7 +2198,8 @@ void TencentCloudChat::GetBlackList(V2TIMValueCallback<V2TIMFriendInfoVector> *c
 void TencentCloudChat::CreateFriendGroup(
 	const V2TIMString &groupName, const V2TIMStringVector &userIDList,
 	V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback){
-		V2TIMManager::GetInstance()->GetFriendshipManager()->CreateFriendGroup(groupName,userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(CreateFriendGroup);
+		TencentCloudChatBackend::Get()->GetFriendshipManager()->CreateFriendGroup(groupName,userIDList,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1926,7 +2209,8 @@ void TencentCloudChat::CreateFriendGroup(
  */
 void TencentCloudChat::GetFriendGroups(const V2TIMStringVector &groupNameList,
 									   V2TIMValueCallback<V2TIMFriendGroupVector> *callback){
-										V2TIMManager::GetInstance()->GetFriendshipManager()->GetFriendGroups(groupNameList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(GetFriendGroups);
+										TencentCloudChatBackend::Get()->GetFriendshipManager()->GetFriendGroups(groupNameList,TencentCloudChatDispatcher::Marshal(callback));
 									   }
 
 /**
@@ -1934,7 +2218,8 @@ void TencentCloudChat::GetFriendGroups(const V2TIMStringVector &groupNameList,
  */
 void TencentCloudChat::DeleteFriendGroup(const V2TIMStringVector &groupNameList,
 										 V2TIMCallback *callback){
-											V2TIMManager::GetInstance()->GetFriendshipManager()->DeleteFriendGroup(groupNameList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteFriendGroup);
+											TencentCloudChatBackend::Get()->GetFriendshipManager()->DeleteFriendGroup(groupNameList,TencentCloudChatDispatcher::Marshal(callback));
 										 }
 
 /**
@@ -1946,7 +2231,8 @@ void TencentCloudChat::DeleteFriendGroup(const V2TIMStringVector &groupNameList,
  */
 void TencentCloudChat::RenameFriendGroup(const V2TIMString &oldName, const V2TIMString &newName,
 										 V2TIMCallback *callback){
-											V2TIMManager::GetInstance()->GetFriendshipManager()->RenameFriendGroup(oldName,newName,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(RenameFriendGroup);
+											TencentCloudChatBackend::Get()->GetFriendshipManager()->RenameFriendGroup(oldName,newName,TencentCloudChatDispatcher::Marshal(callback));
 										 }
 
 /**
@@ -1955,7 +2241,8 @@ void TencentCloudChat::RenameFriendGroup(const V2TIMString &oldName, const V2TIM
 void TencentCloudChat::AddFriendsToFriendGroup(
 	const V2TIMString &groupName, const V2TIMStringVector &userIDList,
 	V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback){
-		V2TIMManager::GetInstance()->GetFriendshipManager()->AddFriendsToFriendGroup(groupName,userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(AddFriendsToFriendGroup);
+		TencentCloudChatBackend::Get()->GetFriendshipManager()->AddFriendsToFriendGroup(groupName,userIDList,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1964,7 +2251,8 @@ void TencentCloudChat::AddFriendsToFriendGroup(
 void TencentCloudChat::DeleteFriendsFromFriendGroup(
 	const V2TIMString &groupName, const V2TIMStringVector &userIDList,
 	V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback){
-		V2TIMManager::GetInstance()->GetFriendshipManager()->DeleteFriendsFromFriendGroup(groupName,userIDList,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DeleteFriendsFromFriendGroup);
+		TencentCloudChatBackend::Get()->GetFriendshipManager()->DeleteFriendsFromFriendGroup(groupName,userIDList,TencentCloudChatDispatcher::Marshal(callback));
 	}
 
 /**
@@ -1975,7 +2263,8 @@ void TencentCloudChat::DeleteFriendsFromFriendGroup(
  * @param callback 回调
  */
 void TencentCloudChat::SetOfflinePushConfig(const V2TIMOfflinePushConfig &config, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetOfflinePushManager()->SetOfflinePushConfig(config,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(SetOfflinePushConfig);
+	TencentCloudChatBackend::Get()->GetOfflinePushManager()->SetOfflinePushConfig(config,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -1987,7 +2276,8 @@ void TencentCloudChat::SetOfflinePushConfig(const V2TIMOfflinePushConfig &config
  * @param callback 回调
  */
 void TencentCloudChat::DoBackground(uint32_t unreadCount, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetOfflinePushManager()->DoBackground(unreadCount,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DoBackground);
+	TencentCloudChatBackend::Get()->GetOfflinePushManager()->DoBackground(unreadCount,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -1998,21 +2288,25 @@ void TencentCloudChat::DoBackground(uint32_t unreadCount, V2TIMCallback *callbac
  * @param callback 回调
  */
 void TencentCloudChat::DoForeground(V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetOfflinePushManager()->DoForeground(callback);
+	TENCENTCLOUDCHAT_SCOPE_API(DoForeground);
+	TencentCloudChatBackend::Get()->GetOfflinePushManager()->DoForeground(TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
  * 添加信令监听
  */
 void TencentCloudChat::AddSignalingListener(V2TIMSignalingListener *listener){
-	V2TIMManager::GetInstance()->GetSignalingManager()->AddSignalingListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(AddSignalingListener);
+	TencentCloudChatBackend::Get()->GetSignalingManager()->AddSignalingListener(TencentCloudChatSignalingListenerProxies::Acquire(listener));
 }
 
 /**
  * 移除信令监听
  */
 void TencentCloudChat::RemoveSignalingListener(V2TIMSignalingListener *listener){
-	V2TIMManager::GetInstance()->GetSignalingManager()->RemoveSignalingListener(listener);
+	TENCENTCLOUDCHAT_SCOPE_API(RemoveSignalingListener);
+	TencentCloudChatBackend::Get()->GetSignalingManager()->RemoveSignalingListener(TencentCloudChatSignalingListenerProxies::Find(listener));
+	TencentCloudChatSignalingListenerProxies::Release(listener);
 }
 
 /**
@@ -2032,7 +2326,8 @@ V2TIMString TencentCloudChat::Invite(const V2TIMString &invitee, const V2TIMStri
 									 bool onlineUserOnly,
 									 const V2TIMOfflinePushInfo &offlinePushInfo, int timeout,
 									 V2TIMCallback *callback){
-										return V2TIMManager::GetInstance()->GetSignalingManager()->Invite(invitee,data,onlineUserOnly,offlinePushInfo,timeout,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(Invite);
+										return TencentCloudChatBackend::Get()->GetSignalingManager()->Invite(invitee,data,onlineUserOnly,offlinePushInfo,timeout,TencentCloudChatDispatcher::Marshal(callback));
 									 }
 
 /**
@@ -2055,7 +2350,8 @@ V2TIMString TencentCloudChat::InviteInGroup(const V2TIMString &groupID,
 											const V2TIMStringVector &inviteeList, const V2TIMString &data,
 											bool onlineUserOnly, int timeout,
 											V2TIMCallback *callback){
-												return V2TIMManager::GetInstance()->GetSignalingManager()->InviteInGroup(groupID,inviteeList,data,onlineUserOnly,timeout,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(InviteInGroup);
+												return TencentCloudChatBackend::Get()->GetSignalingManager()->InviteInGroup(groupID,inviteeList,data,onlineUserOnly,timeout,TencentCloudChatDispatcher::Marshal(callback));
 											}
 
 /**
@@ -2067,7 +2363,8 @@ V2TIMString TencentCloudChat::InviteInGroup(const V2TIMString &groupID,
  */
 void TencentCloudChat::Cancel(const V2TIMString &inviteID, const V2TIMString &data,
 							  V2TIMCallback *callback){
-								V2TIMManager::GetInstance()->GetSignalingManager()->Cancel(inviteID,data,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(Cancel);
+								TencentCloudChatBackend::Get()->GetSignalingManager()->Cancel(inviteID,data,TencentCloudChatDispatcher::Marshal(callback));
 							  }
 
 /**
@@ -2078,7 +2375,8 @@ void TencentCloudChat::Cancel(const V2TIMString &inviteID, const V2TIMString &da
  */
 void TencentCloudChat::Accept(const V2TIMString &inviteID, const V2TIMString &data,
 							  V2TIMCallback *callback){
-								V2TIMManager::GetInstance()->GetSignalingManager()->Accept(inviteID,data,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(Accept);
+								TencentCloudChatBackend::Get()->GetSignalingManager()->Accept(inviteID,data,TencentCloudChatDispatcher::Marshal(callback));
 							  }
 
 /**
@@ -2089,7 +2387,8 @@ void TencentCloudChat::Accept(const V2TIMString &inviteID, const V2TIMString &da
  */
 void TencentCloudChat::Reject(const V2TIMString &inviteID, const V2TIMString &data,
 							  V2TIMCallback *callback){
-								V2TIMManager::GetInstance()->GetSignalingManager()->Reject(inviteID,data,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(Reject);
+								TencentCloudChatBackend::Get()->GetSignalingManager()->Reject(inviteID,data,TencentCloudChatDispatcher::Marshal(callback));
 							  }
 
 /**
@@ -2104,7 +2403,8 @@ void TencentCloudChat::Reject(const V2TIMString &inviteID, const V2TIMString &da
  * @return V2TIMSignalingInfo 信令信息，如果 V2TIMSignalingInfo::inviteID 为空字符串，则 msg 不是一条信令消息。
  */
 V2TIMSignalingInfo TencentCloudChat::GetSignalingInfo(const V2TIMMessage &msg){
-	return V2TIMManager::GetInstance()->GetSignalingManager()->GetSignalingInfo(msg);
+	TENCENTCLOUDCHAT_SCOPE_API(GetSignalingInfo);
+	return TencentCloudChatBackend::Get()->GetSignalingManager()->GetSignalingInfo(msg);
 }
 
 /**
@@ -2126,7 +2426,8 @@ V2TIMSignalingInfo TencentCloudChat::GetSignalingInfo(const V2TIMMessage &msg){
  *  @note 如果添加的信令信息已存在，fail callback 会抛 ERR_SDK_SIGNALING_ALREADY_EXISTS 错误码。
  */
 void TencentCloudChat::AddInvitedSignaling(const V2TIMSignalingInfo &info, V2TIMCallback *callback){
-	V2TIMManager::GetInstance()->GetSignalingManager()->AddInvitedSignaling(info,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(AddInvitedSignaling);
+	TencentCloudChatBackend::Get()->GetSignalingManager()->AddInvitedSignaling(info,TencentCloudChatDispatcher::Marshal(callback));
 }
 
 /**
@@ -2136,9 +2437,100 @@ void TencentCloudChat::AddInvitedSignaling(const V2TIMSignalingInfo &info, V2TIM
  */
 void TencentCloudChat::ModifyInvitation(const V2TIMString &inviteID, const V2TIMString &data,
 										V2TIMCallback *callback){
-											V2TIMManager::GetInstance()->GetSignalingManager()->ModifyInvitation(inviteID,data,callback);
+	TENCENTCLOUDCHAT_SCOPE_API(ModifyInvitation);
+											TencentCloudChatBackend::Get()->GetSignalingManager()->ModifyInvitation(inviteID,data,TencentCloudChatDispatcher::Marshal(callback));
 										}
 
+/////////////////////////////////////////////////////////////////////////////////
+//
+//                         FString 重载
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+void TencentCloudChat::Login(FStringView userID, FStringView userSig, V2TIMCallback *callback)
+{
+	Login(TencentCloudChatString::ToV2TIM(userID), TencentCloudChatString::ToV2TIM(userSig), callback);
+}
+
+V2TIMString TencentCloudChat::SendC2CTextMessage(FStringView text, FStringView userID,
+												 V2TIMSendCallback *callback)
+{
+	return SendC2CTextMessage(TencentCloudChatString::ToV2TIM(text), TencentCloudChatString::ToV2TIM(userID), callback);
+}
+
+V2TIMString TencentCloudChat::SendC2CCustomMessage(const V2TIMBuffer &customData, FStringView userID,
+												   V2TIMSendCallback *callback)
+{
+	return SendC2CCustomMessage(customData, TencentCloudChatString::ToV2TIM(userID), callback);
+}
+
+V2TIMString TencentCloudChat::SendGroupTextMessage(FStringView text, FStringView groupID,
+												   V2TIMMessagePriority priority,
+												   V2TIMSendCallback *callback)
+{
+	return SendGroupTextMessage(TencentCloudChatString::ToV2TIM(text), TencentCloudChatString::ToV2TIM(groupID), priority, callback);
+}
+
+V2TIMString TencentCloudChat::SendGroupCustomMessage(const V2TIMBuffer &customData, FStringView groupID,
+													 V2TIMMessagePriority priority,
+													 V2TIMSendCallback *callback)
+{
+	return SendGroupCustomMessage(customData, TencentCloudChatString::ToV2TIM(groupID), priority, callback);
+}
+
+void TencentCloudChat::JoinGroup(FStringView groupID, FStringView message, V2TIMCallback *callback)
+{
+	JoinGroup(TencentCloudChatString::ToV2TIM(groupID), TencentCloudChatString::ToV2TIM(message), callback);
+}
+
+void TencentCloudChat::QuitGroup(FStringView groupID, V2TIMCallback *callback)
+{
+	QuitGroup(TencentCloudChatString::ToV2TIM(groupID), callback);
+}
+
+V2TIMMessage TencentCloudChat::CreateTextMessage(FStringView text)
+{
+	return CreateTextMessage(TencentCloudChatString::ToV2TIM(text));
+}
+
+V2TIMString TencentCloudChat::SendMessage(V2TIMMessage &message, FStringView receiver,
+										  FStringView groupID, V2TIMMessagePriority priority,
+										  bool onlineUserOnly,
+										  const V2TIMOfflinePushInfo &offlinePushInfo,
+										  V2TIMSendCallback *callback)
+{
+	return SendMessage(message, TencentCloudChatString::ToV2TIM(receiver), TencentCloudChatString::ToV2TIM(groupID),
+					   priority, onlineUserOnly, offlinePushInfo, callback);
+}
+
+void TencentCloudChat::MarkC2CMessageAsRead(FStringView userID, V2TIMCallback *callback)
+{
+	MarkC2CMessageAsRead(TencentCloudChatString::ToV2TIM(userID), callback);
+}
+
+void TencentCloudChat::MarkGroupMessageAsRead(FStringView groupID, V2TIMCallback *callback)
+{
+	MarkGroupMessageAsRead(TencentCloudChatString::ToV2TIM(groupID), callback);
+}
+
+void TencentCloudChat::GetUsersInfo(TConstArrayView<FString> userIDList,
+									V2TIMValueCallback<V2TIMUserFullInfoVector> *callback)
+{
+	GetUsersInfo(TencentCloudChatVector::ToV2TIM(userIDList), callback);
+}
+
+void TencentCloudChat::SubscribeUserStatus(TConstArrayView<FString> userIDList, V2TIMCallback *callback)
+{
+	SubscribeUserStatus(TencentCloudChatVector::ToV2TIM(userIDList), callback);
+}
+
+void TencentCloudChat::KickGroupMember(FStringView groupID, TConstArrayView<FString> memberList, FStringView reason,
+									   V2TIMValueCallback<V2TIMGroupMemberOperationResultVector> *callback)
+{
+	KickGroupMember(TencentCloudChatString::ToV2TIM(groupID), TencentCloudChatVector::ToV2TIM(memberList),
+					TencentCloudChatString::ToV2TIM(reason), callback);
+}
+
 #undef LOCTEXT_NAMESPACE
 
 IMPLEMENT_MODULE(TencentCloudChat, TencentCloudChat)
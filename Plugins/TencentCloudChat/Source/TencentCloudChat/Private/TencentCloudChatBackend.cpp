@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatPrivate.h"
+
+namespace
+{
+	TAtomic<V2TIMManager *> BackendOverride(nullptr);
+	thread_local V2TIMManager *BackendThreadOverride = nullptr;
+}
+
+V2TIMManager *TencentCloudChatBackend::Get()
+{
+	if (BackendThreadOverride)
+	{
+		return BackendThreadOverride;
+	}
+	V2TIMManager *Manager = BackendOverride.Load(EMemoryOrder::Relaxed);
+	return Manager ? Manager : V2TIMManager::GetInstance();
+}
+
+void TencentCloudChatBackend::Set(V2TIMManager *manager)
+{
+	BackendOverride = manager;
+	UE_LOG(LogTencentCloudChat, Log, TEXT("TencentCloudChat backend: %s"), manager ? TEXT("override") : TEXT("SDK"));
+}
+
+bool TencentCloudChatBackend::IsOverridden()
+{
+	return BackendOverride.Load(EMemoryOrder::Relaxed) != nullptr;
+}
+
+bool TencentCloudChatBackend::HasThreadOverride()
+{
+	return BackendThreadOverride != nullptr;
+}
+
+V2TIMManager *TencentCloudChatBackend::ExchangeThreadOverride(V2TIMManager *manager)
+{
+	V2TIMManager *Previous = BackendThreadOverride;
+	BackendThreadOverride = manager;
+	return Previous;
+}
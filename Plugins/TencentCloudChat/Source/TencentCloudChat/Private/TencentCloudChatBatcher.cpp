@@ -0,0 +1,403 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatBatcher.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatCompression.h"
+#include "TencentCloudChatMessageForwarder.h"
+#include "TencentCloudChatPrivate.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/StringBuilder.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batch Payloads Queued"), STAT_TencentCloudChat_BatchPayloads, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batch Messages Sent"), STAT_TencentCloudChat_BatchMessages, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<float> CVarBatchWindowMs(
+	TEXT("TencentCloudChat.Batch.WindowMs"),
+	50.0f,
+	TEXT("How long TencentCloudChatBatcher holds group custom messages before sending them as one message, in milliseconds.\n")
+	TEXT("<= 0 sends on the next tick."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarBatchMaxBytes(
+	TEXT("TencentCloudChat.Batch.MaxBytes"),
+	TencentCloudChatBatcher::MaxMessageBytes,
+	TEXT("Maximum size of a batched group custom message in bytes, including framing. Clamped to 12KB."),
+	ECVF_Default);
+
+/////////////////////////////////////////////////////////////////////////////////
+//
+//                         帧格式
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * | 'T' 'C' 'B' '1' | 条数 uint16 | 长度 uint16 | 内容 | 长度 uint16 | 内容 | ...
+ *
+ * 整数均为小端序；单条消息不超过 12KB，uint16 足够表示长度。
+ */
+namespace
+{
+	constexpr uint8 FrameMagic[4] = { 'T', 'C', 'B', '1' };
+	constexpr int32 FrameHeaderBytes = sizeof(FrameMagic) + sizeof(uint16);
+	constexpr int32 FrameLengthBytes = sizeof(uint16);
+
+	void WriteUInt16(uint8 *dest, uint16 value)
+	{
+		dest[0] = uint8(value & 0xFF);
+		dest[1] = uint8(value >> 8);
+	}
+
+	uint16 ReadUInt16(const uint8 *src)
+	{
+		return uint16(src[0]) | (uint16(src[1]) << 8);
+	}
+
+	int32 GetMaxBytes()
+	{
+		return FMath::Clamp(CVarBatchMaxBytes.GetValueOnAnyThread(), FrameHeaderBytes + FrameLengthBytes + 1, TencentCloudChatBatcher::MaxMessageBytes);
+	}
+}
+
+bool TencentCloudChatBatcher::DecodeFrame(TConstArrayView<uint8> data, TArray<TConstArrayView<uint8>> &outPayloads)
+{
+	if (data.Num() < FrameHeaderBytes || FMemory::Memcmp(data.GetData(), FrameMagic, sizeof(FrameMagic)) != 0)
+	{
+		return false;
+	}
+
+	const int32 Count = ReadUInt16(data.GetData() + sizeof(FrameMagic));
+	if (Count == 0)
+	{
+		return false;
+	}
+
+	const int32 FirstOut = outPayloads.Num();
+	int32 Offset = FrameHeaderBytes;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (Offset + FrameLengthBytes > data.Num())
+		{
+			outPayloads.SetNum(FirstOut);
+			return false;
+		}
+		const int32 Length = ReadUInt16(data.GetData() + Offset);
+		Offset += FrameLengthBytes;
+		if (Offset + Length > data.Num())
+		{
+			outPayloads.SetNum(FirstOut);
+			return false;
+		}
+		outPayloads.Emplace(data.GetData() + Offset, Length);
+		Offset += Length;
+	}
+
+	// 必须恰好用完全部数据，避免把碰巧以帧头开头的普通消息当成合并消息
+	if (Offset != data.Num())
+	{
+		outPayloads.SetNum(FirstOut);
+		return false;
+	}
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+//
+//                         发送端
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct PendingBatch
+	{
+		V2TIMMessagePriority Priority = V2TIM_PRIORITY_DEFAULT;
+		// 帧头在发送时补上条数
+		TArray<uint8> Frame;
+		int32 Count = 0;
+		TArray<V2TIMSendCallback *> Callbacks;
+		double FirstQueuedTime = 0.0;
+	};
+
+	struct ReadyBatch
+	{
+		V2TIMString GroupID;
+		PendingBatch Batch;
+	};
+
+	FCriticalSection BatchPendingMutex;
+	TMap<V2TIMString, PendingBatch> BatchPendingBatches;
+	FTSTicker::FDelegateHandle BatchTickHandle;
+
+	void SendReady(ReadyBatch &&ready)
+	{
+		PendingBatch &Batch = ready.Batch;
+		INC_DWORD_STAT(STAT_TencentCloudChat_BatchMessages);
+
+		TConstArrayView<uint8> Payload;
+		if (Batch.Count == 1)
+		{
+			Payload = TConstArrayView<uint8>(Batch.Frame.GetData() + FrameHeaderBytes + FrameLengthBytes, Batch.Frame.Num() - FrameHeaderBytes - FrameLengthBytes);
+		}
+		else
+		{
+			WriteUInt16(Batch.Frame.GetData() + sizeof(FrameMagic), uint16(Batch.Count));
+			Payload = Batch.Frame;
+		}
+		const V2TIMBuffer Data = TencentCloudChatCompression::ShouldCompressBatches() ? TencentCloudChatCompression::ToBuffer(Payload)
+																					   : V2TIMBuffer(Payload.GetData(), Payload.Num());
+
+		V2TIMSendCallback *Callback = nullptr;
+		Batch.Callbacks.Remove(nullptr);
+		if (Batch.Callbacks.Num() == 1)
+		{
+			Callback = Batch.Callbacks[0];
+		}
+		else if (Batch.Callbacks.Num() > 1)
+		{
+			Callback = TencentCloudChatSendCallback::Create(
+				[Callbacks = Batch.Callbacks](const V2TIMMessage &message)
+				{
+					for (V2TIMSendCallback *Each : Callbacks)
+					{
+						Each->OnSuccess(message);
+					}
+				},
+				[Callbacks = Batch.Callbacks](int error_code, const V2TIMString &error_message)
+				{
+					for (V2TIMSendCallback *Each : Callbacks)
+					{
+						Each->OnError(error_code, error_message);
+					}
+				},
+				[Callbacks = Batch.Callbacks](uint32_t progress)
+				{
+					for (V2TIMSendCallback *Each : Callbacks)
+					{
+						Each->OnProgress(progress);
+					}
+				});
+		}
+
+		TencentCloudChat::SendGroupCustomMessage(Data, ready.GroupID, Batch.Priority, Callback);
+	}
+
+	/**
+	 * 在持有 BatchPendingMutex 时调用，把 groupID 已缓存的消息移到 outReady
+	 */
+	void TakePendingBatch(const V2TIMString &groupID, TArray<ReadyBatch> &outReady)
+	{
+		PendingBatch Batch;
+		if (BatchPendingBatches.RemoveAndCopyValue(groupID, Batch))
+		{
+			outReady.Add({ groupID, MoveTemp(Batch) });
+		}
+	}
+
+	void SendReadyBatches(TArray<ReadyBatch> &ready)
+	{
+		for (ReadyBatch &Ready : ready)
+		{
+			SendReady(MoveTemp(Ready));
+		}
+	}
+}
+
+void TencentCloudChatBatcher::SendGroupCustomMessage(const V2TIMBuffer &customData, const V2TIMString &groupID,
+													  V2TIMMessagePriority priority, V2TIMSendCallback *callback)
+{
+	const int32 PayloadBytes = static_cast<int32>(customData.Size());
+	const int32 MaxBytes = GetMaxBytes();
+
+	// SDK 调用放在锁外面，按加入 Ready 的顺序发出
+	TArray<ReadyBatch> Ready;
+	bool bSendDirectly = false;
+	{
+		FScopeLock Lock(&BatchPendingMutex);
+
+		PendingBatch *Batch = BatchPendingBatches.Find(groupID);
+		if (Batch && (Batch->Priority != priority || Batch->Frame.Num() + FrameLengthBytes + PayloadBytes > MaxBytes))
+		{
+			TakePendingBatch(groupID, Ready);
+			Batch = nullptr;
+		}
+
+		if (FrameHeaderBytes + FrameLengthBytes + PayloadBytes > MaxBytes)
+		{
+			bSendDirectly = true;
+		}
+		else
+		{
+			if (!Batch)
+			{
+				Batch = &BatchPendingBatches.Add(groupID);
+				Batch->Priority = priority;
+				Batch->FirstQueuedTime = FPlatformTime::Seconds();
+				Batch->Frame.Reserve(MaxBytes);
+				Batch->Frame.Append(FrameMagic, sizeof(FrameMagic));
+				Batch->Frame.AddZeroed(sizeof(uint16));
+			}
+
+			const int32 Offset = Batch->Frame.AddUninitialized(FrameLengthBytes + PayloadBytes);
+			WriteUInt16(Batch->Frame.GetData() + Offset, uint16(PayloadBytes));
+			FMemory::Memcpy(Batch->Frame.GetData() + Offset + FrameLengthBytes, customData.Data(), PayloadBytes);
+			++Batch->Count;
+			Batch->Callbacks.Add(callback);
+			INC_DWORD_STAT(STAT_TencentCloudChat_BatchPayloads);
+		}
+	}
+
+	SendReadyBatches(Ready);
+	if (bSendDirectly)
+	{
+		if (TencentCloudChatCompression::ShouldCompressBatches())
+		{
+			TencentCloudChatCompression::SendGroupCustomMessage(customData, groupID, priority, callback);
+		}
+		else
+		{
+			TencentCloudChat::SendGroupCustomMessage(customData, groupID, priority, callback);
+		}
+	}
+}
+
+void TencentCloudChatBatcher::Flush(const V2TIMString &groupID)
+{
+	TArray<ReadyBatch> Ready;
+	{
+		FScopeLock Lock(&BatchPendingMutex);
+		TakePendingBatch(groupID, Ready);
+	}
+	SendReadyBatches(Ready);
+}
+
+void TencentCloudChatBatcher::FlushAll()
+{
+	TArray<ReadyBatch> Ready;
+	{
+		FScopeLock Lock(&BatchPendingMutex);
+		for (TPair<V2TIMString, PendingBatch> &Pair : BatchPendingBatches)
+		{
+			Ready.Add({ Pair.Key, MoveTemp(Pair.Value) });
+		}
+		BatchPendingBatches.Reset();
+	}
+	SendReadyBatches(Ready);
+}
+
+void TencentCloudChatBatcher::Startup()
+{
+	BatchTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float)
+	{
+		const double Deadline = FPlatformTime::Seconds() - FMath::Max(CVarBatchWindowMs.GetValueOnGameThread(), 0.0f) / 1000.0;
+
+		TArray<ReadyBatch> Ready;
+		{
+			FScopeLock Lock(&BatchPendingMutex);
+			for (auto It = BatchPendingBatches.CreateIterator(); It; ++It)
+			{
+				if (It->Value.FirstQueuedTime <= Deadline)
+				{
+					Ready.Add({ It->Key, MoveTemp(It->Value) });
+					It.RemoveCurrent();
+				}
+			}
+		}
+		SendReadyBatches(Ready);
+		return true;
+	}));
+}
+
+void TencentCloudChatBatcher::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(BatchTickHandle);
+	BatchTickHandle.Reset();
+
+	FlushAll();
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+//
+//                         接收端
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+bool TencentCloudChatBatcher::Unbatch(const V2TIMMessage &message, TArray<V2TIMMessage> &outMessages)
+{
+	const V2TIMCustomElem *CustomElem = TencentCloudChatCustomPayload::GetSingleCustomElem(message);
+	if (!CustomElem)
+	{
+		return false;
+	}
+
+	// 发送端先合并再压缩，接收端先解压再拆分
+	TArray<uint8> Decompressed;
+	TConstArrayView<uint8> Data = TencentCloudChatCustomPayload::GetData(*CustomElem);
+	if (TencentCloudChatCompression::IsCompressed(Data))
+	{
+		if (!TencentCloudChatCompression::Decompress(Data, Decompressed))
+		{
+			return false;
+		}
+		Data = Decompressed;
+	}
+
+	TArray<TConstArrayView<uint8>> Decoded;
+	if (!DecodeFrame(Data, Decoded))
+	{
+		return false;
+	}
+
+	outMessages.Reserve(outMessages.Num() + Decoded.Num());
+	for (int32 Index = 0; Index < Decoded.Num(); ++Index)
+	{
+		V2TIMMessage &Out = outMessages.Add_GetRef(TencentCloudChatCustomPayload::Rebuild(message, *CustomElem, Decoded[Index]));
+		// msgID 按字节拼接，不需要经过 TCHAR
+		TAnsiStringBuilder<128> MsgID;
+		MsgID << message.msgID.CString() << '#' << Index;
+		Out.msgID = V2TIMString(MsgID.GetData(), MsgID.Len());
+	}
+	return true;
+}
+
+namespace
+{
+	/**
+	 * 把合并消息拆开后逐条转发给 Target，未合并的消息按 TencentCloudChatCompression 的规则解压后转发
+	 */
+	class UnbatchingListener : public TencentCloudChatAdvancedMsgForwarder
+	{
+	public:
+		using TencentCloudChatAdvancedMsgForwarder::TencentCloudChatAdvancedMsgForwarder;
+
+		void OnRecvNewMessage(const V2TIMMessage &message) override
+		{
+			EventScope Scope(*this);
+			TArray<V2TIMMessage> Messages;
+			if (TencentCloudChatBatcher::Unbatch(message, Messages))
+			{
+				for (const V2TIMMessage &Each : Messages)
+				{
+					Target->OnRecvNewMessage(Each);
+				}
+				return;
+			}
+
+			V2TIMMessage Decompressed;
+			Target->OnRecvNewMessage(TencentCloudChatCompression::DecompressMessage(message, Decompressed) ? Decompressed : message);
+		}
+	};
+
+	using UnbatchingListeners = TencentCloudChatAdvancedMsgForwarderRegistry<UnbatchingListener>;
+}
+
+void TencentCloudChatBatcher::AddAdvancedMsgListener(V2TIMAdvancedMsgListener *listener)
+{
+	UnbatchingListeners::Add(listener);
+}
+
+void TencentCloudChatBatcher::RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *listener)
+{
+	UnbatchingListeners::Remove(listener);
+}
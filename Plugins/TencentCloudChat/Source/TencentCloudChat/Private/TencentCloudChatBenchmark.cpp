@@ -0,0 +1,305 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatBenchmark.h"
+
+#if TENCENTCLOUDCHAT_WITH_BENCHMARKS
+
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatString.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+static TAutoConsoleVariable<float> CVarBenchMinTimeMs(
+	TEXT("TencentCloudChat.Bench.MinTimeMs"),
+	200.0f,
+	TEXT("Minimum measured time per TencentCloudChat benchmark case, in milliseconds."),
+	ECVF_Default);
+
+namespace
+{
+	struct BenchCase
+	{
+		FString Name;
+		TencentCloudChatBenchmark::BenchFunc Func;
+		TencentCloudChatBenchmark::TeardownFunc Teardown;
+	};
+
+	TArray<BenchCase> &GetCases()
+	{
+		static TArray<BenchCase> Cases;
+		return Cases;
+	}
+
+	volatile int64 GBenchSink = 0;
+
+	// 当前用例调用 Skip 时设置；基准只在调用 TencentCloudChat.Bench 的线程上运行
+	FString GBenchSkipReason;
+
+	/**
+	 * 转发到原 GMalloc，只统计基准线程上的分配次数
+	 *
+	 * 对象永不释放：恢复 GMalloc 之后其他线程可能仍持有它的指针。
+	 */
+	class CountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc *Inner = nullptr;
+		uint32 ThreadId = 0;
+		int64 Allocs = 0;
+
+		void *Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Record();
+			return Inner->Malloc(Count, Alignment);
+		}
+		void *Realloc(void *Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				Record();
+			}
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+		void Free(void *Original) override
+		{
+			Inner->Free(Original);
+		}
+		SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Count, Alignment);
+		}
+		bool GetAllocationSize(void *Original, SIZE_T &SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+		bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+		const TCHAR *GetDescriptiveName() override
+		{
+			return TEXT("TencentCloudChatCountingMalloc");
+		}
+
+	private:
+		void Record()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				++Allocs;
+			}
+		}
+	};
+
+	CountingMalloc &GetCountingMalloc()
+	{
+		static CountingMalloc *Instance = new CountingMalloc();
+		return *Instance;
+	}
+
+	/**
+	 * 执行 Iterations 次，返回耗时（秒）和分配次数（无法统计时为 -1）
+	 */
+	double Measure(const TencentCloudChatBenchmark::BenchFunc &Func, int64 Iterations, int64 &OutAllocs)
+	{
+		CountingMalloc &Counter = GetCountingMalloc();
+		Counter.Inner = GMalloc;
+		Counter.ThreadId = FPlatformTLS::GetCurrentThreadId();
+		Counter.Allocs = 0;
+
+		FMalloc *Previous = GMalloc;
+		GMalloc = &Counter;
+
+		// 有的平台会绕过 GMalloc 直接调用固定的分配器，此时无法统计
+		FMemory::Free(FMemory::Malloc(16));
+		const bool bCanCount = Counter.Allocs > 0;
+		Counter.Allocs = 0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		Func(Iterations);
+		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+		GMalloc = Previous;
+		OutAllocs = bCanCount ? Counter.Allocs : -1;
+		return Elapsed;
+	}
+}
+
+void TencentCloudChatBenchmark::Register(const TCHAR *name, BenchFunc &&func, TeardownFunc &&teardown)
+{
+	GetCases().Add({ FString(name), MoveTemp(func), MoveTemp(teardown) });
+}
+
+void TencentCloudChatBenchmark::Skip(const FString &reason)
+{
+	if (GBenchSkipReason.IsEmpty())
+	{
+		GBenchSkipReason = reason.IsEmpty() ? FString(TEXT("skipped")) : reason;
+	}
+}
+
+void TencentCloudChatBenchmark::Sink(int64 value)
+{
+	GBenchSink = GBenchSink + value;
+}
+
+TArray<TencentCloudChatBenchmarkResult> TencentCloudChatBenchmark::Run(const FString &filter)
+{
+	const double MinTime = FMath::Max(CVarBenchMinTimeMs.GetValueOnAnyThread(), 1.0f) / 1000.0;
+
+	TArray<TencentCloudChatBenchmarkResult> Results;
+	for (const BenchCase &Case : GetCases())
+	{
+		if (!filter.IsEmpty() && !Case.Name.Contains(filter))
+		{
+			continue;
+		}
+
+		// 预热，让线程局部缓冲区和对象池进入稳定状态
+		GBenchSkipReason.Reset();
+		Case.Func(1);
+
+		int64 Iterations = 1;
+		int64 Allocs = 0;
+		double Elapsed = 0.0;
+		if (GBenchSkipReason.IsEmpty())
+		{
+			Elapsed = Measure(Case.Func, Iterations, Allocs);
+			while (GBenchSkipReason.IsEmpty() && Elapsed < MinTime && Iterations < (int64(1) << 30))
+			{
+				Iterations *= 2;
+				Elapsed = Measure(Case.Func, Iterations, Allocs);
+			}
+		}
+		if (Case.Teardown)
+		{
+			Case.Teardown();
+		}
+
+		TencentCloudChatBenchmarkResult &Result = Results.AddDefaulted_GetRef();
+		Result.Name = Case.Name;
+		if (!GBenchSkipReason.IsEmpty())
+		{
+			Result.bSkipped = true;
+			Result.SkipReason = MoveTemp(GBenchSkipReason);
+			GBenchSkipReason.Reset();
+			continue;
+		}
+		Result.Iterations = Iterations;
+		Result.NsPerOp = Elapsed * 1e9 / double(Iterations);
+		Result.AllocsPerOp = Allocs >= 0 ? double(Allocs) / double(Iterations) : -1.0;
+	}
+	return Results;
+}
+
+FString TencentCloudChatBenchmark::ToJson(const TArray<TencentCloudChatBenchmarkResult> &results)
+{
+	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TencentCloudChat"));
+
+	FString Json;
+	const TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Writer->WriteValue(TEXT("pluginVersion"), Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : FString());
+	Writer->WriteValue(TEXT("sdkVersion"), TencentCloudChatString::ToFString(TencentCloudChatBackend::Get()->GetVersion()));
+	Writer->WriteValue(TEXT("backend"), TencentCloudChatBackend::IsOverridden() ? TEXT("override") : TEXT("sdk"));
+	Writer->WriteValue(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Writer->WriteValue(TEXT("platform"), FString(FPlatformProperties::IniPlatformName()));
+	Writer->WriteValue(TEXT("buildConfiguration"), FString(LexToString(FApp::GetBuildConfiguration())));
+	Writer->WriteValue(TEXT("minTimeMs"), double(CVarBenchMinTimeMs.GetValueOnAnyThread()));
+	Writer->WriteArrayStart(TEXT("results"));
+	for (const TencentCloudChatBenchmarkResult &Result : results)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Result.Name);
+		if (Result.bSkipped)
+		{
+			Writer->WriteValue(TEXT("skipped"), true);
+			Writer->WriteValue(TEXT("reason"), Result.SkipReason);
+		}
+		else
+		{
+			Writer->WriteValue(TEXT("iterations"), Result.Iterations);
+			Writer->WriteValue(TEXT("nsPerOp"), Result.NsPerOp);
+			Writer->WriteValue(TEXT("opsPerSec"), Result.NsPerOp > 0.0 ? 1e9 / Result.NsPerOp : 0.0);
+			if (Result.AllocsPerOp >= 0.0)
+			{
+				Writer->WriteValue(TEXT("allocsPerOp"), Result.AllocsPerOp);
+			}
+			else
+			{
+				Writer->WriteNull(TEXT("allocsPerOp"));
+			}
+		}
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	return Json;
+}
+
+static FAutoConsoleCommand GTencentCloudChatBenchCommand(
+	TEXT("TencentCloudChat.Bench"),
+	TEXT("Run TencentCloudChat micro-benchmarks. Usage: TencentCloudChat.Bench [NameFilter] [-json[=Path]]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString> &Args)
+	{
+		FString Filter;
+		FString JsonPath;
+		bool bJson = false;
+		for (const FString &Arg : Args)
+		{
+			if (Arg.StartsWith(TEXT("-json")))
+			{
+				bJson = true;
+				Arg.Split(TEXT("="), nullptr, &JsonPath);
+			}
+			else
+			{
+				Filter = Arg;
+			}
+		}
+
+		const TArray<TencentCloudChatBenchmarkResult> Results = TencentCloudChatBenchmark::Run(Filter);
+
+		UE_LOG(LogTencentCloudChat, Display, TEXT("%-56s %12s %12s %12s"), TEXT("Benchmark"), TEXT("Iterations"), TEXT("ns/op"), TEXT("allocs/op"));
+		for (const TencentCloudChatBenchmarkResult &Result : Results)
+		{
+			if (Result.bSkipped)
+			{
+				UE_LOG(LogTencentCloudChat, Display, TEXT("%-56s skipped: %s"), *Result.Name, *Result.SkipReason);
+				continue;
+			}
+			UE_LOG(LogTencentCloudChat, Display, TEXT("%-56s %12lld %12.1f %12s"), *Result.Name, Result.Iterations, Result.NsPerOp,
+				   Result.AllocsPerOp >= 0.0 ? *FString::Printf(TEXT("%.2f"), Result.AllocsPerOp) : TEXT("n/a"));
+		}
+
+		if (bJson)
+		{
+			if (JsonPath.IsEmpty())
+			{
+				JsonPath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("TencentCloudChat"),
+										   FString::Printf(TEXT("Bench-%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+			}
+			if (FFileHelper::SaveStringToFile(TencentCloudChatBenchmark::ToJson(Results), *JsonPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+			{
+				UE_LOG(LogTencentCloudChat, Display, TEXT("Benchmark results written to %s"), *FPaths::ConvertRelativePathToFull(JsonPath));
+			}
+			else
+			{
+				UE_LOG(LogTencentCloudChat, Warning, TEXT("Failed to write benchmark results to %s"), *JsonPath);
+			}
+		}
+	}));
+
+#endif // TENCENTCLOUDCHAT_WITH_BENCHMARKS
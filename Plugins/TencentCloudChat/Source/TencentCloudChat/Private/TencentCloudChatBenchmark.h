@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#ifndef TENCENTCLOUDCHAT_WITH_BENCHMARKS
+#define TENCENTCLOUDCHAT_WITH_BENCHMARKS !UE_BUILD_SHIPPING
+#endif
+
+#if TENCENTCLOUDCHAT_WITH_BENCHMARKS
+
+struct TencentCloudChatBenchmarkResult
+{
+	FString Name;
+	int64 Iterations = 0;
+	double NsPerOp = 0.0;
+	// 每次操作在 UE 堆（GMalloc）上的分配次数，无法统计时为负数；SDK 内部的分配不经过 GMalloc，不计入
+	double AllocsPerOp = -1.0;
+	// 用例调用了 TencentCloudChatBenchmark::Skip，此时只有 Name 和 SkipReason 有效
+	bool bSkipped = false;
+	FString SkipReason;
+};
+
+/**
+ * 插件内部的微基准
+ *
+ * 用例通过 TencentCloudChatBenchmark::Registrar 静态注册，控制台执行 TencentCloudChat.Bench [过滤串] [-json[=路径]] 运行，
+ * 结果输出到日志；带 -json 时同时写入 JSON 文件（默认在 Saved/Profiling/TencentCloudChat 下），用于跨插件版本比较。
+ * 每个用例先预热一次，再倍增迭代次数直到单轮耗时超过 TencentCloudChat.Bench.MinTimeMs；计时期间统计本线程的 GMalloc 分配次数。
+ * 预热时准备数据的用例可以注册 teardown，在用例测完后清理。
+ */
+class TencentCloudChatBenchmark
+{
+public:
+	using BenchFunc = TFunction<void(int64 /* iterations */)>;
+	using TeardownFunc = TFunction<void()>;
+
+	struct Registrar
+	{
+		Registrar(const TCHAR *name, BenchFunc &&func, TeardownFunc &&teardown = nullptr)
+		{
+			Register(name, MoveTemp(func), MoveTemp(teardown));
+		}
+	};
+
+	static void Register(const TCHAR *name, BenchFunc &&func, TeardownFunc &&teardown = nullptr);
+
+	/**
+	 * 运行名字包含 filter 的用例，filter 为空时运行全部
+	 */
+	static TArray<TencentCloudChatBenchmarkResult> Run(const FString &filter);
+
+	/**
+	 * 由用例在运行条件不满足（例如需要登录）或中途失败时调用，当前用例的结果标记为跳过
+	 */
+	static void Skip(const FString &reason);
+
+	/**
+	 * 结果和运行环境（插件、SDK、引擎版本，平台，构建配置）的 JSON
+	 */
+	static FString ToJson(const TArray<TencentCloudChatBenchmarkResult> &results);
+
+	/**
+	 * 把结果累加到一个 volatile 变量上，防止编译器把被测代码优化掉
+	 */
+	static void Sink(int64 value);
+};
+
+#endif // TENCENTCLOUDCHAT_WITH_BENCHMARKS
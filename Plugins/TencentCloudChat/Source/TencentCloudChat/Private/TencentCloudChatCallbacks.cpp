@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatPrivate.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Callback Pool Capacity"), STAT_TencentCloudChat_CallbackPoolCapacity, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Callback Pool Hits"), STAT_TencentCloudChat_CallbackPoolHits, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Callback Pool Misses"), STAT_TencentCloudChat_CallbackPoolMisses, STATGROUP_TencentCloudChat);
+
+namespace
+{
+	TAtomic<int32> TotalCapacity(0);
+	TAtomic<uint64> TotalHits(0);
+	TAtomic<uint64> TotalMisses(0);
+}
+
+TencentCloudChatCallbackPoolStats TencentCloudChatCallbackPools::GetTotalStats()
+{
+	TencentCloudChatCallbackPoolStats Stats;
+	Stats.Capacity = TotalCapacity.Load();
+	Stats.Hits = TotalHits.Load();
+	Stats.Misses = TotalMisses.Load();
+	return Stats;
+}
+
+void TencentCloudChatCallbackPools::RecordCapacity(int32 capacity)
+{
+	TotalCapacity += capacity;
+	INC_DWORD_STAT_BY(STAT_TencentCloudChat_CallbackPoolCapacity, capacity);
+}
+
+void TencentCloudChatCallbackPools::RecordHit()
+{
+	++TotalHits;
+	INC_DWORD_STAT(STAT_TencentCloudChat_CallbackPoolHits);
+}
+
+void TencentCloudChatCallbackPools::RecordMiss()
+{
+	++TotalMisses;
+	INC_DWORD_STAT(STAT_TencentCloudChat_CallbackPoolMisses);
+}
@@ -0,0 +1,428 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatCodec.h"
+#include "TencentCloudChatString.h"
+
+namespace
+{
+	constexpr uint8 CodecMagic = 0xC7;
+
+	enum ECodecWireType : uint8
+	{
+		WireVarint = 0,
+		WireFixed32 = 1,
+		WireFixed64 = 2,
+		WireLengthDelimited = 3,
+		WireDeltaArray = 4,
+	};
+
+	int32 VarintSize(uint64 value)
+	{
+		int32 Size = 1;
+		while (value >= 0x80)
+		{
+			value >>= 7;
+			++Size;
+		}
+		return Size;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+//
+//                         Schema
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+TencentCloudChatCodecSchema &&TencentCloudChatCodecSchema::Field(uint32 id, const TCHAR *name, ETencentCloudChatCodecType type) &&
+{
+	static_cast<TencentCloudChatCodecSchema &>(*this).Field(id, name, type);
+	return MoveTemp(*this);
+}
+
+TencentCloudChatCodecSchema &TencentCloudChatCodecSchema::Field(uint32 id, const TCHAR *name, ETencentCloudChatCodecType type) &
+{
+	checkf(id > 0 && id < (1u << 28), TEXT("TencentCloudChatCodecSchema %u: field id %u out of range"), Id, id);
+	checkf(!FindField(id), TEXT("TencentCloudChatCodecSchema %u: duplicate field id %u"), Id, id);
+	Fields.Add({ id, name, type });
+	return *this;
+}
+
+const TencentCloudChatCodecSchema::FieldDef *TencentCloudChatCodecSchema::FindField(uint32 id) const
+{
+	return Fields.FindByPredicate([id](const FieldDef &Def) { return Def.Id == id; });
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+//
+//                         Writer
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+TencentCloudChatCodecWriter::TencentCloudChatCodecWriter(const TencentCloudChatCodecSchema &schema)
+	: Schema(schema)
+{
+	Reset();
+}
+
+void TencentCloudChatCodecWriter::Reset()
+{
+	Data.Reset();
+	Data.Add(CodecMagic);
+	WriteVarint(Schema.GetId());
+	WriteVarint(Schema.GetVersion());
+}
+
+void TencentCloudChatCodecWriter::WriteVarint(uint64 value)
+{
+	while (value >= 0x80)
+	{
+		Data.Add(uint8(value) | 0x80);
+		value >>= 7;
+	}
+	Data.Add(uint8(value));
+}
+
+void TencentCloudChatCodecWriter::WriteKey(uint32 field, ETencentCloudChatCodecType type, uint8 wireType)
+{
+	const TencentCloudChatCodecSchema::FieldDef *Def = Schema.FindField(field);
+	checkf(Def && Def->Type == type, TEXT("TencentCloudChatCodecSchema %u: field %u is not declared with this type"), Schema.GetId(), field);
+	WriteVarint((uint64(field) << 3) | wireType);
+}
+
+void TencentCloudChatCodecWriter::WriteBool(uint32 field, bool value)
+{
+	WriteKey(field, ETencentCloudChatCodecType::Bool, WireVarint);
+	Data.Add(value ? 1 : 0);
+}
+
+void TencentCloudChatCodecWriter::WriteInt(uint32 field, int64 value)
+{
+	WriteKey(field, ETencentCloudChatCodecType::Int, WireVarint);
+	WriteVarint(TencentCloudChatVarint::ZigZagEncode(value));
+}
+
+void TencentCloudChatCodecWriter::WriteUInt(uint32 field, uint64 value)
+{
+	WriteKey(field, ETencentCloudChatCodecType::UInt, WireVarint);
+	WriteVarint(value);
+}
+
+void TencentCloudChatCodecWriter::WriteFloat(uint32 field, float value)
+{
+	WriteKey(field, ETencentCloudChatCodecType::Float, WireFixed32);
+	uint32 Bits;
+	FMemory::Memcpy(&Bits, &value, sizeof(Bits));
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		Data.Add(uint8(Bits >> (Index * 8)));
+	}
+}
+
+void TencentCloudChatCodecWriter::WriteDouble(uint32 field, double value)
+{
+	WriteKey(field, ETencentCloudChatCodecType::Double, WireFixed64);
+	uint64 Bits;
+	FMemory::Memcpy(&Bits, &value, sizeof(Bits));
+	for (int32 Index = 0; Index < 8; ++Index)
+	{
+		Data.Add(uint8(Bits >> (Index * 8)));
+	}
+}
+
+void TencentCloudChatCodecWriter::WriteString(uint32 field, FStringView value)
+{
+	const FUtf8StringView Utf8 = TencentCloudChatString::ToScratchUtf8(value);
+	WriteKey(field, ETencentCloudChatCodecType::String, WireLengthDelimited);
+	WriteVarint(Utf8.Len());
+	Data.Append(reinterpret_cast<const uint8 *>(Utf8.GetData()), Utf8.Len());
+}
+
+void TencentCloudChatCodecWriter::WriteString(uint32 field, FUtf8StringView value)
+{
+	WriteKey(field, ETencentCloudChatCodecType::String, WireLengthDelimited);
+	WriteVarint(value.Len());
+	Data.Append(reinterpret_cast<const uint8 *>(value.GetData()), value.Len());
+}
+
+void TencentCloudChatCodecWriter::WriteBytes(uint32 field, TConstArrayView<uint8> value)
+{
+	WriteKey(field, ETencentCloudChatCodecType::Bytes, WireLengthDelimited);
+	WriteVarint(value.Num());
+	Data.Append(value.GetData(), value.Num());
+}
+
+void TencentCloudChatCodecWriter::WriteIntArray(uint32 field, TConstArrayView<int64> values)
+{
+	WriteKey(field, ETencentCloudChatCodecType::IntArray, WireDeltaArray);
+
+	// 先算出编码后的长度，写入长度前缀后直接写内容，不需要临时缓冲区
+	int32 EncodedSize = 0;
+	int64 Previous = 0;
+	for (int64 Value : values)
+	{
+		EncodedSize += VarintSize(TencentCloudChatVarint::ZigZagEncode(Value - Previous));
+		Previous = Value;
+	}
+
+	WriteVarint(EncodedSize);
+	Data.Reserve(Data.Num() + EncodedSize);
+	Previous = 0;
+	for (int64 Value : values)
+	{
+		WriteVarint(TencentCloudChatVarint::ZigZagEncode(Value - Previous));
+		Previous = Value;
+	}
+}
+
+V2TIMBuffer TencentCloudChatCodecWriter::ToBuffer() const
+{
+	return V2TIMBuffer(Data.GetData(), Data.Num());
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+//
+//                         Reader
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+void TencentCloudChatCodecIntArrayView::ToArray(TArray<int64> &out) const
+{
+	for (int64 Value : *this)
+	{
+		out.Add(Value);
+	}
+}
+
+bool TencentCloudChatCodecReader::PeekHeader(TConstArrayView<uint8> data, uint32 &outSchemaId, uint32 &outVersion)
+{
+	if (data.Num() < 3 || data[0] != CodecMagic)
+	{
+		return false;
+	}
+
+	const uint8 *Cursor = data.GetData() + 1;
+	const uint8 *End = data.GetData() + data.Num();
+	uint64 Id, Ver;
+	if (!TencentCloudChatVarint::Read(Cursor, End, Id) || !TencentCloudChatVarint::Read(Cursor, End, Ver) || Id > MAX_uint32 || Ver > MAX_uint32)
+	{
+		return false;
+	}
+	outSchemaId = uint32(Id);
+	outVersion = uint32(Ver);
+	return true;
+}
+
+bool TencentCloudChatCodecReader::Parse(const V2TIMBuffer &buffer, const TencentCloudChatCodecSchema *expected)
+{
+	return Parse(TConstArrayView<uint8>(buffer.Data(), static_cast<int32>(buffer.Size())), expected);
+}
+
+bool TencentCloudChatCodecReader::Parse(TConstArrayView<uint8> data, const TencentCloudChatCodecSchema *expected)
+{
+	Data = data;
+	Fields.Reset();
+	bValid = false;
+
+	if (!PeekHeader(data, SchemaId, Version) || (expected && expected->GetId() != SchemaId))
+	{
+		return false;
+	}
+
+	const uint8 *Begin = data.GetData();
+	const uint8 *End = Begin + data.Num();
+	const uint8 *Cursor = Begin + 1;
+	uint64 Skip;
+	TencentCloudChatVarint::Read(Cursor, End, Skip);
+	TencentCloudChatVarint::Read(Cursor, End, Skip);
+
+	while (Cursor < End)
+	{
+		uint64 Key;
+		if (!TencentCloudChatVarint::Read(Cursor, End, Key) || (Key >> 3) > MAX_uint32)
+		{
+			return false;
+		}
+
+		FieldRef Ref;
+		Ref.Id = uint32(Key >> 3);
+		Ref.WireType = uint8(Key & 0x7);
+
+		switch (Ref.WireType)
+		{
+		case WireVarint:
+		{
+			const uint8 *ValueBegin = Cursor;
+			uint64 Value;
+			if (!TencentCloudChatVarint::Read(Cursor, End, Value))
+			{
+				return false;
+			}
+			Ref.Offset = int32(ValueBegin - Begin);
+			Ref.Size = int32(Cursor - ValueBegin);
+			break;
+		}
+		case WireFixed32:
+		case WireFixed64:
+		{
+			const int32 Size = Ref.WireType == WireFixed32 ? 4 : 8;
+			if (End - Cursor < Size)
+			{
+				return false;
+			}
+			Ref.Offset = int32(Cursor - Begin);
+			Ref.Size = Size;
+			Cursor += Size;
+			break;
+		}
+		case WireLengthDelimited:
+		case WireDeltaArray:
+		{
+			uint64 Length;
+			if (!TencentCloudChatVarint::Read(Cursor, End, Length) || Length > uint64(End - Cursor))
+			{
+				return false;
+			}
+			Ref.Offset = int32(Cursor - Begin);
+			Ref.Size = int32(Length);
+			Cursor += Length;
+			break;
+		}
+		default:
+			// 未知的线类型无法跳过，只能认为数据损坏
+			return false;
+		}
+
+		Fields.Add(Ref);
+	}
+
+	bValid = true;
+	return true;
+}
+
+const TencentCloudChatCodecReader::FieldRef *TencentCloudChatCodecReader::Find(uint32 field, uint8 wireType) const
+{
+	for (int32 Index = Fields.Num() - 1; Index >= 0; --Index)
+	{
+		if (Fields[Index].Id == field)
+		{
+			return Fields[Index].WireType == wireType ? &Fields[Index] : nullptr;
+		}
+	}
+	return nullptr;
+}
+
+bool TencentCloudChatCodecReader::Has(uint32 field) const
+{
+	return Fields.ContainsByPredicate([field](const FieldRef &Ref) { return Ref.Id == field; });
+}
+
+bool TencentCloudChatCodecReader::ReadUInt(uint32 field, uint64 &out) const
+{
+	const FieldRef *Ref = Find(field, WireVarint);
+	if (!Ref)
+	{
+		return false;
+	}
+	const uint8 *Cursor = Data.GetData() + Ref->Offset;
+	return TencentCloudChatVarint::Read(Cursor, Cursor + Ref->Size, out);
+}
+
+bool TencentCloudChatCodecReader::ReadBool(uint32 field, bool &out) const
+{
+	uint64 Value;
+	if (!ReadUInt(field, Value))
+	{
+		return false;
+	}
+	out = Value != 0;
+	return true;
+}
+
+bool TencentCloudChatCodecReader::ReadInt(uint32 field, int64 &out) const
+{
+	uint64 Value;
+	if (!ReadUInt(field, Value))
+	{
+		return false;
+	}
+	out = TencentCloudChatVarint::ZigZagDecode(Value);
+	return true;
+}
+
+bool TencentCloudChatCodecReader::ReadFloat(uint32 field, float &out) const
+{
+	const FieldRef *Ref = Find(field, WireFixed32);
+	if (!Ref)
+	{
+		return false;
+	}
+	uint32 Bits = 0;
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		Bits |= uint32(Data[Ref->Offset + Index]) << (Index * 8);
+	}
+	FMemory::Memcpy(&out, &Bits, sizeof(out));
+	return true;
+}
+
+bool TencentCloudChatCodecReader::ReadDouble(uint32 field, double &out) const
+{
+	const FieldRef *Ref = Find(field, WireFixed64);
+	if (!Ref)
+	{
+		return false;
+	}
+	uint64 Bits = 0;
+	for (int32 Index = 0; Index < 8; ++Index)
+	{
+		Bits |= uint64(Data[Ref->Offset + Index]) << (Index * 8);
+	}
+	FMemory::Memcpy(&out, &Bits, sizeof(out));
+	return true;
+}
+
+bool TencentCloudChatCodecReader::ReadString(uint32 field, FUtf8StringView &out) const
+{
+	const FieldRef *Ref = Find(field, WireLengthDelimited);
+	if (!Ref)
+	{
+		return false;
+	}
+	out = FUtf8StringView(reinterpret_cast<const UTF8CHAR *>(Data.GetData() + Ref->Offset), Ref->Size);
+	return true;
+}
+
+bool TencentCloudChatCodecReader::ReadString(uint32 field, FString &out) const
+{
+	FUtf8StringView Utf8;
+	if (!ReadString(field, Utf8))
+	{
+		return false;
+	}
+
+	TencentCloudChatString::ToFString(Utf8, out);
+	return true;
+}
+
+bool TencentCloudChatCodecReader::ReadBytes(uint32 field, TConstArrayView<uint8> &out) const
+{
+	const FieldRef *Ref = Find(field, WireLengthDelimited);
+	if (!Ref)
+	{
+		return false;
+	}
+	out = TConstArrayView<uint8>(Data.GetData() + Ref->Offset, Ref->Size);
+	return true;
+}
+
+bool TencentCloudChatCodecReader::ReadIntArray(uint32 field, TencentCloudChatCodecIntArrayView &out) const
+{
+	const FieldRef *Ref = Find(field, WireDeltaArray);
+	if (!Ref)
+	{
+		return false;
+	}
+	out = TencentCloudChatCodecIntArrayView(TConstArrayView<uint8>(Data.GetData() + Ref->Offset, Ref->Size));
+	return true;
+}
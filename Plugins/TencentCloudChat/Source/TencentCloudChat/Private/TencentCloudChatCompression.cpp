@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatCompression.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatCodec.h"
+#include "TencentCloudChatMessageForwarder.h"
+#include "TencentCloudChatPrivate.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+
+DECLARE_CYCLE_STAT(TEXT("Compress Payload"), STAT_TencentCloudChat_Compress, STATGROUP_TencentCloudChat);
+DECLARE_CYCLE_STAT(TEXT("Decompress Payload"), STAT_TencentCloudChat_Decompress, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Compressed Messages"), STAT_TencentCloudChat_CompressedMessages, STATGROUP_TencentCloudChat);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Compression Ratio"), STAT_TencentCloudChat_CompressionRatio, STATGROUP_TencentCloudChat);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Avg Compress Time (us)"), STAT_TencentCloudChat_CompressTimeUs, STATGROUP_TencentCloudChat);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Avg Decompress Time (us)"), STAT_TencentCloudChat_DecompressTimeUs, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<int32> CVarCompressionThreshold(
+	TEXT("TencentCloudChat.Compression.Threshold"),
+	1024,
+	TEXT("Custom message payloads at least this many bytes are compressed by TencentCloudChatCompression."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<FString> CVarCompressionFormat(
+	TEXT("TencentCloudChat.Compression.Format"),
+	TEXT(""),
+	TEXT("FCompression format used for custom message payloads: Oodle, LZ4 or Zlib.\n")
+	TEXT("Empty picks the first one available in that order."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarCompressionBatches(
+	TEXT("TencentCloudChat.Compression.Batches"),
+	false,
+	TEXT("Compress messages sent by TencentCloudChatBatcher using the same threshold."),
+	ECVF_Default);
+
+namespace
+{
+	// 压缩头中的格式编号，只能追加
+	const FName CompressionFormats[] = { NAME_None, NAME_Zlib, NAME_LZ4, NAME_Oodle };
+
+	uint8 GetFormatId(FName format)
+	{
+		for (uint8 Id = 1; Id < UE_ARRAY_COUNT(CompressionFormats); ++Id)
+		{
+			if (CompressionFormats[Id] == format)
+			{
+				return Id;
+			}
+		}
+		return 0;
+	}
+
+	FName GetSendFormat()
+	{
+		const FString Configured = CVarCompressionFormat.GetValueOnAnyThread();
+		if (!Configured.IsEmpty())
+		{
+			const FName Format(*Configured);
+			return GetFormatId(Format) && FCompression::IsFormatValid(Format) ? Format : NAME_None;
+		}
+		for (FName Format : { NAME_Oodle, NAME_LZ4, NAME_Zlib })
+		{
+			if (FCompression::IsFormatValid(Format))
+			{
+				return Format;
+			}
+		}
+		return NAME_None;
+	}
+
+	// 累计值，用来计算压缩比和平均耗时
+	TAtomic<int64> CompressedCount(0);
+	TAtomic<int64> CompressedBytesIn(0);
+	TAtomic<int64> CompressedBytesOut(0);
+	TAtomic<int64> CompressCycles(0);
+	TAtomic<int64> DecompressedCount(0);
+	TAtomic<int64> DecompressCycles(0);
+}
+
+bool TencentCloudChatCompression::Compress(TConstArrayView<uint8> data, TArray<uint8> &out)
+{
+	if (data.Num() < FMath::Max(CVarCompressionThreshold.GetValueOnAnyThread(), 1) || data.Num() > MaxUncompressedBytes)
+	{
+		return false;
+	}
+
+	const FName Format = GetSendFormat();
+	if (Format.IsNone())
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TencentCloudChat_Compress);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	// 头部：标记、格式、varint 原始长度
+	uint8 Header[2 + 5];
+	int32 HeaderBytes = 0;
+	Header[HeaderBytes++] = HeaderTag;
+	Header[HeaderBytes++] = GetFormatId(Format);
+	for (uint32 Size = uint32(data.Num());; Size >>= 7)
+	{
+		Header[HeaderBytes++] = uint8(Size & 0x7F) | (Size >= 0x80 ? 0x80 : 0);
+		if (Size < 0x80)
+		{
+			break;
+		}
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(Format, data.Num());
+	out.Reset(HeaderBytes + CompressedSize);
+	out.Append(Header, HeaderBytes);
+	out.AddUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(Format, out.GetData() + HeaderBytes, CompressedSize, data.GetData(), data.Num()) ||
+		HeaderBytes + CompressedSize >= data.Num())
+	{
+		out.Reset();
+		return false;
+	}
+	out.SetNum(HeaderBytes + CompressedSize);
+
+	const int64 Count = ++CompressedCount;
+	const int64 BytesIn = CompressedBytesIn += data.Num();
+	const int64 BytesOut = CompressedBytesOut += out.Num();
+	const int64 Cycles = CompressCycles += int64(FPlatformTime::Cycles64() - StartCycles);
+	SET_DWORD_STAT(STAT_TencentCloudChat_CompressedMessages, Count);
+	SET_FLOAT_STAT(STAT_TencentCloudChat_CompressionRatio, float(double(BytesOut) / double(BytesIn)));
+	SET_FLOAT_STAT(STAT_TencentCloudChat_CompressTimeUs, float(FPlatformTime::ToMilliseconds64(Cycles) * 1000.0 / double(Count)));
+	UE_LOG(LogTencentCloudChat, Verbose, TEXT("Compressed custom payload %d -> %d bytes (%s)"), data.Num(), out.Num(), *Format.ToString());
+	return true;
+}
+
+bool TencentCloudChatCompression::IsCompressed(TConstArrayView<uint8> data)
+{
+	return data.Num() >= 3 && data[0] == HeaderTag;
+}
+
+bool TencentCloudChatCompression::Decompress(TConstArrayView<uint8> data, TArray<uint8> &out)
+{
+	if (!IsCompressed(data) || data[1] == 0 || data[1] >= UE_ARRAY_COUNT(CompressionFormats))
+	{
+		return false;
+	}
+	const FName Format = CompressionFormats[data[1]];
+
+	const uint8 *Cursor = data.GetData() + 2;
+	const uint8 *End = data.GetData() + data.Num();
+	uint64 UncompressedSize;
+	if (!TencentCloudChatVarint::Read(Cursor, End, UncompressedSize) || UncompressedSize == 0 || UncompressedSize > uint64(MaxUncompressedBytes))
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TencentCloudChat_Decompress);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	out.Reset(int32(UncompressedSize));
+	out.AddUninitialized(int32(UncompressedSize));
+	if (!FCompression::IsFormatValid(Format) ||
+		!FCompression::UncompressMemory(Format, out.GetData(), int32(UncompressedSize), Cursor, int32(End - Cursor)))
+	{
+		out.Reset();
+		return false;
+	}
+
+	const int64 Count = ++DecompressedCount;
+	const int64 Cycles = DecompressCycles += int64(FPlatformTime::Cycles64() - StartCycles);
+	SET_FLOAT_STAT(STAT_TencentCloudChat_DecompressTimeUs, float(FPlatformTime::ToMilliseconds64(Cycles) * 1000.0 / double(Count)));
+	return true;
+}
+
+V2TIMBuffer TencentCloudChatCompression::ToBuffer(TConstArrayView<uint8> data)
+{
+	TArray<uint8> Compressed;
+	if (Compress(data, Compressed))
+	{
+		return V2TIMBuffer(Compressed.GetData(), Compressed.Num());
+	}
+	return V2TIMBuffer(data.GetData(), data.Num());
+}
+
+bool TencentCloudChatCompression::DecompressMessage(const V2TIMMessage &message, V2TIMMessage &out)
+{
+	const V2TIMCustomElem *CustomElem = TencentCloudChatCustomPayload::GetSingleCustomElem(message);
+	if (!CustomElem)
+	{
+		return false;
+	}
+
+	TArray<uint8> Decompressed;
+	if (!Decompress(TencentCloudChatCustomPayload::GetData(*CustomElem), Decompressed))
+	{
+		return false;
+	}
+	out = TencentCloudChatCustomPayload::Rebuild(message, *CustomElem, Decompressed);
+	return true;
+}
+
+V2TIMString TencentCloudChatCompression::SendGroupCustomMessage(const V2TIMBuffer &customData, const V2TIMString &groupID,
+																 V2TIMMessagePriority priority, V2TIMSendCallback *callback)
+{
+	TArray<uint8> Compressed;
+	if (!Compress(TConstArrayView<uint8>(customData.Data(), static_cast<int32>(customData.Size())), Compressed))
+	{
+		return TencentCloudChat::SendGroupCustomMessage(customData, groupID, priority, callback);
+	}
+	return TencentCloudChat::SendGroupCustomMessage(V2TIMBuffer(Compressed.GetData(), Compressed.Num()), groupID, priority, callback);
+}
+
+V2TIMString TencentCloudChatCompression::SendC2CCustomMessage(const V2TIMBuffer &customData, const V2TIMString &userID,
+															   V2TIMSendCallback *callback)
+{
+	TArray<uint8> Compressed;
+	if (!Compress(TConstArrayView<uint8>(customData.Data(), static_cast<int32>(customData.Size())), Compressed))
+	{
+		return TencentCloudChat::SendC2CCustomMessage(customData, userID, callback);
+	}
+	return TencentCloudChat::SendC2CCustomMessage(V2TIMBuffer(Compressed.GetData(), Compressed.Num()), userID, callback);
+}
+
+bool TencentCloudChatCompression::ShouldCompressBatches()
+{
+	return CVarCompressionBatches.GetValueOnAnyThread();
+}
+
+namespace
+{
+	/**
+	 * 新消息和被修改的消息如果带压缩头，解压后再转发给 Target
+	 */
+	class DecompressingListener : public TencentCloudChatAdvancedMsgForwarder
+	{
+	public:
+		using TencentCloudChatAdvancedMsgForwarder::TencentCloudChatAdvancedMsgForwarder;
+
+		void OnRecvNewMessage(const V2TIMMessage &message) override
+		{
+			EventScope Scope(*this);
+			V2TIMMessage Decompressed;
+			Target->OnRecvNewMessage(TencentCloudChatCompression::DecompressMessage(message, Decompressed) ? Decompressed : message);
+		}
+		void OnRecvMessageModified(const V2TIMMessage &message) override
+		{
+			EventScope Scope(*this);
+			V2TIMMessage Decompressed;
+			Target->OnRecvMessageModified(TencentCloudChatCompression::DecompressMessage(message, Decompressed) ? Decompressed : message);
+		}
+	};
+
+	using DecompressingListeners = TencentCloudChatAdvancedMsgForwarderRegistry<DecompressingListener>;
+}
+
+void TencentCloudChatCompression::AddAdvancedMsgListener(V2TIMAdvancedMsgListener *listener)
+{
+	DecompressingListeners::Add(listener);
+}
+
+void TencentCloudChatCompression::RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *listener)
+{
+	DecompressingListeners::Remove(listener);
+}
@@ -0,0 +1,542 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatConversationStore.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatString.h"
+#include "Math/RandomStream.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_CYCLE_STAT(TEXT("Conversation Store Update"), STAT_TencentCloudChat_ConversationStoreUpdate, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Conversations"), STAT_TencentCloudChat_Conversations, STATGROUP_TencentCloudChat);
+
+namespace
+{
+	struct ConversationNode
+	{
+		V2TIMConversation Conversation;
+		// 排序用的字段单独保存，更新时按旧值找到节点
+		bool bPinned = false;
+		uint64 OrderKey = 0;
+		uint32 Priority = 0;
+		int32 Left = INDEX_NONE;
+		int32 Right = INDEX_NONE;
+		int32 Size = 1;
+	};
+
+	struct ConversationSortKey
+	{
+		bool bPinned;
+		uint64 OrderKey;
+		const V2TIMString &ID;
+	};
+
+	ConversationSortKey GetSortKey(const ConversationNode &node)
+	{
+		return ConversationSortKey{ node.bPinned, node.OrderKey, node.Conversation.conversationID };
+	}
+
+	/**
+	 * 置顶在前，orderKey 大的在前，最后按 conversationID 保证顺序唯一
+	 */
+	bool IsBefore(const ConversationSortKey &a, const ConversationSortKey &b)
+	{
+		if (a.bPinned != b.bPinned)
+		{
+			return a.bPinned;
+		}
+		if (a.OrderKey != b.OrderKey)
+		{
+			return a.OrderKey > b.OrderKey;
+		}
+		return FCStringAnsi::Strcmp(a.ID.CString(), b.ID.CString()) < 0;
+	}
+
+	/**
+	 * 按子树大小增强的 treap，节点保存在数组中，用下标互相引用
+	 *
+	 * 不加锁，由调用方保证互斥。
+	 */
+	class ConversationTreap
+	{
+	public:
+		int32 Num() const { return Index.Num(); }
+
+		const ConversationNode *Find(const V2TIMString &conversationID) const
+		{
+			const int32 *Found = Index.Find(conversationID);
+			return Found ? &Nodes[*Found] : nullptr;
+		}
+
+		void Upsert(const V2TIMConversation &conversation)
+		{
+			int32 Node;
+			if (const int32 *Found = Index.Find(conversation.conversationID))
+			{
+				Node = *Found;
+				Erase(Node);
+				Nodes[Node].Conversation = conversation;
+			}
+			else
+			{
+				Node = FreeNodes.Num() > 0 ? FreeNodes.Pop() : Nodes.AddDefaulted();
+				Nodes[Node].Conversation = conversation;
+				Index.Add(conversation.conversationID, Node);
+			}
+
+			ConversationNode &Entry = Nodes[Node];
+			Entry.bPinned = conversation.isPinned;
+			Entry.OrderKey = conversation.orderKey;
+			Entry.Priority = Random.GetUnsignedInt();
+			Entry.Left = INDEX_NONE;
+			Entry.Right = INDEX_NONE;
+			Entry.Size = 1;
+
+			int32 Before, After;
+			Split(Root, GetSortKey(Entry), Before, After);
+			Root = Merge(Merge(Before, Node), After);
+		}
+
+		bool Remove(const V2TIMString &conversationID)
+		{
+			int32 Node;
+			if (!Index.RemoveAndCopyValue(conversationID, Node))
+			{
+				return false;
+			}
+			Erase(Node);
+			Nodes[Node].Conversation = V2TIMConversation();
+			FreeNodes.Add(Node);
+			return true;
+		}
+
+		int32 GetIndex(const V2TIMString &conversationID) const
+		{
+			const int32 *Found = Index.Find(conversationID);
+			if (!Found)
+			{
+				return INDEX_NONE;
+			}
+
+			const ConversationSortKey Key = GetSortKey(Nodes[*Found]);
+			int32 Rank = 0;
+			for (int32 Node = Root; Node != INDEX_NONE;)
+			{
+				if (Node == *Found)
+				{
+					return Rank + GetSize(Nodes[Node].Left);
+				}
+				if (IsBefore(GetSortKey(Nodes[Node]), Key))
+				{
+					Rank += GetSize(Nodes[Node].Left) + 1;
+					Node = Nodes[Node].Right;
+				}
+				else
+				{
+					Node = Nodes[Node].Left;
+				}
+			}
+			return INDEX_NONE;
+		}
+
+		void Visit(int32 offset, int32 count, TFunctionRef<void(const V2TIMConversation &)> visitor) const
+		{
+			VisitRange(Root, FMath::Max(offset, 0), count, visitor);
+		}
+
+		void Reset()
+		{
+			Nodes.Empty();
+			FreeNodes.Empty();
+			Index.Empty();
+			Root = INDEX_NONE;
+		}
+
+	private:
+		int32 GetSize(int32 node) const
+		{
+			return node == INDEX_NONE ? 0 : Nodes[node].Size;
+		}
+
+		void Update(int32 node)
+		{
+			Nodes[node].Size = 1 + GetSize(Nodes[node].Left) + GetSize(Nodes[node].Right);
+		}
+
+		/**
+		 * 排在 key 之前的节点放入 outBefore，其余放入 outAfter
+		 */
+		void Split(int32 node, const ConversationSortKey &key, int32 &outBefore, int32 &outAfter)
+		{
+			if (node == INDEX_NONE)
+			{
+				outBefore = outAfter = INDEX_NONE;
+				return;
+			}
+			if (IsBefore(GetSortKey(Nodes[node]), key))
+			{
+				Split(Nodes[node].Right, key, Nodes[node].Right, outAfter);
+				outBefore = node;
+			}
+			else
+			{
+				Split(Nodes[node].Left, key, outBefore, Nodes[node].Left);
+				outAfter = node;
+			}
+			Update(node);
+		}
+
+		int32 Merge(int32 before, int32 after)
+		{
+			if (before == INDEX_NONE || after == INDEX_NONE)
+			{
+				return before == INDEX_NONE ? after : before;
+			}
+			if (Nodes[before].Priority > Nodes[after].Priority)
+			{
+				Nodes[before].Right = Merge(Nodes[before].Right, after);
+				Update(before);
+				return before;
+			}
+			Nodes[after].Left = Merge(before, Nodes[after].Left);
+			Update(after);
+			return after;
+		}
+
+		int32 RemoveFirst(int32 node)
+		{
+			if (Nodes[node].Left == INDEX_NONE)
+			{
+				return Nodes[node].Right;
+			}
+			Nodes[node].Left = RemoveFirst(Nodes[node].Left);
+			Update(node);
+			return node;
+		}
+
+		/**
+		 * 按节点中保存的旧排序字段把节点从树中摘下，节点本身保留
+		 */
+		void Erase(int32 node)
+		{
+			int32 Before, After;
+			Split(Root, GetSortKey(Nodes[node]), Before, After);
+			check(After != INDEX_NONE);
+			Root = Merge(Before, RemoveFirst(After));
+		}
+
+		void VisitRange(int32 node, int32 offset, int32 count, TFunctionRef<void(const V2TIMConversation &)> visitor) const
+		{
+			if (node == INDEX_NONE || count <= 0)
+			{
+				return;
+			}
+			const ConversationNode &Entry = Nodes[node];
+			const int32 LeftSize = GetSize(Entry.Left);
+			if (offset < LeftSize)
+			{
+				VisitRange(Entry.Left, offset, count, visitor);
+			}
+			if (offset <= LeftSize && LeftSize < offset + count)
+			{
+				visitor(Entry.Conversation);
+			}
+			if (offset + count > LeftSize + 1)
+			{
+				const int32 RightOffset = FMath::Max(offset - LeftSize - 1, 0);
+				const int32 Skipped = FMath::Max(LeftSize + 1 - offset, 0);
+				VisitRange(Entry.Right, RightOffset, count - Skipped, visitor);
+			}
+		}
+
+		TArray<ConversationNode> Nodes;
+		TArray<int32> FreeNodes;
+		TMap<V2TIMString, int32> Index;
+		int32 Root = INDEX_NONE;
+		FRandomStream Random{ 0x54434353 };
+	};
+
+	FCriticalSection StoreMutex;
+	ConversationTreap StoreConversations;
+	bool bStoreListenerAdded = false;
+	bool bStoreLoaded = false;
+	bool bStoreLoading = false;
+	// Shutdown 后仍在进行的分页拉取通过代数丢弃
+	uint32 StoreGeneration = 0;
+	TArray<TUniqueFunction<void(bool)>> StoreLoadCallbacks;
+
+	FTencentCloudChatConversationStoreDelegate StoreChanged;
+
+	class StoreListener : public V2TIMConversationListener
+	{
+	public:
+		void OnNewConversation(const V2TIMConversationVector &conversationList) override
+		{
+			TencentCloudChatConversationStore::Upsert(conversationList);
+		}
+		void OnConversationChanged(const V2TIMConversationVector &conversationList) override
+		{
+			TencentCloudChatConversationStore::Upsert(conversationList);
+		}
+	};
+	StoreListener StoreListenerInstance;
+
+	void FinishLoad(uint32 generation, bool success)
+	{
+		TArray<TUniqueFunction<void(bool)>> Callbacks;
+		{
+			FScopeLock Lock(&StoreMutex);
+			if (generation != StoreGeneration)
+			{
+				return;
+			}
+			bStoreLoading = false;
+			bStoreLoaded = success;
+			Callbacks = MoveTemp(StoreLoadCallbacks);
+		}
+
+		StoreChanged.Broadcast();
+		for (TUniqueFunction<void(bool)> &Callback : Callbacks)
+		{
+			Callback(success);
+		}
+	}
+
+	/**
+	 * 清空列表并丢弃进行中的拉取，返回尚未回调的 Load 回调；在持有 StoreMutex 时调用
+	 */
+	TArray<TUniqueFunction<void(bool)>> ClearStore()
+	{
+		bStoreLoaded = false;
+		bStoreLoading = false;
+		++StoreGeneration;
+		StoreConversations.Reset();
+		SET_DWORD_STAT(STAT_TencentCloudChat_Conversations, 0);
+		return MoveTemp(StoreLoadCallbacks);
+	}
+
+	void LoadPage(uint32 generation, uint64 nextSeq, uint32 pageSize)
+	{
+		TencentCloudChat::GetConversationList(nextSeq, pageSize, TencentCloudChatValueCallback<V2TIMConversationResult>::Create(
+			[generation, pageSize](const V2TIMConversationResult &result)
+			{
+				{
+					SCOPE_CYCLE_COUNTER(STAT_TencentCloudChat_ConversationStoreUpdate);
+					FScopeLock Lock(&StoreMutex);
+					if (generation != StoreGeneration)
+					{
+						return;
+					}
+					// 已经由监听器更新过的会话比分页结果新，不覆盖
+					for (size_t Index = 0; Index < result.conversationList.Size(); ++Index)
+					{
+						const V2TIMConversation &Conversation = result.conversationList[Index];
+						if (!StoreConversations.Find(Conversation.conversationID))
+						{
+							StoreConversations.Upsert(Conversation);
+						}
+					}
+					SET_DWORD_STAT(STAT_TencentCloudChat_Conversations, StoreConversations.Num());
+				}
+
+				if (result.isFinished)
+				{
+					FinishLoad(generation, true);
+				}
+				else
+				{
+					LoadPage(generation, result.nextSeq, pageSize);
+				}
+			},
+			[generation](int error_code, const V2TIMString &error_message)
+			{
+				UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatConversationStore: GetConversationList failed (%d) %s"),
+					   error_code, *TencentCloudChatString::ToFString(error_message));
+				FinishLoad(generation, false);
+			}));
+	}
+}
+
+void TencentCloudChatConversationStore::Load(TUniqueFunction<void(bool)> &&onLoaded, uint32 pageSize)
+{
+	bool bAddListener = false;
+	uint32 Generation = 0;
+	{
+		FScopeLock Lock(&StoreMutex);
+		if (bStoreLoaded)
+		{
+			Lock.Unlock();
+			if (onLoaded)
+			{
+				onLoaded(true);
+			}
+			return;
+		}
+		if (onLoaded)
+		{
+			StoreLoadCallbacks.Add(MoveTemp(onLoaded));
+		}
+		if (bStoreLoading)
+		{
+			return;
+		}
+		bStoreLoading = true;
+		bAddListener = !bStoreListenerAdded;
+		bStoreListenerAdded = true;
+		Generation = StoreGeneration;
+	}
+
+	// 先注册监听器再拉取，拉取过程中的变更不会丢失
+	if (bAddListener)
+	{
+		TencentCloudChat::AddConversationListener(&StoreListenerInstance);
+	}
+	LoadPage(Generation, 0, FMath::Max<uint32>(pageSize, 1));
+}
+
+bool TencentCloudChatConversationStore::IsLoaded()
+{
+	FScopeLock Lock(&StoreMutex);
+	return bStoreLoaded;
+}
+
+int32 TencentCloudChatConversationStore::Num()
+{
+	FScopeLock Lock(&StoreMutex);
+	return StoreConversations.Num();
+}
+
+int32 TencentCloudChatConversationStore::GetPage(int32 offset, int32 count, TArray<V2TIMConversation> &outConversations)
+{
+	const int32 Start = outConversations.Num();
+	FScopeLock Lock(&StoreMutex);
+	outConversations.Reserve(Start + FMath::Clamp(StoreConversations.Num() - offset, 0, FMath::Max(count, 0)));
+	StoreConversations.Visit(offset, count, [&outConversations](const V2TIMConversation &Conversation)
+	{
+		outConversations.Add(Conversation);
+	});
+	return outConversations.Num() - Start;
+}
+
+void TencentCloudChatConversationStore::VisitPage(int32 offset, int32 count, TFunctionRef<void(const V2TIMConversation &)> visitor)
+{
+	FScopeLock Lock(&StoreMutex);
+	StoreConversations.Visit(offset, count, visitor);
+}
+
+void TencentCloudChatConversationStore::ForEach(TFunctionRef<void(const V2TIMConversation &)> visitor)
+{
+	FScopeLock Lock(&StoreMutex);
+	StoreConversations.Visit(0, StoreConversations.Num(), visitor);
+}
+
+bool TencentCloudChatConversationStore::Find(const V2TIMString &conversationID, V2TIMConversation &outConversation)
+{
+	FScopeLock Lock(&StoreMutex);
+	if (const ConversationNode *Node = StoreConversations.Find(conversationID))
+	{
+		outConversation = Node->Conversation;
+		return true;
+	}
+	return false;
+}
+
+int32 TencentCloudChatConversationStore::GetIndex(const V2TIMString &conversationID)
+{
+	FScopeLock Lock(&StoreMutex);
+	return StoreConversations.GetIndex(conversationID);
+}
+
+void TencentCloudChatConversationStore::Upsert(const V2TIMConversationVector &conversationList)
+{
+	if (conversationList.Size() == 0)
+	{
+		return;
+	}
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TencentCloudChat_ConversationStoreUpdate);
+		FScopeLock Lock(&StoreMutex);
+		for (size_t Index = 0; Index < conversationList.Size(); ++Index)
+		{
+			StoreConversations.Upsert(conversationList[Index]);
+		}
+		SET_DWORD_STAT(STAT_TencentCloudChat_Conversations, StoreConversations.Num());
+	}
+	StoreChanged.Broadcast();
+}
+
+void TencentCloudChatConversationStore::DeleteConversation(const V2TIMString &conversationID, V2TIMCallback *callback)
+{
+	TencentCloudChat::DeleteConversation(conversationID, TencentCloudChatCallback::Create(
+		[conversationID, callback]()
+		{
+			Remove(conversationID);
+			if (callback)
+			{
+				callback->OnSuccess();
+			}
+		},
+		[callback](int error_code, const V2TIMString &error_message)
+		{
+			if (callback)
+			{
+				callback->OnError(error_code, error_message);
+			}
+		}));
+}
+
+void TencentCloudChatConversationStore::Remove(const V2TIMString &conversationID)
+{
+	bool bRemoved;
+	{
+		FScopeLock Lock(&StoreMutex);
+		bRemoved = StoreConversations.Remove(conversationID);
+		SET_DWORD_STAT(STAT_TencentCloudChat_Conversations, StoreConversations.Num());
+	}
+	if (bRemoved)
+	{
+		StoreChanged.Broadcast();
+	}
+}
+
+FTencentCloudChatConversationStoreDelegate &TencentCloudChatConversationStore::OnChanged()
+{
+	return StoreChanged;
+}
+
+void TencentCloudChatConversationStore::Reset()
+{
+	TArray<TUniqueFunction<void(bool)>> Callbacks;
+	{
+		FScopeLock Lock(&StoreMutex);
+		Callbacks = ClearStore();
+	}
+
+	StoreChanged.Broadcast();
+	for (TUniqueFunction<void(bool)> &Callback : Callbacks)
+	{
+		Callback(false);
+	}
+}
+
+void TencentCloudChatConversationStore::Shutdown()
+{
+	bool bRemoveListener;
+	TArray<TUniqueFunction<void(bool)>> Callbacks;
+	{
+		FScopeLock Lock(&StoreMutex);
+		bRemoveListener = bStoreListenerAdded;
+		bStoreListenerAdded = false;
+		Callbacks = ClearStore();
+	}
+
+	if (bRemoveListener)
+	{
+		TencentCloudChat::RemoveConversationListener(&StoreListenerInstance);
+	}
+	for (TUniqueFunction<void(bool)> &Callback : Callbacks)
+	{
+		Callback(false);
+	}
+}
@@ -0,0 +1,468 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatDedup.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatRouter.h"
+#include "Hash/CityHash.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dedup Duplicates"), STAT_TencentCloudChat_DedupDuplicates, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<bool> CVarDedupEnabled(
+	TEXT("TencentCloudChat.Dedup.Enabled"),
+	true,
+	TEXT("Drop inbound messages already seen by the same TencentCloudChatDedupFilter."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDedupCapacity(
+	TEXT("TencentCloudChat.Dedup.Capacity"),
+	4096,
+	TEXT("Number of recent message keys kept by each dedup filter. Applied on first use and on Reset."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDedupFalsePositiveRate(
+	TEXT("TencentCloudChat.Dedup.FalsePositiveRate"),
+	0.01f,
+	TEXT("Target false positive rate of the bloom filter in front of the dedup LRU. Applied on first use and on Reset."),
+	ECVF_Default);
+
+bool TencentCloudChatDedupFilter::GetKey(const V2TIMMessage &message, uint64 &outKey)
+{
+	if (!message.groupID.Empty() && message.seq != 0)
+	{
+		outKey = CityHash64WithSeeds(message.groupID.CString(), static_cast<uint32>(message.groupID.Size()), message.seq, message.random);
+		return true;
+	}
+	if (!message.msgID.Empty())
+	{
+		outKey = CityHash64(message.msgID.CString(), static_cast<uint32>(message.msgID.Size()));
+		return true;
+	}
+	return false;
+}
+
+bool TencentCloudChatDedupFilter::MarkSeen(const V2TIMMessage &message)
+{
+	uint64 Key;
+	if (!CVarDedupEnabled.GetValueOnAnyThread() || !GetKey(message, Key))
+	{
+		return true;
+	}
+	FScopeLock Lock(&Mutex);
+	return !Check(Key, true);
+}
+
+bool TencentCloudChatDedupFilter::IsDuplicate(const V2TIMMessage &message)
+{
+	uint64 Key;
+	if (!CVarDedupEnabled.GetValueOnAnyThread() || !GetKey(message, Key))
+	{
+		return false;
+	}
+	FScopeLock Lock(&Mutex);
+	return Check(Key, false);
+}
+
+void TencentCloudChatDedupFilter::Reset()
+{
+	FScopeLock Lock(&Mutex);
+	Capacity = 0;
+	Configure();
+}
+
+TencentCloudChatDedupStats TencentCloudChatDedupFilter::GetStats() const
+{
+	FScopeLock Lock(&Mutex);
+	TencentCloudChatDedupStats Result = Stats;
+	Result.Entries = KeyToSlot.Num();
+	Result.Capacity = Capacity;
+	Result.MemoryBytes = KeyToSlot.GetAllocatedSize() + Slots.GetAllocatedSize() + BloomWords.GetAllocatedSize();
+	return Result;
+}
+
+bool TencentCloudChatDedupFilter::Check(uint64 key, bool record)
+{
+	if (Capacity == 0)
+	{
+		Configure();
+	}
+	++Stats.Checks;
+
+	if (!BloomMayContain(key))
+	{
+		++Stats.BloomRejects;
+	}
+	else if (const int32 *Found = KeyToSlot.Find(key))
+	{
+		++Stats.Duplicates;
+		INC_DWORD_STAT(STAT_TencentCloudChat_DedupDuplicates);
+		if (record && *Found != Head)
+		{
+			Unlink(*Found);
+			LinkFront(*Found);
+		}
+		return true;
+	}
+	else
+	{
+		++Stats.BloomFalsePositives;
+	}
+
+	if (!record)
+	{
+		return false;
+	}
+
+	int32 Index;
+	if (Slots.Num() < Capacity)
+	{
+		Index = Slots.Add(Slot{ key, INDEX_NONE, INDEX_NONE });
+	}
+	else
+	{
+		// 复用最久未使用的位置
+		Index = Tail;
+		Unlink(Index);
+		KeyToSlot.Remove(Slots[Index].Key);
+		Slots[Index].Key = key;
+		if (++BloomEvicted >= Capacity)
+		{
+			RebuildBloom();
+		}
+	}
+	LinkFront(Index);
+	KeyToSlot.Add(key, Index);
+	BloomAdd(key);
+	return false;
+}
+
+void TencentCloudChatDedupFilter::Configure()
+{
+	Capacity = FMath::Max(CVarDedupCapacity.GetValueOnAnyThread(), 1);
+	const double Rate = FMath::Clamp(double(CVarDedupFalsePositiveRate.GetValueOnAnyThread()), 1e-6, 0.5);
+
+	// 布隆过滤器最多同时包含 LRU 中的 Capacity 个 key 和 Capacity 个已淘汰的 key
+	const double Expected = 2.0 * double(Capacity);
+	const double Ln2 = FMath::Loge(2.0);
+	BloomBits = FMath::Max<uint64>(64, uint64(FMath::CeilToDouble(-Expected * FMath::Loge(Rate) / (Ln2 * Ln2))));
+	BloomHashes = FMath::Clamp(FMath::RoundToInt32(double(BloomBits) / Expected * Ln2), 1, 16);
+
+	KeyToSlot.Empty(Capacity);
+	Slots.Empty(Capacity);
+	Head = INDEX_NONE;
+	Tail = INDEX_NONE;
+	BloomWords.Init(0, int32((BloomBits + 63) / 64));
+	BloomEvicted = 0;
+	Stats = TencentCloudChatDedupStats();
+}
+
+bool TencentCloudChatDedupFilter::BloomMayContain(uint64 key) const
+{
+	// 双重哈希：第 i 个位置为 h1 + i * h2
+	const uint64 H1 = key & 0xFFFFFFFF;
+	const uint64 H2 = (key >> 32) | 1;
+	for (int32 Index = 0; Index < BloomHashes; ++Index)
+	{
+		const uint64 Bit = (H1 + uint64(Index) * H2) % BloomBits;
+		if (!(BloomWords[int32(Bit >> 6)] & (uint64(1) << (Bit & 63))))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void TencentCloudChatDedupFilter::BloomAdd(uint64 key)
+{
+	const uint64 H1 = key & 0xFFFFFFFF;
+	const uint64 H2 = (key >> 32) | 1;
+	for (int32 Index = 0; Index < BloomHashes; ++Index)
+	{
+		const uint64 Bit = (H1 + uint64(Index) * H2) % BloomBits;
+		BloomWords[int32(Bit >> 6)] |= uint64(1) << (Bit & 63);
+	}
+}
+
+void TencentCloudChatDedupFilter::RebuildBloom()
+{
+	FMemory::Memzero(BloomWords.GetData(), BloomWords.Num() * sizeof(uint64));
+	for (const Slot &Each : Slots)
+	{
+		BloomAdd(Each.Key);
+	}
+	BloomEvicted = 0;
+}
+
+void TencentCloudChatDedupFilter::Unlink(int32 slot)
+{
+	Slot &Node = Slots[slot];
+	if (Node.Prev != INDEX_NONE)
+	{
+		Slots[Node.Prev].Next = Node.Next;
+	}
+	else
+	{
+		Head = Node.Next;
+	}
+	if (Node.Next != INDEX_NONE)
+	{
+		Slots[Node.Next].Prev = Node.Prev;
+	}
+	else
+	{
+		Tail = Node.Prev;
+	}
+	Node.Prev = INDEX_NONE;
+	Node.Next = INDEX_NONE;
+}
+
+void TencentCloudChatDedupFilter::LinkFront(int32 slot)
+{
+	Slot &Node = Slots[slot];
+	Node.Prev = INDEX_NONE;
+	Node.Next = Head;
+	if (Head != INDEX_NONE)
+	{
+		Slots[Head].Prev = slot;
+	}
+	Head = slot;
+	if (Tail == INDEX_NONE)
+	{
+		Tail = slot;
+	}
+}
+
+TencentCloudChatDedupFilter &TencentCloudChatDedup::GetDefaultFilter()
+{
+	static TencentCloudChatDedupFilter Filter;
+	return Filter;
+}
+
+TencentCloudChatDedupFilter &TencentCloudChatDedup::GetHistoryFilter()
+{
+	static TencentCloudChatDedupFilter Filter;
+	return Filter;
+}
+
+void TencentCloudChatDedup::GetHistoryMessageList(const V2TIMMessageListGetOption &option,
+												  V2TIMValueCallback<V2TIMMessageVector> *callback)
+{
+	TencentCloudChat::GetHistoryMessageList(option, TencentCloudChatValueCallback<V2TIMMessageVector>::Create(
+		[callback](const V2TIMMessageVector &messages)
+		{
+			TencentCloudChatDedupFilter &Filter = GetHistoryFilter();
+			V2TIMMessageVector Fresh;
+			for (size_t Index = 0; Index < messages.Size(); ++Index)
+			{
+				if (Filter.MarkSeen(messages[Index]))
+				{
+					Fresh.PushBack(messages[Index]);
+				}
+			}
+			if (callback)
+			{
+				callback->OnSuccess(Fresh);
+			}
+		},
+		[callback](int error_code, const V2TIMString &error_message)
+		{
+			if (callback)
+			{
+				callback->OnError(error_code, error_message);
+			}
+		}));
+}
+
+void TencentCloudChatDedup::GetHistoryMessageList(const V2TIMMessageListGetOption &option,
+												  HistorySuccessFunc &&onSuccess, HistoryErrorFunc &&onError)
+{
+	TencentCloudChat::GetHistoryMessageList(option, TencentCloudChatValueCallback<V2TIMMessageVector>::Create(
+		[onSuccess = MoveTemp(onSuccess)](const V2TIMMessageVector &messages)
+		{
+			TencentCloudChatDedupFilter &Filter = GetHistoryFilter();
+			TencentCloudChatDedupFilter &Live = GetDefaultFilter();
+			V2TIMMessageVector Fresh;
+			TBitArray<> AlreadyApplied;
+			for (size_t Index = 0; Index < messages.Size(); ++Index)
+			{
+				if (Filter.MarkSeen(messages[Index]))
+				{
+					Fresh.PushBack(messages[Index]);
+					AlreadyApplied.Add(Live.IsDuplicate(messages[Index]));
+				}
+			}
+			if (onSuccess)
+			{
+				onSuccess(Fresh, AlreadyApplied);
+			}
+		},
+		MoveTemp(onError)));
+}
+
+namespace
+{
+	// 当前线程正在执行的 DedupListener::Forward 层数
+	thread_local int32 ForwardDepth = 0;
+
+	/**
+	 * 向 SDK 注册的唯一一个去重监听器：每条新消息只查一次 GetDefaultFilter，再转发给所有业务监听器
+	 */
+	class DedupListener : public V2TIMAdvancedMsgListener
+	{
+	public:
+		void Add(V2TIMAdvancedMsgListener *listener)
+		{
+			bool bRegister = false;
+			{
+				FScopeLock Lock(&Mutex);
+				if (Targets.Contains(listener))
+				{
+					return;
+				}
+				bRegister = Targets.Num() == 0;
+				Targets.Add(listener);
+			}
+			if (bRegister)
+			{
+				TencentCloudChat::AddAdvancedMsgListener(this);
+			}
+		}
+
+		void Remove(V2TIMAdvancedMsgListener *listener)
+		{
+			bool bUnregister = false;
+			{
+				FScopeLock Lock(&Mutex);
+				if (Targets.Remove(listener) == 0)
+				{
+					return;
+				}
+				bUnregister = Targets.Num() == 0;
+			}
+			if (bUnregister)
+			{
+				TencentCloudChat::RemoveAdvancedMsgListener(this);
+			}
+
+			// 其他线程上正在转发的事件可能仍会调用 listener，等它们结束后再返回，之后调用方可以释放 listener；
+			// 在转发中注销时不等待，调用方自己就在转发中
+			if (ForwardDepth == 0)
+			{
+				while (InFlight.Load() > 0)
+				{
+					FPlatformProcess::YieldThread();
+				}
+			}
+		}
+
+		void OnRecvNewMessage(const V2TIMMessage &message) override
+		{
+			if (TencentCloudChatDedup::GetDefaultFilter().MarkSeen(message))
+			{
+				Forward(&V2TIMAdvancedMsgListener::OnRecvNewMessage, message);
+			}
+		}
+		void OnRecvC2CReadReceipt(const V2TIMMessageReceiptVector &receiptList) override
+		{
+			Forward(&V2TIMAdvancedMsgListener::OnRecvC2CReadReceipt, receiptList);
+		}
+		void OnRecvMessageReadReceipts(const V2TIMMessageReceiptVector &receiptList) override
+		{
+			Forward(&V2TIMAdvancedMsgListener::OnRecvMessageReadReceipts, receiptList);
+		}
+		void OnRecvMessageRevoked(const V2TIMString &messageID) override
+		{
+			Forward(&V2TIMAdvancedMsgListener::OnRecvMessageRevoked, messageID);
+		}
+		void OnRecvMessageModified(const V2TIMMessage &message) override
+		{
+			Forward(&V2TIMAdvancedMsgListener::OnRecvMessageModified, message);
+		}
+		void OnRecvMessageExtensionsChanged(const V2TIMString &msgID,
+											const V2TIMMessageExtensionVector &extensions) override
+		{
+			Forward(&V2TIMAdvancedMsgListener::OnRecvMessageExtensionsChanged, msgID, extensions);
+		}
+		void OnRecvMessageExtensionsDeleted(const V2TIMString &msgID,
+											const V2TIMStringVector &extensionKeys) override
+		{
+			Forward(&V2TIMAdvancedMsgListener::OnRecvMessageExtensionsDeleted, msgID, extensionKeys);
+		}
+
+	private:
+		/**
+		 * 先拷贝监听器列表再调用，监听器中可以注册 / 注销去重监听器；调用每个监听器前确认它仍未注销
+		 */
+		template <typename... ParamTypes, typename... ArgTypes>
+		void Forward(void (V2TIMAdvancedMsgListener::*method)(ParamTypes...), const ArgTypes &...args)
+		{
+			++InFlight;
+			++ForwardDepth;
+			TArray<V2TIMAdvancedMsgListener *, TInlineAllocator<4>> Listeners;
+			{
+				FScopeLock Lock(&Mutex);
+				Listeners = Targets;
+			}
+			for (V2TIMAdvancedMsgListener *Listener : Listeners)
+			{
+				bool bRegistered;
+				{
+					FScopeLock Lock(&Mutex);
+					bRegistered = Targets.Contains(Listener);
+				}
+				if (bRegistered)
+				{
+					(Listener->*method)(args...);
+				}
+			}
+			--ForwardDepth;
+			--InFlight;
+		}
+
+		FCriticalSection Mutex;
+		TArray<V2TIMAdvancedMsgListener *, TInlineAllocator<4>> Targets;
+		TAtomic<int32> InFlight{0};
+	};
+	DedupListener DedupListenerInstance;
+
+	void LogDedupStats(const TCHAR *name, const TencentCloudChatDedupStats &stats)
+	{
+		UE_LOG(LogTencentCloudChat, Display,
+			   TEXT("%s: checks %llu, duplicates %llu (%.2f%%), bloom rejects %llu, bloom false positives %llu, entries %d/%d, %llu bytes"),
+			   name, stats.Checks, stats.Duplicates, stats.GetHitRate() * 100.0, stats.BloomRejects, stats.BloomFalsePositives,
+			   stats.Entries, stats.Capacity, uint64(stats.MemoryBytes));
+	}
+}
+
+void TencentCloudChatDedup::AddAdvancedMsgListener(V2TIMAdvancedMsgListener *listener)
+{
+	if (listener)
+	{
+		DedupListenerInstance.Add(listener);
+	}
+}
+
+void TencentCloudChatDedup::RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *listener)
+{
+	DedupListenerInstance.Remove(listener);
+}
+
+static FAutoConsoleCommand GTencentCloudChatDedupStatsCommand(
+	TEXT("TencentCloudChat.Dedup.Stats"),
+	TEXT("Print hit rate and memory of the dedup filters. Pass 'reset' to clear them and apply the current capacity."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString> &Args)
+	{
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			TencentCloudChatDedup::GetDefaultFilter().Reset();
+			TencentCloudChatDedup::GetHistoryFilter().Reset();
+			TencentCloudChatRouter::GetDedupFilter().Reset();
+			return;
+		}
+		LogDedupStats(TEXT("Default"), TencentCloudChatDedup::GetDefaultFilter().GetStats());
+		LogDedupStats(TEXT("History"), TencentCloudChatDedup::GetHistoryFilter().GetStats());
+		LogDedupStats(TEXT("Router"), TencentCloudChatRouter::GetDedupFilter().GetStats());
+	}));
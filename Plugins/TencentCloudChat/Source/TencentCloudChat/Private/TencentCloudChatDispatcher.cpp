@@ -0,0 +1,227 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatDispatcher.h"
+#include "TencentCloudChatPrivate.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_CYCLE_STAT(TEXT("Dispatch Drain"), STAT_TencentCloudChat_DispatchDrain, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dispatch Queue Depth"), STAT_TencentCloudChat_DispatchQueueDepth, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dispatch Tasks Executed"), STAT_TencentCloudChat_DispatchExecuted, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<bool> CVarDispatchGameThread(
+	TEXT("TencentCloudChat.Dispatch.GameThread"),
+	false,
+	TEXT("Marshal SDK callbacks and listener events passed through TencentCloudChat to the game thread.\n")
+	TEXT("Listeners keep the mode that was active when they were added."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDispatchBudgetMs(
+	TEXT("TencentCloudChat.Dispatch.BudgetMs"),
+	1.0f,
+	TEXT("Per-frame time budget in milliseconds for running marshalled SDK events on the game thread.\n")
+	TEXT("Events over budget carry over to the next frame. <= 0 drains the whole queue every frame."),
+	ECVF_Default);
+
+namespace
+{
+	// 多生产者（SDK 线程）单消费者（游戏线程）的无锁队列
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> PendingTasks;
+	TAtomic<int32> PendingCount(0);
+	FTSTicker::FDelegateHandle TickHandle;
+
+	struct RetiredObject
+	{
+		TUniquePtr<TencentCloudChatRetirable> Object;
+		uint64 Tick;
+	};
+
+	// TickCount 只在游戏线程递增
+	FCriticalSection RetiredMutex;
+	TArray<RetiredObject> RetiredObjects;
+	TAtomic<uint64> TickCount(0);
+
+	void ReleaseRetired()
+	{
+		TArray<TUniquePtr<TencentCloudChatRetirable>, TInlineAllocator<4>> Released;
+		{
+			FScopeLock Lock(&RetiredMutex);
+			const uint64 Tick = TickCount.Load();
+			for (int32 Index = RetiredObjects.Num() - 1; Index >= 0; --Index)
+			{
+				if (RetiredObjects[Index].Tick < Tick && RetiredObjects[Index].Object->IsIdle())
+				{
+					Released.Add(MoveTemp(RetiredObjects[Index].Object));
+					RetiredObjects.RemoveAtSwap(Index);
+				}
+			}
+		}
+		// 在锁外析构
+	}
+}
+
+void TencentCloudChatDispatcher::Enqueue(TUniqueFunction<void()> &&task)
+{
+	PendingTasks.Enqueue(MoveTemp(task));
+	++PendingCount;
+}
+
+int32 TencentCloudChatDispatcher::Drain(double budgetMs)
+{
+	check(IsInGameThread());
+	SCOPE_CYCLE_COUNTER(STAT_TencentCloudChat_DispatchDrain);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const uint64 BudgetCycles = budgetMs > 0.0 ? uint64(budgetMs / 1000.0 / FPlatformTime::GetSecondsPerCycle64()) : MAX_uint64;
+
+	// 每次至少执行一个任务，保证单个耗时任务也能向前推进
+	int32 Executed = 0;
+	TUniqueFunction<void()> Task;
+	while (PendingTasks.Dequeue(Task))
+	{
+		--PendingCount;
+		Task();
+		++Executed;
+
+		if (FPlatformTime::Cycles64() - StartCycles >= BudgetCycles)
+		{
+			break;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_TencentCloudChat_DispatchExecuted, Executed);
+	SET_DWORD_STAT(STAT_TencentCloudChat_DispatchQueueDepth, GetQueueDepth());
+	return Executed;
+}
+
+int32 TencentCloudChatDispatcher::GetQueueDepth()
+{
+	return FMath::Max(PendingCount.Load(), 0);
+}
+
+bool TencentCloudChatDispatcher::IsGameThreadDispatchEnabled()
+{
+	return CVarDispatchGameThread.GetValueOnAnyThread();
+}
+
+void TencentCloudChatDispatcher::Startup()
+{
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float)
+	{
+		++TickCount;
+		Drain(CVarDispatchBudgetMs.GetValueOnGameThread());
+		ReleaseRetired();
+		return true;
+	}));
+}
+
+void TencentCloudChatDispatcher::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	TickHandle.Reset();
+
+	// 模块卸载后监听器可能已经析构，丢弃剩余的任务
+	PendingTasks.Empty();
+	PendingCount = 0;
+
+	FScopeLock Lock(&RetiredMutex);
+	RetiredObjects.Empty();
+}
+
+void TencentCloudChatDispatcher::Retire(TUniquePtr<TencentCloudChatRetirable> &&object)
+{
+	if (object)
+	{
+		FScopeLock Lock(&RetiredMutex);
+		RetiredObjects.Add(RetiredObject{ MoveTemp(object), TickCount.Load() });
+	}
+}
+
+V2TIMCallback *TencentCloudChatDispatcher::Marshal(V2TIMCallback *callback)
+{
+	const bool bGameThread = IsGameThreadDispatchEnabled();
+	if (!callback || (!bGameThread && !TENCENTCLOUDCHAT_WITH_STATS))
+	{
+		return callback;
+	}
+	TencentCloudChatStats::RecordCallIssued();
+	const TencentCloudChatRequestTimer Timer = TencentCloudChatRequestTimer::Start();
+	return TencentCloudChatCallback::Create(
+		[callback, bGameThread, Timer]()
+		{
+			TencentCloudChatStats::RecordCallbackDelivered();
+			Timer.Finish(0);
+			if (bGameThread)
+			{
+				Enqueue([callback]() { callback->OnSuccess(); });
+			}
+			else
+			{
+				callback->OnSuccess();
+			}
+		},
+		[callback, bGameThread, Timer](int error_code, const V2TIMString &error_message)
+		{
+			TencentCloudChatStats::RecordCallbackDelivered();
+			Timer.Finish(error_code);
+			if (bGameThread)
+			{
+				Enqueue([callback, error_code, error_message]() { callback->OnError(error_code, error_message); });
+			}
+			else
+			{
+				callback->OnError(error_code, error_message);
+			}
+		});
+}
+
+V2TIMSendCallback *TencentCloudChatDispatcher::Marshal(V2TIMSendCallback *callback)
+{
+	const bool bGameThread = IsGameThreadDispatchEnabled();
+	if (!callback || (!bGameThread && !TENCENTCLOUDCHAT_WITH_STATS))
+	{
+		return callback;
+	}
+	TencentCloudChatStats::RecordCallIssued();
+	const TencentCloudChatRequestTimer Timer = TencentCloudChatRequestTimer::Start();
+	return TencentCloudChatSendCallback::Create(
+		[callback, bGameThread, Timer](const V2TIMMessage &message)
+		{
+			TencentCloudChatStats::RecordCallbackDelivered();
+			Timer.Finish(0);
+			if (bGameThread)
+			{
+				Enqueue([callback, message]() { callback->OnSuccess(message); });
+			}
+			else
+			{
+				callback->OnSuccess(message);
+			}
+		},
+		[callback, bGameThread, Timer](int error_code, const V2TIMString &error_message)
+		{
+			TencentCloudChatStats::RecordCallbackDelivered();
+			Timer.Finish(error_code);
+			if (bGameThread)
+			{
+				Enqueue([callback, error_code, error_message]() { callback->OnError(error_code, error_message); });
+			}
+			else
+			{
+				callback->OnError(error_code, error_message);
+			}
+		},
+		[callback, bGameThread](uint32_t progress)
+		{
+			if (bGameThread)
+			{
+				Enqueue([callback, progress]() { callback->OnProgress(progress); });
+			}
+			else
+			{
+				callback->OnProgress(progress);
+			}
+		});
+}
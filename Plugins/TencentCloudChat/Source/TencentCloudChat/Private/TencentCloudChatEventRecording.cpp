@@ -0,0 +1,1539 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatEventRecording.h"
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatCodec.h"
+#include "TencentCloudChatLoopback.h"
+#include "TencentCloudChatPrivate.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/Tuple.h"
+#include "Templates/UniquePtr.h"
+
+#include <type_traits>
+
+#include "V2TIMConversationManager.h"
+#include "V2TIMFriendshipManager.h"
+#include "V2TIMListener.h"
+#include "V2TIMManager.h"
+#include "V2TIMMessageManager.h"
+#include "V2TIMSignalingManager.h"
+
+static TAutoConsoleVariable<int32> CVarEventReplayMaxPending(
+	TEXT("TencentCloudChat.EventReplay.MaxPending"),
+	4096,
+	TEXT("Pause reading the replay file while more than this many events are queued in the loopback network."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarEventRecordMaxBufferKB(
+	TEXT("TencentCloudChat.EventRecord.MaxBufferKB"),
+	8192,
+	TEXT("Size in KB of the in-memory buffer between SDK callbacks and the event record writer thread.\n")
+	TEXT("Events that do not fit are dropped and counted. Read when recording starts."),
+	ECVF_Default);
+
+namespace
+{
+	constexpr uint8 EventFileMagic[4] = {'T', 'C', 'C', 'E'};
+	constexpr uint64 EventFileVersion = 1;
+
+	/**
+	 * 文件中的事件编号，按监听器分段，已有的编号不能修改
+	 */
+	enum class RecordedEvent : uint32
+	{
+		Connecting = 1,
+		ConnectSuccess = 2,
+		ConnectFailed = 3,
+		KickedOffline = 4,
+		UserSigExpired = 5,
+		SelfInfoUpdated = 6,
+		UserStatusChanged = 7,
+
+		RecvNewMessage = 20,
+		RecvC2CReadReceipt = 21,
+		RecvMessageReadReceipts = 22,
+		RecvMessageRevoked = 23,
+		RecvMessageModified = 24,
+		RecvMessageExtensionsChanged = 25,
+		RecvMessageExtensionsDeleted = 26,
+
+		MemberEnter = 40,
+		MemberLeave = 41,
+		MemberInvited = 42,
+		MemberKicked = 43,
+		MemberInfoChanged = 44,
+		GroupCreated = 45,
+		GroupDismissed = 46,
+		GroupRecycled = 47,
+		GroupInfoChanged = 48,
+		GroupAttributeChanged = 49,
+		GroupCounterChanged = 50,
+		ReceiveJoinApplication = 51,
+		ApplicationProcessed = 52,
+		GrantAdministrator = 53,
+		RevokeAdministrator = 54,
+		QuitFromGroup = 55,
+		ReceiveRESTCustomData = 56,
+		TopicCreated = 57,
+		TopicDeleted = 58,
+		TopicChanged = 59,
+
+		SyncServerStart = 60,
+		SyncServerFinish = 61,
+		SyncServerFailed = 62,
+		NewConversation = 63,
+		ConversationChanged = 64,
+		TotalUnreadMessageCountChanged = 65,
+		UnreadMessageCountChangedByFilter = 66,
+		ConversationGroupCreated = 67,
+		ConversationGroupDeleted = 68,
+		ConversationGroupNameChanged = 69,
+		ConversationsAddedToGroup = 70,
+		ConversationsDeletedFromGroup = 71,
+
+		FriendApplicationListAdded = 80,
+		FriendApplicationListDeleted = 81,
+		FriendApplicationListRead = 82,
+		FriendListAdded = 83,
+		FriendListDeleted = 84,
+		BlackListAdded = 85,
+		BlackListDeleted = 86,
+		FriendInfoChanged = 87,
+
+		ReceiveNewInvitation = 100,
+		InviteeAccepted = 101,
+		InviteeRejected = 102,
+		InvitationCancelled = 103,
+		InvitationTimeout = 104,
+		InvitationModified = 105,
+	};
+
+	class EventWriter
+	{
+	public:
+		void Varint(uint64 value)
+		{
+			while (value >= 0x80)
+			{
+				Data.Add(uint8(value) | 0x80);
+				value >>= 7;
+			}
+			Data.Add(uint8(value));
+		}
+
+		void Bytes(const void *data, size_t size)
+		{
+			Varint(size);
+			Data.Append(static_cast<const uint8 *>(data), int32(size));
+		}
+
+		void Raw(const void *data, int32 size)
+		{
+			Data.Append(static_cast<const uint8 *>(data), size);
+		}
+
+		TArray<uint8> Data;
+	};
+
+	/**
+	 * 读取一个事件的参数；数据截断或长度不合理时 IsOk 变为 false，之后的读取都返回默认值
+	 */
+	class EventReader
+	{
+	public:
+		explicit EventReader(TConstArrayView<uint8> data)
+			: Cursor(data.GetData()), End(data.GetData() + data.Num())
+		{
+		}
+
+		uint64 Varint()
+		{
+			uint64 Value = 0;
+			if (bOk && !TencentCloudChatVarint::Read(Cursor, End, Value))
+			{
+				bOk = false;
+			}
+			return bOk ? Value : 0;
+		}
+
+		/**
+		 * 列表的元素个数；每个元素至少占一个字节，超过剩余字节数的视为数据损坏
+		 */
+		uint64 Count()
+		{
+			const uint64 Value = Varint();
+			if (Value > uint64(End - Cursor))
+			{
+				bOk = false;
+			}
+			return bOk ? Value : 0;
+		}
+
+		const uint8 *Bytes(size_t &outSize)
+		{
+			const uint64 Size = Varint();
+			if (!bOk || Size > uint64(End - Cursor))
+			{
+				bOk = false;
+				outSize = 0;
+				return nullptr;
+			}
+			const uint8 *Data = Cursor;
+			Cursor += Size;
+			outSize = size_t(Size);
+			return Data;
+		}
+
+		void Raw(void *out, int32 size)
+		{
+			if (!bOk || size > End - Cursor)
+			{
+				bOk = false;
+				FMemory::Memzero(out, size);
+				return;
+			}
+			FMemory::Memcpy(out, Cursor, size);
+			Cursor += size;
+		}
+
+		bool IsOk() const
+		{
+			return bOk;
+		}
+
+	private:
+		const uint8 *Cursor = nullptr;
+		const uint8 *End = nullptr;
+		bool bOk = true;
+	};
+
+	// 整数（有符号数做 zigzag）、bool 和枚举
+	template <typename T>
+	std::enable_if_t<std::is_integral_v<T>> WriteValue(EventWriter &writer, T value)
+	{
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			writer.Varint(value ? 1 : 0);
+		}
+		else if constexpr (std::is_signed_v<T>)
+		{
+			writer.Varint(TencentCloudChatVarint::ZigZagEncode(int64(value)));
+		}
+		else
+		{
+			writer.Varint(uint64(value));
+		}
+	}
+
+	template <typename T>
+	std::enable_if_t<std::is_integral_v<T>> ReadValue(EventReader &reader, T &out)
+	{
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			out = reader.Varint() != 0;
+		}
+		else if constexpr (std::is_signed_v<T>)
+		{
+			out = T(TencentCloudChatVarint::ZigZagDecode(reader.Varint()));
+		}
+		else
+		{
+			out = T(reader.Varint());
+		}
+	}
+
+	template <typename T>
+	std::enable_if_t<std::is_enum_v<T>> WriteValue(EventWriter &writer, T value)
+	{
+		WriteValue(writer, int64(value));
+	}
+
+	template <typename T>
+	std::enable_if_t<std::is_enum_v<T>> ReadValue(EventReader &reader, T &out)
+	{
+		int64 Value = 0;
+		ReadValue(reader, Value);
+		out = T(Value);
+	}
+
+	void WriteValue(EventWriter &writer, double value)
+	{
+		uint64 Bits = 0;
+		FMemory::Memcpy(&Bits, &value, sizeof(Bits));
+		uint8 Bytes[8];
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			Bytes[Index] = uint8(Bits >> (Index * 8));
+		}
+		writer.Raw(Bytes, 8);
+	}
+
+	void ReadValue(EventReader &reader, double &out)
+	{
+		uint8 Bytes[8];
+		reader.Raw(Bytes, 8);
+		uint64 Bits = 0;
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			Bits |= uint64(Bytes[Index]) << (Index * 8);
+		}
+		FMemory::Memcpy(&out, &Bits, sizeof(out));
+	}
+
+	// 其余类型先声明，列表和 map 的模板需要看到全部重载
+	void WriteValue(EventWriter &writer, const V2TIMString &value);
+	void ReadValue(EventReader &reader, V2TIMString &out);
+	void WriteValue(EventWriter &writer, const V2TIMBuffer &value);
+	void ReadValue(EventReader &reader, V2TIMBuffer &out);
+	void WriteValue(EventWriter &writer, const V2TIMCustomInfo &value);
+	void ReadValue(EventReader &reader, V2TIMCustomInfo &out);
+	void WriteValue(EventWriter &writer, const V2TIMGroupAttributeMap &value);
+	void ReadValue(EventReader &reader, V2TIMGroupAttributeMap &out);
+	void WriteValue(EventWriter &writer, const V2TIMStringVector &value);
+	void ReadValue(EventReader &reader, V2TIMStringVector &out);
+	void WriteValue(EventWriter &writer, const UInt64Vector &value);
+	void ReadValue(EventReader &reader, UInt64Vector &out);
+	void WriteValue(EventWriter &writer, const V2TIMUserFullInfo &value);
+	void ReadValue(EventReader &reader, V2TIMUserFullInfo &out);
+	void WriteValue(EventWriter &writer, const V2TIMUserStatus &value);
+	void ReadValue(EventReader &reader, V2TIMUserStatus &out);
+	void WriteValue(EventWriter &writer, const V2TIMUserStatusVector &value);
+	void ReadValue(EventReader &reader, V2TIMUserStatusVector &out);
+	void WriteValue(EventWriter &writer, const V2TIMMessageReceipt &value);
+	void ReadValue(EventReader &reader, V2TIMMessageReceipt &out);
+	void WriteValue(EventWriter &writer, const V2TIMMessageReceiptVector &value);
+	void ReadValue(EventReader &reader, V2TIMMessageReceiptVector &out);
+	void WriteValue(EventWriter &writer, const V2TIMMessageExtension &value);
+	void ReadValue(EventReader &reader, V2TIMMessageExtension &out);
+	void WriteValue(EventWriter &writer, const V2TIMMessageExtensionVector &value);
+	void ReadValue(EventReader &reader, V2TIMMessageExtensionVector &out);
+	void WriteValue(EventWriter &writer, const V2TIMGroupMemberInfo &value);
+	void ReadValue(EventReader &reader, V2TIMGroupMemberInfo &out);
+	void WriteValue(EventWriter &writer, const V2TIMGroupMemberInfoVector &value);
+	void ReadValue(EventReader &reader, V2TIMGroupMemberInfoVector &out);
+	void WriteValue(EventWriter &writer, const V2TIMGroupMemberChangeInfo &value);
+	void ReadValue(EventReader &reader, V2TIMGroupMemberChangeInfo &out);
+	void WriteValue(EventWriter &writer, const V2TIMGroupMemberChangeInfoVector &value);
+	void ReadValue(EventReader &reader, V2TIMGroupMemberChangeInfoVector &out);
+	void WriteValue(EventWriter &writer, const V2TIMGroupChangeInfo &value);
+	void ReadValue(EventReader &reader, V2TIMGroupChangeInfo &out);
+	void WriteValue(EventWriter &writer, const V2TIMGroupChangeInfoVector &value);
+	void ReadValue(EventReader &reader, V2TIMGroupChangeInfoVector &out);
+	void WriteValue(EventWriter &writer, const V2TIMGroupAtInfo &value);
+	void ReadValue(EventReader &reader, V2TIMGroupAtInfo &out);
+	void WriteValue(EventWriter &writer, const V2TIMGroupAtInfoVector &value);
+	void ReadValue(EventReader &reader, V2TIMGroupAtInfoVector &out);
+	void WriteValue(EventWriter &writer, const V2TIMTopicInfo &value);
+	void ReadValue(EventReader &reader, V2TIMTopicInfo &out);
+	void WriteValue(EventWriter &writer, const V2TIMConversation &value);
+	void ReadValue(EventReader &reader, V2TIMConversation &out);
+	void WriteValue(EventWriter &writer, const V2TIMConversationVector &value);
+	void ReadValue(EventReader &reader, V2TIMConversationVector &out);
+	void WriteValue(EventWriter &writer, const V2TIMConversationListFilter &value);
+	void ReadValue(EventReader &reader, V2TIMConversationListFilter &out);
+	void WriteValue(EventWriter &writer, const V2TIMFriendApplication &value);
+	void ReadValue(EventReader &reader, V2TIMFriendApplication &out);
+	void WriteValue(EventWriter &writer, const V2TIMFriendApplicationVector &value);
+	void ReadValue(EventReader &reader, V2TIMFriendApplicationVector &out);
+	void WriteValue(EventWriter &writer, const V2TIMFriendInfo &value);
+	void ReadValue(EventReader &reader, V2TIMFriendInfo &out);
+	void WriteValue(EventWriter &writer, const V2TIMFriendInfoVector &value);
+	void ReadValue(EventReader &reader, V2TIMFriendInfoVector &out);
+	void WriteValue(EventWriter &writer, const V2TIMElem &value);
+	V2TIMElem *ReadElem(EventReader &reader);
+	void WriteValue(EventWriter &writer, const V2TIMMessage &value);
+	void ReadValue(EventReader &reader, V2TIMMessage &out);
+
+	template <typename VectorType>
+	void WriteVector(EventWriter &writer, const VectorType &values)
+	{
+		writer.Varint(values.Size());
+		for (size_t Index = 0; Index < values.Size(); ++Index)
+		{
+			WriteValue(writer, values[Index]);
+		}
+	}
+
+	template <typename ElementType, typename VectorType>
+	void ReadVector(EventReader &reader, VectorType &out)
+	{
+		const uint64 Count = reader.Count();
+		for (uint64 Index = 0; Index < Count && reader.IsOk(); ++Index)
+		{
+			ElementType Element;
+			ReadValue(reader, Element);
+			out.PushBack(Element);
+		}
+	}
+
+	template <typename MapType>
+	void WriteMap(EventWriter &writer, const MapType &values)
+	{
+		const V2TIMStringVector Keys = values.AllKeys();
+		writer.Varint(Keys.Size());
+		for (size_t Index = 0; Index < Keys.Size(); ++Index)
+		{
+			WriteValue(writer, Keys[Index]);
+			WriteValue(writer, values.Get(Keys[Index]));
+		}
+	}
+
+	template <typename ValueType, typename MapType>
+	void ReadMap(EventReader &reader, MapType &out)
+	{
+		const uint64 Count = reader.Count();
+		for (uint64 Index = 0; Index < Count && reader.IsOk(); ++Index)
+		{
+			V2TIMString Key;
+			ValueType Value;
+			ReadValue(reader, Key);
+			ReadValue(reader, Value);
+			out.Insert(Key, Value);
+		}
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMString &value)
+	{
+		writer.Bytes(value.CString(), value.Size());
+	}
+
+	void ReadValue(EventReader &reader, V2TIMString &out)
+	{
+		size_t Size = 0;
+		const uint8 *Data = reader.Bytes(Size);
+		out = Data ? V2TIMString(reinterpret_cast<const char *>(Data), Size) : V2TIMString();
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMBuffer &value)
+	{
+		writer.Bytes(value.Data(), value.Size());
+	}
+
+	void ReadValue(EventReader &reader, V2TIMBuffer &out)
+	{
+		size_t Size = 0;
+		const uint8 *Data = reader.Bytes(Size);
+		out = Data ? V2TIMBuffer(Data, Size) : V2TIMBuffer();
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMCustomInfo &value) { WriteMap(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMCustomInfo &out) { ReadMap<V2TIMBuffer>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMGroupAttributeMap &value) { WriteMap(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMGroupAttributeMap &out) { ReadMap<V2TIMString>(reader, out); }
+
+	void WriteValue(EventWriter &writer, const V2TIMStringVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMStringVector &out) { ReadVector<V2TIMString>(reader, out); }
+	void WriteValue(EventWriter &writer, const UInt64Vector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, UInt64Vector &out) { ReadVector<uint64_t>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMUserStatusVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMUserStatusVector &out) { ReadVector<V2TIMUserStatus>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMMessageReceiptVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMMessageReceiptVector &out) { ReadVector<V2TIMMessageReceipt>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMMessageExtensionVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMMessageExtensionVector &out) { ReadVector<V2TIMMessageExtension>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMGroupMemberInfoVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMGroupMemberInfoVector &out) { ReadVector<V2TIMGroupMemberInfo>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMGroupMemberChangeInfoVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMGroupMemberChangeInfoVector &out) { ReadVector<V2TIMGroupMemberChangeInfo>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMGroupChangeInfoVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMGroupChangeInfoVector &out) { ReadVector<V2TIMGroupChangeInfo>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMGroupAtInfoVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMGroupAtInfoVector &out) { ReadVector<V2TIMGroupAtInfo>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMConversationVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMConversationVector &out) { ReadVector<V2TIMConversation>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMFriendApplicationVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMFriendApplicationVector &out) { ReadVector<V2TIMFriendApplication>(reader, out); }
+	void WriteValue(EventWriter &writer, const V2TIMFriendInfoVector &value) { WriteVector(writer, value); }
+	void ReadValue(EventReader &reader, V2TIMFriendInfoVector &out) { ReadVector<V2TIMFriendInfo>(reader, out); }
+
+	/**
+	 * 按顺序写出 / 读入多个字段，结构体的读写各用一行列出字段，保证两边顺序一致
+	 */
+	template <typename... FieldTypes>
+	void WriteFields(EventWriter &writer, const FieldTypes &...fields)
+	{
+		(WriteValue(writer, fields), ...);
+	}
+
+	template <typename... FieldTypes>
+	void ReadFields(EventReader &reader, FieldTypes &...fields)
+	{
+		(ReadValue(reader, fields), ...);
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMUserFullInfo &value)
+	{
+		WriteFields(writer, value.userID, value.nickName, value.faceURL, value.selfSignature, value.gender, value.role, value.level, value.birthday,
+					value.allowType, value.customInfo, value.modifyFlag);
+	}
+
+	void ReadValue(EventReader &reader, V2TIMUserFullInfo &out)
+	{
+		ReadFields(reader, out.userID, out.nickName, out.faceURL, out.selfSignature, out.gender, out.role, out.level, out.birthday,
+				   out.allowType, out.customInfo, out.modifyFlag);
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMUserStatus &value) { WriteFields(writer, value.userID, value.statusType, value.customStatus); }
+	void ReadValue(EventReader &reader, V2TIMUserStatus &out) { ReadFields(reader, out.userID, out.statusType, out.customStatus); }
+
+	void WriteValue(EventWriter &writer, const V2TIMMessageReceipt &value)
+	{
+		WriteFields(writer, value.msgID, value.userID, value.isPeerRead, value.timestamp, value.groupID);
+	}
+
+	void ReadValue(EventReader &reader, V2TIMMessageReceipt &out)
+	{
+		ReadFields(reader, out.msgID, out.userID, out.isPeerRead, out.timestamp, out.groupID);
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMMessageExtension &value) { WriteFields(writer, value.extensionKey, value.extensionValue); }
+	void ReadValue(EventReader &reader, V2TIMMessageExtension &out) { ReadFields(reader, out.extensionKey, out.extensionValue); }
+
+	void WriteValue(EventWriter &writer, const V2TIMGroupMemberInfo &value)
+	{
+		WriteFields(writer, value.userID, value.nickName, value.friendRemark, value.nameCard, value.faceURL);
+	}
+
+	void ReadValue(EventReader &reader, V2TIMGroupMemberInfo &out)
+	{
+		ReadFields(reader, out.userID, out.nickName, out.friendRemark, out.nameCard, out.faceURL);
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMGroupMemberChangeInfo &value) { WriteFields(writer, value.userID, value.muteTime); }
+	void ReadValue(EventReader &reader, V2TIMGroupMemberChangeInfo &out) { ReadFields(reader, out.userID, out.muteTime); }
+
+	void WriteValue(EventWriter &writer, const V2TIMGroupChangeInfo &value)
+	{
+		WriteFields(writer, value.type, value.value, value.key, value.boolValue, value.intValue);
+	}
+
+	void ReadValue(EventReader &reader, V2TIMGroupChangeInfo &out)
+	{
+		ReadFields(reader, out.type, out.value, out.key, out.boolValue, out.intValue);
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMGroupAtInfo &value) { WriteFields(writer, value.seq, value.atType); }
+	void ReadValue(EventReader &reader, V2TIMGroupAtInfo &out) { ReadFields(reader, out.seq, out.atType); }
+
+	void WriteValue(EventWriter &writer, const V2TIMTopicInfo &value)
+	{
+		WriteFields(writer, value.topicID, value.topicName, value.topicFaceURL, value.introduction, value.notification, value.isAllMuted,
+					value.selfMuteTime, value.customString, value.recvOpt, value.draftText, value.unreadCount, value.groupAtInfoList, value.modifyFlag);
+	}
+
+	void ReadValue(EventReader &reader, V2TIMTopicInfo &out)
+	{
+		ReadFields(reader, out.topicID, out.topicName, out.topicFaceURL, out.introduction, out.notification, out.isAllMuted,
+				   out.selfMuteTime, out.customString, out.recvOpt, out.draftText, out.unreadCount, out.groupAtInfoList, out.modifyFlag);
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMConversation &value)
+	{
+		WriteFields(writer, value.type, value.conversationID, value.userID, value.groupID, value.groupType, value.showName, value.faceUrl,
+					value.unreadCount, value.recvOpt, value.groupAtInfolist, value.draftText, value.draftTimestamp, value.isPinned, value.orderKey,
+					value.markList, value.customData, value.conversationGroupList);
+	}
+
+	void ReadValue(EventReader &reader, V2TIMConversation &out)
+	{
+		ReadFields(reader, out.type, out.conversationID, out.userID, out.groupID, out.groupType, out.showName, out.faceUrl,
+				   out.unreadCount, out.recvOpt, out.groupAtInfolist, out.draftText, out.draftTimestamp, out.isPinned, out.orderKey,
+				   out.markList, out.customData, out.conversationGroupList);
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMConversationListFilter &value) { WriteFields(writer, value.type, value.conversationGroup, value.markType); }
+	void ReadValue(EventReader &reader, V2TIMConversationListFilter &out) { ReadFields(reader, out.type, out.conversationGroup, out.markType); }
+
+	void WriteValue(EventWriter &writer, const V2TIMFriendApplication &value)
+	{
+		WriteFields(writer, value.userID, value.nickName, value.faceUrl, value.addTime, value.addSource, value.addWording, value.type);
+	}
+
+	void ReadValue(EventReader &reader, V2TIMFriendApplication &out)
+	{
+		ReadFields(reader, out.userID, out.nickName, out.faceUrl, out.addTime, out.addSource, out.addWording, out.type);
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMFriendInfo &value)
+	{
+		WriteFields(writer, value.userID, value.friendRemark, value.friendAddTime, value.friendCustomInfo, value.friendGroups, value.userFullInfo,
+					value.modifyFlag);
+	}
+
+	void ReadValue(EventReader &reader, V2TIMFriendInfo &out)
+	{
+		ReadFields(reader, out.userID, out.friendRemark, out.friendAddTime, out.friendCustomInfo, out.friendGroups, out.userFullInfo,
+				   out.modifyFlag);
+	}
+
+	/**
+	 * 元素：类型 + 各类型的字段；富媒体元素只有本地路径、大小等，不包括下载地址
+	 */
+	void WriteValue(EventWriter &writer, const V2TIMElem &value)
+	{
+		WriteValue(writer, value.elemType);
+		switch (value.elemType)
+		{
+		case V2TIM_ELEM_TYPE_TEXT:
+		{
+			const V2TIMTextElem &Elem = static_cast<const V2TIMTextElem &>(value);
+			WriteFields(writer, Elem.text);
+			break;
+		}
+		case V2TIM_ELEM_TYPE_CUSTOM:
+		{
+			const V2TIMCustomElem &Elem = static_cast<const V2TIMCustomElem &>(value);
+			WriteFields(writer, Elem.data, Elem.desc, Elem.extension);
+			break;
+		}
+		case V2TIM_ELEM_TYPE_IMAGE:
+		{
+			const V2TIMImageElem &Elem = static_cast<const V2TIMImageElem &>(value);
+			WriteFields(writer, Elem.path);
+			break;
+		}
+		case V2TIM_ELEM_TYPE_SOUND:
+		{
+			const V2TIMSoundElem &Elem = static_cast<const V2TIMSoundElem &>(value);
+			WriteFields(writer, Elem.path, Elem.uuid, Elem.dataSize, Elem.duration);
+			break;
+		}
+		case V2TIM_ELEM_TYPE_VIDEO:
+		{
+			const V2TIMVideoElem &Elem = static_cast<const V2TIMVideoElem &>(value);
+			WriteFields(writer, Elem.videoPath, Elem.snapshotPath, Elem.videoUUID, Elem.videoSize, Elem.duration);
+			break;
+		}
+		case V2TIM_ELEM_TYPE_FILE:
+		{
+			const V2TIMFileElem &Elem = static_cast<const V2TIMFileElem &>(value);
+			WriteFields(writer, Elem.path, Elem.uuid, Elem.filename, Elem.fileSize);
+			break;
+		}
+		case V2TIM_ELEM_TYPE_LOCATION:
+		{
+			const V2TIMLocationElem &Elem = static_cast<const V2TIMLocationElem &>(value);
+			WriteFields(writer, Elem.desc, Elem.longitude, Elem.latitude);
+			break;
+		}
+		case V2TIM_ELEM_TYPE_FACE:
+		{
+			const V2TIMFaceElem &Elem = static_cast<const V2TIMFaceElem &>(value);
+			WriteFields(writer, Elem.index, Elem.data);
+			break;
+		}
+		case V2TIM_ELEM_TYPE_GROUP_TIPS:
+		{
+			const V2TIMGroupTipsElem &Elem = static_cast<const V2TIMGroupTipsElem &>(value);
+			WriteFields(writer, Elem.groupID, Elem.type, Elem.opMember, Elem.memberList, Elem.groupChangeInfoList, Elem.memberChangeInfoList,
+						Elem.memberCount);
+			break;
+		}
+		case V2TIM_ELEM_TYPE_MERGER:
+		{
+			const V2TIMMergerElem &Elem = static_cast<const V2TIMMergerElem &>(value);
+			WriteFields(writer, Elem.layersOverLimit, Elem.title, Elem.abstractList);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	/**
+	 * 读出一个元素，返回 new 出来的对象（由消息的 elemList 持有）
+	 */
+	V2TIMElem *ReadElem(EventReader &reader)
+	{
+		V2TIMElemType Type = V2TIM_ELEM_TYPE_NONE;
+		ReadValue(reader, Type);
+		switch (Type)
+		{
+		case V2TIM_ELEM_TYPE_TEXT:
+		{
+			V2TIMTextElem *Elem = new V2TIMTextElem();
+			ReadFields(reader, Elem->text);
+			return Elem;
+		}
+		case V2TIM_ELEM_TYPE_CUSTOM:
+		{
+			V2TIMCustomElem *Elem = new V2TIMCustomElem();
+			ReadFields(reader, Elem->data, Elem->desc, Elem->extension);
+			return Elem;
+		}
+		case V2TIM_ELEM_TYPE_IMAGE:
+		{
+			V2TIMImageElem *Elem = new V2TIMImageElem();
+			ReadFields(reader, Elem->path);
+			return Elem;
+		}
+		case V2TIM_ELEM_TYPE_SOUND:
+		{
+			V2TIMSoundElem *Elem = new V2TIMSoundElem();
+			ReadFields(reader, Elem->path, Elem->uuid, Elem->dataSize, Elem->duration);
+			return Elem;
+		}
+		case V2TIM_ELEM_TYPE_VIDEO:
+		{
+			V2TIMVideoElem *Elem = new V2TIMVideoElem();
+			ReadFields(reader, Elem->videoPath, Elem->snapshotPath, Elem->videoUUID, Elem->videoSize, Elem->duration);
+			return Elem;
+		}
+		case V2TIM_ELEM_TYPE_FILE:
+		{
+			V2TIMFileElem *Elem = new V2TIMFileElem();
+			ReadFields(reader, Elem->path, Elem->uuid, Elem->filename, Elem->fileSize);
+			return Elem;
+		}
+		case V2TIM_ELEM_TYPE_LOCATION:
+		{
+			V2TIMLocationElem *Elem = new V2TIMLocationElem();
+			ReadFields(reader, Elem->desc, Elem->longitude, Elem->latitude);
+			return Elem;
+		}
+		case V2TIM_ELEM_TYPE_FACE:
+		{
+			V2TIMFaceElem *Elem = new V2TIMFaceElem();
+			ReadFields(reader, Elem->index, Elem->data);
+			return Elem;
+		}
+		case V2TIM_ELEM_TYPE_GROUP_TIPS:
+		{
+			V2TIMGroupTipsElem *Elem = new V2TIMGroupTipsElem();
+			ReadFields(reader, Elem->groupID, Elem->type, Elem->opMember, Elem->memberList, Elem->groupChangeInfoList, Elem->memberChangeInfoList,
+					   Elem->memberCount);
+			return Elem;
+		}
+		case V2TIM_ELEM_TYPE_MERGER:
+		{
+			V2TIMMergerElem *Elem = new V2TIMMergerElem();
+			ReadFields(reader, Elem->layersOverLimit, Elem->title, Elem->abstractList);
+			return Elem;
+		}
+		default:
+		{
+			V2TIMElem *Elem = new V2TIMElem();
+			Elem->elemType = Type;
+			return Elem;
+		}
+		}
+	}
+
+	void WriteValue(EventWriter &writer, const V2TIMMessage &value)
+	{
+		WriteFields(writer, value.msgID, value.timestamp, value.sender, value.nickName, value.friendRemark, value.nameCard, value.faceURL,
+					value.groupID, value.userID, value.seq, value.random, value.status, value.supportMessageExtension, value.isSelf,
+					value.needReadReceipt, value.isBroadcastMessage, value.priority, value.groupAtUserList, value.cloudCustomData,
+					value.isExcludedFromUnreadCount, value.isExcludedFromLastMessage, value.isRead, value.isPeerRead);
+		writer.Varint(value.elemList.Size());
+		for (size_t Index = 0; Index < value.elemList.Size(); ++Index)
+		{
+			WriteValue(writer, *value.elemList[Index]);
+		}
+	}
+
+	void ReadValue(EventReader &reader, V2TIMMessage &out)
+	{
+		ReadFields(reader, out.msgID, out.timestamp, out.sender, out.nickName, out.friendRemark, out.nameCard, out.faceURL,
+				   out.groupID, out.userID, out.seq, out.random, out.status, out.supportMessageExtension, out.isSelf,
+				   out.needReadReceipt, out.isBroadcastMessage, out.priority, out.groupAtUserList, out.cloudCustomData,
+				   out.isExcludedFromUnreadCount, out.isExcludedFromLastMessage, out.isRead, out.isPeerRead);
+		const uint64 Count = reader.Count();
+		for (uint64 Index = 0; Index < Count && reader.IsOk(); ++Index)
+		{
+			out.elemList.PushBack(ReadElem(reader));
+		}
+	}
+
+	/**
+	 * 录制文件的写线程：SDK 线程只把事件追加到内存缓冲区，这里每 10 毫秒或缓冲区过半时换出缓冲区写入文件
+	 */
+	class EventFileWriter final : public FRunnable
+	{
+	public:
+		EventFileWriter(TUniquePtr<FArchive> &&archive, int32 maxBufferBytes)
+			: Archive(MoveTemp(archive)), MaxBufferBytes(maxBufferBytes), WakeEvent(FPlatformProcess::GetSynchEventFromPool())
+		{
+			Thread = FRunnableThread::Create(this, TEXT("TencentCloudChatEventRecord"));
+		}
+
+		/**
+		 * 等写线程退出后写出剩余的事件并关闭文件
+		 */
+		~EventFileWriter() override
+		{
+			bStopping = true;
+			WakeEvent->Trigger();
+			if (Thread)
+			{
+				Thread->WaitForCompletion();
+				delete Thread;
+			}
+			FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+			Flush();
+			Archive->Close();
+		}
+
+		/**
+		 * 缓冲区放不下时返回 false，事件被丢弃
+		 */
+		bool Append(const EventWriter &length, const EventWriter &header, const EventWriter &payload)
+		{
+			bool bWake = false;
+			{
+				FScopeLock Lock(&Mutex);
+				if (Buffer.Num() + length.Data.Num() + header.Data.Num() + payload.Data.Num() > MaxBufferBytes)
+				{
+					return false;
+				}
+				Buffer.Append(length.Data);
+				Buffer.Append(header.Data);
+				Buffer.Append(payload.Data);
+				bWake = Buffer.Num() >= MaxBufferBytes / 2;
+			}
+			if (bWake)
+			{
+				WakeEvent->Trigger();
+			}
+			return true;
+		}
+
+		uint32 Run() override
+		{
+			while (!bStopping)
+			{
+				WakeEvent->Wait(10);
+				Flush();
+			}
+			return 0;
+		}
+
+		void Stop() override
+		{
+			bStopping = true;
+		}
+
+	private:
+		// 只在写线程上调用，写线程退出后由析构调用
+		void Flush()
+		{
+			{
+				FScopeLock Lock(&Mutex);
+				Swap(Buffer, WriteBuffer);
+			}
+			if (WriteBuffer.Num() > 0)
+			{
+				Archive->Serialize(WriteBuffer.GetData(), WriteBuffer.Num());
+				WriteBuffer.Reset();
+			}
+		}
+
+		TUniquePtr<FArchive> Archive;
+		int32 MaxBufferBytes = 0;
+		FCriticalSection Mutex;
+		TArray<uint8> Buffer;
+		// 写线程正在写出的缓冲区，两个缓冲区交替使用以复用内存
+		TArray<uint8> WriteBuffer;
+		FEvent *WakeEvent = nullptr;
+		TAtomic<bool> bStopping{false};
+		FRunnableThread *Thread = nullptr;
+	};
+
+	/**
+	 * 同时实现六个监听器接口，每个事件序列化后交给 EventFileWriter
+	 */
+	class EventRecorderListener final : public V2TIMSDKListener,
+										public V2TIMAdvancedMsgListener,
+										public V2TIMGroupListener,
+										public V2TIMConversationListener,
+										public V2TIMFriendshipListener,
+										public V2TIMSignalingListener
+	{
+	public:
+		bool Open(const FString &path)
+		{
+			IFileManager::Get().MakeDirectory(*FPaths::GetPath(path), true);
+			TUniquePtr<FArchive> NewArchive(IFileManager::Get().CreateFileWriter(*path));
+			if (!NewArchive)
+			{
+				return false;
+			}
+			EventWriter Header;
+			Header.Raw(EventFileMagic, sizeof(EventFileMagic));
+			Header.Varint(EventFileVersion);
+			Header.Varint(uint64(FDateTime::UtcNow().GetTicks()));
+			NewArchive->Serialize(Header.Data.GetData(), Header.Data.Num());
+
+			const int32 MaxBufferBytes = FMath::Clamp(CVarEventRecordMaxBufferKB.GetValueOnAnyThread(), 64, MAX_int32 / 1024) * 1024;
+			FScopeLock Lock(&Mutex);
+			Writer = MakeUnique<EventFileWriter>(MoveTemp(NewArchive), MaxBufferBytes);
+			StartSeconds = FPlatformTime::Seconds();
+			LastEventMicros = 0;
+			Events = 0;
+			Dropped = 0;
+			return true;
+		}
+
+		void Close()
+		{
+			TUniquePtr<EventFileWriter> Closing;
+			{
+				FScopeLock Lock(&Mutex);
+				Closing = MoveTemp(Writer);
+			}
+			// 在锁外等写线程写完
+		}
+
+		bool IsOpen()
+		{
+			FScopeLock Lock(&Mutex);
+			return Writer.IsValid();
+		}
+
+		int64 GetEvents()
+		{
+			FScopeLock Lock(&Mutex);
+			return Events;
+		}
+
+		int64 GetDropped()
+		{
+			FScopeLock Lock(&Mutex);
+			return Dropped;
+		}
+
+		// V2TIMSDKListener
+		void OnConnecting() override { Record(RecordedEvent::Connecting); }
+		void OnConnectSuccess() override { Record(RecordedEvent::ConnectSuccess); }
+		void OnConnectFailed(int error_code, const V2TIMString &error_message) override { Record(RecordedEvent::ConnectFailed, error_code, error_message); }
+		void OnKickedOffline() override { Record(RecordedEvent::KickedOffline); }
+		void OnUserSigExpired() override { Record(RecordedEvent::UserSigExpired); }
+		void OnSelfInfoUpdated(const V2TIMUserFullInfo &info) override { Record(RecordedEvent::SelfInfoUpdated, info); }
+		void OnUserStatusChanged(const V2TIMUserStatusVector &userStatusList) override { Record(RecordedEvent::UserStatusChanged, userStatusList); }
+
+		// V2TIMAdvancedMsgListener
+		void OnRecvNewMessage(const V2TIMMessage &message) override { Record(RecordedEvent::RecvNewMessage, message); }
+		void OnRecvC2CReadReceipt(const V2TIMMessageReceiptVector &receiptList) override { Record(RecordedEvent::RecvC2CReadReceipt, receiptList); }
+		void OnRecvMessageReadReceipts(const V2TIMMessageReceiptVector &receiptList) override { Record(RecordedEvent::RecvMessageReadReceipts, receiptList); }
+		void OnRecvMessageRevoked(const V2TIMString &messageID) override { Record(RecordedEvent::RecvMessageRevoked, messageID); }
+		void OnRecvMessageModified(const V2TIMMessage &message) override { Record(RecordedEvent::RecvMessageModified, message); }
+		void OnRecvMessageExtensionsChanged(const V2TIMString &msgID, const V2TIMMessageExtensionVector &extensions) override
+		{
+			Record(RecordedEvent::RecvMessageExtensionsChanged, msgID, extensions);
+		}
+		void OnRecvMessageExtensionsDeleted(const V2TIMString &msgID, const V2TIMStringVector &extensionKeys) override
+		{
+			Record(RecordedEvent::RecvMessageExtensionsDeleted, msgID, extensionKeys);
+		}
+
+		// V2TIMGroupListener
+		void OnMemberEnter(const V2TIMString &groupID, const V2TIMGroupMemberInfoVector &memberList) override { Record(RecordedEvent::MemberEnter, groupID, memberList); }
+		void OnMemberLeave(const V2TIMString &groupID, const V2TIMGroupMemberInfo &member) override { Record(RecordedEvent::MemberLeave, groupID, member); }
+		void OnMemberInvited(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser, const V2TIMGroupMemberInfoVector &memberList) override
+		{
+			Record(RecordedEvent::MemberInvited, groupID, opUser, memberList);
+		}
+		void OnMemberKicked(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser, const V2TIMGroupMemberInfoVector &memberList) override
+		{
+			Record(RecordedEvent::MemberKicked, groupID, opUser, memberList);
+		}
+		void OnMemberInfoChanged(const V2TIMString &groupID, const V2TIMGroupMemberChangeInfoVector &v2TIMGroupMemberChangeInfoList) override
+		{
+			Record(RecordedEvent::MemberInfoChanged, groupID, v2TIMGroupMemberChangeInfoList);
+		}
+		void OnGroupCreated(const V2TIMString &groupID) override { Record(RecordedEvent::GroupCreated, groupID); }
+		void OnGroupDismissed(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser) override { Record(RecordedEvent::GroupDismissed, groupID, opUser); }
+		void OnGroupRecycled(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser) override { Record(RecordedEvent::GroupRecycled, groupID, opUser); }
+		void OnGroupInfoChanged(const V2TIMString &groupID, const V2TIMGroupChangeInfoVector &changeInfos) override
+		{
+			Record(RecordedEvent::GroupInfoChanged, groupID, changeInfos);
+		}
+		void OnGroupAttributeChanged(const V2TIMString &groupID, const V2TIMGroupAttributeMap &groupAttributeMap) override
+		{
+			Record(RecordedEvent::GroupAttributeChanged, groupID, groupAttributeMap);
+		}
+		void OnGroupCounterChanged(const V2TIMString &groupID, const V2TIMString &key, int64_t newValue) override
+		{
+			Record(RecordedEvent::GroupCounterChanged, groupID, key, newValue);
+		}
+		void OnReceiveJoinApplication(const V2TIMString &groupID, const V2TIMGroupMemberInfo &member, const V2TIMString &opReason) override
+		{
+			Record(RecordedEvent::ReceiveJoinApplication, groupID, member, opReason);
+		}
+		void OnApplicationProcessed(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser, bool isAgreeJoin, const V2TIMString &opReason) override
+		{
+			Record(RecordedEvent::ApplicationProcessed, groupID, opUser, isAgreeJoin, opReason);
+		}
+		void OnGrantAdministrator(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser, const V2TIMGroupMemberInfoVector &memberList) override
+		{
+			Record(RecordedEvent::GrantAdministrator, groupID, opUser, memberList);
+		}
+		void OnRevokeAdministrator(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser, const V2TIMGroupMemberInfoVector &memberList) override
+		{
+			Record(RecordedEvent::RevokeAdministrator, groupID, opUser, memberList);
+		}
+		void OnQuitFromGroup(const V2TIMString &groupID) override { Record(RecordedEvent::QuitFromGroup, groupID); }
+		void OnReceiveRESTCustomData(const V2TIMString &groupID, const V2TIMBuffer &customData) override { Record(RecordedEvent::ReceiveRESTCustomData, groupID, customData); }
+		void OnTopicCreated(const V2TIMString &groupID, const V2TIMString &topicID) override { Record(RecordedEvent::TopicCreated, groupID, topicID); }
+		void OnTopicDeleted(const V2TIMString &groupID, const V2TIMStringVector &topicIDList) override { Record(RecordedEvent::TopicDeleted, groupID, topicIDList); }
+		void OnTopicChanged(const V2TIMString &groupID, const V2TIMTopicInfo &topicInfo) override { Record(RecordedEvent::TopicChanged, groupID, topicInfo); }
+
+		// V2TIMConversationListener
+		void OnSyncServerStart() override { Record(RecordedEvent::SyncServerStart); }
+		void OnSyncServerFinish() override { Record(RecordedEvent::SyncServerFinish); }
+		void OnSyncServerFailed() override { Record(RecordedEvent::SyncServerFailed); }
+		void OnNewConversation(const V2TIMConversationVector &conversationList) override { Record(RecordedEvent::NewConversation, conversationList); }
+		void OnConversationChanged(const V2TIMConversationVector &conversationList) override { Record(RecordedEvent::ConversationChanged, conversationList); }
+		void OnTotalUnreadMessageCountChanged(uint64_t totalUnreadCount) override { Record(RecordedEvent::TotalUnreadMessageCountChanged, totalUnreadCount); }
+		void OnUnreadMessageCountChangedByFilter(const V2TIMConversationListFilter &filter, uint64_t totalUnreadCount) override
+		{
+			Record(RecordedEvent::UnreadMessageCountChangedByFilter, filter, totalUnreadCount);
+		}
+		void OnConversationGroupCreated(const V2TIMString &groupName, const V2TIMConversationVector &conversationList) override
+		{
+			Record(RecordedEvent::ConversationGroupCreated, groupName, conversationList);
+		}
+		void OnConversationGroupDeleted(const V2TIMString &groupName) override { Record(RecordedEvent::ConversationGroupDeleted, groupName); }
+		void OnConversationGroupNameChanged(const V2TIMString &oldName, const V2TIMString &newName) override
+		{
+			Record(RecordedEvent::ConversationGroupNameChanged, oldName, newName);
+		}
+		void OnConversationsAddedToGroup(const V2TIMString &groupName, const V2TIMConversationVector &conversationList) override
+		{
+			Record(RecordedEvent::ConversationsAddedToGroup, groupName, conversationList);
+		}
+		void OnConversationsDeletedFromGroup(const V2TIMString &groupName, const V2TIMConversationVector &conversationList) override
+		{
+			Record(RecordedEvent::ConversationsDeletedFromGroup, groupName, conversationList);
+		}
+
+		// V2TIMFriendshipListener
+		void OnFriendApplicationListAdded(const V2TIMFriendApplicationVector &applicationList) override { Record(RecordedEvent::FriendApplicationListAdded, applicationList); }
+		void OnFriendApplicationListDeleted(const V2TIMStringVector &userIDList) override { Record(RecordedEvent::FriendApplicationListDeleted, userIDList); }
+		void OnFriendApplicationListRead() override { Record(RecordedEvent::FriendApplicationListRead); }
+		void OnFriendListAdded(const V2TIMFriendInfoVector &userIDList) override { Record(RecordedEvent::FriendListAdded, userIDList); }
+		void OnFriendListDeleted(const V2TIMStringVector &userIDList) override { Record(RecordedEvent::FriendListDeleted, userIDList); }
+		void OnBlackListAdded(const V2TIMFriendInfoVector &infoList) override { Record(RecordedEvent::BlackListAdded, infoList); }
+		void OnBlackListDeleted(const V2TIMStringVector &userIDList) override { Record(RecordedEvent::BlackListDeleted, userIDList); }
+		void OnFriendInfoChanged(const V2TIMFriendInfoVector &infoList) override { Record(RecordedEvent::FriendInfoChanged, infoList); }
+
+		// V2TIMSignalingListener
+		void OnReceiveNewInvitation(const V2TIMString &inviteID, const V2TIMString &inviter, const V2TIMString &groupID, const V2TIMStringVector &inviteeList,
+									const V2TIMString &data) override
+		{
+			Record(RecordedEvent::ReceiveNewInvitation, inviteID, inviter, groupID, inviteeList, data);
+		}
+		void OnInviteeAccepted(const V2TIMString &inviteID, const V2TIMString &invitee, const V2TIMString &data) override
+		{
+			Record(RecordedEvent::InviteeAccepted, inviteID, invitee, data);
+		}
+		void OnInviteeRejected(const V2TIMString &inviteID, const V2TIMString &invitee, const V2TIMString &data) override
+		{
+			Record(RecordedEvent::InviteeRejected, inviteID, invitee, data);
+		}
+		void OnInvitationCancelled(const V2TIMString &inviteID, const V2TIMString &inviter, const V2TIMString &data) override
+		{
+			Record(RecordedEvent::InvitationCancelled, inviteID, inviter, data);
+		}
+		void OnInvitationTimeout(const V2TIMString &inviteID, const V2TIMStringVector &inviteeList) override
+		{
+			Record(RecordedEvent::InvitationTimeout, inviteID, inviteeList);
+		}
+		void OnInvitationModified(const V2TIMString &inviteID, const V2TIMString &data) override { Record(RecordedEvent::InvitationModified, inviteID, data); }
+
+	private:
+		/**
+		 * 参数在锁外序列化，时间戳在锁内取，保证文件中事件的顺序和间隔一致；锁内只追加到内存缓冲区，不写文件。
+		 * 丢弃的事件不更新 LastEventMicros，下一个事件的间隔包含丢弃的时间
+		 */
+		template <typename... ArgTypes>
+		void Record(RecordedEvent event, const ArgTypes &...args)
+		{
+			EventWriter Payload;
+			WriteFields(Payload, args...);
+
+			FScopeLock Lock(&Mutex);
+			if (!Writer)
+			{
+				return;
+			}
+			const int64 NowMicros = int64((FPlatformTime::Seconds() - StartSeconds) * 1000000.0);
+			EventWriter Header;
+			Header.Varint(uint64(FMath::Max<int64>(NowMicros - LastEventMicros, 0)));
+			Header.Varint(uint32(event));
+
+			EventWriter Length;
+			Length.Varint(uint64(Header.Data.Num() + Payload.Data.Num()));
+			if (!Writer->Append(Length, Header, Payload))
+			{
+				++Dropped;
+				return;
+			}
+			LastEventMicros = FMath::Max(NowMicros, LastEventMicros);
+			++Events;
+		}
+
+		FCriticalSection Mutex;
+		TUniquePtr<EventFileWriter> Writer;
+		double StartSeconds = 0.0;
+		int64 LastEventMicros = 0;
+		int64 Events = 0;
+		int64 Dropped = 0;
+	};
+
+	EventRecorderListener EventRecorderInstance;
+	// 录制器注册在哪个 V2TIMManager 上，Start / Stop 之间互斥
+	FCriticalSection EventRecorderMutex;
+	V2TIMManager *EventRecorderManager = nullptr;
+
+	void AddRecorderListeners(V2TIMManager *manager)
+	{
+		manager->AddSDKListener(&EventRecorderInstance);
+		manager->GetMessageManager()->AddAdvancedMsgListener(&EventRecorderInstance);
+		manager->AddGroupListener(&EventRecorderInstance);
+		manager->GetConversationManager()->AddConversationListener(&EventRecorderInstance);
+		manager->GetFriendshipManager()->AddFriendListener(&EventRecorderInstance);
+		manager->GetSignalingManager()->AddSignalingListener(&EventRecorderInstance);
+	}
+
+	void RemoveRecorderListeners(V2TIMManager *manager)
+	{
+		manager->RemoveSDKListener(&EventRecorderInstance);
+		manager->GetMessageManager()->RemoveAdvancedMsgListener(&EventRecorderInstance);
+		manager->RemoveGroupListener(&EventRecorderInstance);
+		manager->GetConversationManager()->RemoveConversationListener(&EventRecorderInstance);
+		manager->GetFriendshipManager()->RemoveFriendListener(&EventRecorderInstance);
+		manager->GetSignalingManager()->RemoveSignalingListener(&EventRecorderInstance);
+	}
+
+	// 回放时按接口类型取出对应的监听器列表
+	const auto &GetReplayListeners(const TencentCloudChatLoopbackListeners &listeners, V2TIMSDKListener *) { return listeners.SDK; }
+	const auto &GetReplayListeners(const TencentCloudChatLoopbackListeners &listeners, V2TIMAdvancedMsgListener *) { return listeners.AdvancedMsg; }
+	const auto &GetReplayListeners(const TencentCloudChatLoopbackListeners &listeners, V2TIMGroupListener *) { return listeners.Group; }
+	const auto &GetReplayListeners(const TencentCloudChatLoopbackListeners &listeners, V2TIMConversationListener *) { return listeners.Conversation; }
+	const auto &GetReplayListeners(const TencentCloudChatLoopbackListeners &listeners, V2TIMFriendshipListener *) { return listeners.Friendship; }
+	const auto &GetReplayListeners(const TencentCloudChatLoopbackListeners &listeners, V2TIMSignalingListener *) { return listeners.Signaling; }
+
+	enum class ReplayResult : uint8
+	{
+		Posted,
+		Unknown,
+		Malformed,
+		NoManager,
+	};
+
+	/**
+	 * 按监听器方法的参数类型读出参数，交给回环后端在模拟网络线程上调用该接口的所有监听器
+	 */
+	template <typename ListenerType, typename... ParamTypes>
+	ReplayResult PostReplayEvent(EventReader &reader, V2TIMManager *manager, void (ListenerType::*method)(ParamTypes...))
+	{
+		TTuple<std::decay_t<ParamTypes>...> Args;
+		VisitTupleElements([&reader](auto &Arg) { ReadValue(reader, Arg); }, Args);
+		if (!reader.IsOk())
+		{
+			return ReplayResult::Malformed;
+		}
+		const bool bPosted = TencentCloudChatLoopback::PostEvent(manager, [method, Args = MoveTemp(Args)](const TencentCloudChatLoopbackListeners &Listeners)
+		{
+			for (ListenerType *Listener : GetReplayListeners(Listeners, static_cast<ListenerType *>(nullptr)))
+			{
+				Args.ApplyAfter(method, Listener);
+			}
+		});
+		return bPosted ? ReplayResult::Posted : ReplayResult::NoManager;
+	}
+
+	ReplayResult ReplayEvent(uint64 event, EventReader &reader, V2TIMManager *manager)
+	{
+		switch (RecordedEvent(event))
+		{
+		case RecordedEvent::Connecting: return PostReplayEvent(reader, manager, &V2TIMSDKListener::OnConnecting);
+		case RecordedEvent::ConnectSuccess: return PostReplayEvent(reader, manager, &V2TIMSDKListener::OnConnectSuccess);
+		case RecordedEvent::ConnectFailed: return PostReplayEvent(reader, manager, &V2TIMSDKListener::OnConnectFailed);
+		case RecordedEvent::KickedOffline: return PostReplayEvent(reader, manager, &V2TIMSDKListener::OnKickedOffline);
+		case RecordedEvent::UserSigExpired: return PostReplayEvent(reader, manager, &V2TIMSDKListener::OnUserSigExpired);
+		case RecordedEvent::SelfInfoUpdated: return PostReplayEvent(reader, manager, &V2TIMSDKListener::OnSelfInfoUpdated);
+		case RecordedEvent::UserStatusChanged: return PostReplayEvent(reader, manager, &V2TIMSDKListener::OnUserStatusChanged);
+
+		case RecordedEvent::RecvNewMessage: return PostReplayEvent(reader, manager, &V2TIMAdvancedMsgListener::OnRecvNewMessage);
+		case RecordedEvent::RecvC2CReadReceipt: return PostReplayEvent(reader, manager, &V2TIMAdvancedMsgListener::OnRecvC2CReadReceipt);
+		case RecordedEvent::RecvMessageReadReceipts: return PostReplayEvent(reader, manager, &V2TIMAdvancedMsgListener::OnRecvMessageReadReceipts);
+		case RecordedEvent::RecvMessageRevoked: return PostReplayEvent(reader, manager, &V2TIMAdvancedMsgListener::OnRecvMessageRevoked);
+		case RecordedEvent::RecvMessageModified: return PostReplayEvent(reader, manager, &V2TIMAdvancedMsgListener::OnRecvMessageModified);
+		case RecordedEvent::RecvMessageExtensionsChanged: return PostReplayEvent(reader, manager, &V2TIMAdvancedMsgListener::OnRecvMessageExtensionsChanged);
+		case RecordedEvent::RecvMessageExtensionsDeleted: return PostReplayEvent(reader, manager, &V2TIMAdvancedMsgListener::OnRecvMessageExtensionsDeleted);
+
+		case RecordedEvent::MemberEnter: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnMemberEnter);
+		case RecordedEvent::MemberLeave: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnMemberLeave);
+		case RecordedEvent::MemberInvited: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnMemberInvited);
+		case RecordedEvent::MemberKicked: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnMemberKicked);
+		case RecordedEvent::MemberInfoChanged: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnMemberInfoChanged);
+		case RecordedEvent::GroupCreated: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnGroupCreated);
+		case RecordedEvent::GroupDismissed: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnGroupDismissed);
+		case RecordedEvent::GroupRecycled: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnGroupRecycled);
+		case RecordedEvent::GroupInfoChanged: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnGroupInfoChanged);
+		case RecordedEvent::GroupAttributeChanged: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnGroupAttributeChanged);
+		case RecordedEvent::GroupCounterChanged: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnGroupCounterChanged);
+		case RecordedEvent::ReceiveJoinApplication: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnReceiveJoinApplication);
+		case RecordedEvent::ApplicationProcessed: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnApplicationProcessed);
+		case RecordedEvent::GrantAdministrator: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnGrantAdministrator);
+		case RecordedEvent::RevokeAdministrator: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnRevokeAdministrator);
+		case RecordedEvent::QuitFromGroup: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnQuitFromGroup);
+		case RecordedEvent::ReceiveRESTCustomData: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnReceiveRESTCustomData);
+		case RecordedEvent::TopicCreated: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnTopicCreated);
+		case RecordedEvent::TopicDeleted: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnTopicDeleted);
+		case RecordedEvent::TopicChanged: return PostReplayEvent(reader, manager, &V2TIMGroupListener::OnTopicChanged);
+
+		case RecordedEvent::SyncServerStart: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnSyncServerStart);
+		case RecordedEvent::SyncServerFinish: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnSyncServerFinish);
+		case RecordedEvent::SyncServerFailed: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnSyncServerFailed);
+		case RecordedEvent::NewConversation: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnNewConversation);
+		case RecordedEvent::ConversationChanged: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnConversationChanged);
+		case RecordedEvent::TotalUnreadMessageCountChanged: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnTotalUnreadMessageCountChanged);
+		case RecordedEvent::UnreadMessageCountChangedByFilter: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnUnreadMessageCountChangedByFilter);
+		case RecordedEvent::ConversationGroupCreated: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnConversationGroupCreated);
+		case RecordedEvent::ConversationGroupDeleted: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnConversationGroupDeleted);
+		case RecordedEvent::ConversationGroupNameChanged: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnConversationGroupNameChanged);
+		case RecordedEvent::ConversationsAddedToGroup: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnConversationsAddedToGroup);
+		case RecordedEvent::ConversationsDeletedFromGroup: return PostReplayEvent(reader, manager, &V2TIMConversationListener::OnConversationsDeletedFromGroup);
+
+		case RecordedEvent::FriendApplicationListAdded: return PostReplayEvent(reader, manager, &V2TIMFriendshipListener::OnFriendApplicationListAdded);
+		case RecordedEvent::FriendApplicationListDeleted: return PostReplayEvent(reader, manager, &V2TIMFriendshipListener::OnFriendApplicationListDeleted);
+		case RecordedEvent::FriendApplicationListRead: return PostReplayEvent(reader, manager, &V2TIMFriendshipListener::OnFriendApplicationListRead);
+		case RecordedEvent::FriendListAdded: return PostReplayEvent(reader, manager, &V2TIMFriendshipListener::OnFriendListAdded);
+		case RecordedEvent::FriendListDeleted: return PostReplayEvent(reader, manager, &V2TIMFriendshipListener::OnFriendListDeleted);
+		case RecordedEvent::BlackListAdded: return PostReplayEvent(reader, manager, &V2TIMFriendshipListener::OnBlackListAdded);
+		case RecordedEvent::BlackListDeleted: return PostReplayEvent(reader, manager, &V2TIMFriendshipListener::OnBlackListDeleted);
+		case RecordedEvent::FriendInfoChanged: return PostReplayEvent(reader, manager, &V2TIMFriendshipListener::OnFriendInfoChanged);
+
+		case RecordedEvent::ReceiveNewInvitation: return PostReplayEvent(reader, manager, &V2TIMSignalingListener::OnReceiveNewInvitation);
+		case RecordedEvent::InviteeAccepted: return PostReplayEvent(reader, manager, &V2TIMSignalingListener::OnInviteeAccepted);
+		case RecordedEvent::InviteeRejected: return PostReplayEvent(reader, manager, &V2TIMSignalingListener::OnInviteeRejected);
+		case RecordedEvent::InvitationCancelled: return PostReplayEvent(reader, manager, &V2TIMSignalingListener::OnInvitationCancelled);
+		case RecordedEvent::InvitationTimeout: return PostReplayEvent(reader, manager, &V2TIMSignalingListener::OnInvitationTimeout);
+		case RecordedEvent::InvitationModified: return PostReplayEvent(reader, manager, &V2TIMSignalingListener::OnInvitationModified);
+		}
+		return ReplayResult::Unknown;
+	}
+
+	/**
+	 * 从文件读一个 varint；文件结束或截断时返回 false
+	 */
+	bool ReadArchiveVarint(FArchive &archive, uint64 &out)
+	{
+		uint64 Value = 0;
+		for (int32 Shift = 0; Shift < 70 && !archive.AtEnd(); Shift += 7)
+		{
+			uint8 Byte = 0;
+			archive.Serialize(&Byte, 1);
+			Value |= uint64(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				out = Value;
+				return !archive.IsError();
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * 回放线程：逐个读出事件，等到 (录制时的偏移 / speed) 后交给回环后端
+	 */
+	class EventReplayWorker final : public FRunnable
+	{
+	public:
+		EventReplayWorker(TUniquePtr<FArchive> &&archive, const FString &path, double speed, V2TIMManager *manager)
+			: Archive(MoveTemp(archive)), Path(path), Speed(speed), Manager(manager)
+		{
+			Thread = FRunnableThread::Create(this, TEXT("TencentCloudChatEventReplay"));
+		}
+
+		~EventReplayWorker() override
+		{
+			bStopping = true;
+			if (Thread)
+			{
+				Thread->WaitForCompletion();
+				delete Thread;
+			}
+		}
+
+		bool IsFinished() const
+		{
+			return bFinished;
+		}
+
+		uint32 Run() override
+		{
+			const double StartSeconds = FPlatformTime::Seconds();
+			uint64 EventMicros = 0;
+			int64 Posted = 0;
+			int64 Unknown = 0;
+			int64 Malformed = 0;
+			bool bTruncated = false;
+			TArray<uint8> Payload;
+
+			while (!bStopping && !Archive->AtEnd())
+			{
+				uint64 Length = 0;
+				if (!ReadArchiveVarint(*Archive, Length) || Length > uint64(Archive->TotalSize() - Archive->Tell()))
+				{
+					bTruncated = true;
+					break;
+				}
+				Payload.SetNumUninitialized(int32(Length));
+				Archive->Serialize(Payload.GetData(), Payload.Num());
+
+				EventReader Reader(Payload);
+				EventMicros += Reader.Varint();
+				const uint64 Event = Reader.Varint();
+				if (!Reader.IsOk())
+				{
+					++Malformed;
+					continue;
+				}
+
+				if (Speed > 0.0)
+				{
+					const double Due = StartSeconds + double(EventMicros) / 1000000.0 / Speed;
+					for (double Now = FPlatformTime::Seconds(); Now < Due && !bStopping; Now = FPlatformTime::Seconds())
+					{
+						FPlatformProcess::SleepNoStats(float(FMath::Min(Due - Now, 0.01)));
+					}
+				}
+				while (!bStopping && TencentCloudChatLoopback::GetPendingEvents() > CVarEventReplayMaxPending.GetValueOnAnyThread())
+				{
+					FPlatformProcess::SleepNoStats(0.001f);
+				}
+				if (bStopping)
+				{
+					break;
+				}
+
+				const ReplayResult Result = ReplayEvent(Event, Reader, Manager);
+				if (Result == ReplayResult::NoManager)
+				{
+					UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatEventReplay: loopback manager is gone, stopping"));
+					break;
+				}
+				Posted += Result == ReplayResult::Posted;
+				Unknown += Result == ReplayResult::Unknown;
+				Malformed += Result == ReplayResult::Malformed;
+			}
+
+			UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChatEventReplay: %s %s after %.2fs, %lld events posted, %lld unknown, %lld malformed%s"),
+				   *Path, bStopping ? TEXT("stopped") : TEXT("finished"), FPlatformTime::Seconds() - StartSeconds, Posted, Unknown, Malformed,
+				   bTruncated ? TEXT(", file truncated") : TEXT(""));
+			Archive->Close();
+			bFinished = true;
+			return 0;
+		}
+
+		void Stop() override
+		{
+			bStopping = true;
+		}
+
+	private:
+		TUniquePtr<FArchive> Archive;
+		FString Path;
+		double Speed = 1.0;
+		V2TIMManager *Manager = nullptr;
+		TAtomic<bool> bStopping{false};
+		TAtomic<bool> bFinished{false};
+		FRunnableThread *Thread = nullptr;
+	};
+
+	FCriticalSection EventReplayMutex;
+	TUniquePtr<EventReplayWorker> EventReplayInstance;
+
+	FString DefaultEventRecordPath()
+	{
+		return FPaths::Combine(FPaths::ProfilingDir(), TEXT("TencentCloudChat"),
+							   FString::Printf(TEXT("Events-%s.tccevents"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+	}
+}
+
+bool TencentCloudChatEventRecorder::Start(const FString &path)
+{
+	V2TIMManager *Manager = TencentCloudChatBackend::Get();
+	FScopeLock Lock(&EventRecorderMutex);
+	if (EventRecorderManager || !Manager)
+	{
+		return false;
+	}
+	if (!EventRecorderInstance.Open(path))
+	{
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatEventRecorder: failed to create %s"), *path);
+		return false;
+	}
+	EventRecorderManager = Manager;
+	AddRecorderListeners(Manager);
+	UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChatEventRecorder: recording to %s"), *FPaths::ConvertRelativePathToFull(path));
+	return true;
+}
+
+void TencentCloudChatEventRecorder::Stop()
+{
+	FScopeLock Lock(&EventRecorderMutex);
+	if (!EventRecorderManager)
+	{
+		return;
+	}
+	RemoveRecorderListeners(EventRecorderManager);
+	EventRecorderManager = nullptr;
+	EventRecorderInstance.Close();
+	UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChatEventRecorder: stopped, %lld events recorded, %lld dropped"), EventRecorderInstance.GetEvents(),
+		   EventRecorderInstance.GetDropped());
+}
+
+bool TencentCloudChatEventRecorder::IsRecording()
+{
+	return EventRecorderInstance.IsOpen();
+}
+
+int64 TencentCloudChatEventRecorder::GetRecordedEvents()
+{
+	return EventRecorderInstance.GetEvents();
+}
+
+int64 TencentCloudChatEventRecorder::GetDroppedEvents()
+{
+	return EventRecorderInstance.GetDropped();
+}
+
+void TencentCloudChatEventRecorder::Shutdown()
+{
+	Stop();
+}
+
+bool TencentCloudChatEventReplay::Start(const FString &path, double speed)
+{
+	V2TIMManager *Manager = TencentCloudChatBackend::Get();
+	if (!TencentCloudChatLoopback::IsLoopback(Manager))
+	{
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatEventReplay: the current backend is not a loopback instance (start with -TencentCloudChatLoopback)"));
+		return false;
+	}
+
+	FScopeLock Lock(&EventReplayMutex);
+	if (EventReplayInstance && !EventReplayInstance->IsFinished())
+	{
+		return false;
+	}
+	EventReplayInstance.Reset();
+
+	TUniquePtr<FArchive> Archive(IFileManager::Get().CreateFileReader(*path));
+	if (!Archive)
+	{
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatEventReplay: failed to open %s"), *path);
+		return false;
+	}
+	uint8 Magic[sizeof(EventFileMagic)] = {};
+	uint64 Version = 0;
+	uint64 StartTicks = 0;
+	if (Archive->TotalSize() < int64(sizeof(Magic)))
+	{
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatEventReplay: %s is not an event recording"), *path);
+		return false;
+	}
+	Archive->Serialize(Magic, sizeof(Magic));
+	if (FMemory::Memcmp(Magic, EventFileMagic, sizeof(Magic)) != 0 || !ReadArchiveVarint(*Archive, Version) || !ReadArchiveVarint(*Archive, StartTicks))
+	{
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatEventReplay: %s is not an event recording"), *path);
+		return false;
+	}
+	if (Version != EventFileVersion)
+	{
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatEventReplay: %s has unsupported version %llu"), *path, Version);
+		return false;
+	}
+
+	UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChatEventReplay: replaying %s (recorded %s UTC) at %s"), *path,
+		   *FDateTime(int64(StartTicks)).ToString(), speed > 0.0 ? *FString::Printf(TEXT("%gx"), speed) : TEXT("max speed"));
+	EventReplayInstance = MakeUnique<EventReplayWorker>(MoveTemp(Archive), path, FMath::Max(speed, 0.0), Manager);
+	return true;
+}
+
+void TencentCloudChatEventReplay::Stop()
+{
+	TUniquePtr<EventReplayWorker> Worker;
+	{
+		FScopeLock Lock(&EventReplayMutex);
+		Worker = MoveTemp(EventReplayInstance);
+	}
+	// 析构时等待回放线程结束
+	Worker.Reset();
+}
+
+bool TencentCloudChatEventReplay::IsReplaying()
+{
+	FScopeLock Lock(&EventReplayMutex);
+	return EventReplayInstance && !EventReplayInstance->IsFinished();
+}
+
+void TencentCloudChatEventReplay::Shutdown()
+{
+	Stop();
+}
+
+static FAutoConsoleCommand GTencentCloudChatEventRecordCommand(
+	TEXT("TencentCloudChat.EventRecord"),
+	TEXT("Record listener events from the current backend. Usage: TencentCloudChat.EventRecord start [Path] | stop"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString> &Args)
+	{
+		const FString Verb = Args.Num() > 0 ? Args[0] : FString();
+		if (Verb.Equals(TEXT("stop"), ESearchCase::IgnoreCase))
+		{
+			TencentCloudChatEventRecorder::Stop();
+		}
+		else if (Verb.Equals(TEXT("start"), ESearchCase::IgnoreCase))
+		{
+			if (!TencentCloudChatEventRecorder::Start(Args.Num() > 1 ? Args[1] : DefaultEventRecordPath()))
+			{
+				UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatEventRecorder: already recording or no backend"));
+			}
+		}
+		else
+		{
+			UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChatEventRecorder: %s, %lld events, %lld dropped"),
+				   TencentCloudChatEventRecorder::IsRecording() ? TEXT("recording") : TEXT("not recording"), TencentCloudChatEventRecorder::GetRecordedEvents(),
+				   TencentCloudChatEventRecorder::GetDroppedEvents());
+		}
+	}));
+
+static FAutoConsoleCommand GTencentCloudChatEventReplayCommand(
+	TEXT("TencentCloudChat.EventReplay"),
+	TEXT("Replay a recorded event file through the loopback backend. Usage: TencentCloudChat.EventReplay <Path> [Speed=1|max] | stop"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString> &Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChatEventReplay: %s"),
+				   TencentCloudChatEventReplay::IsReplaying() ? TEXT("replaying") : TEXT("not replaying"));
+			return;
+		}
+		if (Args[0].Equals(TEXT("stop"), ESearchCase::IgnoreCase))
+		{
+			TencentCloudChatEventReplay::Stop();
+			return;
+		}
+		double Speed = 1.0;
+		if (Args.Num() > 1)
+		{
+			Speed = Args[1].Equals(TEXT("max"), ESearchCase::IgnoreCase) ? 0.0 : FCString::Atod(*Args[1]);
+		}
+		if (!TencentCloudChatEventReplay::Start(Args[0], Speed) && TencentCloudChatEventReplay::IsReplaying())
+		{
+			UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatEventReplay: already replaying"));
+		}
+	}));
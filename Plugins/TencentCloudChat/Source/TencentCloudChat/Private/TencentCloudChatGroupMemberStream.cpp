@@ -0,0 +1,232 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatGroupMemberStream.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatString.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Group Member Pages"), STAT_TencentCloudChat_GroupMemberPages, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<int32> CVarGroupMembersMaxBufferedKB(
+	TEXT("TencentCloudChat.GroupMembers.MaxBufferedKB"),
+	1024,
+	TEXT("TencentCloudChatGroupMemberStream stops prefetching while fetched but unconsumed members use more than this many KB."),
+	ECVF_Default);
+
+TSharedRef<TencentCloudChatGroupMemberStream, ESPMode::ThreadSafe> TencentCloudChatGroupMemberStream::Create(const V2TIMString &groupID, uint32 filter)
+{
+	TSharedRef<TencentCloudChatGroupMemberStream, ESPMode::ThreadSafe> Stream(new TencentCloudChatGroupMemberStream(groupID, filter));
+	Stream->Fetch();
+	return Stream;
+}
+
+TencentCloudChatGroupMemberStream::TencentCloudChatGroupMemberStream(const V2TIMString &groupID, uint32 filter)
+	: GroupID(groupID)
+	, Filter(filter)
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+int32 TencentCloudChatGroupMemberStream::Consume(int32 maxCount, TFunctionRef<void(const TencentCloudChatGroupMember &)> visitor)
+{
+	int32 Visited = 0;
+	bool bFetch;
+	{
+		FScopeLock Lock(&Mutex);
+		while (Visited < maxCount && Pages.Num() > 0)
+		{
+			Page &Front = *Pages[0];
+			const int32 Count = FMath::Min(maxCount - Visited, Front.Members.Num() - Front.Consumed);
+			for (int32 Index = Front.Consumed; Index < Front.Consumed + Count; ++Index)
+			{
+				visitor(Front.Members[Index]);
+			}
+			Front.Consumed += Count;
+			Visited += Count;
+			Available -= Count;
+
+			if (Front.Consumed == Front.Members.Num())
+			{
+				BufferedBytes -= Front.GetAllocatedSize();
+				Pages.RemoveAt(0);
+			}
+		}
+		bFetch = ShouldFetch();
+		bRequestInFlight |= bFetch;
+	}
+
+	if (bFetch)
+	{
+		Fetch();
+	}
+	return Visited;
+}
+
+int32 TencentCloudChatGroupMemberStream::GetAvailable() const
+{
+	FScopeLock Lock(&Mutex);
+	return Available;
+}
+
+bool TencentCloudChatGroupMemberStream::IsFinished() const
+{
+	FScopeLock Lock(&Mutex);
+	return bCancelled || bFailed || (bLastPageFetched && Pages.Num() == 0);
+}
+
+bool TencentCloudChatGroupMemberStream::GetError(int &outErrorCode, FString &outErrorMessage) const
+{
+	FScopeLock Lock(&Mutex);
+	if (bFailed)
+	{
+		outErrorCode = ErrorCode;
+		outErrorMessage = ErrorMessage;
+	}
+	return bFailed;
+}
+
+void TencentCloudChatGroupMemberStream::Cancel()
+{
+	FScopeLock Lock(&Mutex);
+	bCancelled = true;
+	Pages.Empty();
+	Available = 0;
+	BufferedBytes = 0;
+}
+
+int32 TencentCloudChatGroupMemberStream::GetPagesFetched() const
+{
+	FScopeLock Lock(&Mutex);
+	return PagesFetched;
+}
+
+double TencentCloudChatGroupMemberStream::GetPagesPerSecond() const
+{
+	FScopeLock Lock(&Mutex);
+	const double EndTime = bLastPageFetched ? LastPageTime : FPlatformTime::Seconds();
+	return EndTime > StartTime ? double(PagesFetched) / (EndTime - StartTime) : 0.0;
+}
+
+SIZE_T TencentCloudChatGroupMemberStream::GetBufferedBytes() const
+{
+	FScopeLock Lock(&Mutex);
+	return BufferedBytes;
+}
+
+bool TencentCloudChatGroupMemberStream::ShouldFetch() const
+{
+	return !bRequestInFlight && !bLastPageFetched && !bCancelled && !bFailed &&
+		   BufferedBytes < SIZE_T(FMath::Max(CVarGroupMembersMaxBufferedKB.GetValueOnAnyThread(), 1)) * 1024;
+}
+
+void TencentCloudChatGroupMemberStream::Fetch()
+{
+	uint64 Seq;
+	{
+		FScopeLock Lock(&Mutex);
+		bRequestInFlight = true;
+		Seq = NextSeq;
+	}
+
+	TSharedRef<TencentCloudChatGroupMemberStream, ESPMode::ThreadSafe> Self = AsShared();
+	TencentCloudChat::GetGroupMemberList(GroupID, Filter, Seq, TencentCloudChatValueCallback<V2TIMGroupMemberInfoResult>::Create(
+		[Self](const V2TIMGroupMemberInfoResult &result)
+		{
+			Self->OnPage(result);
+		},
+		[Self](int error_code, const V2TIMString &error_message)
+		{
+			Self->OnError(error_code, error_message);
+		}));
+}
+
+void TencentCloudChatGroupMemberStream::OnPage(const V2TIMGroupMemberInfoResult &result)
+{
+	// 在锁外整理分页，不阻塞读取
+	TUniquePtr<Page> NewPage = MakeUnique<Page>();
+	BuildPage(result.memberInfoList, *NewPage);
+
+	bool bFetch;
+	{
+		FScopeLock Lock(&Mutex);
+		bRequestInFlight = false;
+		if (bCancelled)
+		{
+			return;
+		}
+
+		NextSeq = result.nextSequence;
+		bLastPageFetched = result.nextSequence == 0;
+		++PagesFetched;
+		LastPageTime = FPlatformTime::Seconds();
+		INC_DWORD_STAT(STAT_TencentCloudChat_GroupMemberPages);
+
+		if (NewPage->Members.Num() > 0)
+		{
+			Available += NewPage->Members.Num();
+			BufferedBytes += NewPage->GetAllocatedSize();
+			Pages.Add(MoveTemp(NewPage));
+		}
+
+		// 立即预取下一页
+		bFetch = ShouldFetch();
+		bRequestInFlight |= bFetch;
+	}
+
+	if (bFetch)
+	{
+		Fetch();
+	}
+}
+
+void TencentCloudChatGroupMemberStream::OnError(int errorCode, const V2TIMString &errorMessage)
+{
+	FScopeLock Lock(&Mutex);
+	bRequestInFlight = false;
+	if (bCancelled)
+	{
+		return;
+	}
+	bFailed = true;
+	ErrorCode = errorCode;
+	ErrorMessage = TencentCloudChatString::ToFString(errorMessage);
+	UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatGroupMemberStream: GetGroupMemberList failed (%d) %s"), errorCode, *ErrorMessage);
+}
+
+void TencentCloudChatGroupMemberStream::BuildPage(const V2TIMGroupMemberFullInfoVector &members, Page &outPage)
+{
+	const int32 Num = int32(members.Size());
+
+	// 先算出总长度一次分配，之后的 FUtf8StringView 才不会因扩容失效
+	int32 TotalBytes = 0;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const V2TIMGroupMemberFullInfo &Member = members[Index];
+		TotalBytes += int32(Member.userID.Size() + Member.nickName.Size() + Member.nameCard.Size() + Member.faceURL.Size());
+	}
+	outPage.Strings.Reserve(TotalBytes);
+	outPage.Members.Reserve(Num);
+
+	auto Append = [&outPage](const V2TIMString &str)
+	{
+		const int32 Offset = outPage.Strings.Num();
+		outPage.Strings.Append(reinterpret_cast<const UTF8CHAR *>(str.CString()), int32(str.Size()));
+		return FUtf8StringView(outPage.Strings.GetData() + Offset, int32(str.Size()));
+	};
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const V2TIMGroupMemberFullInfo &Member = members[Index];
+		TencentCloudChatGroupMember &Compact = outPage.Members.AddDefaulted_GetRef();
+		Compact.UserID = Append(Member.userID);
+		Compact.NickName = Append(Member.nickName);
+		Compact.NameCard = Append(Member.nameCard);
+		Compact.FaceURL = Append(Member.faceURL);
+		Compact.Role = Member.role;
+		Compact.MuteUntil = Member.muteUntil;
+		Compact.JoinTime = Member.joinTime;
+	}
+}
@@ -0,0 +1,609 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatHistoryCache.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatSearch.h"
+#include "TencentCloudChatString.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/StringBuilder.h"
+#include "V2TIMErrorCode.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("History Cache Hits"), STAT_TencentCloudChat_HistoryCacheHits, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("History Cache Misses"), STAT_TencentCloudChat_HistoryCacheMisses, STATGROUP_TencentCloudChat);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Avg History Fetch Time (ms)"), STAT_TencentCloudChat_HistoryFetchTimeMs, STATGROUP_TencentCloudChat);
+DECLARE_MEMORY_STAT(TEXT("History Cache Memory"), STAT_TencentCloudChat_HistoryCacheMemory, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<int32> CVarHistoryCachePageSize(
+	TEXT("TencentCloudChat.HistoryCache.PageSize"),
+	20,
+	TEXT("Number of messages TencentCloudChatHistoryCache requests per GetHistoryMessageList call."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarHistoryCachePrefetchPages(
+	TEXT("TencentCloudChat.HistoryCache.PrefetchPages"),
+	1,
+	TEXT("Pages of older messages TencentCloudChatHistoryCache keeps fetched beyond the last requested range."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarHistoryCacheMaxMemoryKB(
+	TEXT("TencentCloudChat.HistoryCache.MaxMemoryKB"),
+	8192,
+	TEXT("Estimated memory above which TencentCloudChatHistoryCache trims messages far from the last read range, then evicts the least recently read conversations."),
+	ECVF_Default);
+
+namespace
+{
+	struct HistoryWaiter
+	{
+		int32 Offset;
+		int32 Count;
+		V2TIMValueCallback<V2TIMMessageVector> *Callback;
+	};
+
+	struct HistoryWindow
+	{
+		// 缓存被丢弃后仍在进行的拉取通过 Id 识别
+		uint64 Id = 0;
+		V2TIMString UserID;
+		V2TIMString GroupID;
+		// 从新到旧
+		TArray<V2TIMMessage> Messages;
+		bool bReachedOldest = false;
+		bool bFetching = false;
+		double FetchStartTime = 0.0;
+		TArray<HistoryWaiter> Waiters;
+		SIZE_T Bytes = 0;
+		// 最近一次读取的范围的末尾，淘汰时保留到这里再加上预取的页数
+		int32 ReadEnd = 0;
+		// LRU 链表，HistoryLruHead 为最近读取
+		HistoryWindow *LruPrev = nullptr;
+		HistoryWindow *LruNext = nullptr;
+	};
+
+	/**
+	 * 需要在锁外调用的回调，以及需要继续发出的拉取
+	 */
+	struct HistoryActions
+	{
+		TArray<TPair<V2TIMValueCallback<V2TIMMessageVector> *, V2TIMMessageVector>> Completed;
+		TArray<TPair<V2TIMValueCallback<V2TIMMessageVector> *, TPair<int, V2TIMString>>> Failed;
+		TOptional<V2TIMMessageListGetOption> Fetch;
+		V2TIMMessage FetchAfter;
+		V2TIMString FetchKey;
+		uint64 FetchId = 0;
+	};
+
+	FCriticalSection HistoryMutex;
+	TMap<V2TIMString, TUniquePtr<HistoryWindow>> HistoryWindows;
+	SIZE_T HistoryBytes = 0;
+	uint64 HistoryNextId = 1;
+	HistoryWindow *HistoryLruHead = nullptr;
+	HistoryWindow *HistoryLruTail = nullptr;
+	TencentCloudChatHistoryCacheStats HistoryStats;
+	bool bHistoryListenerAdded = false;
+
+	V2TIMString MakeConversationKey(const V2TIMString &userID, const V2TIMString &groupID)
+	{
+		TAnsiStringBuilder<128> Key;
+		if (!groupID.Empty())
+		{
+			Key << "group_" << groupID.CString();
+		}
+		else
+		{
+			Key << "c2c_" << userID.CString();
+		}
+		return V2TIMString(Key.GetData(), Key.Len());
+	}
+
+	SIZE_T EstimateMessageBytes(const V2TIMMessage &message)
+	{
+		SIZE_T Bytes = sizeof(V2TIMMessage) + message.msgID.Size() + message.sender.Size() + message.nickName.Size() +
+					   message.friendRemark.Size() + message.nameCard.Size() + message.faceURL.Size() +
+					   message.groupID.Size() + message.userID.Size();
+		for (size_t Index = 0; Index < message.elemList.Size(); ++Index)
+		{
+			const V2TIMElem *Elem = message.elemList[Index];
+			Bytes += 64;
+			if (Elem->elemType == V2TIM_ELEM_TYPE_TEXT)
+			{
+				Bytes += static_cast<const V2TIMTextElem *>(Elem)->text.Size();
+			}
+			else if (Elem->elemType == V2TIM_ELEM_TYPE_CUSTOM)
+			{
+				const V2TIMCustomElem *Custom = static_cast<const V2TIMCustomElem *>(Elem);
+				Bytes += Custom->data.Size() + Custom->desc.Size() + Custom->extension.Size();
+			}
+		}
+		return Bytes;
+	}
+
+	int32 FindMessage(const HistoryWindow &window, const V2TIMString &msgID)
+	{
+		return window.Messages.IndexOfByPredicate([&msgID](const V2TIMMessage &Message) { return Message.msgID == msgID; });
+	}
+
+	void AddBytes(HistoryWindow &window, SIZE_T added, SIZE_T removed)
+	{
+		window.Bytes = window.Bytes + added - removed;
+		HistoryBytes = HistoryBytes + added - removed;
+		SET_MEMORY_STAT(STAT_TencentCloudChat_HistoryCacheMemory, HistoryBytes);
+	}
+
+	void UnlinkWindow(HistoryWindow &window)
+	{
+		(window.LruPrev ? window.LruPrev->LruNext : HistoryLruHead) = window.LruNext;
+		(window.LruNext ? window.LruNext->LruPrev : HistoryLruTail) = window.LruPrev;
+		window.LruPrev = nullptr;
+		window.LruNext = nullptr;
+	}
+
+	void TouchWindow(HistoryWindow &window)
+	{
+		if (HistoryLruHead == &window)
+		{
+			return;
+		}
+		if (window.LruPrev || HistoryLruTail == &window)
+		{
+			UnlinkWindow(window);
+		}
+		window.LruNext = HistoryLruHead;
+		(HistoryLruHead ? HistoryLruHead->LruPrev : HistoryLruTail) = &window;
+		HistoryLruHead = &window;
+	}
+
+	void RemoveWindow(const V2TIMString &key)
+	{
+		TUniquePtr<HistoryWindow> Window;
+		if (HistoryWindows.RemoveAndCopyValue(key, Window))
+		{
+			UnlinkWindow(*Window);
+			HistoryBytes -= Window->Bytes;
+			SET_MEMORY_STAT(STAT_TencentCloudChat_HistoryCacheMemory, HistoryBytes);
+		}
+	}
+
+	int32 GetPageSize()
+	{
+		return FMath::Clamp(CVarHistoryCachePageSize.GetValueOnAnyThread(), 1, 100);
+	}
+
+	int32 GetPrefetchCount()
+	{
+		return FMath::Max(CVarHistoryCachePrefetchPages.GetValueOnAnyThread(), 0) * GetPageSize();
+	}
+
+	/**
+	 * 超出内存上限时先从最久未读取的会话起，丢弃各会话中比最近读取的范围和预取页更旧的消息；仍然超出时再按
+	 * 最久未读取的顺序淘汰整个会话，最近读取的会话不淘汰。正在拉取或有等待者的会话不动。在持有 HistoryMutex 时调用
+	 */
+	void EvictHistory()
+	{
+		const SIZE_T MaxBytes = SIZE_T(FMath::Max(CVarHistoryCacheMaxMemoryKB.GetValueOnAnyThread(), 0)) * 1024;
+		if (HistoryBytes <= MaxBytes)
+		{
+			return;
+		}
+
+		const int32 Prefetch = GetPrefetchCount();
+		for (HistoryWindow *Window = HistoryLruTail; Window && HistoryBytes > MaxBytes; Window = Window->LruPrev)
+		{
+			const int32 Keep = Window->ReadEnd + Prefetch;
+			if (Window->bFetching || Window->Waiters.Num() > 0 || Window->Messages.Num() <= Keep)
+			{
+				continue;
+			}
+			SIZE_T Removed = 0;
+			for (int32 Index = Keep; Index < Window->Messages.Num(); ++Index)
+			{
+				Removed += EstimateMessageBytes(Window->Messages[Index]);
+			}
+			Window->Messages.SetNum(Keep);
+			Window->bReachedOldest = false;
+			AddBytes(*Window, 0, Removed);
+		}
+
+		HistoryWindow *Window = HistoryLruTail;
+		while (Window && Window != HistoryLruHead && HistoryBytes > MaxBytes)
+		{
+			HistoryWindow *Newer = Window->LruPrev;
+			if (!Window->bFetching && Window->Waiters.Num() == 0)
+			{
+				RemoveWindow(MakeConversationKey(Window->UserID, Window->GroupID));
+			}
+			Window = Newer;
+		}
+	}
+
+	bool IsSatisfied(const HistoryWindow &window, int32 offset, int32 count)
+	{
+		return window.bReachedOldest || window.Messages.Num() >= offset + count;
+	}
+
+	V2TIMMessageVector Slice(const HistoryWindow &window, int32 offset, int32 count)
+	{
+		V2TIMMessageVector Result;
+		for (int32 Index = offset; Index < FMath::Min(offset + count, window.Messages.Num()); ++Index)
+		{
+			Result.PushBack(window.Messages[Index]);
+		}
+		return Result;
+	}
+
+	/**
+	 * 需要时准备下一次拉取，读取到 readEnd 为止的消息之后还要保留 PrefetchPages 页；在持有 HistoryMutex 时调用
+	 */
+	void PrepareFetch(const V2TIMString &key, HistoryWindow &window, int32 readEnd, HistoryActions &actions)
+	{
+		if (window.bFetching || window.bReachedOldest)
+		{
+			return;
+		}
+		const int32 PageSize = GetPageSize();
+		const int32 Prefetch = GetPrefetchCount();
+		if (window.Waiters.Num() == 0 && window.Messages.Num() >= readEnd + Prefetch)
+		{
+			return;
+		}
+
+		window.bFetching = true;
+		window.FetchStartTime = FPlatformTime::Seconds();
+
+		V2TIMMessageListGetOption &Option = actions.Fetch.Emplace();
+		Option.getType = V2TIM_GET_CLOUD_OLDER_MSG;
+		Option.userID = window.UserID;
+		Option.groupID = window.GroupID;
+		Option.count = uint32(PageSize);
+		Option.lastMsg = nullptr;
+		if (window.Messages.Num() > 0)
+		{
+			actions.FetchAfter = window.Messages.Last();
+		}
+		actions.FetchKey = key;
+		actions.FetchId = window.Id;
+	}
+
+	void Fetch(HistoryActions &actions);
+
+	void RunActions(HistoryActions &actions)
+	{
+		for (TPair<V2TIMValueCallback<V2TIMMessageVector> *, V2TIMMessageVector> &Each : actions.Completed)
+		{
+			Each.Key->OnSuccess(Each.Value);
+		}
+		for (TPair<V2TIMValueCallback<V2TIMMessageVector> *, TPair<int, V2TIMString>> &Each : actions.Failed)
+		{
+			Each.Key->OnError(Each.Value.Key, Each.Value.Value);
+		}
+		if (actions.Fetch.IsSet())
+		{
+			Fetch(actions);
+		}
+	}
+
+	void OnFetched(const V2TIMString &key, uint64 id, const V2TIMMessageVector *messages, int errorCode, const V2TIMString &errorMessage)
+	{
+		if (messages)
+		{
+			TencentCloudChatSearch::AddMessages(*messages);
+		}
+
+		HistoryActions Actions;
+		{
+			FScopeLock Lock(&HistoryMutex);
+			TUniquePtr<HistoryWindow> *Found = HistoryWindows.Find(key);
+			if (!Found || (*Found)->Id != id)
+			{
+				return;
+			}
+			HistoryWindow &Window = **Found;
+			Window.bFetching = false;
+
+			const double Elapsed = FPlatformTime::Seconds() - Window.FetchStartTime;
+			++HistoryStats.Fetches;
+			HistoryStats.TotalFetchSeconds += Elapsed;
+			HistoryStats.MaxFetchSeconds = FMath::Max(HistoryStats.MaxFetchSeconds, Elapsed);
+			SET_FLOAT_STAT(STAT_TencentCloudChat_HistoryFetchTimeMs, float(HistoryStats.GetAverageFetchSeconds() * 1000.0));
+
+			if (!messages)
+			{
+				for (const HistoryWaiter &Waiter : Window.Waiters)
+				{
+					if (Waiter.Callback)
+					{
+						Actions.Failed.Add({ Waiter.Callback, { errorCode, errorMessage } });
+					}
+				}
+				Window.Waiters.Reset();
+			}
+			else
+			{
+				SIZE_T Added = 0;
+				Window.Messages.Reserve(Window.Messages.Num() + int32(messages->Size()));
+				for (size_t Index = 0; Index < messages->Size(); ++Index)
+				{
+					// 第一页拉取期间收到或发出的消息已经插入到最前面，拉取结果中再次出现时跳过
+					const V2TIMMessage &Message = (*messages)[Index];
+					if (FindMessage(Window, Message.msgID) == INDEX_NONE)
+					{
+						Window.Messages.Add(Message);
+						Added += EstimateMessageBytes(Message);
+					}
+				}
+				AddBytes(Window, Added, 0);
+				Window.bReachedOldest = int32(messages->Size()) < GetPageSize();
+
+				int32 ReadEnd = 0;
+				for (int32 Index = Window.Waiters.Num() - 1; Index >= 0; --Index)
+				{
+					const HistoryWaiter &Waiter = Window.Waiters[Index];
+					if (IsSatisfied(Window, Waiter.Offset, Waiter.Count))
+					{
+						ReadEnd = FMath::Max(ReadEnd, Waiter.Offset + Waiter.Count);
+						if (Waiter.Callback)
+						{
+							Actions.Completed.Add({ Waiter.Callback, Slice(Window, Waiter.Offset, Waiter.Count) });
+						}
+						Window.Waiters.RemoveAt(Index);
+					}
+				}
+				// 还有等待者时继续拉取，否则按需预取
+				PrepareFetch(key, Window, ReadEnd, Actions);
+				EvictHistory();
+			}
+		}
+		RunActions(Actions);
+	}
+
+	void Fetch(HistoryActions &actions)
+	{
+		V2TIMMessageListGetOption &Option = actions.Fetch.GetValue();
+		if (!actions.FetchAfter.msgID.Empty())
+		{
+			Option.lastMsg = &actions.FetchAfter;
+		}
+
+		const V2TIMString Key = actions.FetchKey;
+		const uint64 Id = actions.FetchId;
+		TencentCloudChat::GetHistoryMessageList(Option, TencentCloudChatValueCallback<V2TIMMessageVector>::Create(
+			[Key, Id](const V2TIMMessageVector &messages)
+			{
+				OnFetched(Key, Id, &messages, 0, V2TIMString());
+			},
+			[Key, Id](int error_code, const V2TIMString &error_message)
+			{
+				OnFetched(Key, Id, nullptr, error_code, error_message);
+			}));
+	}
+
+	/**
+	 * 把新收到或发送成功的消息插入到已缓存会话的最前面
+	 */
+	void AddNewestMessage(const V2TIMMessage &message)
+	{
+		FScopeLock Lock(&HistoryMutex);
+		TUniquePtr<HistoryWindow> *Found = HistoryWindows.Find(MakeConversationKey(message.userID, message.groupID));
+		if (Found && FindMessage(**Found, message.msgID) == INDEX_NONE)
+		{
+			(*Found)->Messages.Insert(message, 0);
+			AddBytes(**Found, EstimateMessageBytes(message), 0);
+			EvictHistory();
+		}
+	}
+
+	class HistoryListener : public V2TIMAdvancedMsgListener
+	{
+	public:
+		void OnRecvNewMessage(const V2TIMMessage &message) override
+		{
+			AddNewestMessage(message);
+		}
+
+		void OnRecvMessageModified(const V2TIMMessage &message) override
+		{
+			FScopeLock Lock(&HistoryMutex);
+			TUniquePtr<HistoryWindow> *Found = HistoryWindows.Find(MakeConversationKey(message.userID, message.groupID));
+			const int32 Index = Found ? FindMessage(**Found, message.msgID) : INDEX_NONE;
+			if (Index != INDEX_NONE)
+			{
+				V2TIMMessage &Cached = (*Found)->Messages[Index];
+				AddBytes(**Found, EstimateMessageBytes(message), EstimateMessageBytes(Cached));
+				Cached = message;
+			}
+		}
+
+		void OnRecvMessageRevoked(const V2TIMString &messageID) override
+		{
+			// 撤回通知只有 msgID，逐个会话查找
+			FScopeLock Lock(&HistoryMutex);
+			for (TPair<V2TIMString, TUniquePtr<HistoryWindow>> &Pair : HistoryWindows)
+			{
+				const int32 Index = FindMessage(*Pair.Value, messageID);
+				if (Index != INDEX_NONE)
+				{
+					Pair.Value->Messages[Index].status = V2TIM_MSG_STATUS_LOCAL_REVOKED;
+					break;
+				}
+			}
+		}
+	};
+	HistoryListener HistoryListenerInstance;
+
+	class HistorySDKListener : public V2TIMSDKListener
+	{
+	public:
+		void OnConnectSuccess() override
+		{
+			// 断线期间的消息不会通过 OnRecvNewMessage 补发，重连后缓存的会话可能不连续
+			TencentCloudChatHistoryCache::InvalidateAll();
+		}
+	};
+	HistorySDKListener HistorySDKListenerInstance;
+}
+
+void TencentCloudChatHistoryCache::GetMessages(const V2TIMString &userID, const V2TIMString &groupID, int32 offset, int32 count,
+											   V2TIMValueCallback<V2TIMMessageVector> *callback)
+{
+	offset = FMath::Max(offset, 0);
+	count = FMath::Max(count, 0);
+
+	const V2TIMString Key = MakeConversationKey(userID, groupID);
+	HistoryActions Actions;
+	bool bAddListener;
+	{
+		FScopeLock Lock(&HistoryMutex);
+		bAddListener = !bHistoryListenerAdded;
+		bHistoryListenerAdded = true;
+
+		TUniquePtr<HistoryWindow> &Window = HistoryWindows.FindOrAdd(Key);
+		if (!Window)
+		{
+			Window = MakeUnique<HistoryWindow>();
+			Window->Id = HistoryNextId++;
+			Window->UserID = groupID.Empty() ? userID : V2TIMString();
+			Window->GroupID = groupID;
+		}
+		Window->ReadEnd = offset + count;
+		TouchWindow(*Window);
+
+		if (IsSatisfied(*Window, offset, count))
+		{
+			++HistoryStats.Hits;
+			INC_DWORD_STAT(STAT_TencentCloudChat_HistoryCacheHits);
+			if (callback)
+			{
+				Actions.Completed.Add({ callback, Slice(*Window, offset, count) });
+			}
+		}
+		else
+		{
+			++HistoryStats.Misses;
+			INC_DWORD_STAT(STAT_TencentCloudChat_HistoryCacheMisses);
+			Window->Waiters.Add({ offset, count, callback });
+		}
+		PrepareFetch(Key, *Window, offset + count, Actions);
+	}
+
+	// 监听器在第一次拉取之前注册，拉取期间收到的新消息不会丢失
+	if (bAddListener)
+	{
+		TencentCloudChat::AddAdvancedMsgListener(&HistoryListenerInstance);
+		TencentCloudChat::AddSDKListener(&HistorySDKListenerInstance);
+	}
+	RunActions(Actions);
+}
+
+void TencentCloudChatHistoryCache::Invalidate(const V2TIMString &userID, const V2TIMString &groupID)
+{
+	const V2TIMString Key = MakeConversationKey(userID, groupID);
+	HistoryActions Actions;
+	{
+		FScopeLock Lock(&HistoryMutex);
+		if (TUniquePtr<HistoryWindow> *Found = HistoryWindows.Find(Key))
+		{
+			for (const HistoryWaiter &Waiter : (*Found)->Waiters)
+			{
+				if (Waiter.Callback)
+				{
+					Actions.Failed.Add({ Waiter.Callback, { ERR_SDK_COMM_INTERRUPT, V2TIMString("history cache invalidated") } });
+				}
+			}
+			RemoveWindow(Key);
+		}
+	}
+	RunActions(Actions);
+}
+
+void TencentCloudChatHistoryCache::InvalidateAll()
+{
+	HistoryActions Actions;
+	{
+		FScopeLock Lock(&HistoryMutex);
+		for (const TPair<V2TIMString, TUniquePtr<HistoryWindow>> &Pair : HistoryWindows)
+		{
+			for (const HistoryWaiter &Waiter : Pair.Value->Waiters)
+			{
+				if (Waiter.Callback)
+				{
+					Actions.Failed.Add({ Waiter.Callback, { ERR_SDK_COMM_INTERRUPT, V2TIMString("history cache invalidated") } });
+				}
+			}
+		}
+		HistoryWindows.Empty();
+		HistoryLruHead = nullptr;
+		HistoryLruTail = nullptr;
+		HistoryBytes = 0;
+		SET_MEMORY_STAT(STAT_TencentCloudChat_HistoryCacheMemory, 0);
+	}
+	RunActions(Actions);
+}
+
+V2TIMSendCallback *TencentCloudChatHistoryCache::TrackSend(V2TIMSendCallback *callback)
+{
+	if (TencentCloudChatBackend::HasThreadOverride())
+	{
+		return callback;
+	}
+	{
+		FScopeLock Lock(&HistoryMutex);
+		if (HistoryWindows.Num() == 0)
+		{
+			return callback;
+		}
+	}
+	return TencentCloudChatSendCallback::Create(
+		[callback](const V2TIMMessage &message)
+		{
+			AddNewestMessage(message);
+			if (callback)
+			{
+				callback->OnSuccess(message);
+			}
+		},
+		[callback](int error_code, const V2TIMString &error_message)
+		{
+			if (callback)
+			{
+				callback->OnError(error_code, error_message);
+			}
+		},
+		[callback](uint32_t progress)
+		{
+			if (callback)
+			{
+				callback->OnProgress(progress);
+			}
+		});
+}
+
+TencentCloudChatHistoryCacheStats TencentCloudChatHistoryCache::GetStats()
+{
+	FScopeLock Lock(&HistoryMutex);
+	TencentCloudChatHistoryCacheStats Stats = HistoryStats;
+	Stats.Conversations = HistoryWindows.Num();
+	Stats.MemoryBytes = HistoryBytes;
+	return Stats;
+}
+
+void TencentCloudChatHistoryCache::Shutdown()
+{
+	InvalidateAll();
+
+	bool bRemoveListener;
+	{
+		FScopeLock Lock(&HistoryMutex);
+		bRemoveListener = bHistoryListenerAdded;
+		bHistoryListenerAdded = false;
+		HistoryStats = TencentCloudChatHistoryCacheStats();
+	}
+	if (bRemoveListener)
+	{
+		TencentCloudChat::RemoveAdvancedMsgListener(&HistoryListenerInstance);
+		TencentCloudChat::RemoveSDKListener(&HistorySDKListenerInstance);
+	}
+}
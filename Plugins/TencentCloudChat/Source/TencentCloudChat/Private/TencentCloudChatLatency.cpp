@@ -0,0 +1,220 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatLatency.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatStats.h"
+#include "Algo/Sort.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// 每个 2 的幂区间的桶数为 2^LatencySubBucketBits
+	constexpr int32 LatencySubBucketBits = 4;
+	constexpr int32 LatencySubBuckets = 1 << LatencySubBucketBits;
+}
+
+int32 TencentCloudChatLatencyHistogram::GetBucket(uint64 value)
+{
+	if (value < LatencySubBuckets * 2)
+	{
+		return int32(value);
+	}
+	const int32 Shift = int32(FMath::FloorLog2_64(value)) - LatencySubBucketBits;
+	return (Shift + 1) * LatencySubBuckets + int32(value >> Shift) - LatencySubBuckets;
+}
+
+uint64 TencentCloudChatLatencyHistogram::GetBucketUpperValue(int32 bucket)
+{
+	if (bucket < LatencySubBuckets * 2)
+	{
+		return uint64(bucket);
+	}
+	const int32 Shift = bucket / LatencySubBuckets - 1;
+	const uint64 Lower = uint64(bucket % LatencySubBuckets + LatencySubBuckets) << Shift;
+	return Lower + (uint64(1) << Shift) - 1;
+}
+
+void TencentCloudChatLatencyHistogram::Record(uint64 micros)
+{
+	const int32 Bucket = GetBucket(micros);
+	if (Bucket >= Buckets.Num())
+	{
+		Buckets.SetNumZeroed(Bucket + 1);
+	}
+	++Buckets[Bucket];
+	++Count;
+	Sum += micros;
+	Max = FMath::Max(Max, micros);
+}
+
+uint64 TencentCloudChatLatencyHistogram::GetPercentile(double percentile) const
+{
+	if (Count == 0)
+	{
+		return 0;
+	}
+	const uint64 Target = FMath::Max<uint64>(uint64(FMath::CeilToDouble(FMath::Clamp(percentile, 0.0, 100.0) / 100.0 * double(Count))), 1);
+	uint64 Seen = 0;
+	for (int32 Bucket = 0; Bucket < Buckets.Num(); ++Bucket)
+	{
+		Seen += Buckets[Bucket];
+		if (Seen >= Target)
+		{
+			return FMath::Min(GetBucketUpperValue(Bucket), Max);
+		}
+	}
+	return Max;
+}
+
+void TencentCloudChatLatencyHistogram::Reset()
+{
+	Buckets.Reset();
+	Count = 0;
+	Sum = 0;
+	Max = 0;
+}
+
+namespace
+{
+	struct ApiLatency
+	{
+		FString Name;
+		TencentCloudChatLatencyHistogram Histogram;
+		uint64 Errors = 0;
+		TMap<int32, uint64> ErrorCodes;
+	};
+
+	FCriticalSection LatencyMutex;
+	// 下标即接口编号
+	TArray<TUniquePtr<ApiLatency>> LatencyApis;
+	TMap<FString, int32> LatencyApiIds;
+
+	thread_local int32 LatencyCurrentApi = INDEX_NONE;
+}
+
+TencentCloudChatRequestTimer TencentCloudChatRequestTimer::Start()
+{
+	TencentCloudChatRequestTimer Timer;
+#if TENCENTCLOUDCHAT_WITH_STATS
+	Timer.Api = LatencyCurrentApi;
+	if (Timer.Api != INDEX_NONE)
+	{
+		Timer.StartCycles = FPlatformTime::Cycles64();
+	}
+#endif
+	return Timer;
+}
+
+void TencentCloudChatRequestTimer::Finish(int errorCode) const
+{
+	if (Api != INDEX_NONE)
+	{
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		TencentCloudChatLatency::Record(Api, uint64(Seconds * 1e6), errorCode);
+	}
+}
+
+int32 TencentCloudChatLatency::RegisterApi(const TCHAR *name)
+{
+	FScopeLock Lock(&LatencyMutex);
+	if (const int32 *Found = LatencyApiIds.Find(name))
+	{
+		return *Found;
+	}
+	const int32 Api = LatencyApis.Add(MakeUnique<ApiLatency>());
+	LatencyApis[Api]->Name = name;
+	LatencyApiIds.Add(name, Api);
+	return Api;
+}
+
+int32 TencentCloudChatLatency::ExchangeCurrentApi(int32 api)
+{
+	const int32 Previous = LatencyCurrentApi;
+	LatencyCurrentApi = api;
+	return Previous;
+}
+
+void TencentCloudChatLatency::Record(int32 api, uint64 micros, int errorCode)
+{
+	FScopeLock Lock(&LatencyMutex);
+	if (!LatencyApis.IsValidIndex(api))
+	{
+		return;
+	}
+	ApiLatency &Entry = *LatencyApis[api];
+	Entry.Histogram.Record(micros);
+	if (errorCode != 0)
+	{
+		++Entry.Errors;
+		++Entry.ErrorCodes.FindOrAdd(errorCode);
+	}
+}
+
+TArray<TencentCloudChatLatencySummary> TencentCloudChatLatency::GetSummaries()
+{
+	TArray<TencentCloudChatLatencySummary> Summaries;
+	{
+		FScopeLock Lock(&LatencyMutex);
+		for (const TUniquePtr<ApiLatency> &Entry : LatencyApis)
+		{
+			const TencentCloudChatLatencyHistogram &Histogram = Entry->Histogram;
+			if (Histogram.GetCount() == 0)
+			{
+				continue;
+			}
+			TencentCloudChatLatencySummary &Summary = Summaries.AddDefaulted_GetRef();
+			Summary.Api = Entry->Name;
+			Summary.Count = Histogram.GetCount();
+			Summary.Errors = Entry->Errors;
+			Summary.MeanMs = Histogram.GetMean() / 1000.0;
+			Summary.P50Ms = double(Histogram.GetPercentile(50.0)) / 1000.0;
+			Summary.P90Ms = double(Histogram.GetPercentile(90.0)) / 1000.0;
+			Summary.P99Ms = double(Histogram.GetPercentile(99.0)) / 1000.0;
+			Summary.MaxMs = double(Histogram.GetMax()) / 1000.0;
+			for (const TPair<int32, uint64> &Code : Entry->ErrorCodes)
+			{
+				Summary.ErrorCodes.Add(Code);
+			}
+			Algo::Sort(Summary.ErrorCodes, [](const TPair<int32, uint64> &A, const TPair<int32, uint64> &B) { return A.Value > B.Value; });
+		}
+	}
+	Algo::Sort(Summaries, [](const TencentCloudChatLatencySummary &A, const TencentCloudChatLatencySummary &B) { return A.Count > B.Count; });
+	return Summaries;
+}
+
+void TencentCloudChatLatency::Reset()
+{
+	FScopeLock Lock(&LatencyMutex);
+	for (const TUniquePtr<ApiLatency> &Entry : LatencyApis)
+	{
+		Entry->Histogram.Reset();
+		Entry->Errors = 0;
+		Entry->ErrorCodes.Reset();
+	}
+}
+
+static FAutoConsoleCommand GTencentCloudChatLatencyCommand(
+	TEXT("TencentCloudChat.Latency"),
+	TEXT("Print request/response latency of TencentCloudChat APIs. Usage: TencentCloudChat.Latency [reset]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString> &Args)
+	{
+		const TArray<TencentCloudChatLatencySummary> Summaries = TencentCloudChatLatency::GetSummaries();
+		UE_LOG(LogTencentCloudChat, Display, TEXT("%-40s %10s %8s %10s %10s %10s %10s %10s"),
+			   TEXT("API"), TEXT("Count"), TEXT("Errors"), TEXT("Mean ms"), TEXT("p50 ms"), TEXT("p90 ms"), TEXT("p99 ms"), TEXT("Max ms"));
+		for (const TencentCloudChatLatencySummary &Summary : Summaries)
+		{
+			UE_LOG(LogTencentCloudChat, Display, TEXT("%-40s %10llu %8llu %10.2f %10.2f %10.2f %10.2f %10.2f"),
+				   *Summary.Api, Summary.Count, Summary.Errors, Summary.MeanMs, Summary.P50Ms, Summary.P90Ms, Summary.P99Ms, Summary.MaxMs);
+			for (const TPair<int32, uint64> &Code : Summary.ErrorCodes)
+			{
+				UE_LOG(LogTencentCloudChat, Display, TEXT("    error %d: %llu"), Code.Key, Code.Value);
+			}
+		}
+
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+		{
+			TencentCloudChatLatency::Reset();
+			UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChat latency histograms reset"));
+		}
+	}));
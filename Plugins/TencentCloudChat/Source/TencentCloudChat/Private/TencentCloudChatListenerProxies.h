@@ -0,0 +1,464 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/UniquePtr.h"
+
+#include "V2TIMListener.h"
+#include "TencentCloudChatDispatcher.h"
+#include "TencentCloudChatStats.h"
+#include "TencentCloudChatTrace.h"
+
+/**
+ * 监听器代理基类：统计事件数；创建时打开了游戏线程分发的代理在 SDK 线程拷贝事件参数，投递到游戏线程后再调用
+ * 真正的监听器，否则在 SDK 线程直接调用。调用监听器时有一个 TencentCloudChatChannel 上的 CPU scope
+ *
+ * 监听器被移除后，队列中尚未执行的事件会被丢弃；代理本身由 TencentCloudChatDispatcher::Retire 延迟释放。
+ */
+template <class ListenerType, ETencentCloudChatListenerCategory Category>
+class TencentCloudChatListenerProxy : public ListenerType, public TencentCloudChatRetirable
+{
+public:
+	TencentCloudChatListenerProxy(ListenerType *target, bool bInGameThread)
+		: Target(target)
+		, bGameThread(bInGameThread)
+		, bAlive(MakeShared<FThreadSafeBool, ESPMode::ThreadSafe>(true))
+	{
+	}
+
+	void Invalidate()
+	{
+		*bAlive = false;
+	}
+
+protected:
+	template <class... ParamTypes, class... ArgTypes>
+	void Post(void (ListenerType::*method)(ParamTypes...), const ArgTypes &...args)
+	{
+		EventScope Scope(*this);
+		TencentCloudChatStats::RecordListenerEvent(Category);
+		if (!bGameThread)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(TencentCloudChatTrace::GetListenerScopeName(Category), TencentCloudChatChannel);
+			(Target->*method)(args...);
+			return;
+		}
+		TencentCloudChatDispatcher::Enqueue([Target = Target, bAlive = bAlive, method, Args = MakeTuple(args...)]()
+		{
+			if (*bAlive)
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(TencentCloudChatTrace::GetListenerScopeName(Category), TencentCloudChatChannel);
+				Args.ApplyAfter(method, Target);
+			}
+		});
+	}
+
+private:
+	ListenerType *Target;
+	bool bGameThread;
+	TSharedRef<FThreadSafeBool, ESPMode::ThreadSafe> bAlive;
+};
+
+class TencentCloudChatSDKListenerProxy : public TencentCloudChatListenerProxy<V2TIMSDKListener, ETencentCloudChatListenerCategory::SDK>
+{
+public:
+	using TencentCloudChatListenerProxy::TencentCloudChatListenerProxy;
+
+	void OnConnecting() override
+	{
+		Post(&V2TIMSDKListener::OnConnecting);
+	}
+	void OnConnectSuccess() override
+	{
+		Post(&V2TIMSDKListener::OnConnectSuccess);
+	}
+	void OnConnectFailed(int error_code, const V2TIMString &error_message) override
+	{
+		Post(&V2TIMSDKListener::OnConnectFailed, error_code, error_message);
+	}
+	void OnKickedOffline() override
+	{
+		Post(&V2TIMSDKListener::OnKickedOffline);
+	}
+	void OnUserSigExpired() override
+	{
+		Post(&V2TIMSDKListener::OnUserSigExpired);
+	}
+	void OnSelfInfoUpdated(const V2TIMUserFullInfo &info) override
+	{
+		Post(&V2TIMSDKListener::OnSelfInfoUpdated, info);
+	}
+	void OnUserStatusChanged(const V2TIMUserStatusVector &userStatusList) override
+	{
+		Post(&V2TIMSDKListener::OnUserStatusChanged, userStatusList);
+	}
+};
+
+class TencentCloudChatSimpleMsgListenerProxy : public TencentCloudChatListenerProxy<V2TIMSimpleMsgListener, ETencentCloudChatListenerCategory::SimpleMsg>
+{
+public:
+	using TencentCloudChatListenerProxy::TencentCloudChatListenerProxy;
+
+	void OnRecvC2CTextMessage(const V2TIMString &msgID, const V2TIMUserFullInfo &sender,
+							  const V2TIMString &text) override
+	{
+		Post(&V2TIMSimpleMsgListener::OnRecvC2CTextMessage, msgID, sender, text);
+	}
+	void OnRecvC2CCustomMessage(const V2TIMString &msgID, const V2TIMUserFullInfo &sender,
+								const V2TIMBuffer &customData) override
+	{
+		Post(&V2TIMSimpleMsgListener::OnRecvC2CCustomMessage, msgID, sender, customData);
+	}
+	void OnRecvGroupTextMessage(const V2TIMString &msgID, const V2TIMString &groupID,
+								const V2TIMGroupMemberFullInfo &sender,
+								const V2TIMString &text) override
+	{
+		Post(&V2TIMSimpleMsgListener::OnRecvGroupTextMessage, msgID, groupID, sender, text);
+	}
+	void OnRecvGroupCustomMessage(const V2TIMString &msgID, const V2TIMString &groupID,
+								  const V2TIMGroupMemberFullInfo &sender,
+								  const V2TIMBuffer &customData) override
+	{
+		Post(&V2TIMSimpleMsgListener::OnRecvGroupCustomMessage, msgID, groupID, sender, customData);
+	}
+};
+
+class TencentCloudChatAdvancedMsgListenerProxy : public TencentCloudChatListenerProxy<V2TIMAdvancedMsgListener, ETencentCloudChatListenerCategory::AdvancedMsg>
+{
+public:
+	using TencentCloudChatListenerProxy::TencentCloudChatListenerProxy;
+
+	void OnRecvNewMessage(const V2TIMMessage &message) override
+	{
+		Post(&V2TIMAdvancedMsgListener::OnRecvNewMessage, message);
+	}
+	void OnRecvC2CReadReceipt(const V2TIMMessageReceiptVector &receiptList) override
+	{
+		Post(&V2TIMAdvancedMsgListener::OnRecvC2CReadReceipt, receiptList);
+	}
+	void OnRecvMessageReadReceipts(const V2TIMMessageReceiptVector &receiptList) override
+	{
+		Post(&V2TIMAdvancedMsgListener::OnRecvMessageReadReceipts, receiptList);
+	}
+	void OnRecvMessageRevoked(const V2TIMString &messageID) override
+	{
+		Post(&V2TIMAdvancedMsgListener::OnRecvMessageRevoked, messageID);
+	}
+	void OnRecvMessageModified(const V2TIMMessage &message) override
+	{
+		Post(&V2TIMAdvancedMsgListener::OnRecvMessageModified, message);
+	}
+	void OnRecvMessageExtensionsChanged(const V2TIMString &msgID,
+										const V2TIMMessageExtensionVector &extensions) override
+	{
+		Post(&V2TIMAdvancedMsgListener::OnRecvMessageExtensionsChanged, msgID, extensions);
+	}
+	void OnRecvMessageExtensionsDeleted(const V2TIMString &msgID,
+										const V2TIMStringVector &extensionKeys) override
+	{
+		Post(&V2TIMAdvancedMsgListener::OnRecvMessageExtensionsDeleted, msgID, extensionKeys);
+	}
+};
+
+class TencentCloudChatGroupListenerProxy : public TencentCloudChatListenerProxy<V2TIMGroupListener, ETencentCloudChatListenerCategory::Group>
+{
+public:
+	using TencentCloudChatListenerProxy::TencentCloudChatListenerProxy;
+
+	void OnMemberEnter(const V2TIMString &groupID,
+					   const V2TIMGroupMemberInfoVector &memberList) override
+	{
+		Post(&V2TIMGroupListener::OnMemberEnter, groupID, memberList);
+	}
+	void OnMemberLeave(const V2TIMString &groupID, const V2TIMGroupMemberInfo &member) override
+	{
+		Post(&V2TIMGroupListener::OnMemberLeave, groupID, member);
+	}
+	void OnMemberInvited(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser,
+						 const V2TIMGroupMemberInfoVector &memberList) override
+	{
+		Post(&V2TIMGroupListener::OnMemberInvited, groupID, opUser, memberList);
+	}
+	void OnMemberKicked(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser,
+						const V2TIMGroupMemberInfoVector &memberList) override
+	{
+		Post(&V2TIMGroupListener::OnMemberKicked, groupID, opUser, memberList);
+	}
+	void OnMemberInfoChanged(const V2TIMString &groupID,
+							 const V2TIMGroupMemberChangeInfoVector &v2TIMGroupMemberChangeInfoList) override
+	{
+		Post(&V2TIMGroupListener::OnMemberInfoChanged, groupID, v2TIMGroupMemberChangeInfoList);
+	}
+	void OnGroupCreated(const V2TIMString &groupID) override
+	{
+		Post(&V2TIMGroupListener::OnGroupCreated, groupID);
+	}
+	void OnGroupDismissed(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser) override
+	{
+		Post(&V2TIMGroupListener::OnGroupDismissed, groupID, opUser);
+	}
+	void OnGroupRecycled(const V2TIMString &groupID, const V2TIMGroupMemberInfo &opUser) override
+	{
+		Post(&V2TIMGroupListener::OnGroupRecycled, groupID, opUser);
+	}
+	void OnGroupInfoChanged(const V2TIMString &groupID,
+							const V2TIMGroupChangeInfoVector &changeInfos) override
+	{
+		Post(&V2TIMGroupListener::OnGroupInfoChanged, groupID, changeInfos);
+	}
+	void OnGroupAttributeChanged(const V2TIMString &groupID,
+								 const V2TIMGroupAttributeMap &groupAttributeMap) override
+	{
+		Post(&V2TIMGroupListener::OnGroupAttributeChanged, groupID, groupAttributeMap);
+	}
+	void OnGroupCounterChanged(const V2TIMString &groupID,
+							   const V2TIMString &key, int64_t newValue) override
+	{
+		Post(&V2TIMGroupListener::OnGroupCounterChanged, groupID, key, newValue);
+	}
+	void OnReceiveJoinApplication(const V2TIMString &groupID,
+								  const V2TIMGroupMemberInfo &member,
+								  const V2TIMString &opReason) override
+	{
+		Post(&V2TIMGroupListener::OnReceiveJoinApplication, groupID, member, opReason);
+	}
+	void OnApplicationProcessed(const V2TIMString &groupID,
+								const V2TIMGroupMemberInfo &opUser, bool isAgreeJoin,
+								const V2TIMString &opReason) override
+	{
+		Post(&V2TIMGroupListener::OnApplicationProcessed, groupID, opUser, isAgreeJoin, opReason);
+	}
+	void OnGrantAdministrator(const V2TIMString &groupID,
+							  const V2TIMGroupMemberInfo &opUser,
+							  const V2TIMGroupMemberInfoVector &memberList) override
+	{
+		Post(&V2TIMGroupListener::OnGrantAdministrator, groupID, opUser, memberList);
+	}
+	void OnRevokeAdministrator(const V2TIMString &groupID,
+							   const V2TIMGroupMemberInfo &opUser,
+							   const V2TIMGroupMemberInfoVector &memberList) override
+	{
+		Post(&V2TIMGroupListener::OnRevokeAdministrator, groupID, opUser, memberList);
+	}
+	void OnQuitFromGroup(const V2TIMString &groupID) override
+	{
+		Post(&V2TIMGroupListener::OnQuitFromGroup, groupID);
+	}
+	void OnReceiveRESTCustomData(const V2TIMString &groupID,
+								 const V2TIMBuffer &customData) override
+	{
+		Post(&V2TIMGroupListener::OnReceiveRESTCustomData, groupID, customData);
+	}
+	void OnTopicCreated(const V2TIMString &groupID, const V2TIMString &topicID) override
+	{
+		Post(&V2TIMGroupListener::OnTopicCreated, groupID, topicID);
+	}
+	void OnTopicDeleted(const V2TIMString &groupID, const V2TIMStringVector &topicIDList) override
+	{
+		Post(&V2TIMGroupListener::OnTopicDeleted, groupID, topicIDList);
+	}
+	void OnTopicChanged(const V2TIMString &groupID, const V2TIMTopicInfo &topicInfo) override
+	{
+		Post(&V2TIMGroupListener::OnTopicChanged, groupID, topicInfo);
+	}
+};
+
+class TencentCloudChatConversationListenerProxy : public TencentCloudChatListenerProxy<V2TIMConversationListener, ETencentCloudChatListenerCategory::Conversation>
+{
+public:
+	using TencentCloudChatListenerProxy::TencentCloudChatListenerProxy;
+
+	void OnSyncServerStart() override
+	{
+		Post(&V2TIMConversationListener::OnSyncServerStart);
+	}
+	void OnSyncServerFinish() override
+	{
+		Post(&V2TIMConversationListener::OnSyncServerFinish);
+	}
+	void OnSyncServerFailed() override
+	{
+		Post(&V2TIMConversationListener::OnSyncServerFailed);
+	}
+	void OnNewConversation(const V2TIMConversationVector &conversationList) override
+	{
+		Post(&V2TIMConversationListener::OnNewConversation, conversationList);
+	}
+	void OnConversationChanged(const V2TIMConversationVector &conversationList) override
+	{
+		Post(&V2TIMConversationListener::OnConversationChanged, conversationList);
+	}
+	void OnTotalUnreadMessageCountChanged(uint64_t totalUnreadCount) override
+	{
+		Post(&V2TIMConversationListener::OnTotalUnreadMessageCountChanged, totalUnreadCount);
+	}
+	void OnUnreadMessageCountChangedByFilter(const V2TIMConversationListFilter &filter, uint64_t totalUnreadCount) override
+	{
+		Post(&V2TIMConversationListener::OnUnreadMessageCountChangedByFilter, filter, totalUnreadCount);
+	}
+	void OnConversationGroupCreated(const V2TIMString &groupName,
+									const V2TIMConversationVector &conversationList) override
+	{
+		Post(&V2TIMConversationListener::OnConversationGroupCreated, groupName, conversationList);
+	}
+	void OnConversationGroupDeleted(const V2TIMString &groupName) override
+	{
+		Post(&V2TIMConversationListener::OnConversationGroupDeleted, groupName);
+	}
+	void OnConversationGroupNameChanged(const V2TIMString &oldName, const V2TIMString &newName) override
+	{
+		Post(&V2TIMConversationListener::OnConversationGroupNameChanged, oldName, newName);
+	}
+	void OnConversationsAddedToGroup(const V2TIMString &groupName,
+									 const V2TIMConversationVector &conversationList) override
+	{
+		Post(&V2TIMConversationListener::OnConversationsAddedToGroup, groupName, conversationList);
+	}
+	void OnConversationsDeletedFromGroup(const V2TIMString &groupName,
+										 const V2TIMConversationVector &conversationList) override
+	{
+		Post(&V2TIMConversationListener::OnConversationsDeletedFromGroup, groupName, conversationList);
+	}
+};
+
+class TencentCloudChatFriendshipListenerProxy : public TencentCloudChatListenerProxy<V2TIMFriendshipListener, ETencentCloudChatListenerCategory::Friendship>
+{
+public:
+	using TencentCloudChatListenerProxy::TencentCloudChatListenerProxy;
+
+	void OnFriendApplicationListAdded(const V2TIMFriendApplicationVector &applicationList) override
+	{
+		Post(&V2TIMFriendshipListener::OnFriendApplicationListAdded, applicationList);
+	}
+	void OnFriendApplicationListDeleted(const V2TIMStringVector &userIDList) override
+	{
+		Post(&V2TIMFriendshipListener::OnFriendApplicationListDeleted, userIDList);
+	}
+	void OnFriendApplicationListRead() override
+	{
+		Post(&V2TIMFriendshipListener::OnFriendApplicationListRead);
+	}
+	void OnFriendListAdded(const V2TIMFriendInfoVector &userIDList) override
+	{
+		Post(&V2TIMFriendshipListener::OnFriendListAdded, userIDList);
+	}
+	void OnFriendListDeleted(const V2TIMStringVector &userIDList) override
+	{
+		Post(&V2TIMFriendshipListener::OnFriendListDeleted, userIDList);
+	}
+	void OnBlackListAdded(const V2TIMFriendInfoVector &infoList) override
+	{
+		Post(&V2TIMFriendshipListener::OnBlackListAdded, infoList);
+	}
+	void OnBlackListDeleted(const V2TIMStringVector &userIDList) override
+	{
+		Post(&V2TIMFriendshipListener::OnBlackListDeleted, userIDList);
+	}
+	void OnFriendInfoChanged(const V2TIMFriendInfoVector &infoList) override
+	{
+		Post(&V2TIMFriendshipListener::OnFriendInfoChanged, infoList);
+	}
+};
+
+class TencentCloudChatSignalingListenerProxy : public TencentCloudChatListenerProxy<V2TIMSignalingListener, ETencentCloudChatListenerCategory::Signaling>
+{
+public:
+	using TencentCloudChatListenerProxy::TencentCloudChatListenerProxy;
+
+	void OnReceiveNewInvitation(const V2TIMString &inviteID, const V2TIMString &inviter,
+								const V2TIMString &groupID,
+								const V2TIMStringVector &inviteeList,
+								const V2TIMString &data) override
+	{
+		Post(&V2TIMSignalingListener::OnReceiveNewInvitation, inviteID, inviter, groupID, inviteeList, data);
+	}
+	void OnInviteeAccepted(const V2TIMString &inviteID, const V2TIMString &invitee,
+						   const V2TIMString &data) override
+	{
+		Post(&V2TIMSignalingListener::OnInviteeAccepted, inviteID, invitee, data);
+	}
+	void OnInviteeRejected(const V2TIMString &inviteID, const V2TIMString &invitee,
+						   const V2TIMString &data) override
+	{
+		Post(&V2TIMSignalingListener::OnInviteeRejected, inviteID, invitee, data);
+	}
+	void OnInvitationCancelled(const V2TIMString &inviteID, const V2TIMString &inviter,
+							   const V2TIMString &data) override
+	{
+		Post(&V2TIMSignalingListener::OnInvitationCancelled, inviteID, inviter, data);
+	}
+	void OnInvitationTimeout(const V2TIMString &inviteID,
+							 const V2TIMStringVector &inviteeList) override
+	{
+		Post(&V2TIMSignalingListener::OnInvitationTimeout, inviteID, inviteeList);
+	}
+	void OnInvitationModified(const V2TIMString &inviteID, const V2TIMString &data) override
+	{
+		Post(&V2TIMSignalingListener::OnInvitationModified, inviteID, data);
+	}
+};
+
+/**
+ * 用户监听器到代理的映射
+ *
+ * 添加监听器时如果打开了游戏线程分发或 TENCENTCLOUDCHAT_WITH_STATS，就创建代理注册给 SDK；移除时找回对应的代理。
+ */
+template <class ListenerType, class ProxyType>
+class TencentCloudChatListenerProxyRegistry
+{
+public:
+	static ListenerType *Acquire(ListenerType *listener)
+	{
+		const bool bGameThread = TencentCloudChatDispatcher::IsGameThreadDispatchEnabled();
+		if (!listener || (!bGameThread && !TENCENTCLOUDCHAT_WITH_STATS))
+		{
+			return listener;
+		}
+		FScopeLock Lock(&Mutex);
+		TUniquePtr<ProxyType> &Proxy = Proxies.FindOrAdd(listener);
+		if (!Proxy)
+		{
+			Proxy = MakeUnique<ProxyType>(listener, bGameThread);
+		}
+		return Proxy.Get();
+	}
+
+	static ListenerType *Find(ListenerType *listener)
+	{
+		FScopeLock Lock(&Mutex);
+		const TUniquePtr<ProxyType> *Proxy = Proxies.Find(listener);
+		return Proxy ? Proxy->Get() : listener;
+	}
+
+	/**
+	 * 在 SDK 移除代理之后调用，丢弃尚未执行的事件；SDK 线程上可能仍在执行代理的事件，代理延迟释放
+	 */
+	static void Release(ListenerType *listener)
+	{
+		TUniquePtr<ProxyType> Proxy;
+		{
+			FScopeLock Lock(&Mutex);
+			if (!Proxies.RemoveAndCopyValue(listener, Proxy))
+			{
+				return;
+			}
+		}
+		Proxy->Invalidate();
+		TencentCloudChatDispatcher::Retire(MoveTemp(Proxy));
+	}
+
+private:
+	static inline FCriticalSection Mutex;
+	static inline TMap<ListenerType *, TUniquePtr<ProxyType>> Proxies;
+};
+
+using TencentCloudChatSDKListenerProxies = TencentCloudChatListenerProxyRegistry<V2TIMSDKListener, TencentCloudChatSDKListenerProxy>;
+using TencentCloudChatSimpleMsgListenerProxies = TencentCloudChatListenerProxyRegistry<V2TIMSimpleMsgListener, TencentCloudChatSimpleMsgListenerProxy>;
+using TencentCloudChatAdvancedMsgListenerProxies = TencentCloudChatListenerProxyRegistry<V2TIMAdvancedMsgListener, TencentCloudChatAdvancedMsgListenerProxy>;
+using TencentCloudChatGroupListenerProxies = TencentCloudChatListenerProxyRegistry<V2TIMGroupListener, TencentCloudChatGroupListenerProxy>;
+using TencentCloudChatConversationListenerProxies = TencentCloudChatListenerProxyRegistry<V2TIMConversationListener, TencentCloudChatConversationListenerProxy>;
+using TencentCloudChatFriendshipListenerProxies = TencentCloudChatListenerProxyRegistry<V2TIMFriendshipListener, TencentCloudChatFriendshipListenerProxy>;
+using TencentCloudChatSignalingListenerProxies = TencentCloudChatListenerProxyRegistry<V2TIMSignalingListener, TencentCloudChatSignalingListenerProxy>;
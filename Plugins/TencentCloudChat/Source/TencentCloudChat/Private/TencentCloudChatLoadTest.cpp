@@ -0,0 +1,708 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatLoadTest.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatDispatcher.h"
+#include "TencentCloudChatLatency.h"
+#include "TencentCloudChatLoopback.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatStats.h"
+#include "TencentCloudChatString.h"
+#include "Async/Async.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Math/RandomStream.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+
+#include "V2TIMErrorCode.h"
+#include "V2TIMListener.h"
+#include "V2TIMMessage.h"
+
+static TAutoConsoleVariable<float> CVarLoadTestReportIntervalSeconds(
+	TEXT("TencentCloudChat.LoadTest.ReportIntervalSeconds"),
+	10.0f,
+	TEXT("How often a running TencentCloudChat load test logs its statistics."),
+	ECVF_Default);
+
+namespace
+{
+	constexpr double LoadTestJoinRetrySeconds = 1.0;
+	// 群在全部用户登录后仍超过这个时间没有建好（建群的用户失败）时，其余用户放弃加群
+	constexpr double LoadTestJoinTimeoutSeconds = 10.0;
+	constexpr double LoadTestFlushSeconds = 5.0;
+	const char *const LoadTestTextPrefix = "load ";
+
+	enum class LoadTestActionKind : uint8
+	{
+		Login,
+		Join,
+		Act,
+	};
+
+	struct LoadTestAction
+	{
+		double Time = 0.0;
+		int32 User = INDEX_NONE;
+		LoadTestActionKind Kind = LoadTestActionKind::Act;
+		// 回调线程提交的操作在游戏线程取出后延迟的秒数，放入 Schedule 时换算为 Time
+		double Delay = 0.0;
+	};
+
+	struct LoadTestActionLess
+	{
+		bool operator()(const LoadTestAction &a, const LoadTestAction &b) const
+		{
+			return a.Time < b.Time;
+		}
+	};
+
+	uint64 LoadTestMicrosSince(uint64 startCycles)
+	{
+		return uint64(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - startCycles) * 1000000.0);
+	}
+
+	double LoadTestMicrosToMs(uint64 micros)
+	{
+		return double(micros) / 1000.0;
+	}
+
+	struct LoadTestRun;
+
+	/**
+	 * 每个模拟用户一个，经过 TencentCloudChat 注册，从消息中取出发送时间统计投递延迟
+	 */
+	class LoadTestListener : public V2TIMAdvancedMsgListener
+	{
+	public:
+		LoadTestRun *Run = nullptr;
+
+		void OnRecvNewMessage(const V2TIMMessage &message) override;
+	};
+
+	struct LoadTestUser
+	{
+		int32 Index = INDEX_NONE;
+		V2TIMString UserID;
+		V2TIMManager *Manager = nullptr;
+		LoadTestListener Listener;
+		bool bListenerAdded = false;
+		TAtomic<bool> bOnline{false};
+	};
+
+	struct LoadTestRun : public TSharedFromThis<LoadTestRun, ESPMode::ThreadSafe>
+	{
+		TencentCloudChatLoadTestConfig Config;
+		double TotalRate = 0.0;
+		// 超过这个时间仍然找不到群时不再重试加群；开始前确定，之后只读
+		double JoinDeadline = 0.0;
+		TArray<TUniquePtr<LoadTestUser>> Users;
+		TArray<V2TIMString> GroupIDs;
+
+		// 以下只在游戏线程访问
+		FRandomStream Random;
+		TArray<LoadTestAction> Schedule;
+		double StartTime = 0.0;
+		double EndTime = 0.0;
+		double LastReportTime = 0.0;
+		uint64 LastReportSent = 0;
+		uint64 LastReportReceived = 0;
+		double DriverLagMaxMs = 0.0;
+		int32 QueueDepthMax = 0;
+		uint64 MemoryAtStart = 0;
+
+		// 回调线程提交、在游戏线程放入 Schedule 的操作
+		TQueue<LoadTestAction, EQueueMode::Mpsc> Deferred;
+
+		TAtomic<bool> bStopping{false};
+		TAtomic<int32> UsersOnline{0};
+		TAtomic<int32> UsersFailed{0};
+		TAtomic<uint64> Sent{0};
+		TAtomic<uint64> SendFailed{0};
+		TAtomic<uint64> Received{0};
+		TAtomic<uint64> HistoryReads{0};
+
+		// 统计周期内的延迟，输出统计时清空
+		FCriticalSection HistogramMutex;
+		TencentCloudChatLatencyHistogram AckHistogram;
+		TencentCloudChatLatencyHistogram DeliveryHistogram;
+
+		void RecordAck(uint64 micros)
+		{
+			FScopeLock Lock(&HistogramMutex);
+			AckHistogram.Record(micros);
+		}
+
+		void RecordDelivery(uint64 micros)
+		{
+			FScopeLock Lock(&HistogramMutex);
+			DeliveryHistogram.Record(micros);
+		}
+
+		void Defer(int32 user, LoadTestActionKind kind, double delay)
+		{
+			LoadTestAction Action;
+			Action.User = user;
+			Action.Kind = kind;
+			Action.Delay = delay;
+			Deferred.Enqueue(Action);
+		}
+
+		void Push(const LoadTestAction &action)
+		{
+			Schedule.HeapPush(action, LoadTestActionLess());
+		}
+
+		/**
+		 * 按总频率抽取下一次操作的间隔（泊松过程）
+		 */
+		double NextInterval()
+		{
+			return -FMath::Loge(1.0 - Random.GetFraction()) / TotalRate;
+		}
+
+		const V2TIMString &GetGroupID(const LoadTestUser &user) const
+		{
+			return GroupIDs[user.Index / Config.UsersPerGroup];
+		}
+
+		/**
+		 * 同群中随机的另一个用户，群中只有自己时返回 nullptr
+		 */
+		const LoadTestUser *PickPeer(const LoadTestUser &user)
+		{
+			const int32 First = user.Index / Config.UsersPerGroup * Config.UsersPerGroup;
+			const int32 Num = FMath::Min(Config.UsersPerGroup, Users.Num() - First);
+			if (Num <= 1)
+			{
+				return nullptr;
+			}
+			const int32 Offset = Random.RandHelper(Num - 1);
+			const int32 Peer = First + (First + Offset >= user.Index ? Offset + 1 : Offset);
+			return Users[Peer].Get();
+		}
+	};
+
+	void LoadTestListener::OnRecvNewMessage(const V2TIMMessage &message)
+	{
+		if (Run->bStopping || message.elemList.Size() == 0 || !message.elemList[0])
+		{
+			return;
+		}
+		const V2TIMElem *Elem = message.elemList[0];
+		uint64 SentCycles = 0;
+		if (Elem->elemType == V2TIM_ELEM_TYPE_TEXT)
+		{
+			const char *Text = static_cast<const V2TIMTextElem *>(Elem)->text.CString();
+			const size_t PrefixLength = FCStringAnsi::Strlen(LoadTestTextPrefix);
+			if (FCStringAnsi::Strncmp(Text, LoadTestTextPrefix, PrefixLength) != 0)
+			{
+				return;
+			}
+			SentCycles = FCStringAnsi::Strtoui64(Text + PrefixLength, nullptr, 10);
+		}
+		else if (Elem->elemType == V2TIM_ELEM_TYPE_CUSTOM)
+		{
+			const V2TIMBuffer &Data = static_cast<const V2TIMCustomElem *>(Elem)->data;
+			if (Data.Size() < sizeof(SentCycles))
+			{
+				return;
+			}
+			FMemory::Memcpy(&SentCycles, Data.Data(), sizeof(SentCycles));
+		}
+		else
+		{
+			return;
+		}
+		++Run->Received;
+		Run->RecordDelivery(LoadTestMicrosSince(SentCycles));
+	}
+
+	TSharedPtr<LoadTestRun, ESPMode::ThreadSafe> LoadTestCurrent;
+	FTSTicker::FDelegateHandle LoadTestTickHandle;
+
+	using LoadTestRunRef = TSharedRef<LoadTestRun, ESPMode::ThreadSafe>;
+
+	void SetLoadTestOnline(const LoadTestRunRef &run, LoadTestUser &user)
+	{
+		if (!user.bOnline.Exchange(true))
+		{
+			++run->UsersOnline;
+			run->Defer(user.Index, LoadTestActionKind::Act, 0.0);
+		}
+	}
+
+	void FailLoadTestUser(const LoadTestRunRef &run, const LoadTestUser &user, const TCHAR *step, int errorCode, const V2TIMString &errorMessage)
+	{
+		++run->UsersFailed;
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatLoadTest: %s %s failed (%d) %s"),
+			   *TencentCloudChatString::ToFString(user.UserID), step, errorCode, *TencentCloudChatString::ToFString(errorMessage));
+	}
+
+	void LoginLoadTestUser(const LoadTestRunRef &run, LoadTestUser &user)
+	{
+		const TencentCloudChatLoadTestConfig &Config = run->Config;
+		user.Manager = Config.CreateManager ? Config.CreateManager() : TencentCloudChatLoopback::CreateManager();
+		// InitSDK 经过 TencentCloudChat 时在后台线程执行，不受 TencentCloudChatBackendScope 影响，这里直接初始化
+		if (!user.Manager || !user.Manager->InitSDK(Config.SDKAppID, V2TIMSDKConfig()))
+		{
+			FailLoadTestUser(run, user, TEXT("InitSDK"), ERR_SDK_NOT_INITIALIZED, V2TIMString());
+			return;
+		}
+
+		TencentCloudChatBackendScope Backend(user.Manager);
+		TencentCloudChat::AddAdvancedMsgListener(&user.Listener);
+		user.bListenerAdded = true;
+
+		const V2TIMString UserSig = Config.GenerateUserSig ? Config.GenerateUserSig(user.UserID) : V2TIMString();
+		TencentCloudChat::Login(user.UserID, UserSig, TencentCloudChatCallback::Create(
+			[run, &user]()
+			{
+				run->Defer(user.Index, LoadTestActionKind::Join, 0.0);
+			},
+			[run, &user](int error_code, const V2TIMString &error_message)
+			{
+				FailLoadTestUser(run, user, TEXT("Login"), error_code, error_message);
+			}));
+	}
+
+	/**
+	 * 每群的第一个用户建群，其他用户在群建好之后加入
+	 */
+	void JoinLoadTestGroup(const LoadTestRunRef &run, LoadTestUser &user)
+	{
+		TencentCloudChatBackendScope Backend(user.Manager);
+		const V2TIMString &GroupID = run->GetGroupID(user);
+		if (user.Index % run->Config.UsersPerGroup == 0)
+		{
+			TencentCloudChat::CreateGroup(TencentCloudChatString::ToV2TIM(run->Config.GroupType), GroupID, GroupID,
+				TencentCloudChatValueCallback<V2TIMString>::Create(
+					[run, &user](const V2TIMString &)
+					{
+						SetLoadTestOnline(run, user);
+					},
+					[run, &user](int error_code, const V2TIMString &error_message)
+					{
+						FailLoadTestUser(run, user, TEXT("CreateGroup"), error_code, error_message);
+					}));
+			return;
+		}
+
+		TencentCloudChat::JoinGroup(GroupID, V2TIMString(), TencentCloudChatCallback::Create(
+			[run, &user]()
+			{
+				SetLoadTestOnline(run, user);
+			},
+			[run, &user](int error_code, const V2TIMString &error_message)
+			{
+				if (error_code == ERR_SVR_GROUP_ALLREADY_MEMBER)
+				{
+					SetLoadTestOnline(run, user);
+				}
+				else if (error_code == ERR_SVR_GROUP_NOT_FOUND
+						 && FPlatformTime::Seconds() < run->JoinDeadline)
+				{
+					run->Defer(user.Index, LoadTestActionKind::Join, LoadTestJoinRetrySeconds);
+				}
+				else
+				{
+					FailLoadTestUser(run, user, TEXT("JoinGroup"), error_code, error_message);
+				}
+			}));
+	}
+
+	void SendLoadTestMessage(const LoadTestRunRef &run, LoadTestUser &user, bool bGroup, bool bCustom)
+	{
+		const LoadTestUser *Peer = nullptr;
+		if (!bGroup)
+		{
+			Peer = run->PickPeer(user);
+			if (!Peer)
+			{
+				return;
+			}
+		}
+
+		TencentCloudChatBackendScope Backend(user.Manager);
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		V2TIMMessage Message;
+		if (bCustom)
+		{
+			TArray<uint8> Data;
+			Data.SetNumZeroed(FMath::Max<int32>(run->Config.CustomBytes, sizeof(StartCycles)));
+			FMemory::Memcpy(Data.GetData(), &StartCycles, sizeof(StartCycles));
+			Message = TencentCloudChat::CreateCustomMessage(V2TIMBuffer(Data.GetData(), Data.Num()));
+		}
+		else
+		{
+			char Text[32];
+			FCStringAnsi::Snprintf(Text, sizeof(Text), "%s%llu", LoadTestTextPrefix, (unsigned long long)StartCycles);
+			Message = TencentCloudChat::CreateTextMessage(V2TIMString(Text));
+		}
+
+		++run->Sent;
+		TencentCloudChat::SendMessage(Message, Peer ? Peer->UserID : V2TIMString(), bGroup ? run->GetGroupID(user) : V2TIMString(),
+			V2TIM_PRIORITY_NORMAL, false, V2TIMOfflinePushInfo(),
+			TencentCloudChatSendCallback::Create(
+				[run, StartCycles](const V2TIMMessage &)
+				{
+					run->RecordAck(LoadTestMicrosSince(StartCycles));
+				},
+				[run, StartCycles](int, const V2TIMString &)
+				{
+					++run->SendFailed;
+					run->RecordAck(LoadTestMicrosSince(StartCycles));
+				}));
+	}
+
+	void ReadLoadTestHistory(const LoadTestRunRef &run, LoadTestUser &user)
+	{
+		V2TIMMessageListGetOption Option;
+		Option.getType = V2TIM_GET_CLOUD_OLDER_MSG;
+		Option.count = 20;
+		const LoadTestUser *Peer = run->Random.GetFraction() < 0.5 ? run->PickPeer(user) : nullptr;
+		if (Peer)
+		{
+			Option.userID = Peer->UserID;
+		}
+		else
+		{
+			Option.groupID = run->GetGroupID(user);
+		}
+
+		TencentCloudChatBackendScope Backend(user.Manager);
+		TencentCloudChat::GetHistoryMessageList(Option, TencentCloudChatValueCallback<V2TIMMessageVector>::Create(
+			[run](const V2TIMMessageVector &)
+			{
+				++run->HistoryReads;
+			}));
+	}
+
+	/**
+	 * 按各操作的频率比例选一种操作执行
+	 */
+	void ActLoadTestUser(const LoadTestRunRef &run, LoadTestUser &user)
+	{
+		const TencentCloudChatLoadTestConfig &Config = run->Config;
+		double Pick = run->Random.GetFraction() * run->TotalRate;
+		if ((Pick -= Config.C2CTextPerSecond) < 0.0)
+		{
+			SendLoadTestMessage(run, user, false, false);
+		}
+		else if ((Pick -= Config.C2CCustomPerSecond) < 0.0)
+		{
+			SendLoadTestMessage(run, user, false, true);
+		}
+		else if ((Pick -= Config.GroupTextPerSecond) < 0.0)
+		{
+			SendLoadTestMessage(run, user, true, false);
+		}
+		else if ((Pick -= Config.GroupCustomPerSecond) < 0.0)
+		{
+			SendLoadTestMessage(run, user, true, true);
+		}
+		else
+		{
+			ReadLoadTestHistory(run, user);
+		}
+	}
+
+	TencentCloudChatLoadTestReport MakeLoadTestReport(LoadTestRun &run)
+	{
+		const double Now = FPlatformTime::Seconds();
+		TencentCloudChatLoadTestReport Report;
+		Report.ElapsedSeconds = Now - run.StartTime;
+		Report.UsersOnline = run.UsersOnline;
+		Report.UsersFailed = run.UsersFailed;
+		Report.Sent = run.Sent;
+		Report.SendFailed = run.SendFailed;
+		Report.Received = run.Received;
+		Report.HistoryReads = run.HistoryReads;
+		Report.IntervalSeconds = Now - run.LastReportTime;
+		Report.IntervalSent = Report.Sent - run.LastReportSent;
+		Report.IntervalReceived = Report.Received - run.LastReportReceived;
+		{
+			FScopeLock Lock(&run.HistogramMutex);
+			Report.AckP50Ms = LoadTestMicrosToMs(run.AckHistogram.GetPercentile(50.0));
+			Report.AckP99Ms = LoadTestMicrosToMs(run.AckHistogram.GetPercentile(99.0));
+			Report.AckMaxMs = LoadTestMicrosToMs(run.AckHistogram.GetMax());
+			Report.DeliveryP50Ms = LoadTestMicrosToMs(run.DeliveryHistogram.GetPercentile(50.0));
+			Report.DeliveryP99Ms = LoadTestMicrosToMs(run.DeliveryHistogram.GetPercentile(99.0));
+			Report.DeliveryMaxMs = LoadTestMicrosToMs(run.DeliveryHistogram.GetMax());
+		}
+		Report.DriverLagMaxMs = run.DriverLagMaxMs;
+		Report.DispatcherQueueDepth = TencentCloudChatDispatcher::GetQueueDepth();
+		Report.DispatcherQueueDepthMax = FMath::Max(run.QueueDepthMax, Report.DispatcherQueueDepth);
+		Report.CallsInFlight = TencentCloudChatStats::GetCallsInFlight();
+		Report.LoopbackPendingEvents = TencentCloudChatLoopback::GetPendingEvents();
+		Report.MemoryUsedBytes = FPlatformMemory::GetStats().UsedPhysical;
+		Report.MemoryGrowthBytes = int64(Report.MemoryUsedBytes) - int64(run.MemoryAtStart);
+		return Report;
+	}
+
+	void LogLoadTestReport(const TencentCloudChatLoadTestReport &report)
+	{
+		const double Interval = FMath::Max(report.IntervalSeconds, 0.001);
+		UE_LOG(LogTencentCloudChat, Display,
+			   TEXT("TencentCloudChatLoadTest %.0fs: %d online, %d failed | sent %llu (%.1f/s, %llu failed), received %llu (%.1f/s), history %llu | ")
+			   TEXT("ack p50 %.2f p99 %.2f max %.2f ms | delivery p50 %.2f p99 %.2f max %.2f ms | driver lag max %.2f ms | ")
+			   TEXT("dispatch queue %d (max %d), in flight %d, loopback pending %d | memory %.1f MB (%+.1f MB)"),
+			   report.ElapsedSeconds, report.UsersOnline, report.UsersFailed,
+			   report.Sent, report.IntervalSent / Interval, report.SendFailed, report.Received, report.IntervalReceived / Interval, report.HistoryReads,
+			   report.AckP50Ms, report.AckP99Ms, report.AckMaxMs, report.DeliveryP50Ms, report.DeliveryP99Ms, report.DeliveryMaxMs, report.DriverLagMaxMs,
+			   report.DispatcherQueueDepth, report.DispatcherQueueDepthMax, report.CallsInFlight, report.LoopbackPendingEvents,
+			   report.MemoryUsedBytes / (1024.0 * 1024.0), report.MemoryGrowthBytes / (1024.0 * 1024.0));
+	}
+
+	/**
+	 * 输出统计，开始新的统计周期
+	 */
+	void ReportLoadTest(LoadTestRun &run)
+	{
+		const TencentCloudChatLoadTestReport Report = MakeLoadTestReport(run);
+		LogLoadTestReport(Report);
+		run.LastReportTime = run.StartTime + Report.ElapsedSeconds;
+		run.LastReportSent = Report.Sent;
+		run.LastReportReceived = Report.Received;
+		run.DriverLagMaxMs = 0.0;
+		run.QueueDepthMax = 0;
+		FScopeLock Lock(&run.HistogramMutex);
+		run.AckHistogram.Reset();
+		run.DeliveryHistogram.Reset();
+	}
+
+	bool TickLoadTest(const LoadTestRunRef &run)
+	{
+		const double Now = FPlatformTime::Seconds();
+
+		LoadTestAction Deferred;
+		while (run->Deferred.Dequeue(Deferred))
+		{
+			Deferred.Time = Now + Deferred.Delay;
+			if (Deferred.Kind == LoadTestActionKind::Act)
+			{
+				if (run->TotalRate <= 0.0)
+				{
+					continue;
+				}
+				Deferred.Time += run->NextInterval();
+			}
+			run->Push(Deferred);
+		}
+
+		while (run->Schedule.Num() > 0 && run->Schedule.HeapTop().Time <= Now)
+		{
+			LoadTestAction Action;
+			run->Schedule.HeapPop(Action, LoadTestActionLess());
+			run->DriverLagMaxMs = FMath::Max(run->DriverLagMaxMs, (Now - Action.Time) * 1000.0);
+
+			LoadTestUser &User = *run->Users[Action.User];
+			switch (Action.Kind)
+			{
+			case LoadTestActionKind::Login:
+				LoginLoadTestUser(run, User);
+				break;
+			case LoadTestActionKind::Join:
+				JoinLoadTestGroup(run, User);
+				break;
+			case LoadTestActionKind::Act:
+				ActLoadTestUser(run, User);
+				Action.Time = FMath::Max(Action.Time, Now - 1.0) + run->NextInterval();
+				run->Push(Action);
+				break;
+			}
+		}
+
+		run->QueueDepthMax = FMath::Max(run->QueueDepthMax, TencentCloudChatDispatcher::GetQueueDepth());
+		if (Now - run->LastReportTime >= CVarLoadTestReportIntervalSeconds.GetValueOnGameThread())
+		{
+			ReportLoadTest(*run);
+		}
+		return run->EndTime <= 0.0 || Now < run->EndTime;
+	}
+}
+
+bool TencentCloudChatLoadTest::Start(const TencentCloudChatLoadTestConfig &config)
+{
+	check(IsInGameThread());
+	if (LoadTestCurrent.IsValid())
+	{
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatLoadTest: already running"));
+		return false;
+	}
+	if (config.Users <= 0 || config.UsersPerGroup <= 0)
+	{
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatLoadTest: Users and UsersPerGroup must be positive"));
+		return false;
+	}
+
+	// 每次运行使用不同的群 ID，回环后端中上一次的群不影响本次
+	static int32 LoadTestSerial = 0;
+	++LoadTestSerial;
+
+	LoadTestRunRef Run = MakeShared<LoadTestRun, ESPMode::ThreadSafe>();
+	Run->Config = config;
+	Run->TotalRate = FMath::Max(config.C2CTextPerSecond, 0.0) + FMath::Max(config.C2CCustomPerSecond, 0.0) + FMath::Max(config.GroupTextPerSecond, 0.0)
+		+ FMath::Max(config.GroupCustomPerSecond, 0.0) + FMath::Max(config.HistoryPerSecond, 0.0);
+	Run->Random.Initialize(config.Seed);
+
+	const int32 GroupNum = FMath::DivideAndRoundUp(config.Users, config.UsersPerGroup);
+	for (int32 Group = 0; Group < GroupNum; ++Group)
+	{
+		Run->GroupIDs.Add(TencentCloudChatString::ToV2TIM(FString::Printf(TEXT("load_%d_group_%d"), LoadTestSerial, Group)));
+	}
+
+	Run->StartTime = FPlatformTime::Seconds();
+	Run->LastReportTime = Run->StartTime;
+	Run->JoinDeadline = Run->StartTime + FMath::Max(config.RampUpSeconds, 0.0) + LoadTestJoinTimeoutSeconds;
+	Run->EndTime = config.DurationSeconds > 0.0 ? Run->StartTime + FMath::Max(config.RampUpSeconds, 0.0) + config.DurationSeconds : 0.0;
+	Run->MemoryAtStart = FPlatformMemory::GetStats().UsedPhysical;
+	Run->Users.Reserve(config.Users);
+	for (int32 Index = 0; Index < config.Users; ++Index)
+	{
+		TUniquePtr<LoadTestUser> &User = Run->Users.Add_GetRef(MakeUnique<LoadTestUser>());
+		User->Index = Index;
+		User->UserID = TencentCloudChatString::ToV2TIM(FString::Printf(TEXT("load_user_%d"), Index));
+		User->Listener.Run = &Run.Get();
+
+		LoadTestAction Login;
+		Login.Time = Run->StartTime + FMath::Max(config.RampUpSeconds, 0.0) * Index / config.Users;
+		Login.User = Index;
+		Login.Kind = LoadTestActionKind::Login;
+		Run->Push(Login);
+	}
+
+	LoadTestCurrent = Run;
+	LoadTestTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Run](float)
+	{
+		if (!TickLoadTest(Run))
+		{
+			// 在 Ticker 回调之外停止，Stop 会移除这个 Ticker；执行前可能已经手动停止并开始了新的一次，只停止本次
+			TWeakPtr<LoadTestRun, ESPMode::ThreadSafe> WeakRun = Run;
+			AsyncTask(ENamedThreads::GameThread, [WeakRun]()
+			{
+				const TSharedPtr<LoadTestRun, ESPMode::ThreadSafe> Expired = WeakRun.Pin();
+				if (Expired.IsValid() && Expired == LoadTestCurrent)
+				{
+					TencentCloudChatLoadTest::Stop();
+				}
+			});
+			return false;
+		}
+		return true;
+	}));
+
+	UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChatLoadTest: %d users in %d %s groups, %.3f actions/s per user, backend %s"),
+		   config.Users, GroupNum, *config.GroupType, Run->TotalRate, config.CreateManager ? TEXT("custom") : TEXT("loopback"));
+	return true;
+}
+
+void TencentCloudChatLoadTest::Stop()
+{
+	check(IsInGameThread());
+	if (!LoadTestCurrent.IsValid())
+	{
+		return;
+	}
+	FTSTicker::GetCoreTicker().RemoveTicker(LoadTestTickHandle);
+	LoadTestTickHandle.Reset();
+
+	const LoadTestRunRef Run = LoadTestCurrent.ToSharedRef();
+	LoadTestCurrent.Reset();
+	LogLoadTestReport(MakeLoadTestReport(*Run));
+	Run->bStopping = true;
+
+	for (const TUniquePtr<LoadTestUser> &User : Run->Users)
+	{
+		if (!User->Manager)
+		{
+			continue;
+		}
+		if (User->bListenerAdded)
+		{
+			TencentCloudChatBackendScope Backend(User->Manager);
+			TencentCloudChat::RemoveAdvancedMsgListener(&User->Listener);
+		}
+		if (Run->Config.DestroyManager)
+		{
+			Run->Config.DestroyManager(User->Manager);
+		}
+		else
+		{
+			TencentCloudChatLoopback::DestroyManager(User->Manager);
+		}
+		User->Manager = nullptr;
+	}
+
+	// 等回环网络中已经发出的事件执行完，之后再没有对这些监听器的调用；尚未执行的回调持有 Run，不会访问已释放的用户
+	if (!Run->Config.DestroyManager)
+	{
+		TencentCloudChatLoopback::Flush(LoadTestFlushSeconds);
+	}
+	UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChatLoadTest: stopped"));
+}
+
+bool TencentCloudChatLoadTest::IsRunning()
+{
+	return LoadTestCurrent.IsValid();
+}
+
+TencentCloudChatLoadTestReport TencentCloudChatLoadTest::GetReport()
+{
+	return LoadTestCurrent.IsValid() ? MakeLoadTestReport(*LoadTestCurrent) : TencentCloudChatLoadTestReport();
+}
+
+void TencentCloudChatLoadTest::Shutdown()
+{
+	Stop();
+}
+
+static FAutoConsoleCommand GTencentCloudChatLoadTestCommand(
+	TEXT("TencentCloudChat.LoadTest"),
+	TEXT("Drive simulated users through TencentCloudChat. Usage: TencentCloudChat.LoadTest start [Users=256] [UsersPerGroup=64] [GroupType=Meeting] ")
+	TEXT("[RampUp=10] [Duration=0] [C2CText=0.05] [C2CCustom=0.2] [GroupText=0.02] [GroupCustom=0.5] [History=0.01] [CustomBytes=64] [Seed=0] | stop | report"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString> &Args)
+	{
+		const FString Verb = Args.Num() > 0 ? Args[0] : FString();
+		if (Verb.Equals(TEXT("stop"), ESearchCase::IgnoreCase))
+		{
+			TencentCloudChatLoadTest::Stop();
+		}
+		else if (Verb.Equals(TEXT("report"), ESearchCase::IgnoreCase))
+		{
+			if (TencentCloudChatLoadTest::IsRunning())
+			{
+				LogLoadTestReport(TencentCloudChatLoadTest::GetReport());
+			}
+			else
+			{
+				UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChatLoadTest: not running"));
+			}
+		}
+		else if (Verb.Equals(TEXT("start"), ESearchCase::IgnoreCase))
+		{
+			const FString Params = FString::Join(Args, TEXT(" "));
+			TencentCloudChatLoadTestConfig Config;
+			FParse::Value(*Params, TEXT("Users="), Config.Users);
+			FParse::Value(*Params, TEXT("UsersPerGroup="), Config.UsersPerGroup);
+			FParse::Value(*Params, TEXT("GroupType="), Config.GroupType);
+			FParse::Value(*Params, TEXT("RampUp="), Config.RampUpSeconds);
+			FParse::Value(*Params, TEXT("Duration="), Config.DurationSeconds);
+			FParse::Value(*Params, TEXT("C2CText="), Config.C2CTextPerSecond);
+			FParse::Value(*Params, TEXT("C2CCustom="), Config.C2CCustomPerSecond);
+			FParse::Value(*Params, TEXT("GroupText="), Config.GroupTextPerSecond);
+			FParse::Value(*Params, TEXT("GroupCustom="), Config.GroupCustomPerSecond);
+			FParse::Value(*Params, TEXT("History="), Config.HistoryPerSecond);
+			FParse::Value(*Params, TEXT("CustomBytes="), Config.CustomBytes);
+			FParse::Value(*Params, TEXT("Seed="), Config.Seed);
+			TencentCloudChatLoadTest::Start(Config);
+		}
+		else
+		{
+			UE_LOG(LogTencentCloudChat, Display, TEXT("Usage: TencentCloudChat.LoadTest start [Key=Value ...] | stop | report"));
+		}
+	}));
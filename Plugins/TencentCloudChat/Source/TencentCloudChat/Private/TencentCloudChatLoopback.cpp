@@ -0,0 +1,2252 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatLoopback.h"
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatString.h"
+#include "Algo/Sort.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Math/RandomStream.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/StringBuilder.h"
+#include "Templates/SharedPointer.h"
+
+#include "V2TIMConversationManager.h"
+#include "V2TIMErrorCode.h"
+#include "V2TIMFriendshipManager.h"
+#include "V2TIMGroupManager.h"
+#include "V2TIMListener.h"
+#include "V2TIMMessageManager.h"
+#include "V2TIMOfflinePushManager.h"
+#include "V2TIMSignalingManager.h"
+
+static TAutoConsoleVariable<bool> CVarLoopbackEnabled(
+	TEXT("TencentCloudChat.Loopback"),
+	false,
+	TEXT("Use the in-process loopback backend instead of the SDK. Read at module startup; -TencentCloudChatLoopback does the same."),
+	ECVF_ReadOnly);
+
+static TAutoConsoleVariable<float> CVarLoopbackLatencyMs(
+	TEXT("TencentCloudChat.Loopback.LatencyMs"),
+	0.0f,
+	TEXT("One-way latency of the loopback network. Requests and messages cross two legs."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLoopbackJitterMs(
+	TEXT("TencentCloudChat.Loopback.JitterMs"),
+	0.0f,
+	TEXT("Maximum uniformly distributed delay added to each leg of the loopback network."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLoopbackLossPercent(
+	TEXT("TencentCloudChat.Loopback.LossPercent"),
+	0.0f,
+	TEXT("Percentage of sent messages the loopback network drops. The sender gets ERR_SDK_NET_WAIT_ACK_TIMEOUT."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLoopbackSeed(
+	TEXT("TencentCloudChat.Loopback.Seed"),
+	1,
+	TEXT("Random seed for loopback latency jitter and loss. Applied when the loopback network starts or is reset."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLoopbackMaxHistory(
+	TEXT("TencentCloudChat.Loopback.MaxHistory"),
+	1000,
+	TEXT("Messages the loopback backend keeps per conversation for GetHistoryMessageList."),
+	ECVF_Default);
+
+namespace
+{
+	const char *const LoopbackNotSupported = "not supported by the loopback backend";
+
+	// 每页返回的群成员数，与 SDK 一致
+	constexpr uint64 LoopbackMemberPageSize = 100;
+
+	int64 LoopbackNow()
+	{
+		return FDateTime::UtcNow().ToUnixTimestamp();
+	}
+
+	V2TIMString LoopbackConcat(const char *prefix, const V2TIMString &id)
+	{
+		TAnsiStringBuilder<128> Builder;
+		Builder << prefix;
+		Builder.Append(id.CString(), int32(id.Size()));
+		return V2TIMString(Builder.GetData(), size_t(Builder.Len()));
+	}
+
+	V2TIMString LoopbackNumberedID(const char *prefix, uint64 number)
+	{
+		TAnsiStringBuilder<64> Builder;
+		Builder << prefix << number;
+		return V2TIMString(Builder.GetData(), size_t(Builder.Len()));
+	}
+
+	V2TIMString C2CHistoryKey(const V2TIMString &a, const V2TIMString &b)
+	{
+		const V2TIMString &Low = a < b ? a : b;
+		const V2TIMString &High = a < b ? b : a;
+		TAnsiStringBuilder<128> Builder;
+		Builder << "c2c_";
+		Builder.Append(Low.CString(), int32(Low.Size()));
+		Builder << '|';
+		Builder.Append(High.CString(), int32(High.Size()));
+		return V2TIMString(Builder.GetData(), size_t(Builder.Len()));
+	}
+
+	V2TIMString GroupHistoryKey(const V2TIMString &groupID)
+	{
+		return LoopbackConcat("group_", groupID);
+	}
+
+	/**
+	 * 模拟网络线程：按到期时间执行回调和事件，到期时间相同的按投递顺序执行
+	 */
+	class LoopbackNetwork final : public FRunnable
+	{
+	public:
+		LoopbackNetwork()
+			: WakeEvent(FPlatformProcess::GetSynchEventFromPool())
+		{
+			Thread = FRunnableThread::Create(this, TEXT("TencentCloudChatLoopback"));
+		}
+
+		~LoopbackNetwork() override
+		{
+			bStopping = true;
+			WakeEvent->Trigger();
+			if (Thread)
+			{
+				Thread->WaitForCompletion();
+				delete Thread;
+			}
+			FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		}
+
+		void Post(double delaySeconds, TUniqueFunction<void()> &&task)
+		{
+			++Pending;
+			{
+				FScopeLock Lock(&Mutex);
+				Tasks.HeapPush(Task{FPlatformTime::Seconds() + FMath::Max(delaySeconds, 0.0), NextSequence++, MoveTemp(task)});
+			}
+			WakeEvent->Trigger();
+		}
+
+		int32 GetPending() const
+		{
+			return Pending.Load();
+		}
+
+		uint32 Run() override
+		{
+			while (!bStopping)
+			{
+				TUniqueFunction<void()> Next;
+				double WaitSeconds = 0.1;
+				{
+					FScopeLock Lock(&Mutex);
+					if (Tasks.Num() > 0)
+					{
+						const double Now = FPlatformTime::Seconds();
+						if (Tasks.HeapTop().Due <= Now)
+						{
+							Task Top;
+							Tasks.HeapPop(Top);
+							Next = MoveTemp(Top.Function);
+						}
+						else
+						{
+							WaitSeconds = FMath::Min(WaitSeconds, Tasks.HeapTop().Due - Now);
+						}
+					}
+				}
+				if (Next)
+				{
+					Next();
+					--Pending;
+				}
+				else
+				{
+					WakeEvent->Wait(FMath::Max(1u, uint32(WaitSeconds * 1000.0)));
+				}
+			}
+			return 0;
+		}
+
+	private:
+		struct Task
+		{
+			double Due = 0.0;
+			uint64 Sequence = 0;
+			TUniqueFunction<void()> Function;
+
+			bool operator<(const Task &other) const
+			{
+				return Due < other.Due || (Due == other.Due && Sequence < other.Sequence);
+			}
+		};
+
+		FCriticalSection Mutex;
+		TArray<Task> Tasks;
+		uint64 NextSequence = 0;
+		TAtomic<int32> Pending{0};
+		TAtomic<bool> bStopping{false};
+		FEvent *WakeEvent = nullptr;
+		FRunnableThread *Thread = nullptr;
+	};
+
+	class LoopbackManager;
+	using LoopbackManagerPtr = TSharedPtr<LoopbackManager, ESPMode::ThreadSafe>;
+
+	struct LoopbackGroup
+	{
+		V2TIMString GroupType;
+		V2TIMString GroupName;
+		V2TIMString Owner;
+		uint32 CreateTime = 0;
+		TArray<V2TIMString> Members;
+	};
+
+	// 以下状态由 LoopbackMutex 保护；与 LoopbackManager::Mutex 同时持有时先取 LoopbackMutex
+	FCriticalSection LoopbackMutex;
+	TUniquePtr<LoopbackNetwork> LoopbackNetworkInstance;
+	TArray<LoopbackManagerPtr> LoopbackManagers;
+	LoopbackManager *LoopbackDefaultManager = nullptr;
+	TMap<V2TIMString, LoopbackManagerPtr> LoopbackOnlineUsers;
+	TMap<V2TIMString, LoopbackGroup> LoopbackGroups;
+	TMap<V2TIMString, TArray<V2TIMMessage>> LoopbackHistory;
+	FRandomStream LoopbackRandom;
+	uint64 LoopbackNextSeq = 1;
+	uint64 LoopbackNextGroupID = 1;
+	TAtomic<uint64> LoopbackNextMsgID(1);
+
+	void LoopbackPost(double delaySeconds, TUniqueFunction<void()> &&task)
+	{
+		FScopeLock Lock(&LoopbackMutex);
+		if (LoopbackNetworkInstance)
+		{
+			LoopbackNetworkInstance->Post(delaySeconds, MoveTemp(task));
+		}
+	}
+
+	// 持有 LoopbackMutex 时调用
+	double RollLegDelay()
+	{
+		const double LatencyMs = FMath::Max(CVarLoopbackLatencyMs.GetValueOnAnyThread(), 0.0f);
+		const double JitterMs = FMath::Max(CVarLoopbackJitterMs.GetValueOnAnyThread(), 0.0f);
+		return (LatencyMs + (JitterMs > 0.0 ? LoopbackRandom.FRand() * JitterMs : 0.0)) / 1000.0;
+	}
+
+	// 持有 LoopbackMutex 时调用
+	bool RollLoss()
+	{
+		const float LossPercent = CVarLoopbackLossPercent.GetValueOnAnyThread();
+		return LossPercent > 0.0f && LoopbackRandom.FRand() * 100.0f < LossPercent;
+	}
+
+	double RollRequestDelay()
+	{
+		FScopeLock Lock(&LoopbackMutex);
+		return RollLegDelay() + RollLegDelay();
+	}
+
+	V2TIMString NewMessageID()
+	{
+		return LoopbackNumberedID("loopback-", LoopbackNextMsgID++);
+	}
+
+	// 持有 LoopbackMutex 时调用
+	void AppendHistory(const V2TIMString &key, const V2TIMMessage &message)
+	{
+		TArray<V2TIMMessage> &History = LoopbackHistory.FindOrAdd(key);
+		History.Add(message);
+		const int32 MaxHistory = FMath::Max(CVarLoopbackMaxHistory.GetValueOnAnyThread(), 1);
+		if (History.Num() >= MaxHistory * 2)
+		{
+			History.RemoveAt(0, History.Num() - MaxHistory);
+		}
+	}
+
+	void Reply(V2TIMCallback *callback)
+	{
+		if (callback)
+		{
+			LoopbackPost(RollRequestDelay(), [callback]() { callback->OnSuccess(); });
+		}
+	}
+
+	template <class T>
+	void Reply(V2TIMValueCallback<T> *callback, const T &value)
+	{
+		if (callback)
+		{
+			LoopbackPost(RollRequestDelay(), [callback, value]() { callback->OnSuccess(value); });
+		}
+	}
+
+	void ReplyError(V2TIMCallback *callback, int code, const char *message)
+	{
+		if (callback)
+		{
+			LoopbackPost(RollRequestDelay(), [callback, code, Message = V2TIMString(message)]() { callback->OnError(code, Message); });
+		}
+	}
+
+	template <class T>
+	void ReplyError(V2TIMValueCallback<T> *callback, int code, const char *message)
+	{
+		if (callback)
+		{
+			LoopbackPost(RollRequestDelay(), [callback, code, Message = V2TIMString(message)]() { callback->OnError(code, Message); });
+		}
+	}
+
+	template <class T>
+	void ReplyError(V2TIMCompleteCallback<T> *callback, int code, const char *message)
+	{
+		if (callback)
+		{
+			LoopbackPost(RollRequestDelay(), [callback, code, Message = V2TIMString(message)]() { callback->OnComplete(code, Message, T()); });
+		}
+	}
+
+	template <class CallbackType>
+	void ReplyNotSupported(CallbackType *callback)
+	{
+		ReplyError(callback, ERR_SDK_INTERFACE_NOT_SUPPORT, LoopbackNotSupported);
+	}
+
+	LoopbackManagerPtr FindOnlineUser(const V2TIMString &userID)
+	{
+		FScopeLock Lock(&LoopbackMutex);
+		const LoopbackManagerPtr *Manager = LoopbackOnlineUsers.Find(userID);
+		return Manager ? *Manager : LoopbackManagerPtr();
+	}
+
+	/**
+	 * 在 delaySeconds 之后对 userID 当时登录的实例执行 task，不在线时丢弃
+	 */
+	void PostToUser(double delaySeconds, const V2TIMString &userID, TUniqueFunction<void(LoopbackManager &)> &&task)
+	{
+		LoopbackPost(delaySeconds, [userID, Task = MoveTemp(task)]()
+		{
+			if (LoopbackManagerPtr Manager = FindOnlineUser(userID))
+			{
+				Task(*Manager);
+			}
+		});
+	}
+
+	struct LoopbackConversation
+	{
+		V2TIMConversationType Type = V2TIM_C2C;
+		V2TIMString ConversationID;
+		V2TIMString UserID;
+		V2TIMString GroupID;
+		V2TIMString ShowName;
+		V2TIMString DraftText;
+		int32 UnreadCount = 0;
+		uint64 OrderKey = 0;
+		uint64 DraftTimestamp = 0;
+		bool bPinned = false;
+
+		V2TIMConversation ToV2TIM() const
+		{
+			V2TIMConversation Conversation;
+			Conversation.type = Type;
+			Conversation.conversationID = ConversationID;
+			Conversation.userID = UserID;
+			Conversation.groupID = GroupID;
+			Conversation.showName = ShowName;
+			Conversation.unreadCount = UnreadCount;
+			Conversation.draftText = DraftText;
+			Conversation.draftTimestamp = DraftTimestamp;
+			Conversation.isPinned = bPinned;
+			Conversation.orderKey = OrderKey;
+			return Conversation;
+		}
+	};
+
+	bool MatchesFilter(const LoopbackConversation &conversation, const V2TIMConversationListFilter &filter)
+	{
+		return filter.type == V2TIM_UNKNOWN || filter.type == conversation.Type;
+	}
+
+	class LoopbackMessageManager final : public V2TIMMessageManager
+	{
+	public:
+		explicit LoopbackMessageManager(LoopbackManager &owner) : Owner(owner) {}
+
+		void AddAdvancedMsgListener(V2TIMAdvancedMsgListener *listener) override;
+		void RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *listener) override;
+
+		V2TIMMessage CreateTextMessage(const V2TIMString &text) override;
+		V2TIMMessage CreateTextAtMessage(const V2TIMString &text, const V2TIMStringVector &atUserList) override;
+		V2TIMMessage CreateCustomMessage(const V2TIMBuffer &data) override;
+		V2TIMMessage CreateCustomMessage(const V2TIMBuffer &data, const V2TIMString &description, const V2TIMString &extension) override;
+		V2TIMMessage CreateImageMessage(const V2TIMString &imagePath) override { return CreateEmptyMessage(); }
+		V2TIMMessage CreateSoundMessage(const V2TIMString &soundPath, uint32_t duration) override { return CreateEmptyMessage(); }
+		V2TIMMessage CreateVideoMessage(const V2TIMString &videoFilePath, const V2TIMString &type, uint32_t duration, const V2TIMString &snapshotPath) override { return CreateEmptyMessage(); }
+		V2TIMMessage CreateFileMessage(const V2TIMString &filePath, const V2TIMString &fileName) override { return CreateEmptyMessage(); }
+		V2TIMMessage CreateLocationMessage(const V2TIMString &desc, double longitude, double latitude) override { return CreateEmptyMessage(); }
+		V2TIMMessage CreateFaceMessage(uint32_t index, const V2TIMBuffer &data) override { return CreateEmptyMessage(); }
+		V2TIMMessage CreateMergerMessage(const V2TIMMessageVector &messageList, const V2TIMString &title, const V2TIMStringVector &abstractList, const V2TIMString &compatibleText) override { return CreateEmptyMessage(); }
+		V2TIMMessage CreateForwardMessage(const V2TIMMessage &message) override;
+		V2TIMMessage CreateTargetedGroupMessage(const V2TIMMessage &message, const V2TIMStringVector &receiverList) override { return message; }
+		V2TIMMessage CreateAtSignedGroupMessage(const V2TIMMessage &message, const V2TIMStringVector &atUserList) override;
+
+		V2TIMString SendMessage(V2TIMMessage &message, const V2TIMString &receiver, const V2TIMString &groupID, V2TIMMessagePriority priority,
+								bool onlineUserOnly, const V2TIMOfflinePushInfo &offlinePushInfo, V2TIMSendCallback *callback) override;
+
+		void SetC2CReceiveMessageOpt(const V2TIMStringVector &userIDList, V2TIMReceiveMessageOpt opt, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void GetC2CReceiveMessageOpt(const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMReceiveMessageOptInfoVector> *callback) override { ReplyNotSupported(callback); }
+		void SetGroupReceiveMessageOpt(const V2TIMString &groupID, V2TIMReceiveMessageOpt opt, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void GetHistoryMessageList(const V2TIMMessageListGetOption &option, V2TIMValueCallback<V2TIMMessageVector> *callback) override;
+		void RevokeMessage(const V2TIMMessage &message, V2TIMCallback *callback) override;
+		void ModifyMessage(const V2TIMMessage &message, V2TIMCompleteCallback<V2TIMMessage> *callback) override { ReplyNotSupported(callback); }
+		void MarkC2CMessageAsRead(const V2TIMString &userID, V2TIMCallback *callback) override;
+		void MarkGroupMessageAsRead(const V2TIMString &groupID, V2TIMCallback *callback) override;
+		void MarkAllMessageAsRead(V2TIMCallback *callback) override;
+		void DeleteMessages(const V2TIMMessageVector &messages, V2TIMCallback *callback) override;
+		void ClearC2CHistoryMessage(const V2TIMString &userID, V2TIMCallback *callback) override;
+		void ClearGroupHistoryMessage(const V2TIMString &groupID, V2TIMCallback *callback) override;
+		V2TIMString InsertGroupMessageToLocalStorage(V2TIMMessage &message, const V2TIMString &groupID, const V2TIMString &sender, V2TIMValueCallback<V2TIMMessage> *callback) override
+		{
+			ReplyNotSupported(callback);
+			return V2TIMString();
+		}
+		V2TIMString InsertC2CMessageToLocalStorage(V2TIMMessage &message, const V2TIMString &userID, const V2TIMString &sender, V2TIMValueCallback<V2TIMMessage> *callback) override
+		{
+			ReplyNotSupported(callback);
+			return V2TIMString();
+		}
+		void FindMessages(const V2TIMStringVector &messageIDList, V2TIMValueCallback<V2TIMMessageVector> *callback) override;
+		void SearchLocalMessages(const V2TIMMessageSearchParam &searchParam, V2TIMValueCallback<V2TIMMessageSearchResult> *callback) override { ReplyNotSupported(callback); }
+		void SendMessageReadReceipts(const V2TIMMessageVector &messageList, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void GetMessageReadReceipts(const V2TIMMessageVector &messageList, V2TIMValueCallback<V2TIMMessageReceiptVector> *callback) override { ReplyNotSupported(callback); }
+		void GetGroupMessageReadMemberList(const V2TIMMessage &message, V2TIMGroupMessageReadMembersFilter filter, uint64_t nextSeq, uint32_t count,
+										   V2TIMValueCallback<V2TIMGroupMessageReadMemberList> *callback) override { ReplyNotSupported(callback); }
+		void SetMessageExtensions(const V2TIMMessage &message, const V2TIMMessageExtensionVector &extensions, V2TIMValueCallback<V2TIMMessageExtensionResultVector> *callback) override { ReplyNotSupported(callback); }
+		void GetMessageExtensions(const V2TIMMessage &message, V2TIMValueCallback<V2TIMMessageExtensionVector> *callback) override { ReplyNotSupported(callback); }
+		void DeleteMessageExtensions(const V2TIMMessage &message, const V2TIMStringVector &keys, V2TIMValueCallback<V2TIMMessageExtensionResultVector> *callback) override { ReplyNotSupported(callback); }
+		void TranslateText(const V2TIMStringVector &sourceTextList, const V2TIMString &sourceLanguage, const V2TIMString &targetLanguage,
+						   V2TIMValueCallback<V2TIMStringToV2TIMStringMap> *callback) override { ReplyNotSupported(callback); }
+
+	private:
+		V2TIMMessage CreateEmptyMessage();
+
+		LoopbackManager &Owner;
+	};
+
+	class LoopbackGroupManager final : public V2TIMGroupManager
+	{
+	public:
+		explicit LoopbackGroupManager(LoopbackManager &owner) : Owner(owner) {}
+
+		void CreateGroup(const V2TIMGroupInfo &info, const V2TIMCreateGroupMemberInfoVector &memberList, V2TIMValueCallback<V2TIMString> *callback) override;
+		void GetJoinedGroupList(V2TIMValueCallback<V2TIMGroupInfoVector> *callback) override;
+		void GetGroupsInfo(const V2TIMStringVector &groupIDList, V2TIMValueCallback<V2TIMGroupInfoResultVector> *callback) override;
+		void SearchGroups(const V2TIMGroupSearchParam &searchParam, V2TIMValueCallback<V2TIMGroupInfoVector> *callback) override { ReplyNotSupported(callback); }
+		void SetGroupInfo(const V2TIMGroupInfo &info, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void InitGroupAttributes(const V2TIMString &groupID, const V2TIMGroupAttributeMap &attributes, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void SetGroupAttributes(const V2TIMString &groupID, const V2TIMGroupAttributeMap &attributes, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void DeleteGroupAttributes(const V2TIMString &groupID, const V2TIMStringVector &keys, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void GetGroupAttributes(const V2TIMString &groupID, const V2TIMStringVector &keys, V2TIMValueCallback<V2TIMGroupAttributeMap> *callback) override { ReplyNotSupported(callback); }
+		void GetGroupOnlineMemberCount(const V2TIMString &groupID, V2TIMValueCallback<uint32_t> *callback) override;
+		void SetGroupCounters(const V2TIMString &groupID, const V2TIMStringToInt64Map &counters, V2TIMValueCallback<V2TIMStringToInt64Map> *callback) override { ReplyNotSupported(callback); }
+		void GetGroupCounters(const V2TIMString &groupID, const V2TIMStringVector &keys, V2TIMValueCallback<V2TIMStringToInt64Map> *callback) override { ReplyNotSupported(callback); }
+		void IncreaseGroupCounter(const V2TIMString &groupID, const V2TIMString &key, int64_t value, V2TIMValueCallback<V2TIMStringToInt64Map> *callback) override { ReplyNotSupported(callback); }
+		void DecreaseGroupCounter(const V2TIMString &groupID, const V2TIMString &key, int64_t value, V2TIMValueCallback<V2TIMStringToInt64Map> *callback) override { ReplyNotSupported(callback); }
+		void GetGroupMemberList(const V2TIMString &groupID, uint32_t filter, uint64_t nextSeq, V2TIMValueCallback<V2TIMGroupMemberInfoResult> *callback) override;
+		void GetGroupMembersInfo(const V2TIMString &groupID, V2TIMStringVector memberList, V2TIMValueCallback<V2TIMGroupMemberFullInfoVector> *callback) override;
+		void SearchGroupMembers(const V2TIMGroupMemberSearchParam &param, V2TIMValueCallback<V2TIMGroupSearchGroupMembersMap> *callback) override { ReplyNotSupported(callback); }
+		void SetGroupMemberInfo(const V2TIMString &groupID, const V2TIMGroupMemberFullInfo &info, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void MuteGroupMember(const V2TIMString &groupID, const V2TIMString &userID, uint32_t seconds, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void InviteUserToGroup(const V2TIMString &groupID, const V2TIMStringVector &userList, V2TIMValueCallback<V2TIMGroupMemberOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void KickGroupMember(const V2TIMString &groupID, const V2TIMStringVector &memberList, const V2TIMString &reason,
+							 V2TIMValueCallback<V2TIMGroupMemberOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void SetGroupMemberRole(const V2TIMString &groupID, const V2TIMString &userID, uint32_t role, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void MarkGroupMemberList(const V2TIMString &groupID, const V2TIMStringVector &memberList, uint32_t markType, bool enableMark, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void TransferGroupOwner(const V2TIMString &groupID, const V2TIMString &userID, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void GetGroupApplicationList(V2TIMValueCallback<V2TIMGroupApplicationResult> *callback) override { ReplyNotSupported(callback); }
+		void AcceptGroupApplication(const V2TIMGroupApplication &application, const V2TIMString &reason, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void RefuseGroupApplication(const V2TIMGroupApplication &application, const V2TIMString &reason, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void SetGroupApplicationRead(V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void GetJoinedCommunityList(V2TIMValueCallback<V2TIMGroupInfoVector> *callback) override { ReplyNotSupported(callback); }
+		void CreateTopicInCommunity(const V2TIMString &groupID, const V2TIMTopicInfo &topicInfo, V2TIMValueCallback<V2TIMString> *callback) override { ReplyNotSupported(callback); }
+		void DeleteTopicFromCommunity(const V2TIMString &groupID, const V2TIMStringVector &topicIDList, V2TIMValueCallback<V2TIMTopicOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void SetTopicInfo(const V2TIMTopicInfo &topicInfo, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void GetTopicInfoList(const V2TIMString &groupID, const V2TIMStringVector &topicIDList, V2TIMValueCallback<V2TIMTopicInfoResultVector> *callback) override { ReplyNotSupported(callback); }
+
+	private:
+		LoopbackManager &Owner;
+	};
+
+	class LoopbackConversationManager final : public V2TIMConversationManager
+	{
+	public:
+		explicit LoopbackConversationManager(LoopbackManager &owner) : Owner(owner) {}
+
+		void AddConversationListener(V2TIMConversationListener *listener) override;
+		void RemoveConversationListener(V2TIMConversationListener *listener) override;
+		void GetConversationList(uint64_t nextSeq, uint32_t count, V2TIMValueCallback<V2TIMConversationResult> *callback) override;
+		void GetConversation(const V2TIMString &conversationID, V2TIMValueCallback<V2TIMConversation> *callback) override;
+		void GetConversationList(const V2TIMStringVector &conversationIDList, V2TIMValueCallback<V2TIMConversationVector> *callback) override;
+		void GetConversationListByFilter(const V2TIMConversationListFilter &filter, uint64_t nextSeq, uint32_t count, V2TIMValueCallback<V2TIMConversationResult> *callback) override;
+		void DeleteConversation(const V2TIMString &conversationID, V2TIMCallback *callback) override;
+		void SetConversationDraft(const V2TIMString &conversationID, const V2TIMString &draftText, V2TIMCallback *callback) override;
+		void SetConversationCustomData(const V2TIMStringVector &conversationIDList, const V2TIMBuffer &customData, V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void PinConversation(const V2TIMString &conversationID, bool isPinned, V2TIMCallback *callback) override;
+		void MarkConversation(const V2TIMStringVector &conversationIDList, uint64_t markType, bool enableMark, V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void GetTotalUnreadMessageCount(V2TIMValueCallback<uint64_t> *callback) override;
+		void GetUnreadMessageCountByFilter(const V2TIMConversationListFilter &filter, V2TIMValueCallback<uint64_t> *callback) override;
+		void SubscribeUnreadMessageCountByFilter(const V2TIMConversationListFilter &filter) override {}
+		void UnsubscribeUnreadMessageCountByFilter(const V2TIMConversationListFilter &filter) override {}
+		void CreateConversationGroup(const V2TIMString &groupName, const V2TIMStringVector &conversationIDList, V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void GetConversationGroupList(V2TIMValueCallback<V2TIMStringVector> *callback) override { ReplyNotSupported(callback); }
+		void DeleteConversationGroup(const V2TIMString &groupName, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void RenameConversationGroup(const V2TIMString &oldName, const V2TIMString &newName, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void AddConversationsToGroup(const V2TIMString &groupName, const V2TIMStringVector &conversationIDList, V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void DeleteConversationsFromGroup(const V2TIMString &groupName, const V2TIMStringVector &conversationIDList, V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+#if PLATFORM_ANDROID
+		// Android 版 SDK 头文件中多出的接口
+		void DeleteConversationList(const V2TIMStringVector &conversationIDList, bool clearMessage, V2TIMValueCallback<V2TIMConversationOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void CleanConversationUnreadMessageCount(const V2TIMString &conversationID, uint64_t cleanTimestamp, uint64_t cleanSequence, V2TIMCallback *callback) override;
+#endif
+
+	private:
+		void GetPage(const V2TIMConversationListFilter &filter, uint64_t nextSeq, uint32_t count, V2TIMValueCallback<V2TIMConversationResult> *callback);
+
+		LoopbackManager &Owner;
+	};
+
+	class LoopbackFriendshipManager final : public V2TIMFriendshipManager
+	{
+	public:
+		explicit LoopbackFriendshipManager(LoopbackManager &owner)
+			: Owner(owner)
+		{
+		}
+
+		// 监听器只用于回放录制的事件（见 TencentCloudChatLoopback::PostEvent）
+		void AddFriendListener(V2TIMFriendshipListener *listener) override;
+		void RemoveFriendListener(V2TIMFriendshipListener *listener) override;
+		void GetFriendList(V2TIMValueCallback<V2TIMFriendInfoVector> *callback) override { ReplyNotSupported(callback); }
+		void GetFriendsInfo(const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMFriendInfoResultVector> *callback) override { ReplyNotSupported(callback); }
+		void SetFriendInfo(const V2TIMFriendInfo &info, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void SearchFriends(const V2TIMFriendSearchParam &searchParam, V2TIMValueCallback<V2TIMFriendInfoResultVector> *callback) override { ReplyNotSupported(callback); }
+		void AddFriend(const V2TIMFriendAddApplication &application, V2TIMValueCallback<V2TIMFriendOperationResult> *callback) override { ReplyNotSupported(callback); }
+		void DeleteFromFriendList(const V2TIMStringVector &userIDList, V2TIMFriendType deleteType, V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void CheckFriend(const V2TIMStringVector &userIDList, V2TIMFriendType checkType, V2TIMValueCallback<V2TIMFriendCheckResultVector> *callback) override { ReplyNotSupported(callback); }
+		void GetFriendApplicationList(V2TIMValueCallback<V2TIMFriendApplicationResult> *callback) override { ReplyNotSupported(callback); }
+		void AcceptFriendApplication(const V2TIMFriendApplication &application, V2TIMFriendAcceptType acceptType, V2TIMValueCallback<V2TIMFriendOperationResult> *callback) override { ReplyNotSupported(callback); }
+		void RefuseFriendApplication(const V2TIMFriendApplication &application, V2TIMValueCallback<V2TIMFriendOperationResult> *callback) override { ReplyNotSupported(callback); }
+		void DeleteFriendApplication(const V2TIMFriendApplication &application, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void SetFriendApplicationRead(V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void AddToBlackList(const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void DeleteFromBlackList(const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void GetBlackList(V2TIMValueCallback<V2TIMFriendInfoVector> *callback) override { ReplyNotSupported(callback); }
+		void CreateFriendGroup(const V2TIMString &groupName, const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void GetFriendGroups(const V2TIMStringVector &groupNameList, V2TIMValueCallback<V2TIMFriendGroupVector> *callback) override { ReplyNotSupported(callback); }
+		void DeleteFriendGroup(const V2TIMStringVector &groupNameList, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void RenameFriendGroup(const V2TIMString &oldName, const V2TIMString &newName, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void AddFriendsToFriendGroup(const V2TIMString &groupName, const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+		void DeleteFriendsFromFriendGroup(const V2TIMString &groupName, const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMFriendOperationResultVector> *callback) override { ReplyNotSupported(callback); }
+
+	private:
+		LoopbackManager &Owner;
+	};
+
+	class LoopbackOfflinePushManager final : public V2TIMOfflinePushManager
+	{
+	public:
+		// 没有离线推送，直接成功
+		void SetOfflinePushConfig(const V2TIMOfflinePushConfig &config, V2TIMCallback *callback) override { Reply(callback); }
+		void DoBackground(uint32_t unreadCount, V2TIMCallback *callback) override { Reply(callback); }
+		void DoForeground(V2TIMCallback *callback) override { Reply(callback); }
+	};
+
+	class LoopbackSignalingManager final : public V2TIMSignalingManager
+	{
+	public:
+		explicit LoopbackSignalingManager(LoopbackManager &owner)
+			: Owner(owner)
+		{
+		}
+
+		// 监听器只用于回放录制的事件（见 TencentCloudChatLoopback::PostEvent）
+		void AddSignalingListener(V2TIMSignalingListener *listener) override;
+		void RemoveSignalingListener(V2TIMSignalingListener *listener) override;
+		V2TIMString Invite(const V2TIMString &invitee, const V2TIMString &data, bool onlineUserOnly, const V2TIMOfflinePushInfo &offlinePushInfo, int timeout, V2TIMCallback *callback) override
+		{
+			ReplyNotSupported(callback);
+			return V2TIMString();
+		}
+		V2TIMString InviteInGroup(const V2TIMString &groupID, const V2TIMStringVector &inviteeList, const V2TIMString &data, bool onlineUserOnly, int timeout, V2TIMCallback *callback) override
+		{
+			ReplyNotSupported(callback);
+			return V2TIMString();
+		}
+		void Cancel(const V2TIMString &inviteID, const V2TIMString &data, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void Accept(const V2TIMString &inviteID, const V2TIMString &data, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void Reject(const V2TIMString &inviteID, const V2TIMString &data, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		V2TIMSignalingInfo GetSignalingInfo(const V2TIMMessage &msg) override { return V2TIMSignalingInfo(); }
+		void AddInvitedSignaling(const V2TIMSignalingInfo &info, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void ModifyInvitation(const V2TIMString &inviteID, const V2TIMString &data, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+
+	private:
+		LoopbackManager &Owner;
+	};
+
+	/**
+	 * 一个模拟客户端。监听器和会话由 Mutex 保护，回调和事件都在模拟网络线程上触发
+	 */
+	class LoopbackManager final : public V2TIMManager, public TSharedFromThis<LoopbackManager, ESPMode::ThreadSafe>
+	{
+	public:
+		LoopbackManager()
+			: MessageManager(*this), GroupManager(*this), ConversationManager(*this), FriendshipManager(*this), SignalingManager(*this)
+		{
+		}
+
+		void AddSDKListener(V2TIMSDKListener *listener) override { AddListener(SDKListeners, listener); }
+		void RemoveSDKListener(V2TIMSDKListener *listener) override { RemoveListener(SDKListeners, listener); }
+		bool InitSDK(uint32_t sdkAppID, const V2TIMSDKConfig &config) override;
+		void UnInitSDK() override;
+		V2TIMString GetVersion() override { return V2TIMString("loopback"); }
+		int64_t GetServerTime() override { return LoopbackNow(); }
+		void Login(const V2TIMString &userID, const V2TIMString &userSig, V2TIMCallback *callback) override;
+		void Logout(V2TIMCallback *callback) override;
+		V2TIMString GetLoginUser() override;
+		V2TIMLoginStatus GetLoginStatus() override;
+		void AddSimpleMsgListener(V2TIMSimpleMsgListener *listener) override { AddListener(SimpleMsgListeners, listener); }
+		void RemoveSimpleMsgListener(V2TIMSimpleMsgListener *listener) override { RemoveListener(SimpleMsgListeners, listener); }
+		V2TIMString SendC2CTextMessage(const V2TIMString &text, const V2TIMString &userID, V2TIMSendCallback *callback) override;
+		V2TIMString SendC2CCustomMessage(const V2TIMBuffer &customData, const V2TIMString &userID, V2TIMSendCallback *callback) override;
+		V2TIMString SendGroupTextMessage(const V2TIMString &text, const V2TIMString &groupID, V2TIMMessagePriority priority, V2TIMSendCallback *callback) override;
+		V2TIMString SendGroupCustomMessage(const V2TIMBuffer &customData, const V2TIMString &groupID, V2TIMMessagePriority priority, V2TIMSendCallback *callback) override;
+		void AddGroupListener(V2TIMGroupListener *listener) override { AddListener(GroupListeners, listener); }
+		void RemoveGroupListener(V2TIMGroupListener *listener) override { RemoveListener(GroupListeners, listener); }
+		void CreateGroup(const V2TIMString &groupType, const V2TIMString &groupID, const V2TIMString &groupName, V2TIMValueCallback<V2TIMString> *callback) override;
+		void JoinGroup(const V2TIMString &groupID, const V2TIMString &message, V2TIMCallback *callback) override;
+		void QuitGroup(const V2TIMString &groupID, V2TIMCallback *callback) override;
+		void DismissGroup(const V2TIMString &groupID, V2TIMCallback *callback) override;
+		void GetUsersInfo(const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMUserFullInfoVector> *callback) override;
+		void SetSelfInfo(const V2TIMUserFullInfo &info, V2TIMCallback *callback) override;
+		void GetUserStatus(const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMUserStatusVector> *callback) override;
+		void SetSelfStatus(const V2TIMUserStatus &status, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void SubscribeUserStatus(const V2TIMStringVector &userIDList, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		void UnsubscribeUserStatus(const V2TIMStringVector &userIDList, V2TIMCallback *callback) override { ReplyNotSupported(callback); }
+		V2TIMMessageManager *GetMessageManager() override { return &MessageManager; }
+		V2TIMGroupManager *GetGroupManager() override { return &GroupManager; }
+		V2TIMConversationManager *GetConversationManager() override { return &ConversationManager; }
+		V2TIMFriendshipManager *GetFriendshipManager() override { return &FriendshipManager; }
+		V2TIMOfflinePushManager *GetOfflinePushManager() override { return &OfflinePushManager; }
+		V2TIMSignalingManager *GetSignalingManager() override { return &SignalingManager; }
+		void CallExperimentalAPI(const V2TIMString &api, const void *param, V2TIMValueCallback<V2TIMBaseObject> *callback) override { ReplyNotSupported(callback); }
+
+		void AddAdvancedMsgListener(V2TIMAdvancedMsgListener *listener) { AddListener(AdvancedMsgListeners, listener); }
+		void RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *listener) { RemoveListener(AdvancedMsgListeners, listener); }
+		void AddConversationListener(V2TIMConversationListener *listener) { AddListener(ConversationListeners, listener); }
+		void RemoveConversationListener(V2TIMConversationListener *listener) { RemoveListener(ConversationListeners, listener); }
+		void AddFriendshipListener(V2TIMFriendshipListener *listener) { AddListener(FriendshipListeners, listener); }
+		void RemoveFriendshipListener(V2TIMFriendshipListener *listener) { RemoveListener(FriendshipListeners, listener); }
+		void AddSignalingListener(V2TIMSignalingListener *listener) { AddListener(SignalingListeners, listener); }
+		void RemoveSignalingListener(V2TIMSignalingListener *listener) { RemoveListener(SignalingListeners, listener); }
+
+		/**
+		 * 拷贝当前注册的监听器，用于在锁外分发
+		 */
+		void GetListeners(TencentCloudChatLoopbackListeners &outListeners);
+
+		/**
+		 * 填写发送方信息后创建一条由当前用户发出的消息，elem 的所有权转给消息
+		 */
+		V2TIMMessage NewMessage(V2TIMElem *elem);
+
+		V2TIMString Send(V2TIMMessage &message, const V2TIMString &receiver, const V2TIMString &groupID, V2TIMMessagePriority priority,
+						 bool bOnlineUserOnly, V2TIMSendCallback *callback);
+
+		// 以下在模拟网络线程上调用
+		void Deliver(const V2TIMMessage &message, bool bUpdateConversation);
+		void DeliverRevoked(const V2TIMString &msgID);
+		void UpdateConversation(const V2TIMMessage &message, bool bIncoming);
+		void KickOffline();
+		TArray<V2TIMGroupListener *> GetGroupListeners();
+
+		V2TIMGroupMemberInfo GetSelfMemberInfo();
+
+		/**
+		 * 清空 filter 选中的会话的未读数，通知会话监听器后回调 callback
+		 */
+		void MarkRead(TFunctionRef<bool(const LoopbackConversation &)> filter, V2TIMCallback *callback);
+
+		/**
+		 * 在锁内对当前用户的会话执行 func
+		 */
+		template <class Func>
+		auto WithConversations(Func &&func)
+		{
+			FScopeLock Lock(&Mutex);
+			return func(Conversations, TotalUnread);
+		}
+
+		void NotifyConversations(const V2TIMConversationVector &conversations, bool bNew, bool bTotalChanged, uint64 totalUnread);
+
+		/**
+		 * 在模拟网络线程上通知会话变化，然后回调 callback
+		 */
+		void PostConversationsChanged(const V2TIMConversationVector &conversations, bool bTotalChanged, uint64 totalUnread, V2TIMCallback *callback);
+
+	private:
+		template <class ListenerType>
+		void AddListener(TArray<ListenerType *> &listeners, ListenerType *listener)
+		{
+			if (listener)
+			{
+				FScopeLock Lock(&Mutex);
+				listeners.AddUnique(listener);
+			}
+		}
+
+		template <class ListenerType>
+		void RemoveListener(TArray<ListenerType *> &listeners, ListenerType *listener)
+		{
+			FScopeLock Lock(&Mutex);
+			listeners.Remove(listener);
+		}
+
+		void CreateGroupInternal(const V2TIMString &groupType, const V2TIMString &groupID, const V2TIMString &groupName,
+								 const TArray<V2TIMString> &members, V2TIMValueCallback<V2TIMString> *callback);
+		void LogoutInternal();
+
+		friend class LoopbackGroupManager;
+
+		LoopbackMessageManager MessageManager;
+		LoopbackGroupManager GroupManager;
+		LoopbackConversationManager ConversationManager;
+		LoopbackFriendshipManager FriendshipManager;
+		LoopbackOfflinePushManager OfflinePushManager;
+		LoopbackSignalingManager SignalingManager;
+
+		FCriticalSection Mutex;
+		bool bInitialized = false;
+		V2TIMLoginStatus LoginStatus = V2TIM_STATUS_LOGOUT;
+		V2TIMString UserID;
+		V2TIMString NickName;
+		V2TIMString FaceURL;
+		TArray<V2TIMSDKListener *> SDKListeners;
+		TArray<V2TIMSimpleMsgListener *> SimpleMsgListeners;
+		TArray<V2TIMAdvancedMsgListener *> AdvancedMsgListeners;
+		TArray<V2TIMGroupListener *> GroupListeners;
+		TArray<V2TIMConversationListener *> ConversationListeners;
+		TArray<V2TIMFriendshipListener *> FriendshipListeners;
+		TArray<V2TIMSignalingListener *> SignalingListeners;
+		TMap<V2TIMString, LoopbackConversation> Conversations;
+		uint64 TotalUnread = 0;
+	};
+
+	bool LoopbackManager::InitSDK(uint32_t sdkAppID, const V2TIMSDKConfig &config)
+	{
+		{
+			FScopeLock Lock(&Mutex);
+			bInitialized = true;
+		}
+		LoopbackPost(RollRequestDelay(), [Self = AsShared()]()
+		{
+			TArray<V2TIMSDKListener *> Listeners;
+			{
+				FScopeLock Lock(&Self->Mutex);
+				Listeners = Self->SDKListeners;
+			}
+			for (V2TIMSDKListener *Listener : Listeners)
+			{
+				Listener->OnConnecting();
+				Listener->OnConnectSuccess();
+			}
+		});
+		return true;
+	}
+
+	void LoopbackManager::UnInitSDK()
+	{
+		LogoutInternal();
+		FScopeLock Lock(&Mutex);
+		bInitialized = false;
+	}
+
+	void LoopbackManager::Login(const V2TIMString &userID, const V2TIMString &userSig, V2TIMCallback *callback)
+	{
+		bool bReady = false;
+		{
+			FScopeLock Lock(&Mutex);
+			bReady = bInitialized;
+		}
+		if (!bReady)
+		{
+			ReplyError(callback, ERR_SDK_NOT_INITIALIZED, "InitSDK has not been called");
+			return;
+		}
+		if (userID.Size() == 0)
+		{
+			ReplyError(callback, ERR_INVALID_PARAMETERS, "userID is empty");
+			return;
+		}
+
+		if (GetLoginUser() != userID)
+		{
+			LogoutInternal();
+		}
+
+		LoopbackManagerPtr Kicked;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			LoopbackManagerPtr &Slot = LoopbackOnlineUsers.FindOrAdd(userID);
+			if (Slot.IsValid() && Slot.Get() != this)
+			{
+				Kicked = Slot;
+			}
+			Slot = AsShared();
+
+			FScopeLock Lock(&Mutex);
+			UserID = userID;
+			LoginStatus = V2TIM_STATUS_LOGINED;
+		}
+		// 同一用户在另一个实例上登录时，旧实例被踢下线
+		if (Kicked)
+		{
+			Kicked->KickOffline();
+		}
+		Reply(callback);
+	}
+
+	void LoopbackManager::LogoutInternal()
+	{
+		V2TIMString OldUserID;
+		{
+			FScopeLock Lock(&Mutex);
+			if (LoginStatus != V2TIM_STATUS_LOGINED)
+			{
+				return;
+			}
+			OldUserID = UserID;
+			UserID = V2TIMString();
+			LoginStatus = V2TIM_STATUS_LOGOUT;
+			Conversations.Reset();
+			TotalUnread = 0;
+		}
+		FScopeLock NetworkLock(&LoopbackMutex);
+		const LoopbackManagerPtr *Slot = LoopbackOnlineUsers.Find(OldUserID);
+		if (Slot && Slot->Get() == this)
+		{
+			LoopbackOnlineUsers.Remove(OldUserID);
+		}
+	}
+
+	void LoopbackManager::Logout(V2TIMCallback *callback)
+	{
+		LogoutInternal();
+		Reply(callback);
+	}
+
+	void LoopbackManager::KickOffline()
+	{
+		{
+			FScopeLock Lock(&Mutex);
+			UserID = V2TIMString();
+			LoginStatus = V2TIM_STATUS_LOGOUT;
+			Conversations.Reset();
+			TotalUnread = 0;
+		}
+		LoopbackPost(RollRequestDelay(), [Self = AsShared()]()
+		{
+			TArray<V2TIMSDKListener *> Listeners;
+			{
+				FScopeLock Lock(&Self->Mutex);
+				Listeners = Self->SDKListeners;
+			}
+			for (V2TIMSDKListener *Listener : Listeners)
+			{
+				Listener->OnKickedOffline();
+			}
+		});
+	}
+
+	V2TIMString LoopbackManager::GetLoginUser()
+	{
+		FScopeLock Lock(&Mutex);
+		return UserID;
+	}
+
+	V2TIMLoginStatus LoopbackManager::GetLoginStatus()
+	{
+		FScopeLock Lock(&Mutex);
+		return LoginStatus;
+	}
+
+	TArray<V2TIMGroupListener *> LoopbackManager::GetGroupListeners()
+	{
+		FScopeLock Lock(&Mutex);
+		return GroupListeners;
+	}
+
+	void LoopbackManager::GetListeners(TencentCloudChatLoopbackListeners &outListeners)
+	{
+		FScopeLock Lock(&Mutex);
+		outListeners.SDK.Append(SDKListeners);
+		outListeners.AdvancedMsg.Append(AdvancedMsgListeners);
+		outListeners.Group.Append(GroupListeners);
+		outListeners.Conversation.Append(ConversationListeners);
+		outListeners.Friendship.Append(FriendshipListeners);
+		outListeners.Signaling.Append(SignalingListeners);
+	}
+
+	V2TIMGroupMemberInfo LoopbackManager::GetSelfMemberInfo()
+	{
+		FScopeLock Lock(&Mutex);
+		V2TIMGroupMemberInfo Info;
+		Info.userID = UserID;
+		Info.nickName = NickName;
+		Info.faceURL = FaceURL;
+		return Info;
+	}
+
+	V2TIMMessage LoopbackManager::NewMessage(V2TIMElem *elem)
+	{
+		V2TIMMessage Message;
+		Message.msgID = NewMessageID();
+		Message.timestamp = LoopbackNow();
+		Message.status = V2TIM_MSG_STATUS_SENDING;
+		Message.isSelf = true;
+		{
+			FScopeLock Lock(&Mutex);
+			Message.sender = UserID;
+			Message.nickName = NickName;
+			Message.faceURL = FaceURL;
+		}
+		if (elem)
+		{
+			Message.elemList.PushBack(elem);
+		}
+		return Message;
+	}
+
+	V2TIMString LoopbackManager::Send(V2TIMMessage &message, const V2TIMString &receiver, const V2TIMString &groupID, V2TIMMessagePriority priority,
+									  bool bOnlineUserOnly, V2TIMSendCallback *callback)
+	{
+		V2TIMString Self;
+		{
+			FScopeLock Lock(&Mutex);
+			if (LoginStatus == V2TIM_STATUS_LOGINED)
+			{
+				Self = UserID;
+				message.nickName = NickName;
+				message.faceURL = FaceURL;
+			}
+		}
+		if (Self.Size() == 0)
+		{
+			ReplyError(callback, ERR_SDK_NOT_LOGGED_IN, "not logged in");
+			return V2TIMString();
+		}
+		const bool bGroup = groupID.Size() > 0;
+		if (!bGroup && receiver.Size() == 0)
+		{
+			ReplyError(callback, ERR_INVALID_PARAMETERS, "receiver and groupID are both empty");
+			return V2TIMString();
+		}
+
+		if (message.msgID.Size() == 0)
+		{
+			message.msgID = NewMessageID();
+		}
+		message.sender = Self;
+		message.userID = bGroup ? V2TIMString() : receiver;
+		message.groupID = groupID;
+		message.priority = priority;
+		message.timestamp = LoopbackNow();
+		message.isSelf = true;
+		message.status = V2TIM_MSG_STATUS_SENDING;
+
+		TArray<TPair<V2TIMString, double>> Deliveries;
+		double AckDelay = 0.0;
+		bool bLost = false;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			const LoopbackGroup *Group = bGroup ? LoopbackGroups.Find(groupID) : nullptr;
+			if (bGroup && (!Group || !Group->Members.Contains(Self)))
+			{
+				ReplyError(callback, Group ? ERR_SVR_GROUP_PERMISSION_DENY : ERR_SVR_GROUP_NOT_FOUND, "not a member of the group");
+				return message.msgID;
+			}
+			message.seq = LoopbackNextSeq++;
+			message.random = LoopbackRandom.GetUnsignedInt();
+			bLost = RollLoss();
+			const double Uplink = RollLegDelay();
+			AckDelay = Uplink + RollLegDelay();
+			if (!bLost)
+			{
+				message.status = V2TIM_MSG_STATUS_SEND_SUCC;
+				if (!bOnlineUserOnly)
+				{
+					AppendHistory(bGroup ? GroupHistoryKey(groupID) : C2CHistoryKey(Self, receiver), message);
+				}
+				if (bGroup)
+				{
+					Deliveries.Reserve(Group->Members.Num());
+					for (const V2TIMString &Member : Group->Members)
+					{
+						if (Member != Self)
+						{
+							Deliveries.Emplace(Member, Uplink + RollLegDelay());
+						}
+					}
+				}
+				else if (receiver != Self)
+				{
+					Deliveries.Emplace(receiver, Uplink + RollLegDelay());
+				}
+			}
+		}
+
+		V2TIMMessage Sent(message);
+		Sent.status = bLost ? V2TIM_MSG_STATUS_SEND_FAIL : V2TIM_MSG_STATUS_SEND_SUCC;
+		message.status = V2TIM_MSG_STATUS_SENDING;
+		LoopbackPost(AckDelay, [Sender = AsShared(), Sent, callback, bLost, bOnlineUserOnly]()
+		{
+			if (bLost)
+			{
+				if (callback)
+				{
+					callback->OnError(ERR_SDK_NET_WAIT_ACK_TIMEOUT, V2TIMString("dropped by the loopback network"));
+				}
+				return;
+			}
+			if (!bOnlineUserOnly)
+			{
+				Sender->UpdateConversation(Sent, false);
+			}
+			if (callback)
+			{
+				callback->OnSuccess(Sent);
+			}
+		});
+
+		if (Deliveries.Num() > 0)
+		{
+			// 群消息的每个接收者共用一份消息
+			V2TIMMessage Copy(Sent);
+			Copy.isSelf = false;
+			TSharedRef<V2TIMMessage, ESPMode::ThreadSafe> Received = MakeShared<V2TIMMessage, ESPMode::ThreadSafe>(MoveTemp(Copy));
+			for (const TPair<V2TIMString, double> &Delivery : Deliveries)
+			{
+				PostToUser(Delivery.Value, Delivery.Key, [Received, bOnlineUserOnly](LoopbackManager &Recipient)
+				{
+					Recipient.Deliver(*Received, !bOnlineUserOnly);
+				});
+			}
+		}
+		return message.msgID;
+	}
+
+	void LoopbackManager::Deliver(const V2TIMMessage &message, bool bUpdateConversation)
+	{
+		TArray<V2TIMAdvancedMsgListener *> Advanced;
+		TArray<V2TIMSimpleMsgListener *> Simple;
+		{
+			FScopeLock Lock(&Mutex);
+			if (LoginStatus != V2TIM_STATUS_LOGINED)
+			{
+				return;
+			}
+			Advanced = AdvancedMsgListeners;
+			Simple = SimpleMsgListeners;
+		}
+
+		for (V2TIMAdvancedMsgListener *Listener : Advanced)
+		{
+			Listener->OnRecvNewMessage(message);
+		}
+
+		// 与 SDK 一样，只有一个文本或自定义元素的消息才通知 V2TIMSimpleMsgListener
+		const V2TIMElem *Elem = message.elemList.Size() == 1 ? message.elemList[0] : nullptr;
+		if (Simple.Num() > 0 && Elem && (Elem->elemType == V2TIM_ELEM_TYPE_TEXT || Elem->elemType == V2TIM_ELEM_TYPE_CUSTOM))
+		{
+			const bool bText = Elem->elemType == V2TIM_ELEM_TYPE_TEXT;
+			if (message.groupID.Size() > 0)
+			{
+				V2TIMGroupMemberFullInfo Sender;
+				Sender.userID = message.sender;
+				Sender.nickName = message.nickName;
+				Sender.faceURL = message.faceURL;
+				for (V2TIMSimpleMsgListener *Listener : Simple)
+				{
+					if (bText)
+					{
+						Listener->OnRecvGroupTextMessage(message.msgID, message.groupID, Sender, static_cast<const V2TIMTextElem *>(Elem)->text);
+					}
+					else
+					{
+						Listener->OnRecvGroupCustomMessage(message.msgID, message.groupID, Sender, static_cast<const V2TIMCustomElem *>(Elem)->data);
+					}
+				}
+			}
+			else
+			{
+				V2TIMUserFullInfo Sender;
+				Sender.userID = message.sender;
+				Sender.nickName = message.nickName;
+				Sender.faceURL = message.faceURL;
+				for (V2TIMSimpleMsgListener *Listener : Simple)
+				{
+					if (bText)
+					{
+						Listener->OnRecvC2CTextMessage(message.msgID, Sender, static_cast<const V2TIMTextElem *>(Elem)->text);
+					}
+					else
+					{
+						Listener->OnRecvC2CCustomMessage(message.msgID, Sender, static_cast<const V2TIMCustomElem *>(Elem)->data);
+					}
+				}
+			}
+		}
+
+		if (bUpdateConversation)
+		{
+			UpdateConversation(message, true);
+		}
+	}
+
+	void LoopbackManager::DeliverRevoked(const V2TIMString &msgID)
+	{
+		TArray<V2TIMAdvancedMsgListener *> Advanced;
+		{
+			FScopeLock Lock(&Mutex);
+			if (LoginStatus != V2TIM_STATUS_LOGINED)
+			{
+				return;
+			}
+			Advanced = AdvancedMsgListeners;
+		}
+		for (V2TIMAdvancedMsgListener *Listener : Advanced)
+		{
+			Listener->OnRecvMessageRevoked(msgID);
+		}
+	}
+
+	void LoopbackManager::UpdateConversation(const V2TIMMessage &message, bool bIncoming)
+	{
+		const bool bGroup = message.groupID.Size() > 0;
+		const V2TIMString &Peer = bGroup ? message.groupID : (bIncoming ? message.sender : message.userID);
+		const V2TIMString ConversationID = LoopbackConcat(bGroup ? "group_" : "c2c_", Peer);
+
+		V2TIMConversationVector Changed;
+		bool bNew = false;
+		uint64 Total = 0;
+		{
+			FScopeLock Lock(&Mutex);
+			if (LoginStatus != V2TIM_STATUS_LOGINED)
+			{
+				return;
+			}
+			LoopbackConversation *Conversation = Conversations.Find(ConversationID);
+			bNew = Conversation == nullptr;
+			if (bNew)
+			{
+				Conversation = &Conversations.Add(ConversationID);
+				Conversation->Type = bGroup ? V2TIM_GROUP : V2TIM_C2C;
+				Conversation->ConversationID = ConversationID;
+				if (bGroup)
+				{
+					Conversation->GroupID = Peer;
+				}
+				else
+				{
+					Conversation->UserID = Peer;
+				}
+				Conversation->ShowName = Peer;
+			}
+			Conversation->OrderKey = FMath::Max<uint64>(Conversation->OrderKey, message.seq);
+			if (bIncoming)
+			{
+				++Conversation->UnreadCount;
+				++TotalUnread;
+			}
+			Changed.PushBack(Conversation->ToV2TIM());
+			Total = TotalUnread;
+		}
+		NotifyConversations(Changed, bNew, bIncoming, Total);
+	}
+
+	void LoopbackManager::NotifyConversations(const V2TIMConversationVector &conversations, bool bNew, bool bTotalChanged, uint64 totalUnread)
+	{
+		TArray<V2TIMConversationListener *> Listeners;
+		{
+			FScopeLock Lock(&Mutex);
+			Listeners = ConversationListeners;
+		}
+		for (V2TIMConversationListener *Listener : Listeners)
+		{
+			if (conversations.Size() > 0)
+			{
+				if (bNew)
+				{
+					Listener->OnNewConversation(conversations);
+				}
+				else
+				{
+					Listener->OnConversationChanged(conversations);
+				}
+			}
+			if (bTotalChanged)
+			{
+				Listener->OnTotalUnreadMessageCountChanged(totalUnread);
+			}
+		}
+	}
+
+	void LoopbackManager::MarkRead(TFunctionRef<bool(const LoopbackConversation &)> filter, V2TIMCallback *callback)
+	{
+		V2TIMConversationVector Changed;
+		uint64 Total = 0;
+		bool bLoggedIn = false;
+		{
+			FScopeLock Lock(&Mutex);
+			bLoggedIn = LoginStatus == V2TIM_STATUS_LOGINED;
+			for (TPair<V2TIMString, LoopbackConversation> &Pair : Conversations)
+			{
+				LoopbackConversation &Conversation = Pair.Value;
+				if (Conversation.UnreadCount > 0 && filter(Conversation))
+				{
+					TotalUnread -= FMath::Min<uint64>(TotalUnread, uint64(Conversation.UnreadCount));
+					Conversation.UnreadCount = 0;
+					Changed.PushBack(Conversation.ToV2TIM());
+				}
+			}
+			Total = TotalUnread;
+		}
+		if (!bLoggedIn)
+		{
+			ReplyError(callback, ERR_SDK_NOT_LOGGED_IN, "not logged in");
+			return;
+		}
+		PostConversationsChanged(Changed, Changed.Size() > 0, Total, callback);
+	}
+
+	void LoopbackManager::PostConversationsChanged(const V2TIMConversationVector &conversations, bool bTotalChanged, uint64 totalUnread, V2TIMCallback *callback)
+	{
+		LoopbackPost(RollRequestDelay(), [Self = AsShared(), conversations, bTotalChanged, totalUnread, callback]()
+		{
+			if (conversations.Size() > 0 || bTotalChanged)
+			{
+				Self->NotifyConversations(conversations, false, bTotalChanged, totalUnread);
+			}
+			if (callback)
+			{
+				callback->OnSuccess();
+			}
+		});
+	}
+
+	V2TIMString LoopbackManager::SendC2CTextMessage(const V2TIMString &text, const V2TIMString &userID, V2TIMSendCallback *callback)
+	{
+		V2TIMTextElem *Elem = new V2TIMTextElem();
+		Elem->text = text;
+		V2TIMMessage Message = NewMessage(Elem);
+		return Send(Message, userID, V2TIMString(), V2TIM_PRIORITY_DEFAULT, false, callback);
+	}
+
+	V2TIMString LoopbackManager::SendC2CCustomMessage(const V2TIMBuffer &customData, const V2TIMString &userID, V2TIMSendCallback *callback)
+	{
+		V2TIMCustomElem *Elem = new V2TIMCustomElem();
+		Elem->data = customData;
+		V2TIMMessage Message = NewMessage(Elem);
+		return Send(Message, userID, V2TIMString(), V2TIM_PRIORITY_DEFAULT, false, callback);
+	}
+
+	V2TIMString LoopbackManager::SendGroupTextMessage(const V2TIMString &text, const V2TIMString &groupID, V2TIMMessagePriority priority, V2TIMSendCallback *callback)
+	{
+		V2TIMTextElem *Elem = new V2TIMTextElem();
+		Elem->text = text;
+		V2TIMMessage Message = NewMessage(Elem);
+		return Send(Message, V2TIMString(), groupID, priority, false, callback);
+	}
+
+	V2TIMString LoopbackManager::SendGroupCustomMessage(const V2TIMBuffer &customData, const V2TIMString &groupID, V2TIMMessagePriority priority, V2TIMSendCallback *callback)
+	{
+		V2TIMCustomElem *Elem = new V2TIMCustomElem();
+		Elem->data = customData;
+		V2TIMMessage Message = NewMessage(Elem);
+		return Send(Message, V2TIMString(), groupID, priority, false, callback);
+	}
+
+	void LoopbackManager::CreateGroup(const V2TIMString &groupType, const V2TIMString &groupID, const V2TIMString &groupName, V2TIMValueCallback<V2TIMString> *callback)
+	{
+		CreateGroupInternal(groupType, groupID, groupName, TArray<V2TIMString>(), callback);
+	}
+
+	void LoopbackManager::CreateGroupInternal(const V2TIMString &groupType, const V2TIMString &groupID, const V2TIMString &groupName,
+											  const TArray<V2TIMString> &members, V2TIMValueCallback<V2TIMString> *callback)
+	{
+		const V2TIMString Self = GetLoginUser();
+		if (Self.Size() == 0)
+		{
+			ReplyError(callback, ERR_SDK_NOT_LOGGED_IN, "not logged in");
+			return;
+		}
+
+		V2TIMString NewGroupID = groupID;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			if (NewGroupID.Size() == 0)
+			{
+				NewGroupID = LoopbackNumberedID("@TGS#loopback", LoopbackNextGroupID++);
+			}
+			if (LoopbackGroups.Contains(NewGroupID))
+			{
+				ReplyError(callback, ERR_SVR_GROUP_GROUPID_IN_USED, "group ID is in use");
+				return;
+			}
+			LoopbackGroup &Group = LoopbackGroups.Add(NewGroupID);
+			Group.GroupType = groupType;
+			Group.GroupName = groupName;
+			Group.Owner = Self;
+			Group.CreateTime = uint32(LoopbackNow());
+			Group.Members.Add(Self);
+			for (const V2TIMString &Member : members)
+			{
+				Group.Members.AddUnique(Member);
+			}
+		}
+		Reply(callback, NewGroupID);
+	}
+
+	void LoopbackManager::JoinGroup(const V2TIMString &groupID, const V2TIMString &message, V2TIMCallback *callback)
+	{
+		const V2TIMString Self = GetLoginUser();
+		if (Self.Size() == 0)
+		{
+			ReplyError(callback, ERR_SDK_NOT_LOGGED_IN, "not logged in");
+			return;
+		}
+
+		TArray<V2TIMString> Others;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			LoopbackGroup *Group = LoopbackGroups.Find(groupID);
+			if (!Group)
+			{
+				ReplyError(callback, ERR_SVR_GROUP_NOT_FOUND, "group not found");
+				return;
+			}
+			if (Group->Members.Contains(Self))
+			{
+				ReplyError(callback, ERR_SVR_GROUP_ALLREADY_MEMBER, "already a member of the group");
+				return;
+			}
+			Others = Group->Members;
+			Group->Members.Add(Self);
+		}
+
+		V2TIMGroupMemberInfoVector Entered;
+		Entered.PushBack(GetSelfMemberInfo());
+		const double Delay = RollRequestDelay();
+		for (const V2TIMString &Member : Others)
+		{
+			PostToUser(Delay, Member, [groupID, Entered](LoopbackManager &Recipient)
+			{
+				for (V2TIMGroupListener *Listener : Recipient.GetGroupListeners())
+				{
+					Listener->OnMemberEnter(groupID, Entered);
+				}
+			});
+		}
+		Reply(callback);
+	}
+
+	void LoopbackManager::QuitGroup(const V2TIMString &groupID, V2TIMCallback *callback)
+	{
+		const V2TIMString Self = GetLoginUser();
+		if (Self.Size() == 0)
+		{
+			ReplyError(callback, ERR_SDK_NOT_LOGGED_IN, "not logged in");
+			return;
+		}
+
+		TArray<V2TIMString> Others;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			LoopbackGroup *Group = LoopbackGroups.Find(groupID);
+			if (!Group || !Group->Members.Contains(Self))
+			{
+				ReplyError(callback, Group ? ERR_SVR_GROUP_PERMISSION_DENY : ERR_SVR_GROUP_NOT_FOUND, "not a member of the group");
+				return;
+			}
+			Group->Members.Remove(Self);
+			Others = Group->Members;
+			if (Group->Members.Num() == 0)
+			{
+				LoopbackGroups.Remove(groupID);
+				LoopbackHistory.Remove(GroupHistoryKey(groupID));
+			}
+		}
+
+		const V2TIMGroupMemberInfo Left = GetSelfMemberInfo();
+		const double Delay = RollRequestDelay();
+		for (const V2TIMString &Member : Others)
+		{
+			PostToUser(Delay, Member, [groupID, Left](LoopbackManager &Recipient)
+			{
+				for (V2TIMGroupListener *Listener : Recipient.GetGroupListeners())
+				{
+					Listener->OnMemberLeave(groupID, Left);
+				}
+			});
+		}
+		Reply(callback);
+	}
+
+	void LoopbackManager::DismissGroup(const V2TIMString &groupID, V2TIMCallback *callback)
+	{
+		const V2TIMString Self = GetLoginUser();
+		if (Self.Size() == 0)
+		{
+			ReplyError(callback, ERR_SDK_NOT_LOGGED_IN, "not logged in");
+			return;
+		}
+
+		TArray<V2TIMString> Members;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			LoopbackGroup *Group = LoopbackGroups.Find(groupID);
+			if (!Group)
+			{
+				ReplyError(callback, ERR_SVR_GROUP_NOT_FOUND, "group not found");
+				return;
+			}
+			if (Group->Owner != Self)
+			{
+				ReplyError(callback, ERR_SVR_GROUP_PERMISSION_DENY, "only the owner can dismiss the group");
+				return;
+			}
+			Members = MoveTemp(Group->Members);
+			LoopbackGroups.Remove(groupID);
+			LoopbackHistory.Remove(GroupHistoryKey(groupID));
+		}
+
+		const V2TIMGroupMemberInfo OpUser = GetSelfMemberInfo();
+		const double Delay = RollRequestDelay();
+		for (const V2TIMString &Member : Members)
+		{
+			if (Member != Self)
+			{
+				PostToUser(Delay, Member, [groupID, OpUser](LoopbackManager &Recipient)
+				{
+					for (V2TIMGroupListener *Listener : Recipient.GetGroupListeners())
+					{
+						Listener->OnGroupDismissed(groupID, OpUser);
+					}
+				});
+			}
+		}
+		Reply(callback);
+	}
+
+	void LoopbackManager::GetUsersInfo(const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMUserFullInfoVector> *callback)
+	{
+		V2TIMUserFullInfoVector Result;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			for (size_t Index = 0; Index < userIDList.Size(); ++Index)
+			{
+				V2TIMUserFullInfo Info;
+				Info.userID = userIDList[Index];
+				if (const LoopbackManagerPtr *Manager = LoopbackOnlineUsers.Find(Info.userID))
+				{
+					FScopeLock Lock(&(*Manager)->Mutex);
+					Info.nickName = (*Manager)->NickName;
+					Info.faceURL = (*Manager)->FaceURL;
+				}
+				Result.PushBack(Info);
+			}
+		}
+		Reply(callback, Result);
+	}
+
+	void LoopbackManager::SetSelfInfo(const V2TIMUserFullInfo &info, V2TIMCallback *callback)
+	{
+		bool bLoggedIn = false;
+		{
+			FScopeLock Lock(&Mutex);
+			bLoggedIn = LoginStatus == V2TIM_STATUS_LOGINED;
+			if (bLoggedIn)
+			{
+				NickName = info.nickName;
+				FaceURL = info.faceURL;
+			}
+		}
+		if (!bLoggedIn)
+		{
+			ReplyError(callback, ERR_SDK_NOT_LOGGED_IN, "not logged in");
+			return;
+		}
+		Reply(callback);
+	}
+
+	void LoopbackManager::GetUserStatus(const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMUserStatusVector> *callback)
+	{
+		V2TIMUserStatusVector Result;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			for (size_t Index = 0; Index < userIDList.Size(); ++Index)
+			{
+				V2TIMUserStatus Status;
+				Status.userID = userIDList[Index];
+				Status.statusType = LoopbackOnlineUsers.Contains(Status.userID) ? V2TIM_USER_STATUS_ONLINE : V2TIM_USER_STATUS_OFFLINE;
+				Result.PushBack(Status);
+			}
+		}
+		Reply(callback, Result);
+	}
+
+	/* 消息 */
+
+	void LoopbackMessageManager::AddAdvancedMsgListener(V2TIMAdvancedMsgListener *listener)
+	{
+		Owner.AddAdvancedMsgListener(listener);
+	}
+
+	void LoopbackMessageManager::RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *listener)
+	{
+		Owner.RemoveAdvancedMsgListener(listener);
+	}
+
+	V2TIMMessage LoopbackMessageManager::CreateEmptyMessage()
+	{
+		return Owner.NewMessage(nullptr);
+	}
+
+	V2TIMMessage LoopbackMessageManager::CreateTextMessage(const V2TIMString &text)
+	{
+		V2TIMTextElem *Elem = new V2TIMTextElem();
+		Elem->text = text;
+		return Owner.NewMessage(Elem);
+	}
+
+	V2TIMMessage LoopbackMessageManager::CreateTextAtMessage(const V2TIMString &text, const V2TIMStringVector &atUserList)
+	{
+		V2TIMMessage Message = CreateTextMessage(text);
+		Message.groupAtUserList = atUserList;
+		return Message;
+	}
+
+	V2TIMMessage LoopbackMessageManager::CreateCustomMessage(const V2TIMBuffer &data)
+	{
+		V2TIMCustomElem *Elem = new V2TIMCustomElem();
+		Elem->data = data;
+		return Owner.NewMessage(Elem);
+	}
+
+	V2TIMMessage LoopbackMessageManager::CreateCustomMessage(const V2TIMBuffer &data, const V2TIMString &description, const V2TIMString &extension)
+	{
+		V2TIMCustomElem *Elem = new V2TIMCustomElem();
+		Elem->data = data;
+		Elem->desc = description;
+		Elem->extension = extension;
+		return Owner.NewMessage(Elem);
+	}
+
+	V2TIMMessage LoopbackMessageManager::CreateForwardMessage(const V2TIMMessage &message)
+	{
+		V2TIMMessage Forward(message);
+		const V2TIMMessage Fresh = CreateEmptyMessage();
+		Forward.msgID = Fresh.msgID;
+		Forward.sender = Fresh.sender;
+		Forward.nickName = Fresh.nickName;
+		Forward.faceURL = Fresh.faceURL;
+		Forward.timestamp = Fresh.timestamp;
+		Forward.status = V2TIM_MSG_STATUS_SENDING;
+		Forward.isSelf = true;
+		return Forward;
+	}
+
+	V2TIMMessage LoopbackMessageManager::CreateAtSignedGroupMessage(const V2TIMMessage &message, const V2TIMStringVector &atUserList)
+	{
+		V2TIMMessage Message(message);
+		Message.groupAtUserList = atUserList;
+		return Message;
+	}
+
+	V2TIMString LoopbackMessageManager::SendMessage(V2TIMMessage &message, const V2TIMString &receiver, const V2TIMString &groupID, V2TIMMessagePriority priority,
+													bool onlineUserOnly, const V2TIMOfflinePushInfo &offlinePushInfo, V2TIMSendCallback *callback)
+	{
+		return Owner.Send(message, receiver, groupID, priority, onlineUserOnly, callback);
+	}
+
+	void LoopbackMessageManager::GetHistoryMessageList(const V2TIMMessageListGetOption &option, V2TIMValueCallback<V2TIMMessageVector> *callback)
+	{
+		const V2TIMString Self = Owner.GetLoginUser();
+		if (Self.Size() == 0)
+		{
+			ReplyError(callback, ERR_SDK_NOT_LOGGED_IN, "not logged in");
+			return;
+		}
+
+		const bool bGroup = option.groupID.Size() > 0;
+		const V2TIMString Key = bGroup ? GroupHistoryKey(option.groupID) : C2CHistoryKey(Self, option.userID);
+		const bool bNewer = option.getType == V2TIM_GET_CLOUD_NEWER_MSG || option.getType == V2TIM_GET_LOCAL_NEWER_MSG;
+		const uint64 Anchor = option.lastMsg ? option.lastMsg->seq : option.lastMsgSeq;
+		const size_t Count = option.count > 0 ? size_t(option.count) : 20;
+
+		V2TIMMessageVector Result;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			if (const TArray<V2TIMMessage> *History = LoopbackHistory.Find(Key))
+			{
+				// 与 SDK 一样，拉取更老的消息时从新到旧返回，拉取更新的消息时从旧到新返回
+				const int32 Num = History->Num();
+				for (int32 Step = 0; Step < Num && Result.Size() < Count; ++Step)
+				{
+					const V2TIMMessage &Message = (*History)[bNewer ? Step : Num - 1 - Step];
+					if (Anchor > 0 && (bNewer ? Message.seq <= Anchor : Message.seq >= Anchor))
+					{
+						continue;
+					}
+					V2TIMMessage Copy(Message);
+					Copy.isSelf = Message.sender == Self;
+					Result.PushBack(Copy);
+				}
+			}
+		}
+		Reply(callback, Result);
+	}
+
+	void LoopbackMessageManager::RevokeMessage(const V2TIMMessage &message, V2TIMCallback *callback)
+	{
+		const V2TIMString Self = Owner.GetLoginUser();
+		if (Self.Size() == 0)
+		{
+			ReplyError(callback, ERR_SDK_NOT_LOGGED_IN, "not logged in");
+			return;
+		}
+
+		const bool bGroup = message.groupID.Size() > 0;
+		const V2TIMString Peer = message.sender == Self ? message.userID : message.sender;
+		TArray<V2TIMString> Recipients;
+		bool bFound = false;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			if (TArray<V2TIMMessage> *History = LoopbackHistory.Find(bGroup ? GroupHistoryKey(message.groupID) : C2CHistoryKey(Self, Peer)))
+			{
+				for (V2TIMMessage &Stored : *History)
+				{
+					if (Stored.msgID == message.msgID)
+					{
+						Stored.status = V2TIM_MSG_STATUS_LOCAL_REVOKED;
+						bFound = true;
+						break;
+					}
+				}
+			}
+			if (bGroup)
+			{
+				if (const LoopbackGroup *Group = LoopbackGroups.Find(message.groupID))
+				{
+					Recipients = Group->Members;
+				}
+			}
+			else
+			{
+				Recipients.Add(Peer);
+			}
+		}
+		if (!bFound)
+		{
+			ReplyError(callback, ERR_INVALID_PARAMETERS, "message not found");
+			return;
+		}
+
+		const double Delay = RollRequestDelay();
+		const V2TIMString MsgID = message.msgID;
+		for (const V2TIMString &Recipient : Recipients)
+		{
+			if (Recipient != Self)
+			{
+				PostToUser(Delay, Recipient, [MsgID](LoopbackManager &Manager) { Manager.DeliverRevoked(MsgID); });
+			}
+		}
+		Reply(callback);
+	}
+
+	void LoopbackMessageManager::MarkC2CMessageAsRead(const V2TIMString &userID, V2TIMCallback *callback)
+	{
+		Owner.MarkRead([&userID](const LoopbackConversation &Conversation) { return Conversation.Type == V2TIM_C2C && Conversation.UserID == userID; }, callback);
+	}
+
+	void LoopbackMessageManager::MarkGroupMessageAsRead(const V2TIMString &groupID, V2TIMCallback *callback)
+	{
+		Owner.MarkRead([&groupID](const LoopbackConversation &Conversation) { return Conversation.Type == V2TIM_GROUP && Conversation.GroupID == groupID; }, callback);
+	}
+
+	void LoopbackMessageManager::MarkAllMessageAsRead(V2TIMCallback *callback)
+	{
+		Owner.MarkRead([](const LoopbackConversation &) { return true; }, callback);
+	}
+
+	void LoopbackMessageManager::DeleteMessages(const V2TIMMessageVector &messages, V2TIMCallback *callback)
+	{
+		const V2TIMString Self = Owner.GetLoginUser();
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			for (size_t Index = 0; Index < messages.Size(); ++Index)
+			{
+				const V2TIMMessage &Message = messages[Index];
+				const V2TIMString Peer = Message.sender == Self ? Message.userID : Message.sender;
+				if (TArray<V2TIMMessage> *History = LoopbackHistory.Find(Message.groupID.Size() > 0 ? GroupHistoryKey(Message.groupID) : C2CHistoryKey(Self, Peer)))
+				{
+					History->RemoveAll([&Message](const V2TIMMessage &Stored) { return Stored.msgID == Message.msgID; });
+				}
+			}
+		}
+		Reply(callback);
+	}
+
+	void LoopbackMessageManager::ClearC2CHistoryMessage(const V2TIMString &userID, V2TIMCallback *callback)
+	{
+		const V2TIMString Self = Owner.GetLoginUser();
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			LoopbackHistory.Remove(C2CHistoryKey(Self, userID));
+		}
+		Reply(callback);
+	}
+
+	void LoopbackMessageManager::ClearGroupHistoryMessage(const V2TIMString &groupID, V2TIMCallback *callback)
+	{
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			LoopbackHistory.Remove(GroupHistoryKey(groupID));
+		}
+		Reply(callback);
+	}
+
+	void LoopbackMessageManager::FindMessages(const V2TIMStringVector &messageIDList, V2TIMValueCallback<V2TIMMessageVector> *callback)
+	{
+		const V2TIMString Self = Owner.GetLoginUser();
+		TSet<V2TIMString> Wanted;
+		for (size_t Index = 0; Index < messageIDList.Size(); ++Index)
+		{
+			Wanted.Add(messageIDList[Index]);
+		}
+
+		V2TIMMessageVector Result;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			for (const TPair<V2TIMString, TArray<V2TIMMessage>> &Pair : LoopbackHistory)
+			{
+				for (const V2TIMMessage &Message : Pair.Value)
+				{
+					if (Wanted.Contains(Message.msgID))
+					{
+						V2TIMMessage Copy(Message);
+						Copy.isSelf = Message.sender == Self;
+						Result.PushBack(Copy);
+					}
+				}
+			}
+		}
+		Reply(callback, Result);
+	}
+
+	/* 群组 */
+
+	V2TIMGroupInfo ToGroupInfo(const V2TIMString &groupID, const LoopbackGroup &group, const V2TIMString &self)
+	{
+		V2TIMGroupInfo Info;
+		Info.groupID = groupID;
+		Info.groupType = group.GroupType;
+		Info.groupName = group.GroupName;
+		Info.owner = group.Owner;
+		Info.createTime = group.CreateTime;
+		Info.memberCount = uint32(group.Members.Num());
+		Info.role = group.Owner == self ? V2TIM_GROUP_MEMBER_ROLE_SUPER : V2TIM_GROUP_MEMBER_ROLE_MEMBER;
+		return Info;
+	}
+
+	void LoopbackGroupManager::CreateGroup(const V2TIMGroupInfo &info, const V2TIMCreateGroupMemberInfoVector &memberList, V2TIMValueCallback<V2TIMString> *callback)
+	{
+		TArray<V2TIMString> Members;
+		Members.Reserve(int32(memberList.Size()));
+		for (size_t Index = 0; Index < memberList.Size(); ++Index)
+		{
+			Members.Add(memberList[Index].userID);
+		}
+		Owner.CreateGroupInternal(info.groupType, info.groupID, info.groupName, Members, callback);
+	}
+
+	void LoopbackGroupManager::GetJoinedGroupList(V2TIMValueCallback<V2TIMGroupInfoVector> *callback)
+	{
+		const V2TIMString Self = Owner.GetLoginUser();
+		V2TIMGroupInfoVector Result;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			for (const TPair<V2TIMString, LoopbackGroup> &Pair : LoopbackGroups)
+			{
+				if (Pair.Value.Members.Contains(Self))
+				{
+					Result.PushBack(ToGroupInfo(Pair.Key, Pair.Value, Self));
+				}
+			}
+		}
+		Reply(callback, Result);
+	}
+
+	void LoopbackGroupManager::GetGroupsInfo(const V2TIMStringVector &groupIDList, V2TIMValueCallback<V2TIMGroupInfoResultVector> *callback)
+	{
+		const V2TIMString Self = Owner.GetLoginUser();
+		V2TIMGroupInfoResultVector Result;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			for (size_t Index = 0; Index < groupIDList.Size(); ++Index)
+			{
+				V2TIMGroupInfoResult Entry;
+				if (const LoopbackGroup *Group = LoopbackGroups.Find(groupIDList[Index]))
+				{
+					Entry.resultCode = 0;
+					Entry.info = ToGroupInfo(groupIDList[Index], *Group, Self);
+				}
+				else
+				{
+					Entry.resultCode = ERR_SVR_GROUP_NOT_FOUND;
+					Entry.resultMsg = V2TIMString("group not found");
+					Entry.info.groupID = groupIDList[Index];
+				}
+				Result.PushBack(Entry);
+			}
+		}
+		Reply(callback, Result);
+	}
+
+	void LoopbackGroupManager::GetGroupOnlineMemberCount(const V2TIMString &groupID, V2TIMValueCallback<uint32_t> *callback)
+	{
+		uint32_t Count = 0;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			const LoopbackGroup *Group = LoopbackGroups.Find(groupID);
+			if (!Group)
+			{
+				ReplyError(callback, ERR_SVR_GROUP_NOT_FOUND, "group not found");
+				return;
+			}
+			for (const V2TIMString &Member : Group->Members)
+			{
+				Count += LoopbackOnlineUsers.Contains(Member) ? 1 : 0;
+			}
+		}
+		Reply(callback, Count);
+	}
+
+	void LoopbackGroupManager::GetGroupMemberList(const V2TIMString &groupID, uint32_t filter, uint64_t nextSeq, V2TIMValueCallback<V2TIMGroupMemberInfoResult> *callback)
+	{
+		V2TIMGroupMemberInfoResult Result;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			const LoopbackGroup *Group = LoopbackGroups.Find(groupID);
+			if (!Group)
+			{
+				ReplyError(callback, ERR_SVR_GROUP_NOT_FOUND, "group not found");
+				return;
+			}
+			// nextSeq 是下一页第一个成员的下标，返回 0 表示已经拉完
+			const uint64 Num = uint64(Group->Members.Num());
+			const uint64 Begin = FMath::Min(nextSeq, Num);
+			const uint64 End = FMath::Min(Begin + LoopbackMemberPageSize, Num);
+			for (uint64 Index = Begin; Index < End; ++Index)
+			{
+				V2TIMGroupMemberFullInfo Info;
+				Info.userID = Group->Members[int32(Index)];
+				Info.role = Info.userID == Group->Owner ? V2TIM_GROUP_MEMBER_ROLE_SUPER : V2TIM_GROUP_MEMBER_ROLE_MEMBER;
+				Result.memberInfoList.PushBack(Info);
+			}
+			Result.nextSequence = End < Num ? End : 0;
+		}
+		Reply(callback, Result);
+	}
+
+	void LoopbackGroupManager::GetGroupMembersInfo(const V2TIMString &groupID, V2TIMStringVector memberList, V2TIMValueCallback<V2TIMGroupMemberFullInfoVector> *callback)
+	{
+		V2TIMGroupMemberFullInfoVector Result;
+		{
+			FScopeLock NetworkLock(&LoopbackMutex);
+			const LoopbackGroup *Group = LoopbackGroups.Find(groupID);
+			if (!Group)
+			{
+				ReplyError(callback, ERR_SVR_GROUP_NOT_FOUND, "group not found");
+				return;
+			}
+			for (size_t Index = 0; Index < memberList.Size(); ++Index)
+			{
+				if (Group->Members.Contains(memberList[Index]))
+				{
+					V2TIMGroupMemberFullInfo Info;
+					Info.userID = memberList[Index];
+					Info.role = Info.userID == Group->Owner ? V2TIM_GROUP_MEMBER_ROLE_SUPER : V2TIM_GROUP_MEMBER_ROLE_MEMBER;
+					Result.PushBack(Info);
+				}
+			}
+		}
+		Reply(callback, Result);
+	}
+
+	/* 会话 */
+
+	void LoopbackConversationManager::AddConversationListener(V2TIMConversationListener *listener)
+	{
+		Owner.AddConversationListener(listener);
+	}
+
+	void LoopbackConversationManager::RemoveConversationListener(V2TIMConversationListener *listener)
+	{
+		Owner.RemoveConversationListener(listener);
+	}
+
+	void LoopbackConversationManager::GetPage(const V2TIMConversationListFilter &filter, uint64_t nextSeq, uint32_t count, V2TIMValueCallback<V2TIMConversationResult> *callback)
+	{
+		TArray<LoopbackConversation> Sorted = Owner.WithConversations([&filter](const TMap<V2TIMString, LoopbackConversation> &Conversations, uint64)
+		{
+			TArray<LoopbackConversation> Matches;
+			for (const TPair<V2TIMString, LoopbackConversation> &Pair : Conversations)
+			{
+				if (MatchesFilter(Pair.Value, filter))
+				{
+					Matches.Add(Pair.Value);
+				}
+			}
+			return Matches;
+		});
+		// 置顶的在前，其余按 orderKey 从新到旧；nextSeq 是下一页的起始下标
+		Algo::Sort(Sorted, [](const LoopbackConversation &A, const LoopbackConversation &B)
+		{
+			return A.bPinned != B.bPinned ? A.bPinned : A.OrderKey > B.OrderKey;
+		});
+
+		const uint64 Num = uint64(Sorted.Num());
+		const uint64 Begin = FMath::Min(nextSeq, Num);
+		const uint64 End = FMath::Min(Begin + uint64(count), Num);
+		V2TIMConversationResult Result;
+		for (uint64 Index = Begin; Index < End; ++Index)
+		{
+			Result.conversationList.PushBack(Sorted[int32(Index)].ToV2TIM());
+		}
+		Result.nextSeq = End;
+		Result.isFinished = End >= Num;
+		Reply(callback, Result);
+	}
+
+	void LoopbackConversationManager::GetConversationList(uint64_t nextSeq, uint32_t count, V2TIMValueCallback<V2TIMConversationResult> *callback)
+	{
+		GetPage(V2TIMConversationListFilter(), nextSeq, count, callback);
+	}
+
+	void LoopbackConversationManager::GetConversationListByFilter(const V2TIMConversationListFilter &filter, uint64_t nextSeq, uint32_t count, V2TIMValueCallback<V2TIMConversationResult> *callback)
+	{
+		GetPage(filter, nextSeq, count, callback);
+	}
+
+	void LoopbackConversationManager::GetConversation(const V2TIMString &conversationID, V2TIMValueCallback<V2TIMConversation> *callback)
+	{
+		TOptional<V2TIMConversation> Found = Owner.WithConversations([&conversationID](const TMap<V2TIMString, LoopbackConversation> &Conversations, uint64)
+		{
+			const LoopbackConversation *Conversation = Conversations.Find(conversationID);
+			return Conversation ? TOptional<V2TIMConversation>(Conversation->ToV2TIM()) : TOptional<V2TIMConversation>();
+		});
+		if (Found.IsSet())
+		{
+			Reply(callback, Found.GetValue());
+		}
+		else
+		{
+			ReplyError(callback, ERR_INVALID_CONVERSATION, "conversation not found");
+		}
+	}
+
+	void LoopbackConversationManager::GetConversationList(const V2TIMStringVector &conversationIDList, V2TIMValueCallback<V2TIMConversationVector> *callback)
+	{
+		V2TIMConversationVector Result = Owner.WithConversations([&conversationIDList](const TMap<V2TIMString, LoopbackConversation> &Conversations, uint64)
+		{
+			V2TIMConversationVector Matches;
+			for (size_t Index = 0; Index < conversationIDList.Size(); ++Index)
+			{
+				if (const LoopbackConversation *Conversation = Conversations.Find(conversationIDList[Index]))
+				{
+					Matches.PushBack(Conversation->ToV2TIM());
+				}
+			}
+			return Matches;
+		});
+		Reply(callback, Result);
+	}
+
+	void LoopbackConversationManager::DeleteConversation(const V2TIMString &conversationID, V2TIMCallback *callback)
+	{
+		const TOptional<uint64> Total = Owner.WithConversations([&conversationID](TMap<V2TIMString, LoopbackConversation> &Conversations, uint64 &TotalUnread)
+		{
+			LoopbackConversation Removed;
+			if (!Conversations.RemoveAndCopyValue(conversationID, Removed) || Removed.UnreadCount == 0)
+			{
+				return TOptional<uint64>();
+			}
+			TotalUnread -= FMath::Min<uint64>(TotalUnread, uint64(Removed.UnreadCount));
+			return TOptional<uint64>(TotalUnread);
+		});
+		Owner.PostConversationsChanged(V2TIMConversationVector(), Total.IsSet(), Total.Get(0), callback);
+	}
+
+	void LoopbackConversationManager::SetConversationDraft(const V2TIMString &conversationID, const V2TIMString &draftText, V2TIMCallback *callback)
+	{
+		V2TIMConversationVector Changed = Owner.WithConversations([&conversationID, &draftText](TMap<V2TIMString, LoopbackConversation> &Conversations, uint64)
+		{
+			V2TIMConversationVector Result;
+			if (LoopbackConversation *Conversation = Conversations.Find(conversationID))
+			{
+				Conversation->DraftText = draftText;
+				Conversation->DraftTimestamp = draftText.Size() > 0 ? uint64(LoopbackNow()) : 0;
+				Result.PushBack(Conversation->ToV2TIM());
+			}
+			return Result;
+		});
+		if (Changed.Size() == 0)
+		{
+			ReplyError(callback, ERR_INVALID_CONVERSATION, "conversation not found");
+			return;
+		}
+		Owner.PostConversationsChanged(Changed, false, 0, callback);
+	}
+
+	void LoopbackConversationManager::PinConversation(const V2TIMString &conversationID, bool isPinned, V2TIMCallback *callback)
+	{
+		V2TIMConversationVector Changed = Owner.WithConversations([&conversationID, isPinned](TMap<V2TIMString, LoopbackConversation> &Conversations, uint64)
+		{
+			V2TIMConversationVector Result;
+			if (LoopbackConversation *Conversation = Conversations.Find(conversationID))
+			{
+				Conversation->bPinned = isPinned;
+				Result.PushBack(Conversation->ToV2TIM());
+			}
+			return Result;
+		});
+		if (Changed.Size() == 0)
+		{
+			ReplyError(callback, ERR_INVALID_CONVERSATION, "conversation not found");
+			return;
+		}
+		Owner.PostConversationsChanged(Changed, false, 0, callback);
+	}
+
+	void LoopbackConversationManager::GetTotalUnreadMessageCount(V2TIMValueCallback<uint64_t> *callback)
+	{
+		const uint64_t Total = Owner.WithConversations([](const TMap<V2TIMString, LoopbackConversation> &, uint64 TotalUnread) { return uint64_t(TotalUnread); });
+		Reply(callback, Total);
+	}
+
+	void LoopbackConversationManager::GetUnreadMessageCountByFilter(const V2TIMConversationListFilter &filter, V2TIMValueCallback<uint64_t> *callback)
+	{
+		const uint64_t Total = Owner.WithConversations([&filter](const TMap<V2TIMString, LoopbackConversation> &Conversations, uint64)
+		{
+			uint64_t Sum = 0;
+			for (const TPair<V2TIMString, LoopbackConversation> &Pair : Conversations)
+			{
+				if (MatchesFilter(Pair.Value, filter))
+				{
+					Sum += uint64_t(Pair.Value.UnreadCount);
+				}
+			}
+			return Sum;
+		});
+		Reply(callback, Total);
+	}
+
+#if PLATFORM_ANDROID
+	void LoopbackConversationManager::CleanConversationUnreadMessageCount(const V2TIMString &conversationID, uint64_t cleanTimestamp, uint64_t cleanSequence, V2TIMCallback *callback)
+	{
+		Owner.MarkRead([&conversationID](const LoopbackConversation &Conversation) { return Conversation.ConversationID == conversationID; }, callback);
+	}
+#endif
+
+	/* 关系链、信令 */
+
+	void LoopbackFriendshipManager::AddFriendListener(V2TIMFriendshipListener *listener)
+	{
+		Owner.AddFriendshipListener(listener);
+	}
+
+	void LoopbackFriendshipManager::RemoveFriendListener(V2TIMFriendshipListener *listener)
+	{
+		Owner.RemoveFriendshipListener(listener);
+	}
+
+	void LoopbackSignalingManager::AddSignalingListener(V2TIMSignalingListener *listener)
+	{
+		Owner.AddSignalingListener(listener);
+	}
+
+	void LoopbackSignalingManager::RemoveSignalingListener(V2TIMSignalingListener *listener)
+	{
+		Owner.RemoveSignalingListener(listener);
+	}
+
+	// 持有 LoopbackMutex 时调用
+	LoopbackManager *CreateLoopbackManager()
+	{
+		if (!LoopbackNetworkInstance)
+		{
+			LoopbackRandom.Initialize(CVarLoopbackSeed.GetValueOnAnyThread());
+			LoopbackNetworkInstance = MakeUnique<LoopbackNetwork>();
+		}
+		LoopbackManagerPtr Manager = MakeShared<LoopbackManager, ESPMode::ThreadSafe>();
+		LoopbackManagers.Add(Manager);
+		return Manager.Get();
+	}
+}
+
+V2TIMManager *TencentCloudChatLoopback::CreateManager()
+{
+	FScopeLock Lock(&LoopbackMutex);
+	return CreateLoopbackManager();
+}
+
+void TencentCloudChatLoopback::DestroyManager(V2TIMManager *manager)
+{
+	if (!manager)
+	{
+		return;
+	}
+	// 不能在锁内释放：尚未执行的回调也持有实例，最后一个引用释放时才析构
+	LoopbackManagerPtr Released;
+	{
+		FScopeLock Lock(&LoopbackMutex);
+		const int32 Index = LoopbackManagers.IndexOfByPredicate([manager](const LoopbackManagerPtr &Manager) { return Manager.Get() == manager; });
+		if (Index == INDEX_NONE)
+		{
+			return;
+		}
+		Released = LoopbackManagers[Index];
+		LoopbackManagers.RemoveAtSwap(Index);
+		if (LoopbackDefaultManager == Released.Get())
+		{
+			LoopbackDefaultManager = nullptr;
+		}
+	}
+	Released->UnInitSDK();
+}
+
+V2TIMManager *TencentCloudChatLoopback::GetDefaultManager()
+{
+	FScopeLock Lock(&LoopbackMutex);
+	if (!LoopbackDefaultManager)
+	{
+		LoopbackDefaultManager = CreateLoopbackManager();
+	}
+	return LoopbackDefaultManager;
+}
+
+bool TencentCloudChatLoopback::Flush(double timeoutSeconds)
+{
+	const double Deadline = FPlatformTime::Seconds() + timeoutSeconds;
+	while (GetPendingEvents() > 0)
+	{
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			return false;
+		}
+		FPlatformProcess::SleepNoStats(0.001f);
+	}
+	return true;
+}
+
+bool TencentCloudChatLoopback::IsLoopback(V2TIMManager *manager)
+{
+	FScopeLock Lock(&LoopbackMutex);
+	return manager && LoopbackManagers.ContainsByPredicate([manager](const LoopbackManagerPtr &Manager) { return Manager.Get() == manager; });
+}
+
+bool TencentCloudChatLoopback::PostEvent(V2TIMManager *manager, TUniqueFunction<void(const TencentCloudChatLoopbackListeners &)> &&event)
+{
+	FScopeLock Lock(&LoopbackMutex);
+	const LoopbackManagerPtr *Found = LoopbackManagers.FindByPredicate([manager](const LoopbackManagerPtr &Manager) { return Manager.Get() == manager; });
+	if (!Found || !LoopbackNetworkInstance)
+	{
+		return false;
+	}
+	LoopbackNetworkInstance->Post(0.0, [Manager = *Found, Event = MoveTemp(event)]()
+	{
+		TencentCloudChatLoopbackListeners Listeners;
+		Manager->GetListeners(Listeners);
+		Event(Listeners);
+	});
+	return true;
+}
+
+int32 TencentCloudChatLoopback::GetPendingEvents()
+{
+	FScopeLock Lock(&LoopbackMutex);
+	return LoopbackNetworkInstance ? LoopbackNetworkInstance->GetPending() : 0;
+}
+
+void TencentCloudChatLoopback::Reset()
+{
+	FScopeLock Lock(&LoopbackMutex);
+	LoopbackGroups.Reset();
+	LoopbackHistory.Reset();
+	LoopbackRandom.Initialize(CVarLoopbackSeed.GetValueOnAnyThread());
+	LoopbackNextSeq = 1;
+	LoopbackNextGroupID = 1;
+}
+
+void TencentCloudChatLoopback::Startup()
+{
+	if (CVarLoopbackEnabled.GetValueOnGameThread() || FParse::Param(FCommandLine::Get(), TEXT("TencentCloudChatLoopback")))
+	{
+		TencentCloudChatBackend::Set(GetDefaultManager());
+		UE_LOG(LogTencentCloudChat, Display, TEXT("TencentCloudChat is using the in-process loopback backend"));
+	}
+}
+
+void TencentCloudChatLoopback::Shutdown()
+{
+	{
+		FScopeLock Lock(&LoopbackMutex);
+		if (LoopbackDefaultManager && TencentCloudChatBackend::Get() == LoopbackDefaultManager)
+		{
+			TencentCloudChatBackend::Set(nullptr);
+		}
+	}
+
+	// 先停止线程，未执行的回调随网络一起释放，其中持有的实例引用也在这里释放
+	TUniquePtr<LoopbackNetwork> Network;
+	{
+		FScopeLock Lock(&LoopbackMutex);
+		Network = MoveTemp(LoopbackNetworkInstance);
+	}
+	Network.Reset();
+
+	TArray<LoopbackManagerPtr> Managers;
+	TMap<V2TIMString, LoopbackManagerPtr> OnlineUsers;
+	{
+		FScopeLock Lock(&LoopbackMutex);
+		Managers = MoveTemp(LoopbackManagers);
+		OnlineUsers = MoveTemp(LoopbackOnlineUsers);
+		LoopbackDefaultManager = nullptr;
+		LoopbackGroups.Reset();
+		LoopbackHistory.Reset();
+	}
+}
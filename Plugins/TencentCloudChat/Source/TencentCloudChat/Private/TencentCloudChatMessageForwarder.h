@@ -0,0 +1,176 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/UniquePtr.h"
+
+#include "V2TIMListener.h"
+#include "V2TIMMessage.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatDispatcher.h"
+
+/**
+ * 自定义消息内容的改写工具，供合并发送、压缩等收消息时需要还原内容的功能使用
+ */
+class TencentCloudChatCustomPayload
+{
+public:
+	/**
+	 * message 只包含一个自定义元素时返回它，否则返回 nullptr
+	 */
+	static const V2TIMCustomElem *GetSingleCustomElem(const V2TIMMessage &message)
+	{
+		if (message.elemList.Size() != 1 || !message.elemList[0] || message.elemList[0]->elemType != V2TIM_ELEM_TYPE_CUSTOM)
+		{
+			return nullptr;
+		}
+		return static_cast<const V2TIMCustomElem *>(message.elemList[0]);
+	}
+
+	static TConstArrayView<uint8> GetData(const V2TIMCustomElem &elem)
+	{
+		return TConstArrayView<uint8>(elem.data.Data(), static_cast<int32>(elem.data.Size()));
+	}
+
+	/**
+	 * 以 data 为内容重新创建一条自定义消息，除 elemList 外的字段都从 source 拷贝
+	 *
+	 * 在收消息的路径上调用，直接通过后端创建，不经过 TencentCloudChat::CreateCustomMessage，不计入 API 统计和消息生命周期跟踪
+	 */
+	static V2TIMMessage Rebuild(const V2TIMMessage &source, const V2TIMCustomElem &sourceElem, TConstArrayView<uint8> data)
+	{
+		V2TIMMessage Out = TencentCloudChatBackend::Get()->GetMessageManager()->CreateCustomMessage(
+			V2TIMBuffer(data.GetData(), data.Num()), sourceElem.desc, sourceElem.extension);
+		Out.msgID = source.msgID;
+		Out.timestamp = source.timestamp;
+		Out.sender = source.sender;
+		Out.nickName = source.nickName;
+		Out.friendRemark = source.friendRemark;
+		Out.nameCard = source.nameCard;
+		Out.faceURL = source.faceURL;
+		Out.groupID = source.groupID;
+		Out.userID = source.userID;
+		Out.seq = source.seq;
+		Out.random = source.random;
+		Out.status = source.status;
+		Out.supportMessageExtension = source.supportMessageExtension;
+		Out.isSelf = source.isSelf;
+		Out.needReadReceipt = source.needReadReceipt;
+		Out.isBroadcastMessage = source.isBroadcastMessage;
+		Out.priority = source.priority;
+		Out.groupAtUserList = source.groupAtUserList;
+		Out.localCustomData = source.localCustomData;
+		Out.localCustomInt = source.localCustomInt;
+		Out.cloudCustomData = source.cloudCustomData;
+		Out.isExcludedFromUnreadCount = source.isExcludedFromUnreadCount;
+		Out.isExcludedFromLastMessage = source.isExcludedFromLastMessage;
+		Out.offlinePushInfo = source.offlinePushInfo;
+		Out.isRead = source.isRead;
+		Out.isPeerRead = source.isPeerRead;
+		return Out;
+	}
+};
+
+/**
+ * 高级消息监听器的转发基类，所有事件原样转发给 Target，子类只需重写需要改写的事件；重写的事件同样要用 EventScope 计数
+ */
+class TencentCloudChatAdvancedMsgForwarder : public V2TIMAdvancedMsgListener, public TencentCloudChatRetirable
+{
+public:
+	explicit TencentCloudChatAdvancedMsgForwarder(V2TIMAdvancedMsgListener *target)
+		: Target(target)
+	{
+	}
+
+	void OnRecvNewMessage(const V2TIMMessage &message) override
+	{
+		EventScope Scope(*this);
+		Target->OnRecvNewMessage(message);
+	}
+	void OnRecvC2CReadReceipt(const V2TIMMessageReceiptVector &receiptList) override
+	{
+		EventScope Scope(*this);
+		Target->OnRecvC2CReadReceipt(receiptList);
+	}
+	void OnRecvMessageReadReceipts(const V2TIMMessageReceiptVector &receiptList) override
+	{
+		EventScope Scope(*this);
+		Target->OnRecvMessageReadReceipts(receiptList);
+	}
+	void OnRecvMessageRevoked(const V2TIMString &messageID) override
+	{
+		EventScope Scope(*this);
+		Target->OnRecvMessageRevoked(messageID);
+	}
+	void OnRecvMessageModified(const V2TIMMessage &message) override
+	{
+		EventScope Scope(*this);
+		Target->OnRecvMessageModified(message);
+	}
+	void OnRecvMessageExtensionsChanged(const V2TIMString &msgID,
+										const V2TIMMessageExtensionVector &extensions) override
+	{
+		EventScope Scope(*this);
+		Target->OnRecvMessageExtensionsChanged(msgID, extensions);
+	}
+	void OnRecvMessageExtensionsDeleted(const V2TIMString &msgID,
+										const V2TIMStringVector &extensionKeys) override
+	{
+		EventScope Scope(*this);
+		Target->OnRecvMessageExtensionsDeleted(msgID, extensionKeys);
+	}
+
+protected:
+	V2TIMAdvancedMsgListener *Target;
+};
+
+/**
+ * 为每个业务监听器创建一个 ForwarderType 并注册到 SDK；注销后交给 TencentCloudChatDispatcher::Retire 延迟释放
+ */
+template <class ForwarderType>
+class TencentCloudChatAdvancedMsgForwarderRegistry
+{
+public:
+	static void Add(V2TIMAdvancedMsgListener *listener)
+	{
+		if (!listener)
+		{
+			return;
+		}
+
+		ForwarderType *Forwarder = nullptr;
+		{
+			FScopeLock Lock(&Mutex);
+			TUniquePtr<ForwarderType> &Entry = Forwarders.FindOrAdd(listener);
+			if (Entry)
+			{
+				return;
+			}
+			Entry = MakeUnique<ForwarderType>(listener);
+			Forwarder = Entry.Get();
+		}
+		TencentCloudChat::AddAdvancedMsgListener(Forwarder);
+	}
+
+	static void Remove(V2TIMAdvancedMsgListener *listener)
+	{
+		TUniquePtr<ForwarderType> Forwarder;
+		{
+			FScopeLock Lock(&Mutex);
+			if (!Forwarders.RemoveAndCopyValue(listener, Forwarder))
+			{
+				return;
+			}
+		}
+		TencentCloudChat::RemoveAdvancedMsgListener(Forwarder.Get());
+		TencentCloudChatDispatcher::Retire(MoveTemp(Forwarder));
+	}
+
+private:
+	static inline FCriticalSection Mutex;
+	static inline TMap<V2TIMAdvancedMsgListener *, TUniquePtr<ForwarderType>> Forwarders;
+};
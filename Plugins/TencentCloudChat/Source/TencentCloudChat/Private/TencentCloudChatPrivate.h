@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include "TencentCloudChatLatency.h"
+#include "TencentCloudChatStats.h"
+#include "TencentCloudChatTrace.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogTencentCloudChat, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("TencentCloudChat"), STATGROUP_TencentCloudChat, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_EXTERN(TencentCloudChat);
+
+// 最近一次 InitSDK 的耗时（毫秒），用于跟踪启动耗时的回归
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("InitSDK Time (ms)"), STAT_TencentCloudChat_InitSDKTimeMs, STATGROUP_TencentCloudChat, );
+
+/**
+ * 放在 TencentCloudChat 每个接口的开头：stat TencentCloudChat 中的 "API <Name>" cycle counter、CSV 中同名的计时、
+ * TencentCloudChatChannel 上的 "TencentCloudChat::<Name>" CPU scope，并标记当前接口，
+ * 接口内传给 SDK 的回调的响应延迟记录到 TencentCloudChatLatency 中这个接口的直方图
+ */
+#if TENCENTCLOUDCHAT_WITH_STATS
+#define TENCENTCLOUDCHAT_PRIVATE_SCOPE_API_LATENCY(Name) \
+	static const int32 TencentCloudChatApiId = TencentCloudChatLatency::RegisterApi(TEXT(#Name)); \
+	TencentCloudChatApiScope TencentCloudChatApiScopeInstance(TencentCloudChatApiId)
+#else
+#define TENCENTCLOUDCHAT_PRIVATE_SCOPE_API_LATENCY(Name)
+#endif
+
+#define TENCENTCLOUDCHAT_SCOPE_API(Name) \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("API " #Name), STAT_TencentCloudChat_API_##Name, STATGROUP_TencentCloudChat); \
+	CSV_SCOPED_TIMING_STAT(TencentCloudChat, Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("TencentCloudChat::" #Name, TencentCloudChatChannel); \
+	TENCENTCLOUDCHAT_PRIVATE_SCOPE_API_LATENCY(Name)
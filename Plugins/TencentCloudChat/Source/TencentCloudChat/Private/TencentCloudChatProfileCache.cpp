@@ -0,0 +1,362 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatProfileCache.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatString.h"
+#include "Containers/LruCache.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Profile Cache Hits"), STAT_TencentCloudChat_ProfileCacheHits, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Profile Cache Misses"), STAT_TencentCloudChat_ProfileCacheMisses, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Profile Requests"), STAT_TencentCloudChat_ProfileRequests, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<int32> CVarProfileCacheCapacity(
+	TEXT("TencentCloudChat.ProfileCache.Capacity"),
+	2048,
+	TEXT("Maximum number of user profiles kept by TencentCloudChatProfileCache. Applied on first use and on InvalidateAll."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarProfileCacheTTLSeconds(
+	TEXT("TencentCloudChat.ProfileCache.TTLSeconds"),
+	300.0f,
+	TEXT("Seconds a cached user profile stays valid."),
+	ECVF_Default);
+
+namespace
+{
+	struct CachedProfile
+	{
+		V2TIMUserFullInfo Info;
+		double ExpireTime = 0.0;
+	};
+
+	/**
+	 * 一次 GetUsersInfo 调用，等待其中所有未命中的用户返回
+	 */
+	struct ProfileRequest
+	{
+		TArray<V2TIMString> UserIDs;
+		TMap<V2TIMString, V2TIMUserFullInfo> Results;
+		int32 Remaining = 0;
+		bool bFailed = false;
+		int ErrorCode = 0;
+		V2TIMString ErrorMessage;
+		V2TIMValueCallback<V2TIMUserFullInfoVector> *Callback = nullptr;
+	};
+	using ProfileRequestRef = TSharedRef<ProfileRequest, ESPMode::ThreadSafe>;
+
+	FCriticalSection ProfileMutex;
+	TLruCache<V2TIMString, CachedProfile> ProfileEntries;
+	bool bProfileConfigured = false;
+	// 正在拉取的用户，以及等待其结果的请求
+	TMap<V2TIMString, TArray<ProfileRequestRef>> ProfileInFlight;
+	TencentCloudChatProfileCacheStats ProfileStats;
+	bool bProfileListenersAdded = false;
+	// Reset 前发出的请求返回的资料属于上一个账号，不再写入缓存
+	uint32 ProfileGeneration = 0;
+
+	/**
+	 * 在持有 ProfileMutex 时调用
+	 */
+	void ConfigureProfileCache()
+	{
+		ProfileEntries.Empty(FMath::Max(CVarProfileCacheCapacity.GetValueOnAnyThread(), 1));
+		bProfileConfigured = true;
+	}
+
+	void CacheProfile(const V2TIMUserFullInfo &info, double now)
+	{
+		if (!bProfileConfigured)
+		{
+			ConfigureProfileCache();
+		}
+		ProfileEntries.Add(info.userID, CachedProfile{ info, now + CVarProfileCacheTTLSeconds.GetValueOnAnyThread() });
+	}
+
+	void CompleteRequest(const ProfileRequest &request)
+	{
+		if (!request.Callback)
+		{
+			return;
+		}
+		if (request.bFailed)
+		{
+			request.Callback->OnError(request.ErrorCode, request.ErrorMessage);
+			return;
+		}
+
+		V2TIMUserFullInfoVector Infos;
+		for (const V2TIMString &UserID : request.UserIDs)
+		{
+			if (const V2TIMUserFullInfo *Info = request.Results.Find(UserID))
+			{
+				Infos.PushBack(*Info);
+			}
+		}
+		request.Callback->OnSuccess(Infos);
+	}
+
+	void ResolveChunk(uint32 generation, const TArray<V2TIMString> &chunk, const V2TIMUserFullInfoVector *infos, int errorCode, const V2TIMString &errorMessage)
+	{
+		TArray<ProfileRequestRef> Completed;
+		{
+			FScopeLock Lock(&ProfileMutex);
+			TMap<V2TIMString, const V2TIMUserFullInfo *> Found;
+			if (infos)
+			{
+				const double Now = FPlatformTime::Seconds();
+				Found.Reserve(int32(infos->Size()));
+				for (size_t Index = 0; Index < infos->Size(); ++Index)
+				{
+					const V2TIMUserFullInfo &Info = (*infos)[Index];
+					if (generation == ProfileGeneration)
+					{
+						CacheProfile(Info, Now);
+					}
+					Found.Add(Info.userID, &Info);
+				}
+			}
+
+			for (const V2TIMString &UserID : chunk)
+			{
+				TArray<ProfileRequestRef> Waiters;
+				ProfileInFlight.RemoveAndCopyValue(UserID, Waiters);
+				const V2TIMUserFullInfo *const *Info = Found.Find(UserID);
+				for (const ProfileRequestRef &Waiter : Waiters)
+				{
+					if (!infos && !Waiter->bFailed)
+					{
+						Waiter->bFailed = true;
+						Waiter->ErrorCode = errorCode;
+						Waiter->ErrorMessage = errorMessage;
+					}
+					else if (Info)
+					{
+						Waiter->Results.Add(UserID, **Info);
+					}
+					if (--Waiter->Remaining == 0)
+					{
+						Completed.Add(Waiter);
+					}
+				}
+			}
+		}
+
+		for (const ProfileRequestRef &Request : Completed)
+		{
+			CompleteRequest(*Request);
+		}
+	}
+
+	void FetchChunk(uint32 generation, TArray<V2TIMString> &&chunk)
+	{
+		V2TIMStringVector UserIDList;
+		for (const V2TIMString &UserID : chunk)
+		{
+			UserIDList.PushBack(UserID);
+		}
+
+		INC_DWORD_STAT(STAT_TencentCloudChat_ProfileRequests);
+		TencentCloudChat::GetUsersInfo(UserIDList, TencentCloudChatValueCallback<V2TIMUserFullInfoVector>::Create(
+			[generation, chunk](const V2TIMUserFullInfoVector &infos)
+			{
+				ResolveChunk(generation, chunk, &infos, 0, V2TIMString());
+			},
+			[generation, chunk](int error_code, const V2TIMString &error_message)
+			{
+				ResolveChunk(generation, chunk, nullptr, error_code, error_message);
+			}));
+	}
+
+	class ProfileSDKListener : public V2TIMSDKListener
+	{
+	public:
+		void OnSelfInfoUpdated(const V2TIMUserFullInfo &info) override
+		{
+			FScopeLock Lock(&ProfileMutex);
+			CacheProfile(info, FPlatformTime::Seconds());
+		}
+	};
+	ProfileSDKListener ProfileSDKListenerInstance;
+
+	class ProfileFriendListener : public V2TIMFriendshipListener
+	{
+	public:
+		void OnFriendInfoChanged(const V2TIMFriendInfoVector &infoList) override
+		{
+			for (size_t Index = 0; Index < infoList.Size(); ++Index)
+			{
+				TencentCloudChatProfileCache::Invalidate(infoList[Index].userID);
+			}
+		}
+	};
+	ProfileFriendListener ProfileFriendListenerInstance;
+
+	void GetProfiles(TArray<V2TIMString> &&userIDs, V2TIMValueCallback<V2TIMUserFullInfoVector> *callback)
+	{
+		ProfileRequestRef Request = MakeShared<ProfileRequest, ESPMode::ThreadSafe>();
+		Request->UserIDs = MoveTemp(userIDs);
+		Request->Callback = callback;
+
+		TArray<V2TIMString> ToFetch;
+		bool bAddListeners;
+		bool bAllCached;
+		uint32 Generation;
+		{
+			FScopeLock Lock(&ProfileMutex);
+			if (!bProfileConfigured)
+			{
+				ConfigureProfileCache();
+			}
+			bAddListeners = !bProfileListenersAdded;
+			bProfileListenersAdded = true;
+			Generation = ProfileGeneration;
+
+			const double Now = FPlatformTime::Seconds();
+			TSet<V2TIMString> Seen;
+			Seen.Reserve(Request->UserIDs.Num());
+			for (const V2TIMString &UserID : Request->UserIDs)
+			{
+				bool bAlreadySeen;
+				Seen.Add(UserID, &bAlreadySeen);
+				if (bAlreadySeen)
+				{
+					continue;
+				}
+
+				if (const CachedProfile *Cached = ProfileEntries.FindAndTouch(UserID))
+				{
+					if (Cached->ExpireTime > Now)
+					{
+						Request->Results.Add(UserID, Cached->Info);
+						++ProfileStats.Hits;
+						INC_DWORD_STAT(STAT_TencentCloudChat_ProfileCacheHits);
+						continue;
+					}
+					ProfileEntries.Remove(UserID);
+				}
+
+				++Request->Remaining;
+				if (TArray<ProfileRequestRef> *Waiters = ProfileInFlight.Find(UserID))
+				{
+					Waiters->Add(Request);
+					++ProfileStats.Coalesced;
+				}
+				else
+				{
+					ProfileInFlight.Add(UserID).Add(Request);
+					ToFetch.Add(UserID);
+					++ProfileStats.Misses;
+					INC_DWORD_STAT(STAT_TencentCloudChat_ProfileCacheMisses);
+				}
+			}
+			// 其他请求可能在锁外完成本请求等待的用户，只能在这里判断
+			bAllCached = Request->Remaining == 0;
+			ProfileStats.Chunks += (ToFetch.Num() + TencentCloudChatProfileCache::MaxUsersPerRequest - 1) / TencentCloudChatProfileCache::MaxUsersPerRequest;
+		}
+
+		if (bAddListeners)
+		{
+			TencentCloudChat::AddSDKListener(&ProfileSDKListenerInstance);
+			TencentCloudChat::AddFriendListener(&ProfileFriendListenerInstance);
+		}
+
+		if (bAllCached)
+		{
+			CompleteRequest(*Request);
+			return;
+		}
+
+		// 分块同时发出
+		for (int32 Start = 0; Start < ToFetch.Num(); Start += TencentCloudChatProfileCache::MaxUsersPerRequest)
+		{
+			const int32 Count = FMath::Min(TencentCloudChatProfileCache::MaxUsersPerRequest, ToFetch.Num() - Start);
+			FetchChunk(Generation, TArray<V2TIMString>(ToFetch.GetData() + Start, Count));
+		}
+	}
+}
+
+void TencentCloudChatProfileCache::GetUsersInfo(const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMUserFullInfoVector> *callback)
+{
+	TArray<V2TIMString> UserIDs;
+	UserIDs.Reserve(int32(userIDList.Size()));
+	for (size_t Index = 0; Index < userIDList.Size(); ++Index)
+	{
+		UserIDs.Add(userIDList[Index]);
+	}
+	GetProfiles(MoveTemp(UserIDs), callback);
+}
+
+void TencentCloudChatProfileCache::GetUsersInfo(TConstArrayView<FString> userIDList, V2TIMValueCallback<V2TIMUserFullInfoVector> *callback)
+{
+	TArray<V2TIMString> UserIDs;
+	UserIDs.Reserve(userIDList.Num());
+	for (const FString &UserID : userIDList)
+	{
+		UserIDs.Add(TencentCloudChatString::ToV2TIM(UserID));
+	}
+	GetProfiles(MoveTemp(UserIDs), callback);
+}
+
+bool TencentCloudChatProfileCache::FindCached(const V2TIMString &userID, V2TIMUserFullInfo &outInfo)
+{
+	FScopeLock Lock(&ProfileMutex);
+	const CachedProfile *Cached = bProfileConfigured ? ProfileEntries.FindAndTouch(userID) : nullptr;
+	if (!Cached || Cached->ExpireTime <= FPlatformTime::Seconds())
+	{
+		return false;
+	}
+	outInfo = Cached->Info;
+	return true;
+}
+
+void TencentCloudChatProfileCache::Invalidate(const V2TIMString &userID)
+{
+	FScopeLock Lock(&ProfileMutex);
+	if (bProfileConfigured)
+	{
+		ProfileEntries.Remove(userID);
+	}
+}
+
+void TencentCloudChatProfileCache::InvalidateAll()
+{
+	FScopeLock Lock(&ProfileMutex);
+	ConfigureProfileCache();
+}
+
+void TencentCloudChatProfileCache::Reset()
+{
+	FScopeLock Lock(&ProfileMutex);
+	ConfigureProfileCache();
+	++ProfileGeneration;
+}
+
+TencentCloudChatProfileCacheStats TencentCloudChatProfileCache::GetStats()
+{
+	FScopeLock Lock(&ProfileMutex);
+	TencentCloudChatProfileCacheStats Stats = ProfileStats;
+	Stats.Entries = ProfileEntries.Num();
+	return Stats;
+}
+
+void TencentCloudChatProfileCache::Shutdown()
+{
+	bool bRemoveListeners;
+	{
+		FScopeLock Lock(&ProfileMutex);
+		bRemoveListeners = bProfileListenersAdded;
+		bProfileListenersAdded = false;
+		ProfileEntries.Empty();
+		bProfileConfigured = false;
+		ProfileStats = TencentCloudChatProfileCacheStats();
+	}
+	if (bRemoveListeners)
+	{
+		TencentCloudChat::RemoveSDKListener(&ProfileSDKListenerInstance);
+		TencentCloudChat::RemoveFriendListener(&ProfileFriendListenerInstance);
+	}
+}
@@ -0,0 +1,252 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatRouter.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatBatcher.h"
+#include "TencentCloudChatCompression.h"
+#include "TencentCloudChatMessageForwarder.h"
+#include "TencentCloudChatPrivate.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_CYCLE_STAT(TEXT("Router Dispatch"), STAT_TencentCloudChat_RouterDispatch, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Router Messages"), STAT_TencentCloudChat_RouterMessages, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<bool> CVarRouterDedup(
+	TEXT("TencentCloudChat.Router.Dedup"),
+	true,
+	TEXT("Drop messages TencentCloudChatRouter has already routed, e.g. when routing history pages after a reconnect."),
+	ECVF_Default);
+
+namespace
+{
+	using RouteHandler = FTencentCloudChatRouteDelegate::FDelegate;
+
+	/**
+	 * 不直接使用多播委托：委托本身不是线程安全的，路由时需要在锁内拷贝处理函数列表
+	 */
+	struct RouteEntry
+	{
+		TArray<RouteHandler, TInlineAllocator<2>> Handlers;
+		TencentCloudChatRouteStats Stats;
+	};
+
+	// tag 0 为兜底处理函数；路由结束后更新统计时 RouteEntry 可能已经被 Shutdown 移除，RouteEntry 单独分配
+	FCriticalSection RouterMutex;
+	TMap<uint32, TSharedRef<RouteEntry>> RouterEntries;
+	bool bRouterListenerAdded = false;
+
+	class RouterListener : public V2TIMAdvancedMsgListener
+	{
+	public:
+		void OnRecvNewMessage(const V2TIMMessage &message) override
+		{
+			TencentCloudChatRouter::Route(message);
+		}
+	};
+	RouterListener RouterListenerInstance;
+
+	/**
+	 * 在持有 RouterMutex 时调用
+	 */
+	FDelegateHandle AddRoute(uint32 tag, RouteHandler &&handler)
+	{
+		TSharedRef<RouteEntry> *Entry = RouterEntries.Find(tag);
+		if (!Entry)
+		{
+			Entry = &RouterEntries.Add(tag, MakeShared<RouteEntry>());
+			(*Entry)->Stats.Tag = tag;
+		}
+		const FDelegateHandle Handle = handler.GetHandle();
+		(*Entry)->Handlers.Add(MoveTemp(handler));
+		return Handle;
+	}
+
+	void RemoveRoute(uint32 tag, FDelegateHandle handle)
+	{
+		FScopeLock Lock(&RouterMutex);
+		if (TSharedRef<RouteEntry> *Entry = RouterEntries.Find(tag))
+		{
+			(*Entry)->Handlers.RemoveAll([handle](const RouteHandler &Handler) { return Handler.GetHandle() == handle; });
+		}
+	}
+
+	void EnsureRouterListener()
+	{
+		bool bAdd = false;
+		{
+			FScopeLock Lock(&RouterMutex);
+			bAdd = !bRouterListenerAdded;
+			bRouterListenerAdded = true;
+		}
+		if (bAdd)
+		{
+			TencentCloudChat::AddAdvancedMsgListener(&RouterListenerInstance);
+		}
+	}
+
+	void RouteOne(const V2TIMMessage &message)
+	{
+		const V2TIMCustomElem *CustomElem = TencentCloudChatCustomPayload::GetSingleCustomElem(message);
+		const TConstArrayView<uint8> Payload = CustomElem ? TencentCloudChatCustomPayload::GetData(*CustomElem) : TConstArrayView<uint8>();
+
+		TencentCloudChatCodecReader Reader;
+		const uint32 Tag = Reader.Parse(Payload) ? Reader.GetSchemaId() : 0;
+		const TencentCloudChatRoutedMessage Routed{ message, Payload, Reader, Tag };
+
+		TSharedPtr<RouteEntry> Entry;
+		TArray<RouteHandler, TInlineAllocator<2>> Handlers;
+		{
+			FScopeLock Lock(&RouterMutex);
+			const TSharedRef<RouteEntry> *Found = RouterEntries.Find(Tag);
+			if (!Found || (*Found)->Handlers.Num() == 0)
+			{
+				Found = RouterEntries.Find(0);
+				if (!Found || (*Found)->Handlers.Num() == 0)
+				{
+					return;
+				}
+			}
+			Entry = *Found;
+			Handlers = Entry->Handlers;
+		}
+
+		// 调用拷贝出来的处理函数，不持有 RouterMutex，处理函数中可以注册 / 注销处理函数，多个线程也可以同时路由
+		const double StartTime = FPlatformTime::Seconds();
+		for (const RouteHandler &Handler : Handlers)
+		{
+			Handler.ExecuteIfBound(Routed);
+		}
+		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+		FScopeLock Lock(&RouterMutex);
+		++Entry->Stats.Count;
+		Entry->Stats.TotalSeconds += Elapsed;
+		Entry->Stats.MaxSeconds = FMath::Max(Entry->Stats.MaxSeconds, Elapsed);
+	}
+}
+
+FDelegateHandle TencentCloudChatRouter::AddHandler(uint32 tag, FTencentCloudChatRouteDelegate::FDelegate &&handler)
+{
+	checkf(tag != 0, TEXT("TencentCloudChatRouter: tag 0 is reserved for the fallback handler"));
+	FDelegateHandle Handle;
+	{
+		FScopeLock Lock(&RouterMutex);
+		Handle = AddRoute(tag, MoveTemp(handler));
+	}
+	EnsureRouterListener();
+	return Handle;
+}
+
+void TencentCloudChatRouter::RemoveHandler(uint32 tag, FDelegateHandle handle)
+{
+	RemoveRoute(tag, handle);
+}
+
+FDelegateHandle TencentCloudChatRouter::AddFallbackHandler(FTencentCloudChatRouteDelegate::FDelegate &&handler)
+{
+	FDelegateHandle Handle;
+	{
+		FScopeLock Lock(&RouterMutex);
+		Handle = AddRoute(0, MoveTemp(handler));
+	}
+	EnsureRouterListener();
+	return Handle;
+}
+
+void TencentCloudChatRouter::RemoveFallbackHandler(FDelegateHandle handle)
+{
+	RemoveRoute(0, handle);
+}
+
+bool TencentCloudChatRouter::Route(const V2TIMMessage &message)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TencentCloudChat_RouterDispatch);
+
+	if (CVarRouterDedup.GetValueOnAnyThread() && !GetDedupFilter().MarkSeen(message))
+	{
+		return false;
+	}
+
+	// 解压、拆分只做一次，结果交给所有处理函数共用
+	TArray<V2TIMMessage> Unbatched;
+	if (TencentCloudChatBatcher::Unbatch(message, Unbatched))
+	{
+		INC_DWORD_STAT_BY(STAT_TencentCloudChat_RouterMessages, Unbatched.Num());
+		for (const V2TIMMessage &Each : Unbatched)
+		{
+			RouteOne(Each);
+		}
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_TencentCloudChat_RouterMessages);
+	V2TIMMessage Decompressed;
+	RouteOne(TencentCloudChatCompression::DecompressMessage(message, Decompressed) ? Decompressed : message);
+	return true;
+}
+
+TencentCloudChatDedupFilter &TencentCloudChatRouter::GetDedupFilter()
+{
+	static TencentCloudChatDedupFilter Filter;
+	return Filter;
+}
+
+TArray<TencentCloudChatRouteStats> TencentCloudChatRouter::GetStats()
+{
+	TArray<TencentCloudChatRouteStats> Stats;
+	{
+		FScopeLock Lock(&RouterMutex);
+		Stats.Reserve(RouterEntries.Num());
+		for (const TPair<uint32, TSharedRef<RouteEntry>> &Pair : RouterEntries)
+		{
+			Stats.Add(Pair.Value->Stats);
+		}
+	}
+	Stats.Sort([](const TencentCloudChatRouteStats &A, const TencentCloudChatRouteStats &B) { return A.Tag < B.Tag; });
+	return Stats;
+}
+
+void TencentCloudChatRouter::ResetStats()
+{
+	FScopeLock Lock(&RouterMutex);
+	for (TPair<uint32, TSharedRef<RouteEntry>> &Pair : RouterEntries)
+	{
+		Pair.Value->Stats = TencentCloudChatRouteStats();
+		Pair.Value->Stats.Tag = Pair.Key;
+	}
+}
+
+void TencentCloudChatRouter::Shutdown()
+{
+	bool bRemove = false;
+	{
+		FScopeLock Lock(&RouterMutex);
+		bRemove = bRouterListenerAdded;
+		bRouterListenerAdded = false;
+		RouterEntries.Empty();
+	}
+	if (bRemove)
+	{
+		TencentCloudChat::RemoveAdvancedMsgListener(&RouterListenerInstance);
+	}
+}
+
+static FAutoConsoleCommand GTencentCloudChatRouterStatsCommand(
+	TEXT("TencentCloudChat.Router.Stats"),
+	TEXT("Print per-tag dispatch counts and handler time of TencentCloudChatRouter. Pass 'reset' to clear them."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString> &Args)
+	{
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			TencentCloudChatRouter::ResetStats();
+			return;
+		}
+
+		UE_LOG(LogTencentCloudChat, Display, TEXT("%10s %12s %14s %14s"), TEXT("Tag"), TEXT("Count"), TEXT("Avg (us)"), TEXT("Max (us)"));
+		for (const TencentCloudChatRouteStats &Stats : TencentCloudChatRouter::GetStats())
+		{
+			const double AvgUs = Stats.Count > 0 ? Stats.TotalSeconds * 1e6 / double(Stats.Count) : 0.0;
+			UE_LOG(LogTencentCloudChat, Display, TEXT("%10u %12lld %14.2f %14.2f"), Stats.Tag, Stats.Count, AvgUs, Stats.MaxSeconds * 1e6);
+		}
+	}));
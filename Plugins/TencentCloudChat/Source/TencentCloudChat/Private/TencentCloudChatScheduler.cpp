@@ -0,0 +1,345 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatScheduler.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatPrivate.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+#include "V2TIMErrorCode.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Scheduler Queue Depth"), STAT_TencentCloudChat_SchedulerQueueDepth, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduler Messages Sent"), STAT_TencentCloudChat_SchedulerSent, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduler Messages Retried"), STAT_TencentCloudChat_SchedulerRetried, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduler Messages Rejected"), STAT_TencentCloudChat_SchedulerRejected, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<float> CVarSchedulerGlobalRate(
+	TEXT("TencentCloudChat.Scheduler.GlobalRate"),
+	20.0f,
+	TEXT("Messages per second TencentCloudChatScheduler sends across all conversations."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSchedulerGlobalBurst(
+	TEXT("TencentCloudChat.Scheduler.GlobalBurst"),
+	20.0f,
+	TEXT("Maximum burst size of the global token bucket."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSchedulerConversationRate(
+	TEXT("TencentCloudChat.Scheduler.ConversationRate"),
+	5.0f,
+	TEXT("Messages per second TencentCloudChatScheduler sends to a single user or group."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSchedulerConversationBurst(
+	TEXT("TencentCloudChat.Scheduler.ConversationBurst"),
+	5.0f,
+	TEXT("Maximum burst size of each per-conversation token bucket."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSchedulerMaxQueueDepth(
+	TEXT("TencentCloudChat.Scheduler.MaxQueueDepth"),
+	512,
+	TEXT("Maximum number of messages queued in TencentCloudChatScheduler. Further sends are rejected."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSchedulerMaxRetries(
+	TEXT("TencentCloudChat.Scheduler.MaxRetries"),
+	3,
+	TEXT("How many times a message rejected with a frequency-limit error is queued again."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSchedulerRetryDelayMs(
+	TEXT("TencentCloudChat.Scheduler.RetryDelayMs"),
+	500.0f,
+	TEXT("Initial backoff before retrying a message rejected with a frequency-limit error. Doubles on each retry."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSchedulerShedLowAt(
+	TEXT("TencentCloudChat.Scheduler.ShedLowAt"),
+	0.5f,
+	TEXT("Backpressure in [0, 1] at which ShouldShed starts returning true for LOW priority messages."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSchedulerShedNormalAt(
+	TEXT("TencentCloudChat.Scheduler.ShedNormalAt"),
+	0.9f,
+	TEXT("Backpressure in [0, 1] at which ShouldShed starts returning true for NORMAL and DEFAULT priority messages."),
+	ECVF_Default);
+
+namespace
+{
+	// 队列下标：0 = HIGH，1 = NORMAL / DEFAULT，2 = LOW
+	constexpr int32 NumPriorityQueues = 3;
+
+	int32 GetQueueIndex(V2TIMMessagePriority priority)
+	{
+		switch (priority)
+		{
+		case V2TIM_PRIORITY_HIGH:
+			return 0;
+		case V2TIM_PRIORITY_LOW:
+			return 2;
+		default:
+			return 1;
+		}
+	}
+
+	struct ScheduledMessage
+	{
+		V2TIMMessage Message;
+		V2TIMString Receiver;
+		V2TIMString GroupID;
+		V2TIMMessagePriority Priority = V2TIM_PRIORITY_DEFAULT;
+		bool bOnlineUserOnly = false;
+		V2TIMOfflinePushInfo OfflinePushInfo;
+		V2TIMSendCallback *Callback = nullptr;
+		int32 Attempts = 0;
+		// 重试退避期间不出队
+		double NotBefore = 0.0;
+
+		const V2TIMString &GetConversationKey() const
+		{
+			return GroupID.Size() > 0 ? GroupID : Receiver;
+		}
+	};
+
+	using ScheduledMessageRef = TSharedPtr<ScheduledMessage, ESPMode::ThreadSafe>;
+
+	FCriticalSection SchedulerMutex;
+	TArray<ScheduledMessageRef> SchedulerQueues[NumPriorityQueues];
+	int32 SchedulerQueuedCount = 0;
+	TencentCloudChatTokenBucket SchedulerGlobalBucket;
+	TMap<V2TIMString, TencentCloudChatTokenBucket> SchedulerConversationBuckets;
+	FTSTicker::FDelegateHandle SchedulerTickHandle;
+
+	/**
+	 * 因频率限制失败时重新排队，排在同优先级最前面，并清空该会话的令牌
+	 */
+	void RequeueScheduled(const ScheduledMessageRef &entry)
+	{
+		const double Now = FPlatformTime::Seconds();
+		const double DelaySeconds = CVarSchedulerRetryDelayMs.GetValueOnAnyThread() / 1000.0 * double(1 << FMath::Min(entry->Attempts - 1, 10));
+		entry->NotBefore = Now + DelaySeconds;
+
+		FScopeLock Lock(&SchedulerMutex);
+		TencentCloudChatTokenBucket &Bucket = SchedulerConversationBuckets.FindOrAdd(entry->GetConversationKey());
+		Bucket.Tokens = 0.0;
+		Bucket.LastRefillTime = Now;
+
+		SchedulerQueues[GetQueueIndex(entry->Priority)].Insert(entry, 0);
+		++SchedulerQueuedCount;
+	}
+
+	void SendScheduled(const ScheduledMessageRef &entry)
+	{
+		INC_DWORD_STAT(STAT_TencentCloudChat_SchedulerSent);
+		++entry->Attempts;
+
+		V2TIMSendCallback *Original = entry->Callback;
+		V2TIMSendCallback *Callback = TencentCloudChatSendCallback::Create(
+			[Original](const V2TIMMessage &message)
+			{
+				if (Original)
+				{
+					Original->OnSuccess(message);
+				}
+			},
+			[entry](int error_code, const V2TIMString &error_message)
+			{
+				if (TencentCloudChatScheduler::IsFrequencyLimitError(error_code) && entry->Attempts <= CVarSchedulerMaxRetries.GetValueOnAnyThread())
+				{
+					INC_DWORD_STAT(STAT_TencentCloudChat_SchedulerRetried);
+					UE_LOG(LogTencentCloudChat, Verbose, TEXT("Scheduler: frequency limit %d, retry %d"), error_code, entry->Attempts);
+					RequeueScheduled(entry);
+					return;
+				}
+				if (entry->Callback)
+				{
+					entry->Callback->OnError(error_code, error_message);
+				}
+			},
+			[Original](uint32_t progress)
+			{
+				if (Original)
+				{
+					Original->OnProgress(progress);
+				}
+			});
+
+		// 回调可能在 SendMessage 返回前就被调用并回收，这里的 entry 保证参数在调用期间有效
+		TencentCloudChat::SendMessage(entry->Message, entry->Receiver, entry->GroupID, entry->Priority,
+									  entry->bOnlineUserOnly, entry->OfflinePushInfo, Callback);
+	}
+}
+
+bool TencentCloudChatScheduler::SendMessage(const V2TIMMessage &message, const V2TIMString &receiver,
+											const V2TIMString &groupID, V2TIMMessagePriority priority,
+											bool onlineUserOnly, const V2TIMOfflinePushInfo &offlinePushInfo,
+											V2TIMSendCallback *callback)
+{
+	{
+		FScopeLock Lock(&SchedulerMutex);
+		if (SchedulerQueuedCount < FMath::Max(CVarSchedulerMaxQueueDepth.GetValueOnAnyThread(), 1))
+		{
+			ScheduledMessageRef Entry = MakeShared<ScheduledMessage, ESPMode::ThreadSafe>();
+			Entry->Message = message;
+			Entry->Receiver = receiver;
+			Entry->GroupID = groupID;
+			Entry->Priority = priority;
+			Entry->bOnlineUserOnly = onlineUserOnly;
+			Entry->OfflinePushInfo = offlinePushInfo;
+			Entry->Callback = callback;
+			SchedulerQueues[GetQueueIndex(priority)].Add(MoveTemp(Entry));
+			++SchedulerQueuedCount;
+			SET_DWORD_STAT(STAT_TencentCloudChat_SchedulerQueueDepth, SchedulerQueuedCount);
+			return true;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_TencentCloudChat_SchedulerRejected);
+	if (callback)
+	{
+		callback->OnError(ERR_SDK_COMM_API_CALL_FREQUENCY_LIMIT, "TencentCloudChatScheduler queue is full");
+	}
+	return false;
+}
+
+int32 TencentCloudChatScheduler::GetQueueDepth()
+{
+	FScopeLock Lock(&SchedulerMutex);
+	return SchedulerQueuedCount;
+}
+
+int32 TencentCloudChatScheduler::GetQueueDepth(V2TIMMessagePriority priority)
+{
+	FScopeLock Lock(&SchedulerMutex);
+	return SchedulerQueues[GetQueueIndex(priority)].Num();
+}
+
+float TencentCloudChatScheduler::GetBackpressure()
+{
+	const int32 MaxDepth = FMath::Max(CVarSchedulerMaxQueueDepth.GetValueOnAnyThread(), 1);
+	return FMath::Clamp(float(GetQueueDepth()) / float(MaxDepth), 0.0f, 1.0f);
+}
+
+bool TencentCloudChatScheduler::ShouldShed(V2TIMMessagePriority priority)
+{
+	switch (GetQueueIndex(priority))
+	{
+	case 0:
+		return false;
+	case 1:
+		return GetBackpressure() >= CVarSchedulerShedNormalAt.GetValueOnAnyThread();
+	default:
+		return GetBackpressure() >= CVarSchedulerShedLowAt.GetValueOnAnyThread();
+	}
+}
+
+bool TencentCloudChatScheduler::IsFrequencyLimitError(int errorCode)
+{
+	switch (errorCode)
+	{
+	case ERR_SDK_COMM_API_CALL_FREQUENCY_LIMIT:
+	case ERR_SDK_NET_FREQ_LIMIT:
+	case ERR_SVR_SSO_FREQ_LIMIT:
+	case ERR_SVR_SSO_FREQUENCY_LIMIT:
+	case ERR_SVR_COMM_REQ_FREQ_LIMIT:
+	case ERR_SVR_COMM_REQ_FREQ_LIMIT_EX:
+	case ERR_SVR_COMM_SDKAPPID_FREQ_LIMIT:
+	case ERR_SVR_GROUP_FREQ_LIMIT:
+	case ERR_SVR_GROUP_SEND_MSG_FREQ_LIMIT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+int32 TencentCloudChatScheduler::Pump()
+{
+	const double Now = FPlatformTime::Seconds();
+	const double GlobalRate = FMath::Max(CVarSchedulerGlobalRate.GetValueOnAnyThread(), 0.0f);
+	const double GlobalBurst = FMath::Max(CVarSchedulerGlobalBurst.GetValueOnAnyThread(), 1.0f);
+	const double ConversationRate = FMath::Max(CVarSchedulerConversationRate.GetValueOnAnyThread(), 0.0f);
+	const double ConversationBurst = FMath::Max(CVarSchedulerConversationBurst.GetValueOnAnyThread(), 1.0f);
+
+	// SDK 调用放在锁外面
+	TArray<ScheduledMessageRef> Ready;
+	{
+		FScopeLock Lock(&SchedulerMutex);
+		SchedulerGlobalBucket.Refill(Now, GlobalRate, GlobalBurst);
+
+		// 本轮中被跳过的会话，其后续消息也要跳过，保证会话内的顺序
+		TSet<V2TIMString> Blocked;
+		for (int32 QueueIndex = 0; QueueIndex < NumPriorityQueues && SchedulerGlobalBucket.Tokens >= 1.0; ++QueueIndex)
+		{
+			TArray<ScheduledMessageRef> &Queue = SchedulerQueues[QueueIndex];
+			for (int32 Index = 0; Index < Queue.Num() && SchedulerGlobalBucket.Tokens >= 1.0;)
+			{
+				const V2TIMString &Key = Queue[Index]->GetConversationKey();
+				if (Blocked.Contains(Key))
+				{
+					++Index;
+					continue;
+				}
+				if (Queue[Index]->NotBefore > Now || !SchedulerConversationBuckets.FindOrAdd(Key).TryConsume(Now, ConversationRate, ConversationBurst))
+				{
+					Blocked.Add(Key);
+					++Index;
+					continue;
+				}
+
+				SchedulerGlobalBucket.Tokens -= 1.0;
+				Ready.Add(MoveTemp(Queue[Index]));
+				Queue.RemoveAt(Index);
+				--SchedulerQueuedCount;
+			}
+		}
+
+		// 回收已经攒满令牌的空闲会话，避免会话数只增不减
+		if (SchedulerConversationBuckets.Num() > 256)
+		{
+			for (auto It = SchedulerConversationBuckets.CreateIterator(); It; ++It)
+			{
+				It->Value.Refill(Now, ConversationRate, ConversationBurst);
+				if (It->Value.Tokens >= ConversationBurst && !Blocked.Contains(It->Key))
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		SET_DWORD_STAT(STAT_TencentCloudChat_SchedulerQueueDepth, SchedulerQueuedCount);
+	}
+
+	for (const ScheduledMessageRef &Entry : Ready)
+	{
+		SendScheduled(Entry);
+	}
+	return Ready.Num();
+}
+
+void TencentCloudChatScheduler::Startup()
+{
+	SchedulerTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float)
+	{
+		Pump();
+		return true;
+	}));
+}
+
+void TencentCloudChatScheduler::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(SchedulerTickHandle);
+	SchedulerTickHandle.Reset();
+
+	FScopeLock Lock(&SchedulerMutex);
+	for (TArray<ScheduledMessageRef> &Queue : SchedulerQueues)
+	{
+		Queue.Empty();
+	}
+	SchedulerQueuedCount = 0;
+	SchedulerConversationBuckets.Empty();
+	SchedulerGlobalBucket = TencentCloudChatTokenBucket();
+}
@@ -0,0 +1,626 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatSearch.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatString.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/StringBuilder.h"
+
+DECLARE_CYCLE_STAT(TEXT("Search Index Query"), STAT_TencentCloudChat_SearchQuery, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Search Index Messages"), STAT_TencentCloudChat_SearchMessages, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<int32> CVarSearchMaxMessages(
+	TEXT("TencentCloudChat.Search.MaxMessages"),
+	200000,
+	TEXT("Maximum number of messages kept in a TencentCloudChat full-text index; the earliest added are evicted first."),
+	ECVF_Default);
+
+namespace
+{
+	// 删除的文档超过存活的文档且不少于这个数时压缩
+	constexpr int32 SearchMinCompactDocs = 1024;
+
+	bool IsCJK(TCHAR C)
+	{
+		return (C >= 0x3040 && C <= 0x30FF)	   // 平假名、片假名
+			   || (C >= 0x3400 && C <= 0x4DBF) // CJK 扩展 A
+			   || (C >= 0x4E00 && C <= 0x9FFF) // CJK 统一汉字
+			   || (C >= 0xAC00 && C <= 0xD7AF) // 韩文音节
+			   || (C >= 0xF900 && C <= 0xFAFF);	// CJK 兼容汉字
+	}
+
+	bool IsIndexable(TCHAR C)
+	{
+		return IsCJK(C) || FChar::IsAlnum(C);
+	}
+
+	uint64 UnigramToken(TCHAR C)
+	{
+		return uint64(C);
+	}
+
+	// 可索引的字符不为 0，bigram 和 unigram 不会冲突
+	uint64 BigramToken(TCHAR A, TCHAR B)
+	{
+		return (uint64(A) << 32) | uint64(B);
+	}
+
+	/**
+	 * 文档的 token：每段可索引字符的所有 bigram，加上中日韩字符的 unigram；结果排序去重
+	 */
+	void TokenizeDoc(const FString &lowerText, TArray<uint64> &outTokens)
+	{
+		outTokens.Reset();
+		const int32 Len = lowerText.Len();
+		for (int32 Index = 0; Index < Len; ++Index)
+		{
+			const TCHAR C = lowerText[Index];
+			if (!IsIndexable(C))
+			{
+				continue;
+			}
+			if (IsCJK(C))
+			{
+				outTokens.Add(UnigramToken(C));
+			}
+			if (Index + 1 < Len && IsIndexable(lowerText[Index + 1]))
+			{
+				outTokens.Add(BigramToken(C, lowerText[Index + 1]));
+			}
+		}
+		Algo::Sort(outTokens);
+		outTokens.SetNum(Algo::Unique(outTokens));
+	}
+
+	/**
+	 * 查询关键字的 token：每段可索引字符取所有 bigram，只有一个字符的段取中日韩字符的 unigram
+	 *
+	 * @return 这些 token 是否已经完整表达了关键字；否则还需要用原文确认
+	 */
+	bool TokenizeTerm(const FString &lowerTerm, TArray<uint64> &outTokens)
+	{
+		const int32 Len = lowerTerm.Len();
+		int32 Runs = 0;
+		bool bExact = true;
+		for (int32 Start = 0; Start < Len;)
+		{
+			if (!IsIndexable(lowerTerm[Start]))
+			{
+				bExact = false;
+				++Start;
+				continue;
+			}
+			int32 End = Start + 1;
+			while (End < Len && IsIndexable(lowerTerm[End]))
+			{
+				++End;
+			}
+
+			++Runs;
+			if (End - Start == 1)
+			{
+				if (IsCJK(lowerTerm[Start]))
+				{
+					outTokens.Add(UnigramToken(lowerTerm[Start]));
+				}
+				else
+				{
+					bExact = false;
+				}
+			}
+			else
+			{
+				for (int32 Index = Start; Index + 1 < End; ++Index)
+				{
+					outTokens.Add(BigramToken(lowerTerm[Index], lowerTerm[Index + 1]));
+				}
+				// 三个字符以上时 bigram 都出现不代表它们相邻
+				bExact &= End - Start == 2;
+			}
+			Start = End;
+		}
+		return bExact && Runs == 1;
+	}
+
+	/**
+	 * 在递增的 list 中从 cursor 开始查找第一个 >= value 的位置，先倍增步长再二分
+	 */
+	int32 Gallop(const TArray<int32> &list, int32 cursor, int32 value)
+	{
+		int32 Low = cursor;
+		int32 Step = 1;
+		while (Low + Step < list.Num() && list[Low + Step] < value)
+		{
+			Low += Step;
+			Step *= 2;
+		}
+		int32 High = FMath::Min(Low + Step, list.Num());
+		while (Low < High)
+		{
+			const int32 Mid = Low + (High - Low) / 2;
+			if (list[Mid] < value)
+			{
+				Low = Mid + 1;
+			}
+			else
+			{
+				High = Mid;
+			}
+		}
+		return Low;
+	}
+}
+
+V2TIMString TencentCloudChatTextIndex::GetConversationID(const V2TIMMessage &message)
+{
+	TAnsiStringBuilder<128> ID;
+	if (!message.groupID.Empty())
+	{
+		ID << "group_" << message.groupID.CString();
+	}
+	else
+	{
+		ID << "c2c_" << message.userID.CString();
+	}
+	return V2TIMString(ID.GetData(), ID.Len());
+}
+
+bool TencentCloudChatTextIndex::Add(const V2TIMMessage &message)
+{
+	if (message.msgID.Empty() || message.status == V2TIM_MSG_STATUS_LOCAL_REVOKED)
+	{
+		return false;
+	}
+
+	TStringBuilder<256> Text;
+	bool bHasText = false;
+	for (size_t Index = 0; Index < message.elemList.Size(); ++Index)
+	{
+		const V2TIMElem *Elem = message.elemList[Index];
+		if (Elem->elemType == V2TIM_ELEM_TYPE_TEXT)
+		{
+			if (bHasText)
+			{
+				Text << TEXT('\n');
+			}
+			Text << TencentCloudChatString::ToFString(static_cast<const V2TIMTextElem *>(Elem)->text);
+			bHasText = true;
+		}
+	}
+	if (!bHasText)
+	{
+		return false;
+	}
+
+	Add(message.msgID, GetConversationID(message), message.timestamp, Text.ToView());
+	return true;
+}
+
+void TencentCloudChatTextIndex::Add(const V2TIMString &msgID, const V2TIMString &conversationID, int64 timestamp, FStringView text)
+{
+	// 分词不需要持有锁
+	FString Lower(text);
+	Lower.ToLowerInline();
+	TArray<uint64> Tokens;
+	TokenizeDoc(Lower, Tokens);
+
+	FScopeLock Lock(&Mutex);
+	if (const int32 *Existing = MsgIdToDoc.Find(msgID))
+	{
+		RemoveDoc(*Existing);
+	}
+
+	int32 Conversation;
+	if (const int32 *Found = ConversationToIndex.Find(conversationID))
+	{
+		Conversation = *Found;
+	}
+	else
+	{
+		Conversation = Conversations.Add(conversationID);
+		ConversationToIndex.Add(conversationID, Conversation);
+	}
+
+	const int32 DocId = Docs.Num();
+	Doc &NewDoc = Docs.AddDefaulted_GetRef();
+	NewDoc.MsgID = msgID;
+	NewDoc.Text = MoveTemp(Lower);
+	NewDoc.Timestamp = timestamp;
+	NewDoc.Conversation = Conversation;
+	NewDoc.bLive = true;
+	MsgIdToDoc.Add(msgID, DocId);
+	++LiveDocs;
+
+	// DocId 是目前最大的编号，直接追加即可保持递增
+	for (uint64 Token : Tokens)
+	{
+		Postings.FindOrAdd(Token).Add(DocId);
+	}
+	PostingCount += Tokens.Num();
+
+	EvictOldest();
+	SET_DWORD_STAT(STAT_TencentCloudChat_SearchMessages, LiveDocs);
+}
+
+bool TencentCloudChatTextIndex::Remove(const V2TIMString &msgID)
+{
+	FScopeLock Lock(&Mutex);
+	const int32 *Found = MsgIdToDoc.Find(msgID);
+	if (!Found)
+	{
+		return false;
+	}
+	RemoveDoc(*Found);
+	SET_DWORD_STAT(STAT_TencentCloudChat_SearchMessages, LiveDocs);
+	return true;
+}
+
+void TencentCloudChatTextIndex::RemoveDoc(int32 docId)
+{
+	Doc &Removed = Docs[docId];
+	MsgIdToDoc.Remove(Removed.MsgID);
+	Removed.bLive = false;
+	Removed.MsgID = V2TIMString();
+	Removed.Text.Empty();
+	--LiveDocs;
+
+	// 倒排表中的编号留到压缩时再清理，搜索时跳过
+	if (Docs.Num() - LiveDocs >= FMath::Max(LiveDocs, SearchMinCompactDocs))
+	{
+		Compact();
+	}
+}
+
+void TencentCloudChatTextIndex::EvictOldest()
+{
+	const int32 MaxMessages = FMath::Max(CVarSearchMaxMessages.GetValueOnAnyThread(), 1);
+	while (LiveDocs > MaxMessages)
+	{
+		while (!Docs[OldestCursor].bLive)
+		{
+			++OldestCursor;
+		}
+		RemoveDoc(OldestCursor);
+	}
+}
+
+void TencentCloudChatTextIndex::Compact()
+{
+	// 按原顺序重新编号，倒排表保持递增
+	TArray<int32> Remap;
+	Remap.SetNumUninitialized(Docs.Num());
+	int32 NextId = 0;
+	for (int32 DocId = 0; DocId < Docs.Num(); ++DocId)
+	{
+		if (Docs[DocId].bLive)
+		{
+			Remap[DocId] = NextId;
+			if (NextId != DocId)
+			{
+				Docs[NextId] = MoveTemp(Docs[DocId]);
+			}
+			++NextId;
+		}
+		else
+		{
+			Remap[DocId] = INDEX_NONE;
+		}
+	}
+	Docs.SetNum(NextId);
+
+	PostingCount = 0;
+	for (auto It = Postings.CreateIterator(); It; ++It)
+	{
+		TArray<int32> &List = It.Value();
+		int32 Kept = 0;
+		for (int32 DocId : List)
+		{
+			if (Remap[DocId] != INDEX_NONE)
+			{
+				List[Kept++] = Remap[DocId];
+			}
+		}
+		if (Kept == 0)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		List.SetNum(Kept);
+		List.Shrink();
+		PostingCount += Kept;
+	}
+	Postings.Compact();
+
+	for (TPair<V2TIMString, int32> &Pair : MsgIdToDoc)
+	{
+		Pair.Value = Remap[Pair.Value];
+	}
+	OldestCursor = 0;
+}
+
+int32 TencentCloudChatTextIndex::Search(FStringView query, TArray<TencentCloudChatSearchHit> &outHits, int32 maxHits,
+										const V2TIMString &conversationID)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TencentCloudChat_SearchQuery);
+	const double StartTime = FPlatformTime::Seconds();
+	outHits.Reset();
+
+	FString Lower(query);
+	Lower.ToLowerInline();
+	TArray<FString> Terms;
+	Lower.ParseIntoArrayWS(Terms);
+
+	TArray<uint64> Tokens;
+	TArray<FString> VerifyTerms;
+	for (FString &Term : Terms)
+	{
+		const int32 TokensBefore = Tokens.Num();
+		if (!TokenizeTerm(Term, Tokens) && Tokens.Num() > TokensBefore)
+		{
+			VerifyTerms.Add(MoveTemp(Term));
+		}
+	}
+	Algo::Sort(Tokens);
+	Tokens.SetNum(Algo::Unique(Tokens));
+
+	FScopeLock Lock(&Mutex);
+	int32 Total = 0;
+	if (Tokens.Num() > 0)
+	{
+		int32 Conversation = INDEX_NONE;
+		bool bConversationKnown = true;
+		if (!conversationID.Empty())
+		{
+			const int32 *Found = ConversationToIndex.Find(conversationID);
+			bConversationKnown = Found != nullptr;
+			Conversation = Found ? *Found : INDEX_NONE;
+		}
+
+		TArray<const TArray<int32> *, TInlineAllocator<16>> Lists;
+		for (uint64 Token : Tokens)
+		{
+			const TArray<int32> *List = Postings.Find(Token);
+			if (!List)
+			{
+				Lists.Reset();
+				break;
+			}
+			Lists.Add(List);
+		}
+
+		if (Lists.Num() > 0 && bConversationKnown)
+		{
+			Algo::Sort(Lists, [](const TArray<int32> *A, const TArray<int32> *B) { return A->Num() < B->Num(); });
+
+			// 从最短的倒排表开始，逐个求交集
+			TArray<int32> Candidates;
+			Candidates.Reserve(Lists[0]->Num());
+			for (int32 DocId : *Lists[0])
+			{
+				const Doc &Candidate = Docs[DocId];
+				if (Candidate.bLive && (Conversation == INDEX_NONE || Candidate.Conversation == Conversation))
+				{
+					Candidates.Add(DocId);
+				}
+			}
+			for (int32 ListIndex = 1; ListIndex < Lists.Num() && Candidates.Num() > 0; ++ListIndex)
+			{
+				const TArray<int32> &List = *Lists[ListIndex];
+				int32 Cursor = 0;
+				int32 Kept = 0;
+				for (int32 DocId : Candidates)
+				{
+					Cursor = Gallop(List, Cursor, DocId);
+					if (Cursor == List.Num())
+					{
+						break;
+					}
+					if (List[Cursor] == DocId)
+					{
+						Candidates[Kept++] = DocId;
+					}
+				}
+				Candidates.SetNum(Kept);
+			}
+
+			// 按时间保留最新的 maxHits 条：小顶堆的堆顶是已保留的最旧一条
+			using HeapEntry = TPair<int64, int32>;
+			auto HeapLess = [](const HeapEntry &A, const HeapEntry &B) { return A.Key < B.Key || (A.Key == B.Key && A.Value < B.Value); };
+			TArray<HeapEntry> Heap;
+			Heap.Reserve(FMath::Min(maxHits, Candidates.Num()) + 1);
+			for (int32 DocId : Candidates)
+			{
+				const Doc &Candidate = Docs[DocId];
+				bool bMatch = true;
+				for (const FString &Term : VerifyTerms)
+				{
+					if (!Candidate.Text.Contains(Term, ESearchCase::CaseSensitive))
+					{
+						bMatch = false;
+						break;
+					}
+				}
+				if (!bMatch)
+				{
+					continue;
+				}
+
+				++Total;
+				const HeapEntry Entry(Candidate.Timestamp, DocId);
+				if (Heap.Num() < maxHits)
+				{
+					Heap.HeapPush(Entry, HeapLess);
+				}
+				else if (maxHits > 0 && HeapLess(Heap.HeapTop(), Entry))
+				{
+					Heap.HeapPopDiscard(HeapLess);
+					Heap.HeapPush(Entry, HeapLess);
+				}
+			}
+
+			Algo::Sort(Heap, [&HeapLess](const HeapEntry &A, const HeapEntry &B) { return HeapLess(B, A); });
+			outHits.Reserve(Heap.Num());
+			for (const HeapEntry &Entry : Heap)
+			{
+				const Doc &Hit = Docs[Entry.Value];
+				outHits.Add({ Hit.MsgID, Conversations[Hit.Conversation], Hit.Timestamp });
+			}
+		}
+	}
+
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+	++Stats.Searches;
+	Stats.TotalSearchSeconds += Elapsed;
+	Stats.MaxSearchSeconds = FMath::Max(Stats.MaxSearchSeconds, Elapsed);
+	return Total;
+}
+
+void TencentCloudChatTextIndex::Reset()
+{
+	FScopeLock Lock(&Mutex);
+	Docs.Empty();
+	MsgIdToDoc.Empty();
+	Postings.Empty();
+	Conversations.Empty();
+	ConversationToIndex.Empty();
+	LiveDocs = 0;
+	OldestCursor = 0;
+	PostingCount = 0;
+	Stats = TencentCloudChatTextIndexStats();
+	SET_DWORD_STAT(STAT_TencentCloudChat_SearchMessages, 0);
+}
+
+int32 TencentCloudChatTextIndex::Num() const
+{
+	FScopeLock Lock(&Mutex);
+	return LiveDocs;
+}
+
+TencentCloudChatTextIndexStats TencentCloudChatTextIndex::GetStats() const
+{
+	FScopeLock Lock(&Mutex);
+	TencentCloudChatTextIndexStats Result = Stats;
+	Result.Messages = LiveDocs;
+	Result.Tokens = Postings.Num();
+	Result.Postings = PostingCount;
+
+	SIZE_T Bytes = Docs.GetAllocatedSize() + MsgIdToDoc.GetAllocatedSize() + Postings.GetAllocatedSize() +
+				   Conversations.GetAllocatedSize() + ConversationToIndex.GetAllocatedSize();
+	for (const Doc &Each : Docs)
+	{
+		Bytes += Each.Text.GetAllocatedSize() + Each.MsgID.Size();
+	}
+	for (const TPair<uint64, TArray<int32>> &Pair : Postings)
+	{
+		Bytes += Pair.Value.GetAllocatedSize();
+	}
+	Result.MemoryBytes = Bytes;
+	return Result;
+}
+
+namespace
+{
+	TencentCloudChatTextIndex SearchIndex;
+	FCriticalSection SearchMutex;
+	bool bSearchEnabled = false;
+
+	class SearchListener : public V2TIMAdvancedMsgListener
+	{
+	public:
+		void OnRecvNewMessage(const V2TIMMessage &message) override
+		{
+			SearchIndex.Add(message);
+		}
+
+		void OnRecvMessageModified(const V2TIMMessage &message) override
+		{
+			// 修改后不再是文本消息时也要删掉旧的内容
+			if (!SearchIndex.Add(message))
+			{
+				SearchIndex.Remove(message.msgID);
+			}
+		}
+
+		void OnRecvMessageRevoked(const V2TIMString &messageID) override
+		{
+			SearchIndex.Remove(messageID);
+		}
+	};
+	SearchListener SearchListenerInstance;
+}
+
+void TencentCloudChatSearch::Enable(bool bEnable)
+{
+	{
+		FScopeLock Lock(&SearchMutex);
+		if (bSearchEnabled == bEnable)
+		{
+			return;
+		}
+		bSearchEnabled = bEnable;
+	}
+
+	if (bEnable)
+	{
+		TencentCloudChat::AddAdvancedMsgListener(&SearchListenerInstance);
+	}
+	else
+	{
+		TencentCloudChat::RemoveAdvancedMsgListener(&SearchListenerInstance);
+		SearchIndex.Reset();
+	}
+}
+
+bool TencentCloudChatSearch::IsEnabled()
+{
+	FScopeLock Lock(&SearchMutex);
+	return bSearchEnabled;
+}
+
+void TencentCloudChatSearch::AddMessages(const V2TIMMessageVector &messages)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+	for (size_t Index = 0; Index < messages.Size(); ++Index)
+	{
+		SearchIndex.Add(messages[Index]);
+	}
+}
+
+int32 TencentCloudChatSearch::Search(FStringView query, TArray<TencentCloudChatSearchHit> &outHits, int32 maxHits,
+									 const V2TIMString &conversationID)
+{
+	return SearchIndex.Search(query, outHits, maxHits, conversationID);
+}
+
+TencentCloudChatTextIndex &TencentCloudChatSearch::GetIndex()
+{
+	return SearchIndex;
+}
+
+void TencentCloudChatSearch::Reset()
+{
+	SearchIndex.Reset();
+}
+
+void TencentCloudChatSearch::Shutdown()
+{
+	Enable(false);
+}
+
+static FAutoConsoleCommand GTencentCloudChatSearchStatsCommand(
+	TEXT("TencentCloudChat.Search.Stats"),
+	TEXT("Print statistics of the TencentCloudChat local full-text index."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const TencentCloudChatTextIndexStats Stats = TencentCloudChatSearch::GetIndex().GetStats();
+		UE_LOG(LogTencentCloudChat, Display, TEXT("Search index: enabled=%d messages=%d tokens=%d postings=%lld memory=%.1f KB searches=%llu avg=%.3f ms max=%.3f ms"),
+			   TencentCloudChatSearch::IsEnabled() ? 1 : 0, Stats.Messages, Stats.Tokens, Stats.Postings, double(Stats.MemoryBytes) / 1024.0,
+			   Stats.Searches, Stats.GetAverageSearchSeconds() * 1000.0, Stats.MaxSearchSeconds * 1000.0);
+	}));
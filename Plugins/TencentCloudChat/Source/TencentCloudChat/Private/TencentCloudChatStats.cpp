@@ -0,0 +1,213 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatStats.h"
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatPrivate.h"
+#include "Containers/Ticker.h"
+#include "Misc/ScopeLock.h"
+
+#include "V2TIMListener.h"
+#include "V2TIMManager.h"
+#include "V2TIMMessageManager.h"
+
+CSV_DEFINE_CATEGORY(TencentCloudChat, true);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Calls In Flight"), STAT_TencentCloudChat_CallsInFlight, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Callbacks Delivered"), STAT_TencentCloudChat_CallbacksDelivered, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listener Events (SDK)"), STAT_TencentCloudChat_ListenerEventsSDK, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listener Events (SimpleMsg)"), STAT_TencentCloudChat_ListenerEventsSimpleMsg, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listener Events (AdvancedMsg)"), STAT_TencentCloudChat_ListenerEventsAdvancedMsg, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listener Events (Group)"), STAT_TencentCloudChat_ListenerEventsGroup, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listener Events (Conversation)"), STAT_TencentCloudChat_ListenerEventsConversation, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listener Events (Friendship)"), STAT_TencentCloudChat_ListenerEventsFriendship, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listener Events (Signaling)"), STAT_TencentCloudChat_ListenerEventsSignaling, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Payload Bytes Sent"), STAT_TencentCloudChat_PayloadBytesSent, STATGROUP_TencentCloudChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Payload Bytes Received"), STAT_TencentCloudChat_PayloadBytesReceived, STATGROUP_TencentCloudChat);
+
+namespace
+{
+	constexpr int32 ListenerCategoryNum = int32(ETencentCloudChatListenerCategory::Num);
+
+	// 累计值；CSV 每帧写入与上一帧的差
+	TAtomic<int32> CallsInFlight(0);
+	TAtomic<int64> CallbacksDelivered(0);
+	TAtomic<int64> ListenerEvents[ListenerCategoryNum];
+	TAtomic<int64> PayloadBytesSent(0);
+	TAtomic<int64> PayloadBytesReceived(0);
+
+	FTSTicker::FDelegateHandle StatsTickHandle;
+
+	class PayloadListener : public V2TIMAdvancedMsgListener
+	{
+	public:
+		void OnRecvNewMessage(const V2TIMMessage &message) override
+		{
+			int64 Bytes = 0;
+			for (size_t Index = 0; Index < message.elemList.Size(); ++Index)
+			{
+				const V2TIMElem *Elem = message.elemList[Index];
+				if (Elem && Elem->elemType == V2TIM_ELEM_TYPE_CUSTOM)
+				{
+					Bytes += int64(static_cast<const V2TIMCustomElem *>(Elem)->data.Size());
+				}
+			}
+			if (Bytes > 0)
+			{
+				TencentCloudChatStats::RecordPayloadReceived(Bytes);
+			}
+		}
+	};
+	PayloadListener PayloadListenerInstance;
+	FCriticalSection PayloadListenerMutex;
+	bool bPayloadListenerAdded = false;
+
+#if CSV_PROFILER
+	struct CsvSnapshot
+	{
+		int64 CallbacksDelivered = 0;
+		int64 ListenerEvents[ListenerCategoryNum] = {};
+		int64 PayloadBytesSent = 0;
+		int64 PayloadBytesReceived = 0;
+	};
+	CsvSnapshot LastCsvSnapshot;
+
+	void WriteCsvStats()
+	{
+		CsvSnapshot Current;
+		Current.CallbacksDelivered = CallbacksDelivered.Load();
+		for (int32 Category = 0; Category < ListenerCategoryNum; ++Category)
+		{
+			Current.ListenerEvents[Category] = ListenerEvents[Category].Load();
+		}
+		Current.PayloadBytesSent = PayloadBytesSent.Load();
+		Current.PayloadBytesReceived = PayloadBytesReceived.Load();
+
+		auto Delta = [](int64 Now, int64 Last) { return int32(Now - Last); };
+		const int64 *Events = Current.ListenerEvents;
+		const int64 *LastEvents = LastCsvSnapshot.ListenerEvents;
+
+		CSV_CUSTOM_STAT(TencentCloudChat, CallsInFlight, CallsInFlight.Load(), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TencentCloudChat, CallbacksDelivered, Delta(Current.CallbacksDelivered, LastCsvSnapshot.CallbacksDelivered), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TencentCloudChat, ListenerEventsSDK, Delta(Events[0], LastEvents[0]), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TencentCloudChat, ListenerEventsSimpleMsg, Delta(Events[1], LastEvents[1]), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TencentCloudChat, ListenerEventsAdvancedMsg, Delta(Events[2], LastEvents[2]), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TencentCloudChat, ListenerEventsGroup, Delta(Events[3], LastEvents[3]), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TencentCloudChat, ListenerEventsConversation, Delta(Events[4], LastEvents[4]), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TencentCloudChat, ListenerEventsFriendship, Delta(Events[5], LastEvents[5]), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TencentCloudChat, ListenerEventsSignaling, Delta(Events[6], LastEvents[6]), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TencentCloudChat, PayloadBytesSent, Delta(Current.PayloadBytesSent, LastCsvSnapshot.PayloadBytesSent), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TencentCloudChat, PayloadBytesReceived, Delta(Current.PayloadBytesReceived, LastCsvSnapshot.PayloadBytesReceived), ECsvCustomStatOp::Set);
+
+		LastCsvSnapshot = Current;
+	}
+#endif
+}
+
+void TencentCloudChatStats::RecordCallIssued()
+{
+	++CallsInFlight;
+	INC_DWORD_STAT(STAT_TencentCloudChat_CallsInFlight);
+}
+
+void TencentCloudChatStats::RecordCallbackDelivered()
+{
+	--CallsInFlight;
+	++CallbacksDelivered;
+	DEC_DWORD_STAT(STAT_TencentCloudChat_CallsInFlight);
+	INC_DWORD_STAT(STAT_TencentCloudChat_CallbacksDelivered);
+}
+
+void TencentCloudChatStats::RecordListenerEvent(ETencentCloudChatListenerCategory category)
+{
+	++ListenerEvents[int32(category)];
+	switch (category)
+	{
+	case ETencentCloudChatListenerCategory::SDK:
+		INC_DWORD_STAT(STAT_TencentCloudChat_ListenerEventsSDK);
+		break;
+	case ETencentCloudChatListenerCategory::SimpleMsg:
+		INC_DWORD_STAT(STAT_TencentCloudChat_ListenerEventsSimpleMsg);
+		break;
+	case ETencentCloudChatListenerCategory::AdvancedMsg:
+		INC_DWORD_STAT(STAT_TencentCloudChat_ListenerEventsAdvancedMsg);
+		break;
+	case ETencentCloudChatListenerCategory::Group:
+		INC_DWORD_STAT(STAT_TencentCloudChat_ListenerEventsGroup);
+		break;
+	case ETencentCloudChatListenerCategory::Conversation:
+		INC_DWORD_STAT(STAT_TencentCloudChat_ListenerEventsConversation);
+		break;
+	case ETencentCloudChatListenerCategory::Friendship:
+		INC_DWORD_STAT(STAT_TencentCloudChat_ListenerEventsFriendship);
+		break;
+	case ETencentCloudChatListenerCategory::Signaling:
+		INC_DWORD_STAT(STAT_TencentCloudChat_ListenerEventsSignaling);
+		break;
+	default:
+		break;
+	}
+}
+
+void TencentCloudChatStats::RecordPayloadSent(int64 bytes)
+{
+	PayloadBytesSent += bytes;
+	INC_DWORD_STAT_BY(STAT_TencentCloudChat_PayloadBytesSent, bytes);
+}
+
+void TencentCloudChatStats::RecordPayloadReceived(int64 bytes)
+{
+	PayloadBytesReceived += bytes;
+	INC_DWORD_STAT_BY(STAT_TencentCloudChat_PayloadBytesReceived, bytes);
+}
+
+int32 TencentCloudChatStats::GetCallsInFlight()
+{
+	return FMath::Max(CallsInFlight.Load(), 0);
+}
+
+void TencentCloudChatStats::OnSDKInitialized()
+{
+#if TENCENTCLOUDCHAT_WITH_STATS
+	{
+		FScopeLock Lock(&PayloadListenerMutex);
+		if (bPayloadListenerAdded)
+		{
+			return;
+		}
+		bPayloadListenerAdded = true;
+	}
+	// 直接注册给 SDK，不经过 TencentCloudChat，不计入监听器事件
+	TencentCloudChatBackend::Get()->GetMessageManager()->AddAdvancedMsgListener(&PayloadListenerInstance);
+#endif
+}
+
+void TencentCloudChatStats::OnSDKUninitialized()
+{
+	{
+		FScopeLock Lock(&PayloadListenerMutex);
+		if (!bPayloadListenerAdded)
+		{
+			return;
+		}
+		bPayloadListenerAdded = false;
+	}
+	TencentCloudChatBackend::Get()->GetMessageManager()->RemoveAdvancedMsgListener(&PayloadListenerInstance);
+}
+
+void TencentCloudChatStats::Startup()
+{
+#if CSV_PROFILER
+	StatsTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float)
+	{
+		WriteCsvStats();
+		return true;
+	}));
+#endif
+}
+
+void TencentCloudChatStats::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(StatsTickHandle);
+	StatsTickHandle.Reset();
+	OnSDKUninitialized();
+}
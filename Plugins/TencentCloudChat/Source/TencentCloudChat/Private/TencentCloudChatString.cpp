@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatString.h"
+
+namespace
+{
+	// 每个线程一块 UTF-8 临时缓冲区，只增不减
+	TArray<UTF8CHAR> &GetScratch()
+	{
+		static thread_local TArray<UTF8CHAR> Scratch;
+		return Scratch;
+	}
+}
+
+FUtf8StringView TencentCloudChatString::ToScratchUtf8(FStringView str)
+{
+	if (str.IsEmpty())
+	{
+		return FUtf8StringView();
+	}
+
+	const int32 Utf8Len = FPlatformString::ConvertedLength<UTF8CHAR>(str.GetData(), str.Len());
+	TArray<UTF8CHAR> &Scratch = GetScratch();
+	if (Scratch.Num() < Utf8Len)
+	{
+		Scratch.SetNumUninitialized(FMath::RoundUpToPowerOfTwo(Utf8Len));
+	}
+	FPlatformString::Convert(Scratch.GetData(), Utf8Len, str.GetData(), str.Len());
+	return FUtf8StringView(Scratch.GetData(), Utf8Len);
+}
+
+V2TIMString TencentCloudChatString::ToV2TIM(FStringView str)
+{
+	return ToV2TIM(ToScratchUtf8(str));
+}
+
+V2TIMString TencentCloudChatString::ToV2TIM(FUtf8StringView str)
+{
+	if (str.IsEmpty())
+	{
+		return V2TIMString();
+	}
+	return V2TIMString(reinterpret_cast<const char *>(str.GetData()), str.Len());
+}
+
+FUtf8StringView TencentCloudChatString::ToUtf8View(const V2TIMString &str)
+{
+	return FUtf8StringView(reinterpret_cast<const UTF8CHAR *>(str.CString()), static_cast<int32>(str.Size()));
+}
+
+FString TencentCloudChatString::ToFString(const V2TIMString &str)
+{
+	FString Out;
+	ToFString(str, Out);
+	return Out;
+}
+
+void TencentCloudChatString::ToFString(const V2TIMString &str, FString &out)
+{
+	ToFString(ToUtf8View(str), out);
+}
+
+void TencentCloudChatString::ToFString(FUtf8StringView str, FString &out)
+{
+	if (str.IsEmpty())
+	{
+		out.Reset();
+		return;
+	}
+
+	const int32 DestLen = FPlatformString::ConvertedLength<TCHAR>(str.GetData(), str.Len());
+	TArray<TCHAR> &Chars = out.GetCharArray();
+	Chars.Reset(DestLen + 1);
+	Chars.AddUninitialized(DestLen + 1);
+	FPlatformString::Convert(Chars.GetData(), DestLen, str.GetData(), str.Len());
+	Chars[DestLen] = TEXT('\0');
+}
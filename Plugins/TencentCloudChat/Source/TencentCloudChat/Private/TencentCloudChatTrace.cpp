@@ -0,0 +1,170 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatTrace.h"
+#include "TencentCloudChatBackend.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatPrivate.h"
+#include "Misc/ScopeLock.h"
+
+#include "V2TIMListener.h"
+#include "V2TIMManager.h"
+#include "V2TIMMessageManager.h"
+
+UE_TRACE_CHANNEL_DEFINE(TencentCloudChatChannel);
+
+#if UE_TRACE_ENABLED
+UE_TRACE_EVENT_BEGIN(TencentCloudChat, MessageLifecycle)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint8, Stage)
+	UE_TRACE_EVENT_FIELD(int32, Value)
+	UE_TRACE_EVENT_FIELD(UE::Trace::AnsiString, MsgID)
+UE_TRACE_EVENT_END()
+#endif
+
+namespace
+{
+#if UE_TRACE_ENABLED
+	class TraceRecvListener : public V2TIMAdvancedMsgListener
+	{
+	public:
+		void OnRecvNewMessage(const V2TIMMessage &message) override
+		{
+			TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage::Received, message.msgID);
+		}
+	};
+	TraceRecvListener TraceRecvListenerInstance;
+	FCriticalSection TraceRecvListenerMutex;
+	bool bTraceRecvListenerAdded = false;
+#endif
+}
+
+bool TencentCloudChatTrace::IsEnabled()
+{
+	return UE_TRACE_CHANNELEXPR_IS_ENABLED(TencentCloudChatChannel);
+}
+
+void TencentCloudChatTrace::MessageStage(ETencentCloudChatMessageStage stage, const V2TIMString &msgID, int32 value)
+{
+#if UE_TRACE_ENABLED
+	UE_TRACE_LOG(TencentCloudChat, MessageLifecycle, TencentCloudChatChannel)
+		<< MessageLifecycle.Cycle(FPlatformTime::Cycles64())
+		<< MessageLifecycle.Stage(uint8(stage))
+		<< MessageLifecycle.Value(value)
+		<< MessageLifecycle.MsgID(msgID.CString(), int32(msgID.Size()));
+#endif
+}
+
+V2TIMSendCallback *TencentCloudChatTrace::TraceSend(const V2TIMString &msgID, V2TIMSendCallback *callback)
+{
+	if (!callback || !IsEnabled())
+	{
+		return callback;
+	}
+	return TencentCloudChatSendCallback::Create(
+		[callback](const V2TIMMessage &message)
+		{
+			MessageStage(ETencentCloudChatMessageStage::SendSucceeded, message.msgID);
+			callback->OnSuccess(message);
+		},
+		[callback, msgID](int error_code, const V2TIMString &error_message)
+		{
+			MessageStage(ETencentCloudChatMessageStage::SendFailed, msgID, error_code);
+			callback->OnError(error_code, error_message);
+		},
+		[callback, msgID](uint32_t progress)
+		{
+			MessageStage(ETencentCloudChatMessageStage::SendProgress, msgID, int32(progress));
+			callback->OnProgress(progress);
+		});
+}
+
+V2TIMSendCallback *TencentCloudChatTrace::TraceSend(TencentCloudChatTraceSendId &outMsgID, V2TIMSendCallback *callback)
+{
+	if (!callback || !IsEnabled())
+	{
+		return callback;
+	}
+	TSharedRef<TencentCloudChatTraceSendId::FState, ESPMode::ThreadSafe> State = MakeShared<TencentCloudChatTraceSendId::FState, ESPMode::ThreadSafe>();
+	outMsgID.State = State;
+	return TencentCloudChatSendCallback::Create(
+		[callback](const V2TIMMessage &message)
+		{
+			MessageStage(ETencentCloudChatMessageStage::SendSucceeded, message.msgID);
+			callback->OnSuccess(message);
+		},
+		[callback, State](int error_code, const V2TIMString &error_message)
+		{
+			State->Record(ETencentCloudChatMessageStage::SendFailed, error_code);
+			callback->OnError(error_code, error_message);
+		},
+		[callback, State](uint32_t progress)
+		{
+			State->Record(ETencentCloudChatMessageStage::SendProgress, int32(progress));
+			callback->OnProgress(progress);
+		});
+}
+
+void TencentCloudChatTraceSendId::FState::Record(ETencentCloudChatMessageStage stage, int32 value)
+{
+	FScopeLock Lock(&Mutex);
+	if (bSet)
+	{
+		TencentCloudChatTrace::MessageStage(stage, MsgID, value);
+	}
+	else
+	{
+		Pending.Add({ stage, value });
+	}
+}
+
+void TencentCloudChatTraceSendId::Set(const V2TIMString &msgID)
+{
+	if (!State)
+	{
+		return;
+	}
+	FScopeLock Lock(&State->Mutex);
+	State->MsgID = msgID;
+	State->bSet = true;
+	for (const TPair<ETencentCloudChatMessageStage, int32> &Each : State->Pending)
+	{
+		TencentCloudChatTrace::MessageStage(Each.Key, msgID, Each.Value);
+	}
+	State->Pending.Empty();
+}
+
+void TencentCloudChatTrace::OnSDKInitialized()
+{
+#if UE_TRACE_ENABLED
+	{
+		FScopeLock Lock(&TraceRecvListenerMutex);
+		if (bTraceRecvListenerAdded)
+		{
+			return;
+		}
+		bTraceRecvListenerAdded = true;
+	}
+	// 直接注册给 SDK，多个用户监听器时每条消息只记录一次
+	TencentCloudChatBackend::Get()->GetMessageManager()->AddAdvancedMsgListener(&TraceRecvListenerInstance);
+#endif
+}
+
+void TencentCloudChatTrace::OnSDKUninitialized()
+{
+#if UE_TRACE_ENABLED
+	{
+		FScopeLock Lock(&TraceRecvListenerMutex);
+		if (!bTraceRecvListenerAdded)
+		{
+			return;
+		}
+		bTraceRecvListenerAdded = false;
+	}
+	TencentCloudChatBackend::Get()->GetMessageManager()->RemoveAdvancedMsgListener(&TraceRecvListenerInstance);
+#endif
+}
+
+void TencentCloudChatTrace::Shutdown()
+{
+	OnSDKUninitialized();
+}
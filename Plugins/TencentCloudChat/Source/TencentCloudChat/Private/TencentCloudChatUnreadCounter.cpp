@@ -0,0 +1,278 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatUnreadCounter.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatConversationStore.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatString.h"
+#include "Containers/Ticker.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	struct UnreadFilterKey
+	{
+		int32 Type;
+		V2TIMString ConversationGroup;
+		uint64 MarkType;
+
+		explicit UnreadFilterKey(const V2TIMConversationListFilter &filter)
+			: Type(int32(filter.type))
+			, ConversationGroup(filter.conversationGroup)
+			, MarkType(filter.markType)
+		{
+		}
+
+		bool operator==(const UnreadFilterKey &other) const
+		{
+			return Type == other.Type && MarkType == other.MarkType && ConversationGroup == other.ConversationGroup;
+		}
+
+		friend uint32 GetTypeHash(const UnreadFilterKey &key)
+		{
+			return HashCombine(HashCombine(::GetTypeHash(key.Type), ::GetTypeHash(key.MarkType)), ::GetTypeHash(key.ConversationGroup));
+		}
+	};
+
+	bool IsCounted(const V2TIMConversation &conversation)
+	{
+		return conversation.recvOpt != V2TIM_NOT_RECEIVE_MESSAGE && conversation.recvOpt != V2TIM_RECEIVE_NOT_NOTIFY_MESSAGE;
+	}
+
+	bool MatchesFilter(const V2TIMConversation &conversation, const UnreadFilterKey &filter)
+	{
+		if (filter.Type != V2TIM_UNKNOWN && int32(conversation.type) != filter.Type)
+		{
+			return false;
+		}
+		if (filter.MarkType != 0)
+		{
+			bool bMarked = false;
+			for (size_t Index = 0; Index < conversation.markList.Size() && !bMarked; ++Index)
+			{
+				bMarked = conversation.markList[Index] == filter.MarkType;
+			}
+			if (!bMarked)
+			{
+				return false;
+			}
+		}
+		if (!filter.ConversationGroup.Empty())
+		{
+			bool bInGroup = false;
+			for (size_t Index = 0; Index < conversation.conversationGroupList.Size() && !bInGroup; ++Index)
+			{
+				bInGroup = conversation.conversationGroupList[Index] == filter.ConversationGroup;
+			}
+			if (!bInGroup)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FCriticalSection UnreadMutex;
+	// SDK 推送的值优先于本地计算的值
+	TOptional<uint64> PushedTotalUnread;
+	TMap<UnreadFilterKey, uint64> PushedFilterUnread;
+	TMap<UnreadFilterKey, uint64> ComputedFilterUnread;
+	TOptional<uint64> ComputedTotalUnread;
+	bool bUnreadListenerAdded = false;
+	bool bUnreadLoaded = false;
+	// Reset 前发出的 GetTotalUnreadMessageCount 通过代数丢弃
+	uint32 UnreadGeneration = 0;
+	FDelegateHandle UnreadStoreHandle;
+
+	TAtomic<bool> bUnreadDirty(false);
+	FTSTicker::FDelegateHandle UnreadTickHandle;
+	FTencentCloudChatUnreadChangedDelegate UnreadChanged;
+
+	void MarkUnreadDirty()
+	{
+		bUnreadDirty = true;
+	}
+
+	class UnreadListener : public V2TIMConversationListener
+	{
+	public:
+		void OnTotalUnreadMessageCountChanged(uint64_t totalUnreadCount) override
+		{
+			{
+				FScopeLock Lock(&UnreadMutex);
+				PushedTotalUnread = totalUnreadCount;
+			}
+			MarkUnreadDirty();
+		}
+		void OnUnreadMessageCountChangedByFilter(const V2TIMConversationListFilter &filter, uint64_t totalUnreadCount) override
+		{
+			{
+				FScopeLock Lock(&UnreadMutex);
+				PushedFilterUnread.Add(UnreadFilterKey(filter), totalUnreadCount);
+			}
+			MarkUnreadDirty();
+		}
+	};
+	UnreadListener UnreadListenerInstance;
+
+	/**
+	 * 在持有 UnreadMutex 时调用
+	 */
+	void ClearUnread()
+	{
+		PushedTotalUnread.Reset();
+		PushedFilterUnread.Reset();
+		ComputedFilterUnread.Reset();
+		ComputedTotalUnread.Reset();
+		bUnreadLoaded = false;
+		++UnreadGeneration;
+	}
+
+	void OnConversationsChanged()
+	{
+		{
+			FScopeLock Lock(&UnreadMutex);
+			ComputedFilterUnread.Reset();
+			ComputedTotalUnread.Reset();
+		}
+		MarkUnreadDirty();
+	}
+
+	/**
+	 * 在持有 UnreadMutex 时调用；会话列表的锁在其内部获取，两者的顺序在所有路径上一致
+	 */
+	uint64 ComputeUnread(const UnreadFilterKey *filter)
+	{
+		uint64 Total = 0;
+		TencentCloudChatConversationStore::ForEach([filter, &Total](const V2TIMConversation &Conversation)
+		{
+			if (Conversation.unreadCount > 0 && IsCounted(Conversation) && (!filter || MatchesFilter(Conversation, *filter)))
+			{
+				Total += uint64(Conversation.unreadCount);
+			}
+		});
+		return Total;
+	}
+}
+
+void TencentCloudChatUnreadCounter::Load()
+{
+	bool bAdd;
+	uint32 Generation;
+	{
+		FScopeLock Lock(&UnreadMutex);
+		if (bUnreadLoaded)
+		{
+			return;
+		}
+		bUnreadLoaded = true;
+		bAdd = !bUnreadListenerAdded;
+		bUnreadListenerAdded = true;
+		Generation = UnreadGeneration;
+		if (bAdd)
+		{
+			UnreadStoreHandle = TencentCloudChatConversationStore::OnChanged().AddStatic(&OnConversationsChanged);
+		}
+	}
+
+	if (bAdd)
+	{
+		TencentCloudChat::AddConversationListener(&UnreadListenerInstance);
+	}
+	TencentCloudChatConversationStore::Load();
+	TencentCloudChat::GetTotalUnreadMessageCount(TencentCloudChatValueCallback<uint64_t>::Create(
+		[Generation](const uint64_t &totalUnreadCount)
+		{
+			{
+				FScopeLock Lock(&UnreadMutex);
+				if (PushedTotalUnread.IsSet() || !bUnreadListenerAdded || Generation != UnreadGeneration)
+				{
+					return;
+				}
+				PushedTotalUnread = totalUnreadCount;
+			}
+			MarkUnreadDirty();
+		},
+		[](int error_code, const V2TIMString &error_message)
+		{
+			UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatUnreadCounter: GetTotalUnreadMessageCount failed (%d) %s"),
+				   error_code, *TencentCloudChatString::ToFString(error_message));
+		}));
+}
+
+uint64 TencentCloudChatUnreadCounter::GetTotalUnreadMessageCount()
+{
+	FScopeLock Lock(&UnreadMutex);
+	if (PushedTotalUnread.IsSet())
+	{
+		return PushedTotalUnread.GetValue();
+	}
+	if (!ComputedTotalUnread.IsSet())
+	{
+		ComputedTotalUnread = ComputeUnread(nullptr);
+	}
+	return ComputedTotalUnread.GetValue();
+}
+
+uint64 TencentCloudChatUnreadCounter::GetUnreadMessageCountByFilter(const V2TIMConversationListFilter &filter)
+{
+	const UnreadFilterKey Key(filter);
+	FScopeLock Lock(&UnreadMutex);
+	if (const uint64 *Pushed = PushedFilterUnread.Find(Key))
+	{
+		return *Pushed;
+	}
+	if (const uint64 *Computed = ComputedFilterUnread.Find(Key))
+	{
+		return *Computed;
+	}
+	return ComputedFilterUnread.Add(Key, ComputeUnread(&Key));
+}
+
+FTencentCloudChatUnreadChangedDelegate &TencentCloudChatUnreadCounter::OnChanged()
+{
+	return UnreadChanged;
+}
+
+void TencentCloudChatUnreadCounter::Reset()
+{
+	{
+		FScopeLock Lock(&UnreadMutex);
+		ClearUnread();
+	}
+	MarkUnreadDirty();
+}
+
+void TencentCloudChatUnreadCounter::Startup()
+{
+	UnreadTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float)
+	{
+		if (bUnreadDirty.Exchange(false))
+		{
+			UnreadChanged.Broadcast();
+		}
+		return true;
+	}));
+}
+
+void TencentCloudChatUnreadCounter::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(UnreadTickHandle);
+	UnreadTickHandle.Reset();
+
+	bool bRemove;
+	{
+		FScopeLock Lock(&UnreadMutex);
+		bRemove = bUnreadListenerAdded;
+		bUnreadListenerAdded = false;
+		ClearUnread();
+		TencentCloudChatConversationStore::OnChanged().Remove(UnreadStoreHandle);
+		UnreadStoreHandle.Reset();
+	}
+	if (bRemove)
+	{
+		TencentCloudChat::RemoveConversationListener(&UnreadListenerInstance);
+	}
+	bUnreadDirty = false;
+}
@@ -0,0 +1,290 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TencentCloudChatUserStatus.h"
+#include "TencentCloudChat.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatPrivate.h"
+#include "TencentCloudChatString.h"
+#include "Algo/Sort.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Status Subscriptions"), STAT_TencentCloudChat_StatusSubscriptions, STATGROUP_TencentCloudChat);
+
+static TAutoConsoleVariable<int32> CVarUserStatusMaxSubscriptions(
+	TEXT("TencentCloudChat.UserStatus.MaxSubscriptions"),
+	200,
+	TEXT("Maximum number of users TencentCloudChatUserStatus keeps subscribed; lower priority users are dropped first."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarUserStatusFlushIntervalMs(
+	TEXT("TencentCloudChat.UserStatus.FlushIntervalMs"),
+	200.0f,
+	TEXT("Interval at which TencentCloudChatUserStatus sends accumulated subscription changes to the SDK."),
+	ECVF_Default);
+
+namespace
+{
+	// 单次 SubscribeUserStatus / UnsubscribeUserStatus / GetUserStatus 的用户数
+	constexpr int32 StatusRequestChunk = 100;
+
+	struct StatusInterest
+	{
+		// 每个订阅的 priority，计数即元素个数
+		TArray<int32> Priorities;
+
+		int32 GetPriority() const
+		{
+			return FMath::Max(Priorities);
+		}
+	};
+
+	FCriticalSection StatusMutex;
+	TMap<V2TIMString, StatusInterest> StatusInterests;
+	TSet<V2TIMString> StatusSubscribed;
+	TMap<V2TIMString, V2TIMUserStatus> StatusTable;
+	bool bStatusDirty = false;
+	bool bStatusListenerAdded = false;
+	double StatusLastFlushTime = 0.0;
+	FTSTicker::FDelegateHandle StatusTickHandle;
+	FTencentCloudChatUserStatusDelegate StatusChanged;
+
+	class StatusListener : public V2TIMSDKListener
+	{
+	public:
+		void OnConnectSuccess() override
+		{
+			// 重连后按当前需要的用户全部重新订阅
+			{
+				FScopeLock Lock(&StatusMutex);
+				StatusSubscribed.Reset();
+				bStatusDirty = true;
+			}
+		}
+
+		void OnUserStatusChanged(const V2TIMUserStatusVector &userStatusList) override
+		{
+			TArray<V2TIMUserStatus> Changed;
+			{
+				FScopeLock Lock(&StatusMutex);
+				for (size_t Index = 0; Index < userStatusList.Size(); ++Index)
+				{
+					const V2TIMUserStatus &Status = userStatusList[Index];
+					if (StatusInterests.Contains(Status.userID))
+					{
+						StatusTable.Add(Status.userID, Status);
+						Changed.Add(Status);
+					}
+				}
+			}
+			for (const V2TIMUserStatus &Status : Changed)
+			{
+				StatusChanged.Broadcast(Status);
+			}
+		}
+	};
+	StatusListener StatusListenerInstance;
+
+	template <class SendFunc>
+	void SendInChunks(const TArray<V2TIMString> &userIDs, SendFunc &&send)
+	{
+		for (int32 Start = 0; Start < userIDs.Num(); Start += StatusRequestChunk)
+		{
+			V2TIMStringVector Chunk;
+			for (int32 Index = Start; Index < FMath::Min(Start + StatusRequestChunk, userIDs.Num()); ++Index)
+			{
+				Chunk.PushBack(userIDs[Index]);
+			}
+			send(Chunk);
+		}
+	}
+
+	void LogStatusError(const TCHAR *api, int errorCode, const V2TIMString &errorMessage)
+	{
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatUserStatus: %s failed (%d) %s"),
+			   api, errorCode, *TencentCloudChatString::ToFString(errorMessage));
+	}
+}
+
+void TencentCloudChatUserStatus::Subscribe(const V2TIMString &userID, int32 priority)
+{
+	bool bAddListener;
+	{
+		FScopeLock Lock(&StatusMutex);
+		StatusInterests.FindOrAdd(userID).Priorities.Add(priority);
+		bStatusDirty = true;
+		bAddListener = !bStatusListenerAdded;
+		bStatusListenerAdded = true;
+	}
+	if (bAddListener)
+	{
+		TencentCloudChat::AddSDKListener(&StatusListenerInstance);
+	}
+}
+
+void TencentCloudChatUserStatus::Unsubscribe(const V2TIMString &userID, int32 priority)
+{
+	FScopeLock Lock(&StatusMutex);
+	StatusInterest *Interest = StatusInterests.Find(userID);
+	if (!Interest || Interest->Priorities.RemoveSingleSwap(priority) == 0)
+	{
+		UE_LOG(LogTencentCloudChat, Warning, TEXT("TencentCloudChatUserStatus: Unsubscribe without matching Subscribe (%s, %d)"),
+			   *TencentCloudChatString::ToFString(userID), priority);
+		return;
+	}
+	if (Interest->Priorities.Num() == 0)
+	{
+		StatusInterests.Remove(userID);
+		StatusTable.Remove(userID);
+	}
+	bStatusDirty = true;
+}
+
+bool TencentCloudChatUserStatus::GetStatus(const V2TIMString &userID, V2TIMUserStatus &outStatus)
+{
+	FScopeLock Lock(&StatusMutex);
+	if (const V2TIMUserStatus *Status = StatusTable.Find(userID))
+	{
+		outStatus = *Status;
+		return true;
+	}
+	return false;
+}
+
+void TencentCloudChatUserStatus::Flush()
+{
+	TArray<V2TIMString> ToSubscribe;
+	TArray<V2TIMString> ToUnsubscribe;
+	{
+		FScopeLock Lock(&StatusMutex);
+		StatusLastFlushTime = FPlatformTime::Seconds();
+		if (!bStatusDirty)
+		{
+			return;
+		}
+		bStatusDirty = false;
+
+		// 超过上限时按 priority 从高到低取前 MaxSubscriptions 个
+		TArray<TPair<int32, const V2TIMString *>> Wanted;
+		Wanted.Reserve(StatusInterests.Num());
+		for (const TPair<V2TIMString, StatusInterest> &Pair : StatusInterests)
+		{
+			Wanted.Add({ Pair.Value.GetPriority(), &Pair.Key });
+		}
+		const int32 MaxSubscriptions = FMath::Max(CVarUserStatusMaxSubscriptions.GetValueOnAnyThread(), 0);
+		if (Wanted.Num() > MaxSubscriptions)
+		{
+			Algo::Sort(Wanted, [](const TPair<int32, const V2TIMString *> &A, const TPair<int32, const V2TIMString *> &B) { return A.Key > B.Key; });
+			Wanted.SetNum(MaxSubscriptions);
+		}
+
+		TSet<V2TIMString> Desired;
+		Desired.Reserve(Wanted.Num());
+		for (const TPair<int32, const V2TIMString *> &Each : Wanted)
+		{
+			Desired.Add(*Each.Value);
+			if (!StatusSubscribed.Contains(*Each.Value))
+			{
+				ToSubscribe.Add(*Each.Value);
+			}
+		}
+		for (const V2TIMString &UserID : StatusSubscribed)
+		{
+			if (!Desired.Contains(UserID))
+			{
+				// 被上限挤出的用户不会再收到更新，不保留已经过时的状态
+				ToUnsubscribe.Add(UserID);
+				StatusTable.Remove(UserID);
+			}
+		}
+		StatusSubscribed = MoveTemp(Desired);
+		SET_DWORD_STAT(STAT_TencentCloudChat_StatusSubscriptions, StatusSubscribed.Num());
+	}
+
+	// 先取消订阅，避免新订阅的用户把仍然需要的用户挤出后台的订阅列表
+	SendInChunks(ToUnsubscribe, [](const V2TIMStringVector &Chunk)
+	{
+		TencentCloudChat::UnsubscribeUserStatus(Chunk, TencentCloudChatCallback::Create(nullptr,
+			[](int error_code, const V2TIMString &error_message)
+			{
+				LogStatusError(TEXT("UnsubscribeUserStatus"), error_code, error_message);
+			}));
+	});
+	SendInChunks(ToSubscribe, [](const V2TIMStringVector &Chunk)
+	{
+		TencentCloudChat::SubscribeUserStatus(Chunk, TencentCloudChatCallback::Create(nullptr,
+			[](int error_code, const V2TIMString &error_message)
+			{
+				LogStatusError(TEXT("SubscribeUserStatus"), error_code, error_message);
+			}));
+
+		// 新订阅的用户查询一次当前状态，之后由 OnUserStatusChanged 更新
+		TencentCloudChat::GetUserStatus(Chunk, TencentCloudChatValueCallback<V2TIMUserStatusVector>::Create(
+			[](const V2TIMUserStatusVector &userStatusList)
+			{
+				StatusListenerInstance.OnUserStatusChanged(userStatusList);
+			},
+			[](int error_code, const V2TIMString &error_message)
+			{
+				LogStatusError(TEXT("GetUserStatus"), error_code, error_message);
+			}));
+	});
+}
+
+int32 TencentCloudChatUserStatus::GetSubscribedNum()
+{
+	FScopeLock Lock(&StatusMutex);
+	return StatusSubscribed.Num();
+}
+
+FTencentCloudChatUserStatusDelegate &TencentCloudChatUserStatus::OnStatusChanged()
+{
+	return StatusChanged;
+}
+
+void TencentCloudChatUserStatus::Reset()
+{
+	FScopeLock Lock(&StatusMutex);
+	StatusInterests.Empty();
+	StatusSubscribed.Empty();
+	StatusTable.Empty();
+	bStatusDirty = false;
+	SET_DWORD_STAT(STAT_TencentCloudChat_StatusSubscriptions, 0);
+}
+
+void TencentCloudChatUserStatus::Startup()
+{
+	StatusTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float)
+	{
+		const double Interval = FMath::Max(CVarUserStatusFlushIntervalMs.GetValueOnGameThread(), 0.0f) / 1000.0;
+		bool bDue;
+		{
+			FScopeLock Lock(&StatusMutex);
+			bDue = bStatusDirty && FPlatformTime::Seconds() - StatusLastFlushTime >= Interval;
+		}
+		if (bDue)
+		{
+			Flush();
+		}
+		return true;
+	}));
+}
+
+void TencentCloudChatUserStatus::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(StatusTickHandle);
+	StatusTickHandle.Reset();
+
+	bool bRemoveListener;
+	{
+		FScopeLock Lock(&StatusMutex);
+		bRemoveListener = bStatusListenerAdded;
+		bStatusListenerAdded = false;
+	}
+	Reset();
+	if (bRemoveListener)
+	{
+		TencentCloudChat::RemoveSDKListener(&StatusListenerInstance);
+	}
+}
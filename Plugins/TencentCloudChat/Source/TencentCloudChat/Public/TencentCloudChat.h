@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "Async/Future.h"
+#include "Delegates/Delegate.h"
 
 #include "V2TIMBuffer.h"
 #include "V2TIMCallback.h"
@@ -23,7 +25,23 @@
 #include "V2TIMString.h"
 #include "V2TIMOfflinePushManager.h"
 
-
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatDispatcher.h"
+#include "TencentCloudChatString.h"
+
+/**
+ * InitSDKAsync 完成回调，在游戏线程执行
+ *
+ * @param bSuccess true：成功；false：失败
+ */
+DECLARE_DELEGATE_OneParam(FTencentCloudChatInitSDKDelegate, bool /* bSuccess */);
+
+/**
+ * TencentCloudChat 静态接口
+ *
+ * 默认情况下回调和监听事件在 SDK 内部线程触发；打开 TencentCloudChat.Dispatch.GameThread 后，
+ * 通过本类传入的回调和监听器会经由 TencentCloudChatDispatcher 统一分发到游戏线程。
+ */
 class TencentCloudChat : public IModuleInterface
 {
 private:
@@ -42,12 +60,32 @@ public:
 	/**
      * 1.4 初始化 SDK
      *
+     * @note 该接口会阻塞调用线程直到初始化完成，在游戏线程上请使用 InitSDKAsync。
+     *
      * @param sdkAppID 应用 ID，必填项，可以在[控制台](https://console.cloud.tencent.com/im)中获取
      * @param config   配置信息
      * @return true：成功；false：失败
      */
     static bool InitSDK(uint32_t sdkAppID, const V2TIMSDKConfig &config);
 	/**
+     * 1.4 异步初始化 SDK
+     *
+     * 初始化在后台线程执行，不阻塞调用线程，适合在 BeginPlay 等游戏线程入口中调用。
+     * 初始化耗时记录在 stat TencentCloudChat 的 InitSDK Time (ms) 中。
+     *
+     * @param sdkAppID 应用 ID，必填项，可以在[控制台](https://console.cloud.tencent.com/im)中获取
+     * @param config   配置信息
+     * @return 初始化结果，true：成功；false：失败
+     */
+    static TFuture<bool> InitSDKAsync(uint32_t sdkAppID, const V2TIMSDKConfig &config);
+	/**
+     * 1.4 异步初始化 SDK
+     *
+     * @param onComplete 初始化完成后在游戏线程回调
+     */
+    static void InitSDKAsync(uint32_t sdkAppID, const V2TIMSDKConfig &config,
+                              FTencentCloudChatInitSDKDelegate onComplete);
+	/**
      * 1.5 反初始化 SDK
      *
      */
@@ -1735,4 +1773,59 @@ public:
      */
     static void ModifyInvitation(const V2TIMString& inviteID, const V2TIMString& data,
                                   V2TIMCallback* callback);
+
+    /////////////////////////////////////////////////////////////////////////////////
+    //
+    //                         FString 重载
+    //
+    /////////////////////////////////////////////////////////////////////////////////
+
+    /**
+     * 以下接口与同名的 V2TIMString 版本行为一致，字符串参数可以直接传 FString、FStringView 或 TEXT("")。
+     *
+     * 字符串经 TencentCloudChatString 的线程局部缓冲区转为 UTF-8，不再需要 TCHAR_TO_UTF8 临时对象。
+     * 已经是 UTF-8 的字符串请用 TencentCloudChatString::ToV2TIM(FUtf8StringView) 转换后调用 V2TIMString 版本。
+     */
+    static void Login(FStringView userID, FStringView userSig, V2TIMCallback *callback);
+
+    static V2TIMString SendC2CTextMessage(FStringView text, FStringView userID,
+                                           V2TIMSendCallback *callback);
+
+    static V2TIMString SendC2CCustomMessage(const V2TIMBuffer &customData, FStringView userID,
+                                             V2TIMSendCallback *callback);
+
+    static V2TIMString SendGroupTextMessage(FStringView text, FStringView groupID,
+                                             V2TIMMessagePriority priority,
+                                             V2TIMSendCallback *callback);
+
+    static V2TIMString SendGroupCustomMessage(const V2TIMBuffer &customData, FStringView groupID,
+                                               V2TIMMessagePriority priority,
+                                               V2TIMSendCallback *callback);
+
+    static void JoinGroup(FStringView groupID, FStringView message, V2TIMCallback *callback);
+
+    static void QuitGroup(FStringView groupID, V2TIMCallback *callback);
+
+    static V2TIMMessage CreateTextMessage(FStringView text);
+
+    static V2TIMString SendMessage(V2TIMMessage &message, FStringView receiver,
+                                    FStringView groupID, V2TIMMessagePriority priority,
+                                    bool onlineUserOnly,
+                                    const V2TIMOfflinePushInfo &offlinePushInfo,
+                                    V2TIMSendCallback *callback);
+
+    static void MarkC2CMessageAsRead(FStringView userID, V2TIMCallback *callback);
+
+    static void MarkGroupMessageAsRead(FStringView groupID, V2TIMCallback *callback);
+
+    /**
+     * 以下接口的 ID 列表可以直接传 TArray<FString>，经 TencentCloudChatVector 批量转换为 V2TIMStringVector。
+     */
+    static void GetUsersInfo(TConstArrayView<FString> userIDList,
+                              V2TIMValueCallback<V2TIMUserFullInfoVector> *callback);
+
+    static void SubscribeUserStatus(TConstArrayView<FString> userIDList, V2TIMCallback *callback);
+
+    static void KickGroupMember(FStringView groupID, TConstArrayView<FString> memberList, FStringView reason,
+                                V2TIMValueCallback<V2TIMGroupMemberOperationResultVector> *callback);
 };
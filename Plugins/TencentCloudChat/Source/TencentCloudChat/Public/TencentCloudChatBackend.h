@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "V2TIMManager.h"
+
+/**
+ * TencentCloudChat 使用的 V2TIMManager 实现
+ *
+ * 插件内部所有对 SDK 的调用都经过 Get()，默认是 SDK 的 V2TIMManager::GetInstance()。
+ * 设置为其他实现（例如 TencentCloudChatLoopback 的进程内回环后端）后，TencentCloudChat 的接口、
+ * 监听器和插件内部的各个模块都改为使用这个实现。
+ *
+ * 另可用 TencentCloudChatBackendScope 只在当前线程内改用某个实现，优先于 Set，例如负载测试中由同一个线程
+ * 轮流以多个模拟用户的身份调用 TencentCloudChat。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatBackend
+{
+public:
+	static V2TIMManager *Get();
+
+	/**
+	 * 在 InitSDK 和添加监听器之前调用，nullptr 恢复使用 SDK；不负责 manager 的生命周期
+	 */
+	static void Set(V2TIMManager *manager);
+
+	/**
+	 * 当前是否使用了 SDK 以外的实现
+	 */
+	static bool IsOverridden();
+
+	/**
+	 * 当前线程是否在 TencentCloudChatBackendScope 中；此时调用来自负载测试等模拟用户，
+	 * 插件内部按当前账号维护的缓存（历史消息、会话、资料等）不受这些调用影响
+	 */
+	static bool HasThreadOverride();
+
+	/**
+	 * 设置当前线程使用的实现，返回之前的值，nullptr 表示跟随 Set；由 TencentCloudChatBackendScope 使用
+	 */
+	static V2TIMManager *ExchangeThreadOverride(V2TIMManager *manager);
+};
+
+/**
+ * 在作用域内让当前线程的 TencentCloudChat 调用使用 manager
+ *
+ * 只影响当前线程上的同步调用：SDK 回调线程、InitSDKAsync 的后台线程等其他线程上的调用仍使用 Set 设置的实现。
+ */
+class TencentCloudChatBackendScope
+{
+public:
+	explicit TencentCloudChatBackendScope(V2TIMManager *manager)
+		: Previous(TencentCloudChatBackend::ExchangeThreadOverride(manager))
+	{
+	}
+
+	~TencentCloudChatBackendScope()
+	{
+		TencentCloudChatBackend::ExchangeThreadOverride(Previous);
+	}
+
+private:
+	V2TIMManager *Previous;
+};
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+
+#include "V2TIMBuffer.h"
+#include "V2TIMCallback.h"
+#include "V2TIMListener.h"
+#include "V2TIMMessage.h"
+#include "V2TIMString.h"
+
+/**
+ * 群自定义消息的合并发送
+ *
+ * 点赞、表情、光标位置这类高频的小消息如果逐条调用 SendGroupCustomMessage，每条都是一次完整的 SDK 请求，
+ * 并且都计入群消息的频率限制。通过 TencentCloudChatBatcher::SendGroupCustomMessage 发送时，同一个群的消息
+ * 先在本地缓存，满足以下任一条件时合并成一条自定义消息发出：
+ *  - 第一条消息缓存的时间超过 TencentCloudChat.Batch.WindowMs；
+ *  - 再加入一条会超过 TencentCloudChat.Batch.MaxBytes（不超过单条消息 12KB 的上限）；
+ *  - 新消息的优先级与已缓存的不同；
+ *  - 调用 Flush / FlushAll。
+ *
+ * 只缓存了一条消息时按原样发送，不加帧头，未使用合并功能的接收方不受影响。
+ * 打开 TencentCloudChat.Compression.Batches 后，合并后的消息再按 TencentCloudChatCompression 的规则压缩。
+ *
+ * 接收方通过 TencentCloudChatBatcher::AddAdvancedMsgListener 注册监听器，压缩过的消息先解压，合并消息会被拆回多条，
+ * 逐条回调 OnRecvNewMessage；也可以自行调用 Unbatch 拆分。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatBatcher
+{
+public:
+	/**
+	 * 单条消息的大小上限（TencentCloudChat::SendGroupCustomMessage 最大支持 12KB）
+	 */
+	static constexpr int32 MaxMessageBytes = 12 * 1024;
+
+	/**
+	 * 缓存一条群自定义消息，稍后与同一个群的其他消息合并发送，可在任意线程调用
+	 *
+	 * 单条消息本身超过大小上限时，先发出该群已缓存的消息，再单独发送这一条。
+	 *
+	 * @param callback 合并消息发送完成后，每条消息各自的 callback 都会收到同一个结果；OnSuccess 中的 message 为合并后的消息
+	 */
+	static void SendGroupCustomMessage(const V2TIMBuffer &customData, const V2TIMString &groupID,
+									   V2TIMMessagePriority priority, V2TIMSendCallback *callback);
+
+	/**
+	 * 立即发出指定群已缓存的消息
+	 */
+	static void Flush(const V2TIMString &groupID);
+
+	/**
+	 * 立即发出所有群已缓存的消息
+	 */
+	static void FlushAll();
+
+	/**
+	 * 判断 customData 是否为合并消息的帧格式，成功时 outPayloads 中依次是每条消息的内容，指向 data 内部
+	 */
+	static bool DecodeFrame(TConstArrayView<uint8> data, TArray<TConstArrayView<uint8>> &outPayloads);
+
+	/**
+	 * 把收到的合并消息拆成多条自定义消息
+	 *
+	 * 拆出的消息保留原消息的发送者、群、时间、序列号等信息，msgID 为 "原 msgID#序号"。
+	 *
+	 * @return message 不是合并消息时返回 false，outMessages 不变
+	 */
+	static bool Unbatch(const V2TIMMessage &message, TArray<V2TIMMessage> &outMessages);
+
+	/**
+	 * 注册 / 注销会自动拆分合并消息的高级消息监听器，其余事件原样转发
+	 */
+	static void AddAdvancedMsgListener(V2TIMAdvancedMsgListener *listener);
+	static void RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *listener);
+
+	/**
+	 * 由模块在启动和关闭时调用，注册或注销按时间窗口发送的 Ticker；关闭时发出所有缓存的消息
+	 */
+	static void Startup();
+	static void Shutdown();
+};
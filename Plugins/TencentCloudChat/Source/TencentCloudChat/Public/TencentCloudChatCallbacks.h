@@ -0,0 +1,317 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LockFreeList.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+
+#include "V2TIMCallback.h"
+
+/**
+ * 每种回调适配器预先分配的对象数，可在工程的 Build.cs 中通过 PublicDefinitions 覆盖
+ */
+#ifndef TENCENTCLOUDCHAT_CALLBACK_POOL_SIZE
+#define TENCENTCLOUDCHAT_CALLBACK_POOL_SIZE 128
+#endif
+
+/**
+ * 回调对象池的统计信息
+ *
+ * Hits：从池中取到对象的次数；Misses：池已用完、退化为堆分配的次数。
+ */
+struct TencentCloudChatCallbackPoolStats
+{
+	int32 Capacity = 0;
+	uint64 Hits = 0;
+	uint64 Misses = 0;
+};
+
+/**
+ * 所有回调对象池的汇总统计，同时会写入 stat TencentCloudChat
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatCallbackPools
+{
+public:
+	static TencentCloudChatCallbackPoolStats GetTotalStats();
+
+	static void RecordCapacity(int32 capacity);
+	static void RecordHit();
+	static void RecordMiss();
+};
+
+/**
+ * 固定大小的回调对象池
+ *
+ * 对象在第一次使用时一次性分配，之后通过无锁链表复用；池用完时退化为堆分配，回收时直接释放。
+ * Acquire 和 Release 可以在任意线程调用（通常 Acquire 在游戏线程，Release 在 SDK 线程）。
+ */
+template <class AdapterType, int32 Capacity = TENCENTCLOUDCHAT_CALLBACK_POOL_SIZE>
+class TencentCloudChatCallbackPool
+{
+public:
+	static AdapterType *Acquire()
+	{
+		Storage &Pool = Get();
+		if (AdapterType *Adapter = Pool.FreeList.Pop())
+		{
+			++Pool.Hits;
+			TencentCloudChatCallbackPools::RecordHit();
+			return Adapter;
+		}
+		++Pool.Misses;
+		TencentCloudChatCallbackPools::RecordMiss();
+		return new AdapterType();
+	}
+
+	static void Release(AdapterType *adapter)
+	{
+		Storage &Pool = Get();
+		if (adapter >= Pool.Slots.Get() && adapter < Pool.Slots.Get() + Capacity)
+		{
+			Pool.FreeList.Push(adapter);
+		}
+		else
+		{
+			delete adapter;
+		}
+	}
+
+	static TencentCloudChatCallbackPoolStats GetStats()
+	{
+		Storage &Pool = Get();
+		TencentCloudChatCallbackPoolStats Stats;
+		Stats.Capacity = Capacity;
+		Stats.Hits = Pool.Hits.Load();
+		Stats.Misses = Pool.Misses.Load();
+		return Stats;
+	}
+
+private:
+	struct Storage
+	{
+		Storage()
+			: Slots(MakeUnique<AdapterType[]>(Capacity))
+		{
+			for (int32 Index = Capacity - 1; Index >= 0; --Index)
+			{
+				FreeList.Push(&Slots[Index]);
+			}
+			TencentCloudChatCallbackPools::RecordCapacity(Capacity);
+		}
+
+		TUniquePtr<AdapterType[]> Slots;
+		TLockFreePointerListLIFO<AdapterType> FreeList;
+		TAtomic<uint64> Hits{0};
+		TAtomic<uint64> Misses{0};
+	};
+
+	static Storage &Get()
+	{
+		static Storage Pool;
+		return Pool;
+	}
+};
+
+/**
+ * V2TIMCallback 的 lambda 适配器
+ *
+ * 对象从池中分配，OnSuccess/OnError 执行完后自动回到池中，调用方不需要也不能 delete。
+ *
+ * 示例：
+ * TencentCloudChat::Login(userID, userSig, TencentCloudChatCallback::Create(
+ *     []() { UE_LOG(LogTemp, Log, TEXT("login ok")); },
+ *     [](int code, const V2TIMString &desc) { UE_LOG(LogTemp, Log, TEXT("login failed %d"), code); }));
+ */
+class TencentCloudChatCallback : public V2TIMCallback
+{
+public:
+	using Pool = TencentCloudChatCallbackPool<TencentCloudChatCallback>;
+	using SuccessFunc = TUniqueFunction<void()>;
+	using ErrorFunc = TUniqueFunction<void(int, const V2TIMString &)>;
+
+	static TencentCloudChatCallback *Create(SuccessFunc &&onSuccess, ErrorFunc &&onError = nullptr)
+	{
+		TencentCloudChatCallback *Adapter = Pool::Acquire();
+		Adapter->Success = MoveTemp(onSuccess);
+		Adapter->Error = MoveTemp(onError);
+		return Adapter;
+	}
+
+	static TencentCloudChatCallbackPoolStats GetPoolStats() { return Pool::GetStats(); }
+
+	void OnSuccess() override
+	{
+		if (Success)
+		{
+			Success();
+		}
+		Recycle();
+	}
+	void OnError(int error_code, const V2TIMString &error_message) override
+	{
+		if (Error)
+		{
+			Error(error_code, error_message);
+		}
+		Recycle();
+	}
+
+private:
+	void Recycle()
+	{
+		Success = nullptr;
+		Error = nullptr;
+		Pool::Release(this);
+	}
+
+	SuccessFunc Success;
+	ErrorFunc Error;
+};
+
+/**
+ * V2TIMValueCallback<T> 的 lambda 适配器，回收规则同 TencentCloudChatCallback
+ */
+template <class T>
+class TencentCloudChatValueCallback : public V2TIMValueCallback<T>
+{
+public:
+	using Pool = TencentCloudChatCallbackPool<TencentCloudChatValueCallback<T>>;
+	using SuccessFunc = TUniqueFunction<void(const T &)>;
+	using ErrorFunc = TUniqueFunction<void(int, const V2TIMString &)>;
+
+	static TencentCloudChatValueCallback *Create(SuccessFunc &&onSuccess, ErrorFunc &&onError = nullptr)
+	{
+		TencentCloudChatValueCallback *Adapter = Pool::Acquire();
+		Adapter->Success = MoveTemp(onSuccess);
+		Adapter->Error = MoveTemp(onError);
+		return Adapter;
+	}
+
+	static TencentCloudChatCallbackPoolStats GetPoolStats() { return Pool::GetStats(); }
+
+	void OnSuccess(const T &value) override
+	{
+		if (Success)
+		{
+			Success(value);
+		}
+		Recycle();
+	}
+	void OnError(int error_code, const V2TIMString &error_message) override
+	{
+		if (Error)
+		{
+			Error(error_code, error_message);
+		}
+		Recycle();
+	}
+
+private:
+	void Recycle()
+	{
+		Success = nullptr;
+		Error = nullptr;
+		Pool::Release(this);
+	}
+
+	SuccessFunc Success;
+	ErrorFunc Error;
+};
+
+/**
+ * V2TIMSendCallback 的 lambda 适配器
+ *
+ * OnProgress 可能被调用多次，对象在 OnSuccess/OnError 之后才回到池中。
+ */
+class TencentCloudChatSendCallback : public V2TIMSendCallback
+{
+public:
+	using Pool = TencentCloudChatCallbackPool<TencentCloudChatSendCallback>;
+	using SuccessFunc = TUniqueFunction<void(const V2TIMMessage &)>;
+	using ErrorFunc = TUniqueFunction<void(int, const V2TIMString &)>;
+	using ProgressFunc = TUniqueFunction<void(uint32_t)>;
+
+	static TencentCloudChatSendCallback *Create(SuccessFunc &&onSuccess, ErrorFunc &&onError = nullptr,
+												ProgressFunc &&onProgress = nullptr)
+	{
+		TencentCloudChatSendCallback *Adapter = Pool::Acquire();
+		Adapter->Success = MoveTemp(onSuccess);
+		Adapter->Error = MoveTemp(onError);
+		Adapter->Progress = MoveTemp(onProgress);
+		return Adapter;
+	}
+
+	static TencentCloudChatCallbackPoolStats GetPoolStats() { return Pool::GetStats(); }
+
+	void OnSuccess(const V2TIMMessage &message) override
+	{
+		if (Success)
+		{
+			Success(message);
+		}
+		Recycle();
+	}
+	void OnError(int error_code, const V2TIMString &error_message) override
+	{
+		if (Error)
+		{
+			Error(error_code, error_message);
+		}
+		Recycle();
+	}
+	void OnProgress(uint32_t progress) override
+	{
+		if (Progress)
+		{
+			Progress(progress);
+		}
+	}
+
+private:
+	void Recycle()
+	{
+		Success = nullptr;
+		Error = nullptr;
+		Progress = nullptr;
+		Pool::Release(this);
+	}
+
+	SuccessFunc Success;
+	ErrorFunc Error;
+	ProgressFunc Progress;
+};
+
+/**
+ * V2TIMCompleteCallback<T> 的 lambda 适配器，OnComplete 之后回到池中
+ */
+template <class T>
+class TencentCloudChatCompleteCallback : public V2TIMCompleteCallback<T>
+{
+public:
+	using Pool = TencentCloudChatCallbackPool<TencentCloudChatCompleteCallback<T>>;
+	using CompleteFunc = TUniqueFunction<void(int, const V2TIMString &, const T &)>;
+
+	static TencentCloudChatCompleteCallback *Create(CompleteFunc &&onComplete)
+	{
+		TencentCloudChatCompleteCallback *Adapter = Pool::Acquire();
+		Adapter->Complete = MoveTemp(onComplete);
+		return Adapter;
+	}
+
+	static TencentCloudChatCallbackPoolStats GetPoolStats() { return Pool::GetStats(); }
+
+	void OnComplete(int error_code, const V2TIMString &error_message, const T &value) override
+	{
+		if (Complete)
+		{
+			Complete(error_code, error_message, value);
+		}
+		Complete = nullptr;
+		Pool::Release(this);
+	}
+
+private:
+	CompleteFunc Complete;
+};
@@ -0,0 +1,285 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Containers/StringView.h"
+
+#include "V2TIMBuffer.h"
+
+/**
+ * 自定义消息（CreateCustomMessage、SendC2CCustomMessage、cloudCustomData 等）的二进制编码
+ *
+ * 编码格式：
+ *   | 0xC7 | schema id (varint) | schema 版本 (varint) | 字段 | 字段 | ...
+ * 每个字段为 | (字段 id << 3 | 线类型) (varint) | 值 |，线类型：
+ *   0 varint（Bool、UInt，Int 先做 zigzag）
+ *   1 4 字节小端（Float）
+ *   2 8 字节小端（Double）
+ *   3 长度 (varint) + 内容（String 为 UTF-8，Bytes 原样）
+ *   4 长度 (varint) + 增量 zigzag varint 序列（IntArray，适合时间戳、坐标等相邻差值小的数列）
+ *
+ * 解码时不认识的字段按线类型跳过，缺少的字段返回 false，因此新旧版本的 schema 可以互相读取，
+ * 只要不复用已删除字段的 id、不改变已有字段的类型。
+ * schema id 同时作为消息类型的标识，接收方可以据此分发（见 PeekHeader）。
+ */
+enum class ETencentCloudChatCodecType : uint8
+{
+	Bool,
+	Int,
+	UInt,
+	Float,
+	Double,
+	String,
+	Bytes,
+	IntArray,
+};
+
+/**
+ * 一种自定义消息的字段定义
+ *
+ *   static const TencentCloudChatCodecSchema GiftSchema = TencentCloudChatCodecSchema(1, 2)
+ *       .Field(1, TEXT("GiftId"), ETencentCloudChatCodecType::UInt)
+ *       .Field(2, TEXT("Count"), ETencentCloudChatCodecType::UInt)
+ *       .Field(3, TEXT("Message"), ETencentCloudChatCodecType::String);
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatCodecSchema
+{
+public:
+	struct FieldDef
+	{
+		uint32 Id = 0;
+		const TCHAR *Name = nullptr;
+		ETencentCloudChatCodecType Type = ETencentCloudChatCodecType::UInt;
+	};
+
+	TencentCloudChatCodecSchema(uint32 id, uint32 version)
+		: Id(id), Version(version)
+	{
+	}
+
+	/**
+	 * 追加一个字段，id 从 1 开始且不能重复
+	 */
+	TencentCloudChatCodecSchema &&Field(uint32 id, const TCHAR *name, ETencentCloudChatCodecType type) &&;
+	TencentCloudChatCodecSchema &Field(uint32 id, const TCHAR *name, ETencentCloudChatCodecType type) &;
+
+	const FieldDef *FindField(uint32 id) const;
+
+	uint32 GetId() const { return Id; }
+	uint32 GetVersion() const { return Version; }
+	TConstArrayView<FieldDef> GetFields() const { return Fields; }
+
+private:
+	uint32 Id;
+	uint32 Version;
+	TArray<FieldDef> Fields;
+};
+
+/**
+ * 按 schema 编码
+ *
+ * 写入的字段必须在 schema 中声明且类型一致（check），字段可以按任意顺序写、可以省略。
+ * Reset 后可以复用内部缓冲区，连续编码时不再分配内存。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatCodecWriter
+{
+public:
+	explicit TencentCloudChatCodecWriter(const TencentCloudChatCodecSchema &schema);
+
+	/**
+	 * 清空已写入的内容，重新写入消息头
+	 */
+	void Reset();
+
+	void WriteBool(uint32 field, bool value);
+	void WriteInt(uint32 field, int64 value);
+	void WriteUInt(uint32 field, uint64 value);
+	void WriteFloat(uint32 field, float value);
+	void WriteDouble(uint32 field, double value);
+	void WriteString(uint32 field, FStringView value);
+	void WriteString(uint32 field, FUtf8StringView value);
+	void WriteBytes(uint32 field, TConstArrayView<uint8> value);
+	void WriteIntArray(uint32 field, TConstArrayView<int64> values);
+
+	TConstArrayView<uint8> GetData() const { return Data; }
+
+	/**
+	 * 拷贝为 V2TIMBuffer，用于 CreateCustomMessage、SendC2CCustomMessage 或 cloudCustomData
+	 */
+	V2TIMBuffer ToBuffer() const;
+
+private:
+	void WriteKey(uint32 field, ETencentCloudChatCodecType type, uint8 wireType);
+	void WriteVarint(uint64 value);
+
+	const TencentCloudChatCodecSchema &Schema;
+	TArray<uint8> Data;
+};
+
+/**
+ * IntArray 字段的只读视图，遍历时逐个解码，不分配内存
+ */
+class TencentCloudChatCodecIntArrayView
+{
+public:
+	class Iterator
+	{
+	public:
+		Iterator(const uint8 *cursor, const uint8 *end)
+			: Cursor(cursor), End(end)
+		{
+			Advance();
+		}
+
+		int64 operator*() const { return Current; }
+		Iterator &operator++()
+		{
+			Advance();
+			return *this;
+		}
+		bool operator!=(const Iterator &other) const { return bValid != other.bValid || (bValid && Cursor != other.Cursor); }
+
+	private:
+		void Advance();
+
+		const uint8 *Cursor;
+		const uint8 *End;
+		int64 Current = 0;
+		bool bValid = false;
+	};
+
+	TencentCloudChatCodecIntArrayView() = default;
+	explicit TencentCloudChatCodecIntArrayView(TConstArrayView<uint8> encoded)
+		: Encoded(encoded)
+	{
+	}
+
+	Iterator begin() const { return Iterator(Encoded.GetData(), Encoded.GetData() + Encoded.Num()); }
+	Iterator end() const { return Iterator(nullptr, nullptr); }
+
+	/**
+	 * 解码全部元素追加到 out
+	 */
+	void ToArray(TArray<int64> &out) const;
+
+private:
+	TConstArrayView<uint8> Encoded;
+};
+
+/**
+ * 解码，字符串、字节和数组字段都是指向原始数据的视图，不拷贝
+ *
+ * 视图的生命周期不能超过传入的数据（例如收到的 V2TIMMessage 中的 V2TIMCustomElem::data）。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatCodecReader
+{
+public:
+	TencentCloudChatCodecReader() = default;
+
+	/**
+	 * 解析消息头并建立字段索引
+	 *
+	 * @param expected 不为空时要求 schema id 一致
+	 * @return 数据格式错误或 schema id 不一致时返回 false
+	 */
+	bool Parse(TConstArrayView<uint8> data, const TencentCloudChatCodecSchema *expected = nullptr);
+	bool Parse(const V2TIMBuffer &buffer, const TencentCloudChatCodecSchema *expected = nullptr);
+
+	/**
+	 * 只读取消息头，不解析字段；data 不是本编码格式时返回 false
+	 */
+	static bool PeekHeader(TConstArrayView<uint8> data, uint32 &outSchemaId, uint32 &outVersion);
+
+	bool IsValid() const { return bValid; }
+	uint32 GetSchemaId() const { return SchemaId; }
+	uint32 GetVersion() const { return Version; }
+
+	bool Has(uint32 field) const;
+
+	/**
+	 * 读取字段，字段不存在或线类型不符时返回 false，out 不变；同一字段出现多次时以最后一次为准
+	 */
+	bool ReadBool(uint32 field, bool &out) const;
+	bool ReadInt(uint32 field, int64 &out) const;
+	bool ReadUInt(uint32 field, uint64 &out) const;
+	bool ReadFloat(uint32 field, float &out) const;
+	bool ReadDouble(uint32 field, double &out) const;
+	bool ReadString(uint32 field, FUtf8StringView &out) const;
+	bool ReadBytes(uint32 field, TConstArrayView<uint8> &out) const;
+	bool ReadIntArray(uint32 field, TencentCloudChatCodecIntArrayView &out) const;
+
+	/**
+	 * 读取字符串并转为 FString，复用 out 的容量
+	 */
+	bool ReadString(uint32 field, FString &out) const;
+
+private:
+	struct FieldRef
+	{
+		uint32 Id;
+		uint8 WireType;
+		// 定长和 varint 类型指向值本身；长度前缀类型指向内容
+		int32 Offset;
+		int32 Size;
+	};
+
+	const FieldRef *Find(uint32 field, uint8 wireType) const;
+
+	TConstArrayView<uint8> Data;
+	TArray<FieldRef, TInlineAllocator<16>> Fields;
+	uint32 SchemaId = 0;
+	uint32 Version = 0;
+	bool bValid = false;
+};
+
+/**
+ * varint 与 zigzag 编码的公共实现
+ */
+namespace TencentCloudChatVarint
+{
+	inline uint64 ZigZagEncode(int64 value)
+	{
+		return (uint64(value) << 1) ^ uint64(value >> 63);
+	}
+
+	inline int64 ZigZagDecode(uint64 value)
+	{
+		return int64(value >> 1) ^ -int64(value & 1);
+	}
+
+	/**
+	 * 从 cursor 读取一个 varint，成功时移动 cursor；数据截断或超过 10 字节时返回 false
+	 */
+	inline bool Read(const uint8 *&cursor, const uint8 *end, uint64 &out)
+	{
+		uint64 Value = 0;
+		for (int32 Shift = 0; Shift < 70 && cursor < end; Shift += 7)
+		{
+			const uint8 Byte = *cursor++;
+			Value |= uint64(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				out = Value;
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+inline void TencentCloudChatCodecIntArrayView::Iterator::Advance()
+{
+	uint64 Raw;
+	if (Cursor && Cursor < End && TencentCloudChatVarint::Read(Cursor, End, Raw))
+	{
+		Current += TencentCloudChatVarint::ZigZagDecode(Raw);
+		bValid = true;
+	}
+	else
+	{
+		Cursor = nullptr;
+		bValid = false;
+	}
+}
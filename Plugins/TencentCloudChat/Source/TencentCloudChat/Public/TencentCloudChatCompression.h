@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+
+#include "V2TIMBuffer.h"
+#include "V2TIMCallback.h"
+#include "V2TIMListener.h"
+#include "V2TIMMessage.h"
+#include "V2TIMString.h"
+
+/**
+ * 自定义消息内容的压缩
+ *
+ * 通过 TencentCloudChatCompression::SendGroupCustomMessage / SendC2CCustomMessage 发送时，超过
+ * TencentCloudChat.Compression.Threshold 字节的内容用 FCompression 压缩后发送，压缩后不变小则按原样发送。
+ * 压缩格式由 TencentCloudChat.Compression.Format 指定，留空时按 Oodle、LZ4、Zlib 的顺序选择当前平台可用的第一个。
+ *
+ * 压缩后的格式：
+ *   | 0xC8 | 格式 (1 字节) | 原始长度 (varint) | 压缩数据 |
+ *
+ * 接收方通过 TencentCloudChatCompression::AddAdvancedMsgListener 注册监听器，带压缩头的自定义消息会先解压再回调；
+ * TencentCloudChatBatcher 的监听器同样会解压。原始内容恰好以 0xC8 开头但不是压缩数据时，解压失败，按原样回调。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatCompression
+{
+public:
+	static constexpr uint8 HeaderTag = 0xC8;
+
+	/**
+	 * 解压后允许的最大长度，防止构造的数据让接收方分配过多内存
+	 */
+	static constexpr int32 MaxUncompressedBytes = 1024 * 1024;
+
+	/**
+	 * 按阈值压缩，成功时 out 为带压缩头的数据
+	 *
+	 * @return 低于阈值、没有可用的压缩格式或压缩后不变小时返回 false
+	 */
+	static bool Compress(TConstArrayView<uint8> data, TArray<uint8> &out);
+
+	/**
+	 * 是否以压缩头开头
+	 */
+	static bool IsCompressed(TConstArrayView<uint8> data);
+
+	/**
+	 * 解压带压缩头的数据
+	 */
+	static bool Decompress(TConstArrayView<uint8> data, TArray<uint8> &out);
+
+	/**
+	 * 压缩有收益时返回压缩后的 V2TIMBuffer，否则返回原始内容的拷贝
+	 */
+	static V2TIMBuffer ToBuffer(TConstArrayView<uint8> data);
+
+	/**
+	 * message 为带压缩头的自定义消息时，解压后写入 out（其余字段从 message 拷贝），否则返回 false
+	 */
+	static bool DecompressMessage(const V2TIMMessage &message, V2TIMMessage &out);
+
+	/**
+	 * 与 TencentCloudChat 同名接口相同，内容按需压缩
+	 */
+	static V2TIMString SendGroupCustomMessage(const V2TIMBuffer &customData, const V2TIMString &groupID,
+											  V2TIMMessagePriority priority, V2TIMSendCallback *callback);
+	static V2TIMString SendC2CCustomMessage(const V2TIMBuffer &customData, const V2TIMString &userID,
+											V2TIMSendCallback *callback);
+
+	/**
+	 * TencentCloudChatBatcher 发送合并消息前是否压缩（TencentCloudChat.Compression.Batches）
+	 */
+	static bool ShouldCompressBatches();
+
+	/**
+	 * 注册 / 注销会自动解压的高级消息监听器，其余事件原样转发
+	 */
+	static void AddAdvancedMsgListener(V2TIMAdvancedMsgListener *listener);
+	static void RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *listener);
+};
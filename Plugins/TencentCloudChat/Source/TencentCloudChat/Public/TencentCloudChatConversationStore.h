@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Delegates/Delegate.h"
+#include "Templates/Function.h"
+
+#include "V2TIMCallback.h"
+#include "V2TIMConversation.h"
+#include "V2TIMString.h"
+
+DECLARE_MULTICAST_DELEGATE(FTencentCloudChatConversationStoreDelegate);
+
+/**
+ * 本地维护的会话列表
+ *
+ * 每次刷新界面都调用 TencentCloudChat::GetConversationList 从头拉取会话代价很高。会话列表只在 Load 时完整拉取一次，
+ * 之后由 V2TIMConversationListener 的 OnNewConversation / OnConversationChanged 增量更新，分页读取直接在本地完成。
+ *
+ * 会话按置顶在前、orderKey 降序排列（orderKey 相同时按 conversationID），保存在按子树大小增强的 treap 中，
+ * 插入、更新、删除和按位置查找都是 O(log n)，读取一页为 O(log n + count)。
+ *
+ * 会话监听器在 Load 时注册，拉取过程中收到的增量更新不会被较旧的分页结果覆盖。可在任意线程读取。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatConversationStore
+{
+public:
+	/**
+	 * 注册会话监听器，并按每页 pageSize 个拉取全部会话；已经加载过时直接回调
+	 *
+	 * @param onLoaded 全部拉取完成后回调，失败时 bSuccess 为 false，已拉取的部分仍然保留
+	 */
+	static void Load(TUniqueFunction<void(bool /* bSuccess */)> &&onLoaded = nullptr, uint32 pageSize = 100);
+
+	static bool IsLoaded();
+
+	static int32 Num();
+
+	/**
+	 * 拷贝从 offset 开始的最多 count 个会话到 outConversations
+	 *
+	 * @return 拷贝的个数
+	 */
+	static int32 GetPage(int32 offset, int32 count, TArray<V2TIMConversation> &outConversations);
+
+	/**
+	 * 在持有锁的情况下依次访问从 offset 开始的最多 count 个会话，不拷贝；visitor 中不能修改会话列表
+	 */
+	static void VisitPage(int32 offset, int32 count, TFunctionRef<void(const V2TIMConversation &)> visitor);
+
+	/**
+	 * 依次访问全部会话
+	 */
+	static void ForEach(TFunctionRef<void(const V2TIMConversation &)> visitor);
+
+	static bool Find(const V2TIMString &conversationID, V2TIMConversation &outConversation);
+
+	/**
+	 * 会话在列表中的位置，不存在时返回 INDEX_NONE
+	 */
+	static int32 GetIndex(const V2TIMString &conversationID);
+
+	/**
+	 * 插入或更新会话，会话监听器收到的变更都经过这里
+	 */
+	static void Upsert(const V2TIMConversationVector &conversationList);
+
+	/**
+	 * 与 TencentCloudChat::DeleteConversation 相同，成功后从本地列表中删除
+	 */
+	static void DeleteConversation(const V2TIMString &conversationID, V2TIMCallback *callback);
+
+	static void Remove(const V2TIMString &conversationID);
+
+	/**
+	 * 会话列表发生变化时广播，在会话监听器回调的线程执行
+	 */
+	static FTencentCloudChatConversationStoreDelegate &OnChanged();
+
+	/**
+	 * 清空本地列表，丢弃进行中的 Load（回调收到 false），会话监听器保持注册；由 TencentCloudChat::Login / Logout 调用，
+	 * 切换账号后需要重新 Load
+	 */
+	static void Reset();
+
+	/**
+	 * 清空本地列表并注销会话监听器，由模块关闭时调用
+	 */
+	static void Shutdown();
+};
@@ -0,0 +1,150 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "V2TIMCallback.h"
+#include "V2TIMListener.h"
+#include "V2TIMMessage.h"
+
+/**
+ * 去重过滤器的统计信息
+ *
+ * BloomRejects：布隆过滤器直接判定为新消息、不需要查 LRU 的次数；
+ * BloomFalsePositives：布隆过滤器判定可能重复，但 LRU 中没有的次数。
+ */
+struct TencentCloudChatDedupStats
+{
+	uint64 Checks = 0;
+	uint64 Duplicates = 0;
+	uint64 BloomRejects = 0;
+	uint64 BloomFalsePositives = 0;
+	int32 Entries = 0;
+	int32 Capacity = 0;
+	SIZE_T MemoryBytes = 0;
+
+	double GetHitRate() const { return Checks > 0 ? double(Duplicates) / double(Checks) : 0.0; }
+};
+
+/**
+ * 按消息 key 去重的过滤器，可在任意线程调用
+ *
+ * 消息的 key：
+ *  - 群消息按 groupID + seq + random；
+ *  - 其余消息（以及 seq 为 0 的群消息）按 msgID。
+ *
+ * 最近的 TencentCloudChat.Dedup.Capacity 个 key 保存在 LRU 中做精确判断。LRU 前面是一个布隆过滤器，包含 LRU 中
+ * 所有的 key，大小按 TencentCloudChat.Dedup.FalsePositiveRate 计算；布隆过滤器判定不存在的 key 直接视为新消息，
+ * 只有可能存在时才查 LRU。被 LRU 淘汰的 key 累积到 Capacity 个时，按 LRU 的内容重建布隆过滤器。
+ *
+ * 容量在第一次使用和 Reset 时按 CVar 确定。关闭 TencentCloudChat.Dedup.Enabled 后所有消息都视为新消息。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatDedupFilter
+{
+public:
+	/**
+	 * 记录 message
+	 *
+	 * @return 第一次见到时返回 true，重复时返回 false；无法生成 key 的消息总是返回 true
+	 */
+	bool MarkSeen(const V2TIMMessage &message);
+
+	/**
+	 * 只判断是否见过，不记录
+	 */
+	bool IsDuplicate(const V2TIMMessage &message);
+
+	/**
+	 * 清空所有记录，并按当前 CVar 重新确定容量，例如切换账号后
+	 */
+	void Reset();
+
+	TencentCloudChatDedupStats GetStats() const;
+
+	/**
+	 * 计算消息的 key，msgID 为空且不是带 seq 的群消息时返回 false
+	 */
+	static bool GetKey(const V2TIMMessage &message, uint64 &outKey);
+
+private:
+	struct Slot
+	{
+		uint64 Key;
+		int32 Prev;
+		int32 Next;
+	};
+
+	bool Check(uint64 key, bool record);
+	void Configure();
+	bool BloomMayContain(uint64 key) const;
+	void BloomAdd(uint64 key);
+	void RebuildBloom();
+	void Unlink(int32 slot);
+	void LinkFront(int32 slot);
+
+	mutable FCriticalSection Mutex;
+
+	// LRU：Slots 按 Prev/Next 串成链表，Head 为最近使用，Tail 为最久未使用
+	TMap<uint64, int32> KeyToSlot;
+	TArray<Slot> Slots;
+	int32 Head = INDEX_NONE;
+	int32 Tail = INDEX_NONE;
+	int32 Capacity = 0;
+
+	TArray<uint64> BloomWords;
+	uint64 BloomBits = 0;
+	int32 BloomHashes = 0;
+	int32 BloomEvicted = 0;
+
+	TencentCloudChatDedupStats Stats;
+};
+
+/**
+ * 收消息的去重
+ *
+ * 断线重连后（OnConnectSuccess）SDK 可能再次通过 OnRecvNewMessage 投递已经收到过的消息。通过本类的
+ * AddAdvancedMsgListener 注册的监听器共用一个向 SDK 注册的去重监听器，每条消息只查一次 GetDefaultFilter，
+ * 再转发给所有监听器，每个监听器对每条消息只收到一次。
+ *
+ * GetHistoryMessageList 使用单独的过滤器（GetHistoryFilter），只去掉翻页时重复出现在多页中的消息；
+ * 已经从 OnRecvNewMessage 收到的消息照常出现在历史消息中，以免界面上出现空洞。需要应用游戏事件的业务使用
+ * 带 alreadyApplied 的重载：按 GetDefaultFilter 只读判断（IsDuplicate）每条消息是否已经由去重监听器投递过，
+ * 跳过标记为 true 的消息；应用其余消息时调用 GetDefaultFilter().MarkSeen，重连后 SDK 再次投递时不会重复应用。
+ *
+ * TencentCloudChatRouter 使用自己的过滤器，见 TencentCloudChatRouter::GetDedupFilter。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatDedup
+{
+public:
+	static TencentCloudChatDedupFilter &GetDefaultFilter();
+
+	/**
+	 * GetHistoryMessageList 使用的过滤器，切换会话或重新从头翻页前可以 Reset
+	 */
+	static TencentCloudChatDedupFilter &GetHistoryFilter();
+
+	/**
+	 * 与 TencentCloudChat::GetHistoryMessageList 相同，callback 只收到之前的页中没有出现过的消息
+	 */
+	static void GetHistoryMessageList(const V2TIMMessageListGetOption &option,
+									  V2TIMValueCallback<V2TIMMessageVector> *callback);
+
+	using HistorySuccessFunc = TUniqueFunction<void(const V2TIMMessageVector &, const TBitArray<> &)>;
+	using HistoryErrorFunc = TUniqueFunction<void(int, const V2TIMString &)>;
+
+	/**
+	 * 同上，onSuccess 额外收到与消息一一对应的 alreadyApplied：已经通过 AddAdvancedMsgListener 注册的监听器
+	 * 收到过的消息为 true。只读判断，不会记录到 GetDefaultFilter 中
+	 */
+	static void GetHistoryMessageList(const V2TIMMessageListGetOption &option,
+									  HistorySuccessFunc &&onSuccess, HistoryErrorFunc &&onError = nullptr);
+
+	/**
+	 * 注册 / 注销只回调新消息的高级消息监听器，其余事件原样转发
+	 *
+	 * RemoveAdvancedMsgListener 等其他线程上正在转发的事件结束后才返回，返回后可以释放 listener
+	 */
+	static void AddAdvancedMsgListener(V2TIMAdvancedMsgListener *listener);
+	static void RemoveAdvancedMsgListener(V2TIMAdvancedMsgListener *listener);
+};
@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+
+#include "V2TIMCallback.h"
+#include "TencentCloudChatCallbacks.h"
+#include "TencentCloudChatLatency.h"
+#include "TencentCloudChatStats.h"
+
+/**
+ * 注销后由 TencentCloudChatDispatcher::Retire 延迟释放的监听器对象
+ *
+ * SDK 注销监听器时不会等待其他线程上正在执行的事件结束。子类在每个事件中用 EventScope 计数，Retire 之后
+ * 至少经过一次游戏线程的 Drain、并且没有正在执行的事件时才释放。
+ */
+class TencentCloudChatRetirable
+{
+public:
+	virtual ~TencentCloudChatRetirable() = default;
+
+	bool IsIdle() const { return InFlight.Load() == 0; }
+
+protected:
+	struct EventScope
+	{
+		explicit EventScope(TencentCloudChatRetirable &owner)
+			: Owner(owner)
+		{
+			++Owner.InFlight;
+		}
+		~EventScope()
+		{
+			--Owner.InFlight;
+		}
+
+		TencentCloudChatRetirable &Owner;
+	};
+
+private:
+	TAtomic<int32> InFlight{0};
+};
+
+/**
+ * SDK 回调和监听事件的游戏线程分发队列
+ *
+ * SDK 的回调和监听事件都在 SDK 内部线程触发。打开 TencentCloudChat.Dispatch.GameThread 后，
+ * 经过 TencentCloudChat 传入的回调和监听器不再直接在 SDK 线程执行，而是先放入一个无锁的
+ * MPSC 队列，由游戏线程每帧统一执行一次。
+ *
+ * 每帧的执行时间受 TencentCloudChat.Dispatch.BudgetMs 限制，超出预算的事件顺延到下一帧，
+ * 保证消息突发时不会拉长帧时间。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatDispatcher
+{
+public:
+	/**
+	 * 投递一个任务，可在任意线程调用，任务在游戏线程执行
+	 */
+	static void Enqueue(TUniqueFunction<void()> &&task);
+
+	/**
+	 * 在游戏线程执行队列中的任务
+	 *
+	 * @param budgetMs 本次最多执行的时间（毫秒），<= 0 表示执行完队列中的所有任务
+	 * @return 本次执行的任务数
+	 */
+	static int32 Drain(double budgetMs);
+
+	/**
+	 * 当前排队等待执行的任务数
+	 */
+	static int32 GetQueueDepth();
+
+	/**
+	 * 是否把回调和监听事件分发到游戏线程（TencentCloudChat.Dispatch.GameThread）
+	 */
+	static bool IsGameThreadDispatchEnabled();
+
+	/**
+	 * 释放已经从 SDK 注销的 object，可在任意线程调用，object 在游戏线程上空闲后释放
+	 */
+	static void Retire(TUniquePtr<TencentCloudChatRetirable> &&object);
+
+	/**
+	 * 由模块在启动和关闭时调用，注册或注销每帧的 Drain
+	 */
+	static void Startup();
+	static void Shutdown();
+
+	/**
+	 * 包装传给 SDK 的回调
+	 *
+	 * 打开游戏线程分发或 TENCENTCLOUDCHAT_WITH_STATS 时返回一个从对象池分配的转发回调，转发完成后自动回收；
+	 * 否则原样返回 callback。没有打开游戏线程分发时转发回调在 SDK 线程直接调用 callback，只做统计。
+	 * 在 TENCENTCLOUDCHAT_SCOPE_API 标记的接口内调用时，同时记录请求的响应延迟（TencentCloudChatLatency）。
+	 */
+	static V2TIMCallback *Marshal(V2TIMCallback *callback);
+	static V2TIMSendCallback *Marshal(V2TIMSendCallback *callback);
+	template <class T>
+	static V2TIMValueCallback<T> *Marshal(V2TIMValueCallback<T> *callback);
+	template <class T>
+	static V2TIMCompleteCallback<T> *Marshal(V2TIMCompleteCallback<T> *callback);
+};
+
+template <class T>
+V2TIMValueCallback<T> *TencentCloudChatDispatcher::Marshal(V2TIMValueCallback<T> *callback)
+{
+	const bool bGameThread = IsGameThreadDispatchEnabled();
+	if (!callback || (!bGameThread && !TENCENTCLOUDCHAT_WITH_STATS))
+	{
+		return callback;
+	}
+	TencentCloudChatStats::RecordCallIssued();
+	const TencentCloudChatRequestTimer Timer = TencentCloudChatRequestTimer::Start();
+	return TencentCloudChatValueCallback<T>::Create(
+		[callback, bGameThread, Timer](const T &value)
+		{
+			TencentCloudChatStats::RecordCallbackDelivered();
+			Timer.Finish(0);
+			if (bGameThread)
+			{
+				Enqueue([callback, value]() { callback->OnSuccess(value); });
+			}
+			else
+			{
+				callback->OnSuccess(value);
+			}
+		},
+		[callback, bGameThread, Timer](int error_code, const V2TIMString &error_message)
+		{
+			TencentCloudChatStats::RecordCallbackDelivered();
+			Timer.Finish(error_code);
+			if (bGameThread)
+			{
+				Enqueue([callback, error_code, error_message]() { callback->OnError(error_code, error_message); });
+			}
+			else
+			{
+				callback->OnError(error_code, error_message);
+			}
+		});
+}
+
+template <class T>
+V2TIMCompleteCallback<T> *TencentCloudChatDispatcher::Marshal(V2TIMCompleteCallback<T> *callback)
+{
+	const bool bGameThread = IsGameThreadDispatchEnabled();
+	if (!callback || (!bGameThread && !TENCENTCLOUDCHAT_WITH_STATS))
+	{
+		return callback;
+	}
+	TencentCloudChatStats::RecordCallIssued();
+	const TencentCloudChatRequestTimer Timer = TencentCloudChatRequestTimer::Start();
+	return TencentCloudChatCompleteCallback<T>::Create(
+		[callback, bGameThread, Timer](int error_code, const V2TIMString &error_message, const T &value)
+		{
+			TencentCloudChatStats::RecordCallbackDelivered();
+			Timer.Finish(error_code);
+			if (bGameThread)
+			{
+				Enqueue([callback, error_code, error_message, value]() { callback->OnComplete(error_code, error_message, value); });
+			}
+			else
+			{
+				callback->OnComplete(error_code, error_message, value);
+			}
+		});
+}
@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 录制 SDK 投递给监听器的事件流
+ *
+ * Start 时直接向当前后端（TencentCloudChatBackend::Get()）注册一个同时实现 V2TIMSDKListener、V2TIMAdvancedMsgListener、
+ * V2TIMGroupListener、V2TIMConversationListener、V2TIMFriendshipListener 和 V2TIMSignalingListener 的录制器，
+ * 每个事件只记录一次，与业务注册了多少个监听器无关。V2TIMSimpleMsgListener 的事件由同一条消息的 OnRecvNewMessage 派生，不单独记录。
+ *
+ * 文件格式（整数都是 varint，有符号数先做 zigzag，见 TencentCloudChatVarint）：
+ *   文件头 | "TCCE" | 版本 | 录制开始的 UTC 时间（FDateTime ticks）|
+ *   事件   | 长度 | 距上一个事件的微秒数 | 事件编号 | 参数 ... |
+ * 字符串和二进制数据为长度 + 原始字节，列表为个数 + 元素，结构体按固定顺序写出各字段。
+ * 读取时不认识的事件按长度跳过。
+ *
+ * 监听器回调中只把事件追加到内存缓冲区，由写线程写入文件；缓冲区（TencentCloudChat.EventRecord.MaxBufferKB）
+ * 满时丢弃事件并计数，丢弃的时间算入下一个事件的间隔。
+ *
+ * 记录的是影响插件处理开销的字段：消息的基本字段、文本 / 自定义 / 表情 / 位置 / 群提示元素的全部内容，图片、语音等
+ * 富媒体元素只记录类型和本地信息；会话和话题的 lastMessage、消息的离线推送信息不记录。
+ *
+ * 控制台：TencentCloudChat.EventRecord start [路径] | stop，默认写入 Saved/Profiling/TencentCloudChat。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatEventRecorder
+{
+public:
+	/**
+	 * 开始录制到 path；已经在录制或无法创建文件时返回 false
+	 */
+	static bool Start(const FString &path);
+
+	/**
+	 * 注销录制器并关闭文件
+	 */
+	static void Stop();
+
+	static bool IsRecording();
+
+	/**
+	 * 当前或上一次录制的事件数
+	 */
+	static int64 GetRecordedEvents();
+
+	/**
+	 * 当前或上一次录制中因缓冲区满丢弃的事件数
+	 */
+	static int64 GetDroppedEvents();
+
+	/**
+	 * 由模块在关闭时调用
+	 */
+	static void Shutdown();
+};
+
+/**
+ * 回放 TencentCloudChatEventRecorder 录制的事件流
+ *
+ * 事件按录制时的间隔（除以 speed）交给回环后端（TencentCloudChatLoopback::PostEvent），在模拟网络线程上调用
+ * 当前后端注册的监听器，与 SDK 在回调线程上投递事件相同：经过 TencentCloudChat 注册的监听器照常经过代理、
+ * 统计和游戏线程分发，插件内部直接注册的监听器（会话列表、统计等）也一起收到事件。因此需要 TencentCloudChat
+ * 正在使用回环后端（启动参数 -TencentCloudChatLoopback）。
+ *
+ * 读取和定时在单独的线程上进行。模拟网络中积压的事件超过 TencentCloudChat.EventReplay.MaxPending 时暂停读取，
+ * 尽快回放（speed 为 0）时也不会无限占用内存。相同的文件每次以相同的顺序投递相同的事件。
+ *
+ * 控制台：TencentCloudChat.EventReplay <路径> [速度，默认 1，max 表示尽快] | stop
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatEventReplay
+{
+public:
+	/**
+	 * 开始回放
+	 *
+	 * @param speed 1 为原速，N 为 N 倍速，0 为不等待、尽快回放
+	 * @return 已经在回放、文件无法读取或格式不对、当前后端不是回环实例时返回 false
+	 */
+	static bool Start(const FString &path, double speed = 1.0);
+
+	/**
+	 * 停止回放线程；已经交给模拟网络的事件仍会投递
+	 */
+	static void Stop();
+
+	static bool IsReplaying();
+
+	/**
+	 * 由模块在关闭时调用
+	 */
+	static void Shutdown();
+};
@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+
+#include "V2TIMGroup.h"
+#include "V2TIMString.h"
+
+/**
+ * 紧凑保存的群成员资料
+ *
+ * 字符串指向所在分页的连续缓冲区，只在 Consume 的 visitor 中有效；需要保留时自行拷贝。
+ */
+struct TencentCloudChatGroupMember
+{
+	FUtf8StringView UserID;
+	FUtf8StringView NickName;
+	FUtf8StringView NameCard;
+	FUtf8StringView FaceURL;
+	uint32 Role = 0;
+	uint32 MuteUntil = 0;
+	int64 JoinTime = 0;
+};
+
+/**
+ * 流式读取群成员列表
+ *
+ * TencentCloudChat::GetGroupMemberList 需要调用方按 nextSeq 一页一页地拉取，社群（Community）最多有 10 万成员，
+ * 串行拉取并逐页处理很慢。TencentCloudChatGroupMemberStream 在收到一页后立即请求下一页，调用方处理当前页的同时
+ * 下一页已经在路上；已拉取但尚未读取的成员不超过 TencentCloudChat.GroupMembers.MaxBufferedKB，超过时暂停预取，
+ * 读取后自动恢复。
+ *
+ * 每页成员的字符串保存在一块连续内存中，读取完的分页立即释放。可在任意线程调用，通常每帧在游戏线程调用 Consume。
+ *
+ * @code
+ * Stream = TencentCloudChatGroupMemberStream::Create(GroupID, V2TIM_GROUP_MEMBER_FILTER_ALL);
+ * // 每帧
+ * Stream->Consume(200, [](const TencentCloudChatGroupMember &Member) { ... });
+ * if (Stream->IsFinished()) { ... }
+ * @endcode
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatGroupMemberStream : public TSharedFromThis<TencentCloudChatGroupMemberStream, ESPMode::ThreadSafe>
+{
+public:
+	/**
+	 * 创建并开始拉取第一页，参数与 TencentCloudChat::GetGroupMemberList 相同
+	 */
+	static TSharedRef<TencentCloudChatGroupMemberStream, ESPMode::ThreadSafe> Create(const V2TIMString &groupID, uint32 filter);
+
+	/**
+	 * 依次访问最多 maxCount 个已拉取的成员，读取完的分页被释放，必要时恢复预取
+	 *
+	 * @return 访问的成员数，下一页还没到达时可能为 0
+	 */
+	int32 Consume(int32 maxCount, TFunctionRef<void(const TencentCloudChatGroupMember &)> visitor);
+
+	/**
+	 * 已拉取、尚未读取的成员数
+	 */
+	int32 GetAvailable() const;
+
+	/**
+	 * 所有分页都已拉取并读取完，或已取消 / 失败
+	 */
+	bool IsFinished() const;
+
+	/**
+	 * 拉取失败时返回 true，错误码和错误信息见 outErrorCode / outErrorMessage
+	 */
+	bool GetError(int &outErrorCode, FString &outErrorMessage) const;
+
+	/**
+	 * 停止拉取并释放已缓存的分页，正在进行的请求返回后被丢弃
+	 */
+	void Cancel();
+
+	int32 GetPagesFetched() const;
+
+	/**
+	 * 从开始到现在（或到最后一页到达）的平均拉取速度
+	 */
+	double GetPagesPerSecond() const;
+
+	/**
+	 * 已缓存分页占用的内存
+	 */
+	SIZE_T GetBufferedBytes() const;
+
+private:
+	struct Page
+	{
+		TArray<UTF8CHAR> Strings;
+		TArray<TencentCloudChatGroupMember> Members;
+		int32 Consumed = 0;
+
+		SIZE_T GetAllocatedSize() const { return Strings.GetAllocatedSize() + Members.GetAllocatedSize(); }
+	};
+
+	TencentCloudChatGroupMemberStream(const V2TIMString &groupID, uint32 filter);
+
+	/**
+	 * 在持有 Mutex 时调用，返回是否需要发出下一页的请求
+	 */
+	bool ShouldFetch() const;
+
+	void Fetch();
+	void OnPage(const V2TIMGroupMemberInfoResult &result);
+	void OnError(int errorCode, const V2TIMString &errorMessage);
+
+	static void BuildPage(const V2TIMGroupMemberFullInfoVector &members, Page &outPage);
+
+	mutable FCriticalSection Mutex;
+	V2TIMString GroupID;
+	uint32 Filter;
+	uint64 NextSeq = 0;
+	bool bRequestInFlight = false;
+	bool bLastPageFetched = false;
+	bool bCancelled = false;
+	bool bFailed = false;
+	int ErrorCode = 0;
+	FString ErrorMessage;
+
+	TArray<TUniquePtr<Page>> Pages;
+	int32 Available = 0;
+	SIZE_T BufferedBytes = 0;
+
+	int32 PagesFetched = 0;
+	double StartTime = 0.0;
+	double LastPageTime = 0.0;
+};
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "V2TIMCallback.h"
+#include "V2TIMMessage.h"
+#include "V2TIMString.h"
+
+/**
+ * 历史消息缓存的统计信息
+ *
+ * 命中指请求的范围全部在缓存中，不需要等待 SDK；拉取耗时从发出 GetHistoryMessageList 到收到结果。
+ */
+struct TencentCloudChatHistoryCacheStats
+{
+	uint64 Hits = 0;
+	uint64 Misses = 0;
+	uint64 Fetches = 0;
+	double TotalFetchSeconds = 0.0;
+	double MaxFetchSeconds = 0.0;
+	int32 Conversations = 0;
+	SIZE_T MemoryBytes = 0;
+
+	double GetHitRate() const { return Hits + Misses > 0 ? double(Hits) / double(Hits + Misses) : 0.0; }
+	double GetAverageFetchSeconds() const { return Fetches > 0 ? TotalFetchSeconds / double(Fetches) : 0.0; }
+};
+
+/**
+ * 按会话缓存的历史消息
+ *
+ * 聊天窗口滚动时逐页调用 TencentCloudChat::GetHistoryMessageList，每次重新打开会话都要重新拉取。
+ * TencentCloudChatHistoryCache 为每个会话缓存从最新一条开始、连续的一段消息（按时间从新到旧）：
+ *  - GetMessages 读取 [offset, offset + count) 范围，已缓存时直接回调，否则从缓存中最旧的一条继续向前拉取；
+ *  - 读取后如果缓存中比可见范围更旧的消息不足 TencentCloudChat.HistoryCache.PrefetchPages 页，在后台预取；
+ *  - 所有会话的缓存总量超过 TencentCloudChat.HistoryCache.MaxMemoryKB 时，先丢弃各会话中比最近读取的范围和预取页更旧的
+ *    消息，仍然超出时再按最久未读取的顺序淘汰整个会话，最近读取的会话保留；
+ *  - OnRecvNewMessage / OnRecvMessageModified / OnRecvMessageRevoked 以及经过 TencentCloudChat 发送成功的消息会更新已缓存的会话；
+ *  - 登录、登出和断线重连（OnConnectSuccess）时丢弃全部缓存。
+ *
+ * 内存按消息中文本、自定义数据等字段的长度估算。命中率和拉取耗时见 GetStats 及 stat TencentCloudChat。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatHistoryCache
+{
+public:
+	/**
+	 * 读取会话的历史消息，userID 和 groupID 只填一个（与 V2TIMMessageListGetOption 相同）
+	 *
+	 * @param offset 从最新一条消息数起的位置
+	 * @param callback 按时间从新到旧返回；已经到达最早的消息时可能少于 count 条。全部命中缓存时在调用线程直接回调
+	 */
+	static void GetMessages(const V2TIMString &userID, const V2TIMString &groupID, int32 offset, int32 count,
+							V2TIMValueCallback<V2TIMMessageVector> *callback);
+
+	/**
+	 * 丢弃一个会话的缓存
+	 */
+	static void Invalidate(const V2TIMString &userID, const V2TIMString &groupID);
+
+	static void InvalidateAll();
+
+	/**
+	 * 由 TencentCloudChat 的发送接口调用：发送成功时把消息加入对应会话的缓存；没有缓存的会话或在
+	 * TencentCloudChatBackendScope 中（模拟用户发送）时直接返回 callback
+	 */
+	static V2TIMSendCallback *TrackSend(V2TIMSendCallback *callback);
+
+	static TencentCloudChatHistoryCacheStats GetStats();
+
+	/**
+	 * 清空缓存并注销消息监听器，例如切换账号后；模块关闭时也会调用
+	 */
+	static void Shutdown();
+};
@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 对数分桶的延迟直方图（HDR 风格），单位微秒，不是线程安全的
+ *
+ * 每个 2 的幂区间再等分为 16 个桶，任意值的相对误差不超过 1/16；桶数组按记录到的最大值增长，
+ * 最大值和平均值单独精确记录。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatLatencyHistogram
+{
+public:
+	void Record(uint64 micros);
+
+	/**
+	 * @param percentile 0 到 100
+	 * @return 不小于 percentile% 记录值的桶上界，没有记录时返回 0
+	 */
+	uint64 GetPercentile(double percentile) const;
+
+	uint64 GetCount() const { return Count; }
+	uint64 GetMax() const { return Max; }
+	double GetMean() const { return Count > 0 ? double(Sum) / double(Count) : 0.0; }
+
+	void Reset();
+
+private:
+	static int32 GetBucket(uint64 value);
+	static uint64 GetBucketUpperValue(int32 bucket);
+
+	TArray<uint64> Buckets;
+	uint64 Count = 0;
+	uint64 Sum = 0;
+	uint64 Max = 0;
+};
+
+/**
+ * 一个接口的延迟统计
+ */
+struct TencentCloudChatLatencySummary
+{
+	FString Api;
+	uint64 Count = 0;
+	uint64 Errors = 0;
+	double MeanMs = 0.0;
+	double P50Ms = 0.0;
+	double P90Ms = 0.0;
+	double P99Ms = 0.0;
+	double MaxMs = 0.0;
+	// 错误码及次数，按次数从多到少
+	TArray<TPair<int32, uint64>> ErrorCodes;
+};
+
+/**
+ * 一次请求的计时，由 TencentCloudChatDispatcher::Marshal 在请求发出时创建，收到结果时结束
+ */
+struct TENCENTCLOUDCHAT_API TencentCloudChatRequestTimer
+{
+	int32 Api = INDEX_NONE;
+	uint64 StartCycles = 0;
+
+	/**
+	 * 记录当前线程所在的 TencentCloudChat 接口；不在接口内时不计时
+	 */
+	static TencentCloudChatRequestTimer Start();
+
+	void Finish(int errorCode) const;
+};
+
+/**
+ * TencentCloudChat 异步接口的请求 / 响应延迟
+ *
+ * 每个接口在开头标记当前线程正在调用的接口（见 TencentCloudChatApiScope），接口内经过 Marshal 包装的回调
+ * 从请求发出到 SDK 回调 OnSuccess / OnError / OnComplete 的时间记录到这个接口的直方图中，失败时另按错误码计数。
+ * 时间在 SDK 回调的线程上结束，不包括打开游戏线程分发后在队列中等待的时间。
+ *
+ * 控制台执行 TencentCloudChat.Latency 按调用次数输出各接口的 p50 / p90 / p99 / max 和错误码，
+ * TencentCloudChat.Latency reset 输出后清空。只在 TENCENTCLOUDCHAT_WITH_STATS 时记录。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatLatency
+{
+public:
+	/**
+	 * 同名接口（重载）返回相同的编号
+	 */
+	static int32 RegisterApi(const TCHAR *name);
+
+	/**
+	 * 设置当前线程正在调用的接口，返回之前的值
+	 */
+	static int32 ExchangeCurrentApi(int32 api);
+
+	static void Record(int32 api, uint64 micros, int errorCode);
+
+	/**
+	 * 有记录的接口，按调用次数从多到少
+	 */
+	static TArray<TencentCloudChatLatencySummary> GetSummaries();
+
+	static void Reset();
+};
+
+/**
+ * 在作用域内把当前线程正在调用的接口设为 api，由 TENCENTCLOUDCHAT_SCOPE_API 使用
+ */
+class TencentCloudChatApiScope
+{
+public:
+	explicit TencentCloudChatApiScope(int32 api)
+		: Previous(TencentCloudChatLatency::ExchangeCurrentApi(api))
+	{
+	}
+
+	~TencentCloudChatApiScope()
+	{
+		TencentCloudChatLatency::ExchangeCurrentApi(Previous);
+	}
+
+private:
+	int32 Previous;
+};
@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+#include "V2TIMManager.h"
+#include "V2TIMString.h"
+
+/**
+ * 负载测试的参数；各种操作的频率都是每个在线用户每秒的次数
+ */
+struct TencentCloudChatLoadTestConfig
+{
+	int32 Users = 256;
+	// 每 UsersPerGroup 个用户一个群，第一个用户建群，其余加入；单聊的对象也从同群用户中随机选取
+	int32 UsersPerGroup = 64;
+	// 例如 Meeting（对局大厅）或 AVChatRoom（观战直播间）
+	FString GroupType = TEXT("Meeting");
+	// 用户在 RampUpSeconds 内依次登录
+	double RampUpSeconds = 10.0;
+	// 全部用户上线后运行的时间，0 表示直到 Stop
+	double DurationSeconds = 0.0;
+
+	double C2CTextPerSecond = 0.05;
+	double C2CCustomPerSecond = 0.2;
+	double GroupTextPerSecond = 0.02;
+	double GroupCustomPerSecond = 0.5;
+	double HistoryPerSecond = 0.01;
+	// 自定义消息的数据大小，不小于 8 字节（前 8 字节为发送时间）
+	int32 CustomBytes = 64;
+
+	uint32 SDKAppID = 0;
+	int32 Seed = 0;
+
+	/**
+	 * 每个模拟用户使用的 V2TIMManager，为空时使用 TencentCloudChatLoopback::CreateManager / DestroyManager
+	 */
+	TFunction<V2TIMManager *()> CreateManager;
+	TFunction<void(V2TIMManager *)> DestroyManager;
+
+	/**
+	 * 生成登录用的 userSig，为空时传空串（回环后端不校验）
+	 */
+	TFunction<V2TIMString(const V2TIMString & /* userID */)> GenerateUserSig;
+};
+
+/**
+ * 负载测试的统计；延迟单位毫秒，Interval 开头的字段为最近一个统计周期的值
+ */
+struct TencentCloudChatLoadTestReport
+{
+	double ElapsedSeconds = 0.0;
+	int32 UsersOnline = 0;
+	int32 UsersFailed = 0;
+
+	uint64 Sent = 0;
+	uint64 SendFailed = 0;
+	uint64 Received = 0;
+	uint64 HistoryReads = 0;
+
+	double IntervalSeconds = 0.0;
+	uint64 IntervalSent = 0;
+	uint64 IntervalReceived = 0;
+
+	// SendMessage 调用到发送回调执行（包括游戏线程分发的排队时间）
+	double AckP50Ms = 0.0;
+	double AckP99Ms = 0.0;
+	double AckMaxMs = 0.0;
+	// 发送方调用 SendMessage 到接收方的 OnRecvNewMessage 执行
+	double DeliveryP50Ms = 0.0;
+	double DeliveryP99Ms = 0.0;
+	double DeliveryMaxMs = 0.0;
+	// 到期的操作在驱动 Ticker 中晚执行的时间，持续增长说明游戏线程跟不上设定的频率
+	double DriverLagMaxMs = 0.0;
+
+	int32 DispatcherQueueDepth = 0;
+	int32 DispatcherQueueDepthMax = 0;
+	int32 CallsInFlight = 0;
+	int32 LoopbackPendingEvents = 0;
+
+	// 进程占用的物理内存，包括回环后端模拟的服务器状态（群、历史消息）
+	uint64 MemoryUsedBytes = 0;
+	int64 MemoryGrowthBytes = 0;
+};
+
+/**
+ * 在一个进程内模拟大量用户的负载测试
+ *
+ * 每个模拟用户有独立的 V2TIMManager（默认为 TencentCloudChatLoopback 的回环实例），通过 TencentCloudChatBackendScope
+ * 以该用户的身份调用 TencentCloudChat 的接口：登录、建群 / 加群、按设定频率发送单聊和群聊的文本 / 自定义消息、
+ * 拉取历史消息，消息监听器也经过 TencentCloudChat 注册，因此游戏线程分发、统计和延迟记录都和正式使用时一致。
+ * 按当前账号维护的缓存（历史消息、会话、资料、搜索索引等）在 BackendScope 中跳过，模拟用户的登录和发送不会改动它们；
+ * 消息路由和去重只挂在全局后端上，不经过模拟用户。
+ *
+ * 操作由游戏线程上的 Ticker 按泊松过程调度。运行期间每 TencentCloudChat.LoadTest.ReportIntervalSeconds 秒在日志中
+ * 输出一次统计，包括分发队列深度、未完成的请求数、内存增长和回调延迟。
+ *
+ * 控制台：TencentCloudChat.LoadTest start [Users=] [UsersPerGroup=] [GroupType=] [RampUp=] [Duration=] [C2CText=]
+ * [C2CCustom=] [GroupText=] [GroupCustom=] [History=] [CustomBytes=] [Seed=]，TencentCloudChat.LoadTest stop | report。
+ * 只能在游戏线程调用。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatLoadTest
+{
+public:
+	/**
+	 * 开始一次负载测试；已经在运行时返回 false
+	 */
+	static bool Start(const TencentCloudChatLoadTestConfig &config);
+
+	/**
+	 * 停止并输出最终统计，移除监听器并释放所有模拟用户
+	 */
+	static void Stop();
+
+	static bool IsRunning();
+
+	/**
+	 * 当前的统计，Interval 字段为上次输出以来的值
+	 */
+	static TencentCloudChatLoadTestReport GetReport();
+
+	/**
+	 * 由模块在关闭时调用
+	 */
+	static void Shutdown();
+};
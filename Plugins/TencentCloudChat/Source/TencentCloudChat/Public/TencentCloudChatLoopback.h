@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "V2TIMListener.h"
+#include "V2TIMManager.h"
+
+/**
+ * 一个回环实例当前注册的监听器，见 TencentCloudChatLoopback::PostEvent
+ */
+struct TencentCloudChatLoopbackListeners
+{
+	TArray<V2TIMSDKListener *, TInlineAllocator<4>> SDK;
+	TArray<V2TIMAdvancedMsgListener *, TInlineAllocator<4>> AdvancedMsg;
+	TArray<V2TIMGroupListener *, TInlineAllocator<4>> Group;
+	TArray<V2TIMConversationListener *, TInlineAllocator<4>> Conversation;
+	TArray<V2TIMFriendshipListener *, TInlineAllocator<4>> Friendship;
+	TArray<V2TIMSignalingListener *, TInlineAllocator<4>> Signaling;
+};
+
+/**
+ * 进程内的回环后端：不连接服务器，在内存中模拟 V2TIMManager 及各个子 manager，用于离线和可重复的基准测试
+ *
+ * 每个 CreateManager 返回的实例相当于一个客户端，Login 之后就是网络中的一个模拟用户，实例之间可以
+ * 互发单聊和群聊消息。所有回调和监听事件都在一个模拟网络线程上按到期时间依次触发，相当于 SDK 的回调线程：
+ *  - TencentCloudChat.Loopback.LatencyMs / JitterMs：单程延迟和每段的随机附加延迟，请求的回调和消息到达
+ *    各经过两段（客户端到服务器、服务器到客户端）；
+ *  - TencentCloudChat.Loopback.LossPercent：发送的消息被丢弃的比例，丢弃时对端收不到，发送方收到
+ *    OnError(ERR_SDK_NET_WAIT_ACK_TIMEOUT)；
+ *  - TencentCloudChat.Loopback.Seed：随机延迟和丢包的种子，网络启动或 Reset 时生效，相同的种子和调用顺序
+ *    得到相同的结果。
+ *
+ * 支持登录、消息的创建 / 发送 / 接收 / 撤回、历史消息、群组的创建 / 加入 / 退出 / 解散 / 成员列表、
+ * 会话列表和未读数；会话的 lastMessage 为空。其余接口以 ERR_SDK_INTERFACE_NOT_SUPPORT 失败。
+ * 消息、字符串等数据类型仍由 SDK 的库实现，因此仍需要链接 SDK，只是不再需要网络。
+ *
+ * 启动参数 -TencentCloudChatLoopback 或 TencentCloudChat.Loopback=1 时，模块启动后 TencentCloudChat
+ * 使用 GetDefaultManager()（见 TencentCloudChatBackend）。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatLoopback
+{
+public:
+	/**
+	 * 创建一个模拟客户端，由调用方通过 DestroyManager 释放
+	 */
+	static V2TIMManager *CreateManager();
+	static void DestroyManager(V2TIMManager *manager);
+
+	/**
+	 * 模块在回环模式下给 TencentCloudChat 使用的实例，第一次调用时创建
+	 */
+	static V2TIMManager *GetDefaultManager();
+
+	/**
+	 * manager 是否为仍然存在的回环实例
+	 */
+	static bool IsLoopback(V2TIMManager *manager);
+
+	/**
+	 * 等待模拟网络中已经发出的回调和事件全部执行完
+	 *
+	 * @return 超时前执行完返回 true
+	 */
+	static bool Flush(double timeoutSeconds);
+
+	/**
+	 * 在模拟网络线程上把一个事件交给 manager 当前注册的监听器，排在已经到期的回调和事件之后
+	 *
+	 * 用于回放录制的事件流（见 TencentCloudChatEventReplay），事件不经过模拟的服务器状态。
+	 *
+	 * @return manager 不是回环实例时返回 false
+	 */
+	static bool PostEvent(V2TIMManager *manager, TUniqueFunction<void(const TencentCloudChatLoopbackListeners &)> &&event);
+
+	/**
+	 * 模拟网络中尚未执行的回调和事件数
+	 */
+	static int32 GetPendingEvents();
+
+	/**
+	 * 清空群组和历史消息，重新设置随机种子；不影响已经登录的用户
+	 */
+	static void Reset();
+
+	/**
+	 * 由模块在启动和关闭时调用，按启动参数选择后端，关闭时停止模拟网络线程并释放所有实例
+	 */
+	static void Startup();
+	static void Shutdown();
+};
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+
+#include "V2TIMCallback.h"
+#include "V2TIMFriendship.h"
+#include "V2TIMString.h"
+
+/**
+ * 资料缓存的统计信息
+ *
+ * Coalesced：请求的用户已经在另一个请求中拉取，直接等待其结果的次数；Chunks：实际发出的 GetUsersInfo 请求数。
+ */
+struct TencentCloudChatProfileCacheStats
+{
+	uint64 Hits = 0;
+	uint64 Misses = 0;
+	uint64 Coalesced = 0;
+	uint64 Chunks = 0;
+	int32 Entries = 0;
+};
+
+/**
+ * 用户资料缓存
+ *
+ * 聊天列表的每一行各自调用 TencentCloudChat::GetUsersInfo 会产生大量重复请求，而且调用方需要自己保证每次不超过 100 个用户。
+ * 通过 TencentCloudChatProfileCache::GetUsersInfo 获取资料时：
+ *  - 命中缓存且没有过期（TencentCloudChat.ProfileCache.TTLSeconds）的用户直接返回；
+ *  - 正在被其他请求拉取的用户不重复请求，等待同一个结果；
+ *  - 其余用户按每 MaxUsersPerRequest 个拆分，同时发出多个 GetUsersInfo 请求。
+ *
+ * 缓存按 LRU 淘汰，容量为 TencentCloudChat.ProfileCache.Capacity。OnSelfInfoUpdated 会更新自己的资料，
+ * OnFriendInfoChanged 会使相应好友的缓存失效。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatProfileCache
+{
+public:
+	/**
+	 * 单个 GetUsersInfo 请求的用户数上限（后台限制数据包最大为 1MB）
+	 */
+	static constexpr int32 MaxUsersPerRequest = 100;
+
+	/**
+	 * 与 TencentCloudChat::GetUsersInfo 相同，结果按 userIDList 的顺序排列，不存在的用户不出现在结果中
+	 *
+	 * 全部命中缓存时在调用线程直接回调；任意一个分块请求失败时以第一个错误回调 OnError。
+	 */
+	static void GetUsersInfo(const V2TIMStringVector &userIDList, V2TIMValueCallback<V2TIMUserFullInfoVector> *callback);
+	static void GetUsersInfo(TConstArrayView<FString> userIDList, V2TIMValueCallback<V2TIMUserFullInfoVector> *callback);
+
+	/**
+	 * 只查缓存，不发请求
+	 */
+	static bool FindCached(const V2TIMString &userID, V2TIMUserFullInfo &outInfo);
+
+	static void Invalidate(const V2TIMString &userID);
+	static void InvalidateAll();
+
+	/**
+	 * 清空缓存，进行中的请求返回的资料不再写入缓存；由 TencentCloudChat::Login / Logout 调用
+	 */
+	static void Reset();
+
+	static TencentCloudChatProfileCacheStats GetStats();
+
+	/**
+	 * 清空缓存并注销监听器，由模块关闭时调用
+	 */
+	static void Shutdown();
+};
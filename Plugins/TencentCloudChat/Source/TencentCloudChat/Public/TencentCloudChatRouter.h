@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Delegates/Delegate.h"
+
+#include "V2TIMMessage.h"
+#include "TencentCloudChatCodec.h"
+#include "TencentCloudChatDedup.h"
+
+/**
+ * 路由给处理函数的消息，只在回调期间有效
+ */
+struct TencentCloudChatRoutedMessage
+{
+	/**
+	 * 已经解压、拆分后的消息
+	 */
+	const V2TIMMessage &Message;
+
+	/**
+	 * 自定义消息的内容，不是自定义消息时为空
+	 */
+	TConstArrayView<uint8> Payload;
+
+	/**
+	 * Payload 按 TencentCloudChatCodec 解析的结果；Tag 为 0 时无效
+	 */
+	const TencentCloudChatCodecReader &Reader;
+
+	/**
+	 * TencentCloudChatCodec 的 schema id，不是该编码格式时为 0
+	 */
+	uint32 Tag;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FTencentCloudChatRouteDelegate, const TencentCloudChatRoutedMessage &);
+
+struct TencentCloudChatRouteStats
+{
+	uint32 Tag = 0;
+	int64 Count = 0;
+	double TotalSeconds = 0.0;
+	double MaxSeconds = 0.0;
+};
+
+/**
+ * 收消息的类型路由
+ *
+ * 每个通过 AddAdvancedMsgListener 注册的监听器都会收到全部新消息，各自遍历 elemList 判断是否相关。
+ * TencentCloudChatRouter 只向 SDK 注册一个监听器，每条消息只做一次解压、拆分（TencentCloudChatBatcher）和
+ * TencentCloudChatCodec 解析，再按 schema id 在哈希表中找到处理函数，只调用对应的处理函数。
+ * 路由前先经过去重（GetDedupFilter），重连或翻页历史消息时重复收到的消息不会再次路由；关闭
+ * TencentCloudChat.Router.Dedup 后每条消息都会路由。
+ *
+ * 处理函数在 SDK 回调的线程执行；打开 TencentCloudChat.Dispatch.GameThread 时即游戏线程。调用处理函数时不持有
+ * 路由的锁，处理函数中可以注册、注销处理函数。
+ * 每个 tag 的调用次数与耗时可以通过 GetStats 或控制台命令 TencentCloudChat.Router.Stats 查看。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatRouter
+{
+public:
+	/**
+	 * 为 tag（TencentCloudChatCodecSchema 的 id）注册处理函数，第一次注册时向 SDK 注册路由监听器
+	 */
+	static FDelegateHandle AddHandler(uint32 tag, FTencentCloudChatRouteDelegate::FDelegate &&handler);
+
+	static void RemoveHandler(uint32 tag, FDelegateHandle handle);
+
+	/**
+	 * 注册处理函数，接收没有对应 tag 处理函数的消息，包括文本等非自定义消息
+	 */
+	static FDelegateHandle AddFallbackHandler(FTencentCloudChatRouteDelegate::FDelegate &&handler);
+
+	static void RemoveFallbackHandler(FDelegateHandle handle);
+
+	/**
+	 * 按 tag 路由一条消息，路由监听器收到的每条消息都经过这里；也可以用来路由历史消息
+	 *
+	 * @return 已经路由过的消息返回 false
+	 */
+	static bool Route(const V2TIMMessage &message);
+
+	/**
+	 * Route 使用的去重过滤器
+	 */
+	static TencentCloudChatDedupFilter &GetDedupFilter();
+
+	/**
+	 * 每个 tag 的调用次数与耗时，按 tag 升序；tag 0 为兜底处理函数
+	 */
+	static TArray<TencentCloudChatRouteStats> GetStats();
+
+	static void ResetStats();
+
+	/**
+	 * 由模块关闭时调用，注销路由监听器
+	 */
+	static void Shutdown();
+};
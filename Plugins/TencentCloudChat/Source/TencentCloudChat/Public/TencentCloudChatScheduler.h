@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "V2TIMCallback.h"
+#include "V2TIMMessage.h"
+#include "V2TIMString.h"
+
+/**
+ * 令牌桶，按 rate（个/秒）补充令牌，最多积攒 burst 个
+ *
+ * 不加锁，由调用方保证互斥。
+ */
+struct TencentCloudChatTokenBucket
+{
+	double Tokens = -1.0;
+	double LastRefillTime = 0.0;
+
+	void Refill(double now, double rate, double burst)
+	{
+		if (Tokens < 0.0)
+		{
+			Tokens = burst;
+		}
+		else
+		{
+			Tokens = FMath::Min(burst, Tokens + (now - LastRefillTime) * rate);
+		}
+		LastRefillTime = now;
+	}
+
+	bool TryConsume(double now, double rate, double burst)
+	{
+		Refill(now, rate, burst);
+		if (Tokens < 1.0)
+		{
+			return false;
+		}
+		Tokens -= 1.0;
+		return true;
+	}
+};
+
+/**
+ * 带优先级和限速的消息发送队列
+ *
+ * TencentCloudChat::SendMessage 直接调用 SDK，没有本地限速，突发流量会被后台以频率限制错误码拒绝，消息随之丢失。
+ * 通过 TencentCloudChatScheduler::SendMessage 发送的消息先进入本地队列，由游戏线程每帧按以下规则发出：
+ *  - 按优先级出队：HIGH 先于 NORMAL（以及 DEFAULT）先于 LOW，同一优先级内先进先出；
+ *  - 全局令牌桶（TencentCloudChat.Scheduler.GlobalRate / GlobalBurst）限制总发送速率；
+ *  - 每个会话（群聊按 groupID，单聊按 receiver）一个令牌桶（ConversationRate / ConversationBurst），
+ *    某个会话没有令牌时只跳过该会话，不阻塞其他会话，同一会话内的顺序保持不变；
+ *  - 因频率限制失败的消息（见 IsFrequencyLimitError）退避后重新排队，最多重试 TencentCloudChat.Scheduler.MaxRetries 次。
+ *
+ * 队列长度上限为 TencentCloudChat.Scheduler.MaxQueueDepth。业务可以通过 GetBackpressure / ShouldShed
+ * 在后台开始拒绝之前主动丢弃低优先级的消息。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatScheduler
+{
+public:
+	/**
+	 * 把一条消息加入发送队列，参数含义与 TencentCloudChat::SendMessage 相同，可在任意线程调用
+	 *
+	 * message 会被拷贝；消息发出后的结果通过 callback 返回，msgID 见 OnSuccess 中的 message。
+	 *
+	 * @return 队列已满时返回 false，并以 ERR_SDK_COMM_API_CALL_FREQUENCY_LIMIT 调用 callback->OnError
+	 */
+	static bool SendMessage(const V2TIMMessage &message, const V2TIMString &receiver,
+							const V2TIMString &groupID, V2TIMMessagePriority priority,
+							bool onlineUserOnly, const V2TIMOfflinePushInfo &offlinePushInfo,
+							V2TIMSendCallback *callback);
+
+	/**
+	 * 排队中的消息总数
+	 */
+	static int32 GetQueueDepth();
+
+	/**
+	 * 排队中指定优先级的消息数，DEFAULT 与 NORMAL 合并计算
+	 */
+	static int32 GetQueueDepth(V2TIMMessagePriority priority);
+
+	/**
+	 * 队列压力，取值 [0, 1]，即排队消息数 / TencentCloudChat.Scheduler.MaxQueueDepth
+	 */
+	static float GetBackpressure();
+
+	/**
+	 * 当前压力下是否应该放弃发送该优先级的消息
+	 *
+	 * 压力达到 TencentCloudChat.Scheduler.ShedLowAt 时放弃 LOW，达到 ShedNormalAt 时放弃 NORMAL 和 DEFAULT，HIGH 不受影响。
+	 */
+	static bool ShouldShed(V2TIMMessagePriority priority);
+
+	/**
+	 * 是否为频率限制类错误码，这类错误在降低发送频率后重试即可成功
+	 */
+	static bool IsFrequencyLimitError(int errorCode);
+
+	/**
+	 * 在游戏线程发出当前令牌允许的消息，Ticker 每帧调用一次
+	 *
+	 * @return 本次发出的消息数
+	 */
+	static int32 Pump();
+
+	/**
+	 * 由模块在启动和关闭时调用，注册或注销每帧的 Pump；关闭时丢弃排队中的消息
+	 */
+	static void Startup();
+	static void Shutdown();
+};
@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "V2TIMMessage.h"
+#include "V2TIMString.h"
+
+/**
+ * 一条搜索结果
+ */
+struct TencentCloudChatSearchHit
+{
+	V2TIMString MsgID;
+	// 与 SDK 的 conversationID 相同："c2c_" + userID 或 "group_" + groupID
+	V2TIMString ConversationID;
+	int64 Timestamp = 0;
+};
+
+/**
+ * 全文索引的统计信息
+ */
+struct TencentCloudChatTextIndexStats
+{
+	int32 Messages = 0;
+	int32 Tokens = 0;
+	int64 Postings = 0;
+	SIZE_T MemoryBytes = 0;
+	uint64 Searches = 0;
+	double TotalSearchSeconds = 0.0;
+	double MaxSearchSeconds = 0.0;
+
+	double GetAverageSearchSeconds() const { return Searches > 0 ? TotalSearchSeconds / double(Searches) : 0.0; }
+};
+
+/**
+ * 消息文本的倒排索引，可在任意线程调用
+ *
+ * 文本转成小写后按连续的字母、数字和中日韩字符切分，每段生成相邻两个字符的 bigram；中日韩字符另外单独作为一个
+ * token，支持单字搜索。倒排表按加入顺序递增保存文档编号，搜索时从最短的倒排表开始求交集，需要时再用原文确认
+ * 子串匹配，结果按消息时间从新到旧返回。
+ *
+ * 删除只做标记，删除的消息超过存活的消息时整体压缩一次。消息数超过 TencentCloudChat.Search.MaxMessages 时
+ * 淘汰最早加入的消息。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatTextIndex
+{
+public:
+	/**
+	 * 加入一条文本，msgID 已存在时替换原来的文本
+	 */
+	void Add(const V2TIMString &msgID, const V2TIMString &conversationID, int64 timestamp, FStringView text);
+
+	/**
+	 * 加入消息中所有文本元素的内容，没有文本元素、已撤回或没有 msgID 时返回 false
+	 */
+	bool Add(const V2TIMMessage &message);
+
+	/**
+	 * @return msgID 不在索引中时返回 false
+	 */
+	bool Remove(const V2TIMString &msgID);
+
+	/**
+	 * 搜索包含 query 中所有关键字的消息，关键字之间用空白分隔，不区分大小写
+	 *
+	 * 只有标点的关键字会被忽略；单个非中日韩字符的关键字没有区分度，也会被忽略。
+	 *
+	 * @param maxHits outHits 最多返回的条数，按时间从新到旧
+	 * @param conversationID 非空时只搜索这个会话
+	 * @return 匹配的消息总数，可能大于 outHits 的条数
+	 */
+	int32 Search(FStringView query, TArray<TencentCloudChatSearchHit> &outHits, int32 maxHits = 50,
+				 const V2TIMString &conversationID = V2TIMString());
+
+	void Reset();
+
+	int32 Num() const;
+
+	TencentCloudChatTextIndexStats GetStats() const;
+
+	/**
+	 * 消息所在会话的 conversationID
+	 */
+	static V2TIMString GetConversationID(const V2TIMMessage &message);
+
+private:
+	struct Doc
+	{
+		V2TIMString MsgID;
+		// 小写后的原文，用于确认子串匹配
+		FString Text;
+		int64 Timestamp = 0;
+		int32 Conversation = INDEX_NONE;
+		bool bLive = false;
+	};
+
+	void RemoveDoc(int32 docId);
+	void EvictOldest();
+	void Compact();
+
+	mutable FCriticalSection Mutex;
+
+	// 文档编号即下标，只增不减，直到 Compact 重新编号
+	TArray<Doc> Docs;
+	TMap<V2TIMString, int32> MsgIdToDoc;
+	TMap<uint64, TArray<int32>> Postings;
+	TArray<V2TIMString> Conversations;
+	TMap<V2TIMString, int32> ConversationToIndex;
+	int32 LiveDocs = 0;
+	int32 OldestCursor = 0;
+	int64 PostingCount = 0;
+
+	TencentCloudChatTextIndexStats Stats;
+};
+
+/**
+ * 本地消息全文搜索
+ *
+ * TencentCloudChat::SearchLocalMessages 每次都要异步查询 SDK 的数据库，只支持关键字的“或 / 与”匹配和分页，
+ * 不适合边输入边搜索。打开后（Enable）本类在进程内维护一个 TencentCloudChatTextIndex：
+ *  - OnRecvNewMessage / OnRecvMessageModified 收到的消息和 TencentCloudChatHistoryCache 拉取到的历史消息自动加入；
+ *  - OnRecvMessageRevoked 撤回的消息从索引中删除；
+ *  - 其他来源的消息（例如自己发送的消息）通过 AddMessages 加入。
+ *
+ * Search 在调用线程同步返回，目标是 10 万条消息时单次搜索低于 5 毫秒，与 SearchLocalMessages 的对比见 TencentCloudChat.Bench Search。
+ * 索引只包含打开之后见到的消息，不能替代 SearchLocalMessages 对完整历史的搜索。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatSearch
+{
+public:
+	/**
+	 * 打开时注册消息监听器；关闭时注销监听器并清空索引
+	 */
+	static void Enable(bool bEnable);
+
+	static bool IsEnabled();
+
+	/**
+	 * 没有打开时忽略
+	 */
+	static void AddMessages(const V2TIMMessageVector &messages);
+
+	/**
+	 * 见 TencentCloudChatTextIndex::Search
+	 */
+	static int32 Search(FStringView query, TArray<TencentCloudChatSearchHit> &outHits, int32 maxHits = 50,
+						const V2TIMString &conversationID = V2TIMString());
+
+	static TencentCloudChatTextIndex &GetIndex();
+
+	/**
+	 * 清空索引，保持打开状态；由 TencentCloudChat::Login / Logout 调用
+	 */
+	static void Reset();
+
+	/**
+	 * 由模块在关闭时调用
+	 */
+	static void Shutdown();
+};
@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/**
+ * 是否统计 TencentCloudChat 的调用和事件，默认在 stat 或 CSV 可用时打开（Shipping 中关闭），
+ * 可在工程的 Build.cs 中通过 PublicDefinitions 覆盖
+ *
+ * 打开时所有经过 TencentCloudChat 的回调和监听器都会被包装，即使没有打开游戏线程分发。
+ */
+#ifndef TENCENTCLOUDCHAT_WITH_STATS
+#define TENCENTCLOUDCHAT_WITH_STATS (STATS || CSV_PROFILER)
+#endif
+
+enum class ETencentCloudChatListenerCategory : uint8
+{
+	SDK,
+	SimpleMsg,
+	AdvancedMsg,
+	Group,
+	Conversation,
+	Friendship,
+	Signaling,
+	Num
+};
+
+/**
+ * 插件的运行时计数，写入 stat TencentCloudChat 和 CSV 的 TencentCloudChat 分类
+ *
+ *  - Calls In Flight：已经传给 SDK、还没有收到 OnSuccess / OnError / OnComplete 的回调数；
+ *  - Callbacks Delivered：每帧收到的回调数；
+ *  - Listener Events：每帧分发给各类监听器的事件数，同一事件分发给多个监听器时分别计数；
+ *  - Payload Bytes Sent / Received：每帧发送和收到的自定义消息数据（V2TIMCustomElem::data）字节数。
+ *
+ * 每个 TencentCloudChat 接口的同步耗时另有独立的 cycle counter（API 接口名）和 CSV 计时，
+ * 异步请求的响应延迟见 TencentCloudChatLatency。
+ * CSV 中的计数每帧在游戏线程写入一次。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatStats
+{
+public:
+	static void RecordCallIssued();
+	static void RecordCallbackDelivered();
+	static void RecordListenerEvent(ETencentCloudChatListenerCategory category);
+	static void RecordPayloadSent(int64 bytes);
+	static void RecordPayloadReceived(int64 bytes);
+
+	static int32 GetCallsInFlight();
+
+	/**
+	 * 由 TencentCloudChat 在 InitSDK 成功和 UnInitSDK 时调用，注册或注销统计收到字节数的消息监听器
+	 */
+	static void OnSDKInitialized();
+	static void OnSDKUninitialized();
+
+	/**
+	 * 由模块在启动和关闭时调用，注册或注销每帧写入 CSV 的 Ticker
+	 */
+	static void Startup();
+	static void Shutdown();
+};
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "Hash/CityHash.h"
+
+#include "V2TIMString.h"
+
+/**
+ * FString 与 V2TIMString 之间的转换
+ *
+ * TCHAR -> UTF-8 的转换结果写入线程局部的临时缓冲区，缓冲区按需增长后一直复用，
+ * 因此除了 V2TIMString 自身的存储之外不再产生额外的堆分配。
+ * 所有接口均可在任意线程调用。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatString
+{
+public:
+	/**
+	 * FString / FStringView / TEXT("") 转为 V2TIMString
+	 */
+	static V2TIMString ToV2TIM(FStringView str);
+
+	/**
+	 * UTF-8 字符串（FUtf8StringView，以及可以隐式转换为它的 UTF-8 字符串类型）转为 V2TIMString，不经过临时缓冲区
+	 */
+	static V2TIMString ToV2TIM(FUtf8StringView str);
+
+	/**
+	 * 对 V2TIMString 内容的 UTF-8 只读视图，不拷贝，生命周期不能超过 str
+	 */
+	static FUtf8StringView ToUtf8View(const V2TIMString &str);
+
+	/**
+	 * V2TIMString 转为 FString
+	 */
+	static FString ToFString(const V2TIMString &str);
+
+	/**
+	 * V2TIMString 转为 FString，写入 out 并复用 out 已有的容量
+	 */
+	static void ToFString(const V2TIMString &str, FString &out);
+
+	/**
+	 * UTF-8 字符串转为 FString，写入 out 并复用 out 已有的容量
+	 */
+	static void ToFString(FUtf8StringView str, FString &out);
+
+	/**
+	 * 把 str 以 UTF-8 编码写入当前线程的临时缓冲区，返回的视图在本线程下一次转换前有效
+	 */
+	static FUtf8StringView ToScratchUtf8(FStringView str);
+};
+
+/**
+ * 让 V2TIMString 可以直接作为 TMap / TSet 的键
+ */
+inline uint32 GetTypeHash(const V2TIMString &str)
+{
+	return static_cast<uint32>(CityHash64(str.CString(), static_cast<uint32>(str.Size())));
+}
@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+#include "V2TIMCallback.h"
+#include "V2TIMMessage.h"
+#include "TencentCloudChatStats.h"
+
+UE_TRACE_CHANNEL_EXTERN(TencentCloudChatChannel, TENCENTCLOUDCHAT_API);
+
+/**
+ * 消息生命周期中的阶段，写入 TencentCloudChat.MessageLifecycle 事件的 Stage 字段
+ */
+enum class ETencentCloudChatMessageStage : uint8
+{
+	// CreateXxxMessage 返回
+	Created,
+	// SendMessage / SendXxxMessage 调用 SDK 之后
+	SendIssued,
+	// 发送回调 OnProgress，Value 为进度
+	SendProgress,
+	// 发送回调 OnSuccess
+	SendSucceeded,
+	// 发送回调 OnError，Value 为错误码
+	SendFailed,
+	// OnRecvNewMessage
+	Received,
+};
+
+/**
+ * 发送前还不知道消息 ID 时 TraceSend 使用的 MsgID，发送接口返回后通过 Set 补上
+ *
+ * Set 之前 SDK 回调的 SendProgress / SendFailed 事件先保存，Set 时再写入；SendSucceeded 使用回调中消息的 msgID。
+ * 通道关闭时 TraceSend 不设置它，Set 不做任何事。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatTraceSendId
+{
+public:
+	void Set(const V2TIMString &msgID);
+
+private:
+	friend class TencentCloudChatTrace;
+
+	struct FState
+	{
+		FCriticalSection Mutex;
+		V2TIMString MsgID;
+		bool bSet = false;
+		TArray<TPair<ETencentCloudChatMessageStage, int32>> Pending;
+
+		void Record(ETencentCloudChatMessageStage stage, int32 value);
+	};
+
+	TSharedPtr<FState, ESPMode::ThreadSafe> State;
+};
+
+/**
+ * TencentCloudChat 在 Unreal Insights 中的 trace 通道
+ *
+ * 启动参数 -trace=cpu,TencentCloudChat（或运行时 Trace.Enable TencentCloudChat）打开后：
+ *  - 每个 TencentCloudChat 接口有一个 "TencentCloudChat::<接口名>" CPU scope；
+ *  - 经过 TencentCloudChat 注册的监听器每次被调用时有一个 "TencentCloudChat::Listener::<类别>" CPU scope，
+ *    打开游戏线程分发时在游戏线程上，否则在 SDK 线程上；
+ *  - 每条消息的创建、发送、发送进度、发送结果和收到各写入一个 TencentCloudChat.MessageLifecycle 事件
+ *    （Cycle、Stage、Value、MsgID），可以按 MsgID 串起一条消息的发送过程，与同一时间的帧对齐。
+ *
+ * SendC2CTextMessage 等简单消息接口在发送前没有消息 ID，它们的 SendProgress / SendFailed 事件在接口返回 MsgID
+ * 之后才写入（见 TencentCloudChatTraceSendId）。通道关闭时只有一次通道状态的检查。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatTrace
+{
+public:
+	static bool IsEnabled();
+
+	static void MessageStage(ETencentCloudChatMessageStage stage, const V2TIMString &msgID, int32 value = 0);
+
+	/**
+	 * 通道打开时返回一个从对象池分配的转发回调，记录发送进度和结果后调用 callback；否则原样返回 callback
+	 *
+	 * 放在 TencentCloudChatDispatcher::Marshal 之外，事件时间是 SDK 回调的时间。
+	 */
+	static V2TIMSendCallback *TraceSend(const V2TIMString &msgID, V2TIMSendCallback *callback);
+
+	/**
+	 * 同上，发送前还不知道消息 ID 时使用，发送接口返回后调用 outMsgID.Set
+	 */
+	static V2TIMSendCallback *TraceSend(TencentCloudChatTraceSendId &outMsgID, V2TIMSendCallback *callback);
+
+	/**
+	 * 监听器 CPU scope 的名字
+	 */
+	static constexpr const ANSICHAR *GetListenerScopeName(ETencentCloudChatListenerCategory category)
+	{
+		switch (category)
+		{
+		case ETencentCloudChatListenerCategory::SDK:
+			return "TencentCloudChat::Listener::SDK";
+		case ETencentCloudChatListenerCategory::SimpleMsg:
+			return "TencentCloudChat::Listener::SimpleMsg";
+		case ETencentCloudChatListenerCategory::AdvancedMsg:
+			return "TencentCloudChat::Listener::AdvancedMsg";
+		case ETencentCloudChatListenerCategory::Group:
+			return "TencentCloudChat::Listener::Group";
+		case ETencentCloudChatListenerCategory::Conversation:
+			return "TencentCloudChat::Listener::Conversation";
+		case ETencentCloudChatListenerCategory::Friendship:
+			return "TencentCloudChat::Listener::Friendship";
+		case ETencentCloudChatListenerCategory::Signaling:
+			return "TencentCloudChat::Listener::Signaling";
+		default:
+			return "TencentCloudChat::Listener";
+		}
+	}
+
+	/**
+	 * 由 TencentCloudChat 在 InitSDK 成功和 UnInitSDK 时调用，注册或注销记录收到消息的监听器
+	 */
+	static void OnSDKInitialized();
+	static void OnSDKUninitialized();
+
+	/**
+	 * 由模块在关闭时调用
+	 */
+	static void Shutdown();
+};
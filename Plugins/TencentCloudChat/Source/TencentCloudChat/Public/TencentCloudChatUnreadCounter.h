@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Delegates/Delegate.h"
+
+#include "V2TIMConversation.h"
+
+DECLARE_MULTICAST_DELEGATE(FTencentCloudChatUnreadChangedDelegate);
+
+/**
+ * 本地汇总的未读数
+ *
+ * 界面上的角标每次都调用 TencentCloudChat::GetTotalUnreadMessageCount / GetUnreadMessageCountByFilter 会产生大量 SDK 请求。
+ * Load 之后，未读数由以下事件在本地维护，查询不再访问 SDK：
+ *  - OnTotalUnreadMessageCountChanged：总未读数；
+ *  - OnUnreadMessageCountChangedByFilter：已通过 SubscribeUnreadMessageCountByFilter 订阅的过滤条件的未读数；
+ *  - TencentCloudChatConversationStore 的会话变化：其余过滤条件按本地会话列表计算，结果缓存到会话列表下一次变化。
+ *
+ * 与 SDK 相同，免打扰（V2TIM_NOT_RECEIVE_MESSAGE / V2TIM_RECEIVE_NOT_NOTIFY_MESSAGE）的会话不计入未读数。
+ *
+ * 未读数变化时 OnChanged 在游戏线程广播，同一帧内的多次变化只广播一次。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatUnreadCounter
+{
+public:
+	/**
+	 * 注册会话监听器，拉取总未读数，并加载 TencentCloudChatConversationStore；已经加载过时直接返回
+	 */
+	static void Load();
+
+	/**
+	 * 清空推送和计算得到的未读数，会话监听器保持注册；由 TencentCloudChat::Login / Logout 调用，切换账号后需要重新 Load
+	 */
+	static void Reset();
+
+	static uint64 GetTotalUnreadMessageCount();
+
+	/**
+	 * filter 中 type 为 V2TIM_UNKNOWN、conversationGroup 为空、markType 为 0 的条件不参与过滤
+	 */
+	static uint64 GetUnreadMessageCountByFilter(const V2TIMConversationListFilter &filter);
+
+	/**
+	 * 未读数可能发生变化时广播，每帧最多一次
+	 */
+	static FTencentCloudChatUnreadChangedDelegate &OnChanged();
+
+	/**
+	 * 由模块在启动和关闭时调用，注册或注销合并通知的 Ticker；关闭时同时清空未读数并注销监听器
+	 */
+	static void Startup();
+	static void Shutdown();
+};
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Delegates/Delegate.h"
+
+#include "V2TIMFriendship.h"
+#include "V2TIMString.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FTencentCloudChatUserStatusDelegate, const V2TIMUserStatus &);
+
+/**
+ * 带引用计数的用户状态订阅
+ *
+ * 多个界面各自调用 TencentCloudChat::SubscribeUserStatus / UnsubscribeUserStatus 时，重叠的用户会被重复订阅，
+ * 其中一个界面取消订阅会影响其他界面；订阅数超过后台上限时，最早订阅的用户会被悄悄淘汰。
+ * 通过 TencentCloudChatUserStatus 订阅时：
+ *  - 每个用户按 Subscribe / Unsubscribe 的次数计数，计数归零时才真正取消订阅；
+ *  - 变化先在本地累积，每 TencentCloudChat.UserStatus.FlushIntervalMs 只向 SDK 发出一次差异（先取消订阅再订阅）；
+ *  - 需要订阅的用户超过 TencentCloudChat.UserStatus.MaxSubscriptions 时，只订阅 priority 最高的用户；
+ *  - 断线重连（OnConnectSuccess）后重新订阅全部用户。
+ *
+ * 新订阅的用户会批量查询一次当前状态，之后由 OnUserStatusChanged 更新本地的状态表，界面通过 GetStatus 读取，
+ * 不需要调用 TencentCloudChat::GetUserStatus。
+ */
+class TENCENTCLOUDCHAT_API TencentCloudChatUserStatus
+{
+public:
+	/**
+	 * 增加对 userID 的订阅计数，可在任意线程调用
+	 *
+	 * @param priority 超过订阅上限时优先订阅 priority 高的用户；同一用户取所有订阅中的最大值
+	 */
+	static void Subscribe(const V2TIMString &userID, int32 priority = 0);
+
+	/**
+	 * 减少订阅计数，priority 需要与 Subscribe 时相同
+	 */
+	static void Unsubscribe(const V2TIMString &userID, int32 priority = 0);
+
+	/**
+	 * 本地状态表中 userID 的状态，还没有收到过或因超过 MaxSubscriptions 没有订阅时返回 false
+	 */
+	static bool GetStatus(const V2TIMString &userID, V2TIMUserStatus &outStatus);
+
+	/**
+	 * 立即把累积的变化发给 SDK
+	 */
+	static void Flush();
+
+	/**
+	 * 已订阅的用户数
+	 */
+	static int32 GetSubscribedNum();
+
+	/**
+	 * 订阅的用户状态变化时广播，在 SDK 监听器回调的线程执行
+	 */
+	static FTencentCloudChatUserStatusDelegate &OnStatusChanged();
+
+	/**
+	 * 清空订阅计数、订阅列表和状态表，不调用 SDK（登出后后台的订阅随会话失效）；由 TencentCloudChat::Login / Logout 调用，
+	 * 切换账号后界面需要重新 Subscribe
+	 */
+	static void Reset();
+
+	/**
+	 * 由模块在启动和关闭时调用，注册或注销定时发送差异的 Ticker；关闭时清空订阅计数和状态表，不调用 SDK
+	 */
+	static void Startup();
+	static void Shutdown();
+};
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+
+#include <type_traits>
+#include <utility>
+
+#include "V2TIMString.h"
+#include "TencentCloudChatString.h"
+
+/**
+ * 判断 T 是否为 V2TIMDefine.h 中 DEFINE_VECTOR / DEFINE_POINT_VECTOR 生成的容器（TXxxVector / TXPxxVector）
+ */
+template <typename T, typename = void>
+struct TIsTencentCloudChatVector
+{
+	static constexpr bool Value = false;
+};
+
+template <typename T>
+struct TIsTencentCloudChatVector<T, std::void_t<
+	decltype(std::declval<const T &>().Size()),
+	decltype(std::declval<const T &>()[size_t(0)]),
+	decltype(std::declval<T &>().PushBack(std::declval<const T &>()[size_t(0)])),
+	decltype(std::declval<T &>().PopBack()),
+	decltype(std::declval<T &>().Erase(size_t(0)))>>
+{
+	static constexpr bool Value = true;
+};
+
+/**
+ * SDK 容器的元素类型，例如 TTencentCloudChatVectorElement<V2TIMStringVector> 为 V2TIMString
+ */
+template <typename VectorType>
+using TTencentCloudChatVectorElement = std::decay_t<decltype(std::declval<const VectorType &>()[size_t(0)])>;
+
+/**
+ * SDK 容器的下标迭代器，只用于范围 for
+ *
+ * SDK 容器不暴露连续存储，operator[] 每次都要经过 pimpl 转发，因此迭代器只保存容器指针和下标。
+ */
+template <typename VectorType>
+class TencentCloudChatVectorIterator
+{
+public:
+	TencentCloudChatVectorIterator(VectorType &vector, size_t index)
+		: Vector(&vector), Index(index)
+	{
+	}
+
+	decltype(auto) operator*() const
+	{
+		return (*Vector)[Index];
+	}
+
+	TencentCloudChatVectorIterator &operator++()
+	{
+		++Index;
+		return *this;
+	}
+
+	bool operator!=(const TencentCloudChatVectorIterator &other) const
+	{
+		return Index != other.Index;
+	}
+
+private:
+	VectorType *Vector;
+	size_t Index;
+};
+
+/**
+ * 让 SDK 容器支持范围 for：for (const V2TIMString &userID : userIDList)
+ *
+ * SDK 容器定义在全局命名空间，这里的 begin / end 通过 ADL 被找到；非 SDK 容器不参与重载。
+ */
+template <typename VectorType, typename = std::enable_if_t<TIsTencentCloudChatVector<std::remove_const_t<VectorType>>::Value>>
+TencentCloudChatVectorIterator<VectorType> begin(VectorType &vector)
+{
+	return TencentCloudChatVectorIterator<VectorType>(vector, 0);
+}
+
+template <typename VectorType, typename = std::enable_if_t<TIsTencentCloudChatVector<std::remove_const_t<VectorType>>::Value>>
+TencentCloudChatVectorIterator<VectorType> end(VectorType &vector)
+{
+	return TencentCloudChatVectorIterator<VectorType>(vector, vector.Size());
+}
+
+/**
+ * TArray 与 SDK 容器之间的批量转换
+ *
+ * SDK 容器没有 Reserve，PushBack 时必然拷贝一次元素；这里保证除此之外不再有中间拷贝：
+ * FString 直接经 TencentCloudChatString 的临时缓冲区转为 V2TIMString，不生成 TCHAR_TO_UTF8 临时对象；
+ * 反方向先按 Size() 预留 TArray 容量，再逐个原地构造。
+ */
+class TencentCloudChatVector
+{
+public:
+	/**
+	 * FString 列表转为 V2TIMStringVector（例如 GetUsersInfo、KickGroupMember、SubscribeUserStatus 的 userID 列表）
+	 */
+	static V2TIMStringVector ToV2TIM(TConstArrayView<FString> strs)
+	{
+		V2TIMStringVector Out;
+		AppendTo(Out, strs);
+		return Out;
+	}
+
+	/**
+	 * 追加到已有的 V2TIMStringVector 末尾
+	 */
+	static void AppendTo(V2TIMStringVector &out, TConstArrayView<FString> strs)
+	{
+		for (const FString &Str : strs)
+		{
+			out.PushBack(TencentCloudChatString::ToV2TIM(Str));
+		}
+	}
+
+	/**
+	 * 元素原样拷贝的通用版本，例如 ToV2TIM<V2TIMMessageVector>(Messages)
+	 */
+	template <typename VectorType, typename = std::enable_if_t<TIsTencentCloudChatVector<VectorType>::Value>>
+	static VectorType ToV2TIM(TConstArrayView<TTencentCloudChatVectorElement<VectorType>> elements)
+	{
+		VectorType Out;
+		for (const TTencentCloudChatVectorElement<VectorType> &Element : elements)
+		{
+			Out.PushBack(Element);
+		}
+		return Out;
+	}
+
+	/**
+	 * V2TIMStringVector 转为 FString 列表
+	 */
+	static TArray<FString> ToTArray(const V2TIMStringVector &strs)
+	{
+		TArray<FString> Out;
+		ToTArray(strs, Out);
+		return Out;
+	}
+
+	/**
+	 * V2TIMStringVector 转为 FString 列表，写入 out 并复用 out 及其中 FString 已有的容量
+	 */
+	static void ToTArray(const V2TIMStringVector &strs, TArray<FString> &out)
+	{
+		const int32 Num = static_cast<int32>(strs.Size());
+		out.SetNum(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			TencentCloudChatString::ToFString(strs[Index], out[Index]);
+		}
+	}
+
+	/**
+	 * 通用版本，元素原样拷贝，例如 V2TIMConversationVector -> TArray<V2TIMConversation>
+	 */
+	template <typename VectorType, typename = std::enable_if_t<TIsTencentCloudChatVector<VectorType>::Value>>
+	static TArray<TTencentCloudChatVectorElement<VectorType>> ToTArray(const VectorType &elements)
+	{
+		const size_t Num = elements.Size();
+		TArray<TTencentCloudChatVectorElement<VectorType>> Out;
+		Out.Reserve(static_cast<int32>(Num));
+		for (size_t Index = 0; Index < Num; ++Index)
+		{
+			Out.Emplace(elements[Index]);
+		}
+		return Out;
+	}
+};
@@ -38,6 +38,7 @@ public class TencentCloudChat : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
+				"Json",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
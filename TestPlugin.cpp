@@ -10,37 +10,25 @@
 #include "TencentCloudChat.h"
 
 
-class SendMessageCallback : public V2TIMSendCallback {
-  public:
-
-	 void OnSuccess(const V2TIMMessage &message) override{
-        UE_LOG(LogTemp,Log,TEXT("=== SendCallback OnSuccess ======"));
-		
-    };
-    void OnError(int error_code, const V2TIMString &error_message) override {
-        UE_LOG(LogTemp,Log,TEXT("=== SendCallback OnError error code:%d ======"),error_code);
-    };
-    void OnProgress(uint32_t progress) override {
-      UE_LOG(LogTemp,Log,TEXT("=== SendCallback OnProgress progress:%d ======"),progress);
-    };
-  };
- class LoginCallback : public V2TIMCallback {
-    
-    public:
-  
-      void OnSuccess() override {
-        UE_LOG(LogTemp,Log,TEXT("<== login OnSuccess"));
-		V2TIMString textmessage = static_cast<V2TIMString>("message from ue5");
-		V2TIMString groupid = static_cast<V2TIMString>("@TGS#1F33BWOM6");
-		V2TIMString rec = static_cast<V2TIMString>("");
-		V2TIMMessage msg = TencentCloudChat::CreateTextMessage(textmessage);
-		SendMessageCallback* sb = new SendMessageCallback();
-		TencentCloudChat::SendMessage(msg, "",groupid, V2TIM_PRIORITY_DEFAULT,false,V2TIMOfflinePushInfo(),sb);
-      };
-      void OnError(int error_code, const V2TIMString &error_message) override {
-        UE_LOG(LogTemp,Log,TEXT("<== login failed OnError ======: %d"), error_code);
-      };
-  };
+// Callbacks are built from lambdas through TencentCloudChat*Callback::Create. The adapters come
+// from a fixed-size pool and recycle themselves after OnSuccess/OnError, so there is nothing to delete.
+static void SendTestMessage()
+{
+	V2TIMString textmessage = static_cast<V2TIMString>("message from ue5");
+	V2TIMString groupid = static_cast<V2TIMString>("@TGS#1F33BWOM6");
+	V2TIMMessage msg = TencentCloudChat::CreateTextMessage(textmessage);
+	TencentCloudChat::SendMessage(msg, "",groupid, V2TIM_PRIORITY_DEFAULT,false,V2TIMOfflinePushInfo(),
+		TencentCloudChatSendCallback::Create(
+			[](const V2TIMMessage &message) {
+				UE_LOG(LogTemp,Log,TEXT("=== SendCallback OnSuccess ======"));
+			},
+			[](int error_code, const V2TIMString &error_message) {
+				UE_LOG(LogTemp,Log,TEXT("=== SendCallback OnError error code:%d ======"),error_code);
+			},
+			[](uint32_t progress) {
+				UE_LOG(LogTemp,Log,TEXT("=== SendCallback OnProgress progress:%d ======"),progress);
+			}));
+}
 
 //////////////////////////////////////////////////////////////////////////
 // AUE5_PluginCharacter
@@ -83,16 +71,26 @@ void AUE5_PluginCharacter::BeginPlay()
 		Config.initPath = static_cast<V2TIMString>("/sdcard/Android/data/com.YourCompany.UE5_Plugin/files/UnrealGame/UE5_Plugin");
 		Config.logPath = static_cast<V2TIMString>("/sdcard/Android/data/com.YourCompany.UE5_Plugin/files/UnrealGame/UE5_Plugin");
 	#endif
-	bool initSuccess = TencentCloudChat::InitSDK(0,Config); // replace 0 with your sdkappid
-	if(initSuccess){
-		UE_LOG(LogTemp,Log,TEXT("TencentCloudChat Log============================================================================================= Init OnSuccess in work "));
-		 V2TIMString userid = static_cast<V2TIMString>("your login userid");// your userid 
-		 V2TIMString userSig = static_cast<V2TIMString>("your usersig "); // your usersig . you can get it here https://console.cloud.tencent.com/im/tool-usersig 
-		LoginCallback* login_callback_ = new LoginCallback();
-		TencentCloudChat::Login(userid,userSig,login_callback_);
-
-		// FMessageDialog::Open(EAppMsgType::Ok, text);
-	}
+	// InitSDKAsync runs the SDK init on a worker thread so BeginPlay does not hitch
+	TencentCloudChat::InitSDKAsync(0, Config, // replace 0 with your sdkappid
+		FTencentCloudChatInitSDKDelegate::CreateLambda([](bool initSuccess)
+	{
+		if(initSuccess){
+			UE_LOG(LogTemp,Log,TEXT("TencentCloudChat Log============================================================================================= Init OnSuccess in work "));
+			 V2TIMString userid = static_cast<V2TIMString>("your login userid");// your userid 
+			 V2TIMString userSig = static_cast<V2TIMString>("your usersig "); // your usersig . you can get it here https://console.cloud.tencent.com/im/tool-usersig 
+			TencentCloudChat::Login(userid,userSig,TencentCloudChatCallback::Create(
+				[]() {
+					UE_LOG(LogTemp,Log,TEXT("<== login OnSuccess"));
+					SendTestMessage();
+				},
+				[](int error_code, const V2TIMString &error_message) {
+					UE_LOG(LogTemp,Log,TEXT("<== login failed OnError ======: %d"), error_code);
+				}));
+
+			// FMessageDialog::Open(EAppMsgType::Ok, text);
+		}
+	}));
 	//Add Input Mapping Context
 	if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
 	{